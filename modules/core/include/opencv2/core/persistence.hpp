@@ -316,6 +316,8 @@ public:
         FORMAT_XML  = (1<<3), //!< flag, XML format
         FORMAT_YAML = (2<<3), //!< flag, YAML format
         FORMAT_JSON = (3<<3), //!< flag, JSON format
+        FORMAT_BINARY = (4<<3), /**< flag, binary format with aligned raw data blocks. Matrices are loaded
+                                     from memory mapped file without copying (see FileStorage::open) */
 
         BASE64      = 64,     //!< flag, write rawdata in Base64 by default. (consider using WRITE_BASE64)
         WRITE_BASE64 = BASE64 | WRITE, //!< flag, enable both WRITE and BASE64
@@ -354,6 +356,11 @@ public:
      the output file format (e.g. mydata.xml, .yml etc.). A file name can also contain parameters.
      You can use this format, "*?base64" (e.g. "file.json?base64" (case sensitive)), as an alternative to
      FileStorage::BASE64 flag.
+     Files with .cvbin extension (or FileStorage::FORMAT_BINARY flag) use the binary format: raw data
+     written by writeRaw() (e.g. matrix elements) is stored as aligned blocks in host byte order. Such files
+     are memory mapped on reading and matrices read from them reference the mapping (copy-on-write)
+     instead of parsing and copying the data. The binary format doesn't support appending, compression
+     and reading from memory buffer.
      @param flags Mode of operation. One of FileStorage::Mode
      @param encoding Encoding of the file. Note that UTF-16 XML encoding is not supported currently and
      you should use 8-bit encoding instead of it.
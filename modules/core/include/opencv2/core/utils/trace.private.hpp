@@ -16,6 +16,7 @@
 //! @cond IGNORED
 
 #include <deque>
+#include <vector>
 #include <ostream>
 
 #define INTEL_ITTNOTIFY_API_PRIVATE 1
@@ -68,6 +69,53 @@ public:
     virtual bool put(const TraceMessage& msg) const = 0;
 };
 
+//! Binary trace record (Chrome Trace Event export)
+struct TraceEvent
+{
+    enum Type {
+        EVENT_COMPLETE = 0,  ///< finished region: timestamp = begin, value.i = end timestamp
+        EVENT_FLOW,          ///< parallel_for_ body attached to root region (value.root)
+        EVENT_ARG_INT,
+        EVENT_ARG_DOUBLE,
+        EVENT_ARG_STRING
+    };
+    int type;
+    int regionID;
+    int64 timestamp;
+    const void* ptr;         ///< location (EVENT_COMPLETE) or argument name (EVENT_ARG_*)
+    union {
+        int64 i;
+        double d;
+        char s[24];          ///< truncated copy of string argument value
+        struct { int threadID; int regionID; int64 beginTimestamp; } root;
+    } value;
+};
+
+//! Per-thread ring buffer of trace records.
+//! Single producer (owner thread), no locks; oldest records are overwritten on overflow.
+//! Buffer content is read on process shutdown only.
+class TraceEventBuffer
+{
+public:
+    explicit TraceEventBuffer(size_t capacity_) : events(std::max(capacity_, (size_t)16)), written(0) {}
+
+    inline TraceEvent& next()
+    {
+        return events[(size_t)(written++ % events.size())];
+    }
+    inline size_t size() const { return (size_t)std::min<uint64>(written, events.size()); }
+    inline uint64 totalWritten() const { return written; }
+    //! i-th record in chronological order
+    inline const TraceEvent& at(size_t i) const
+    {
+        size_t first = written > events.size() ? (size_t)(written % events.size()) : 0;
+        return events[(first + i) % events.size()];
+    }
+private:
+    std::vector<TraceEvent> events;
+    uint64 written;
+};
+
 struct RegionStatistics
 {
     int currentSkippedRegions;
@@ -266,6 +314,7 @@ struct TraceManagerThreadLocal
 
 
     mutable cv::Ptr<TraceStorage> storage;
+    mutable cv::Ptr<TraceEventBuffer> eventBuffer;
 
     TraceManagerThreadLocal() :
         threadID(cv::utils::getThreadID()),
@@ -280,6 +329,7 @@ struct TraceManagerThreadLocal
     ~TraceManagerThreadLocal();
 
     TraceStorage* getStorage() const;
+    TraceEventBuffer* getEventBuffer() const;
 
     void recordLocation(const Region::LocationStaticStorage& location);
     void recordRegionEnter(const Region& region);
@@ -337,6 +387,7 @@ public:
     TLSDataAccumulator<TraceManagerThreadLocal> tls;
 
     cv::Ptr<TraceStorage> trace_storage;
+    bool trace_events;  // Chrome Trace Event JSON output (OPENCV_TRACE_FORMAT=chrome)
 private:
     // disable copying
     TraceManager(const TraceManager&);
@@ -0,0 +1,56 @@
+#include "perf_precomp.hpp"
+
+namespace opencv_test
+{
+using namespace perf;
+
+// Performance is 2*M*N*K/time FLOPs; run with OPENCV_CORE_GEMM_PACKED=0
+// to measure the previous (non-packed) implementation for comparison.
+
+CV_ENUM(GemmFlags, 0, GEMM_1_T, GEMM_2_T, GEMM_1_T | GEMM_2_T)
+
+typedef tuple<int, MatType, GemmFlags> Gemm_Size_Type_Flags_t;
+typedef TestBaseWithParam<Gemm_Size_Type_Flags_t> Gemm_Size_Type_Flags;
+
+PERF_TEST_P(Gemm_Size_Type_Flags, gemm,
+            testing::Combine(
+                testing::Values(64, 128, 256, 512, 1024),
+                testing::Values(CV_32FC1, CV_64FC1),
+                GemmFlags::all()
+                ))
+{
+    int size = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int flags = get<2>(GetParam());
+
+    Mat a(size, size, type), b(size, size, type), c(size, size, type), d(size, size, type);
+    declare.in(a, b, c, WARMUP_RNG).out(d);
+    declare.time(100);
+
+    TEST_CYCLE() cv::gemm(a, b, 1.0, c, 0.5, d, flags);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Gemm_Size_Type_Flags, gemm_rect,
+            testing::Combine(
+                testing::Values(100, 300),
+                testing::Values(CV_32FC1, CV_64FC1),
+                testing::Values(0, (int)GEMM_2_T)
+                ))
+{
+    int size = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int flags = get<2>(GetParam());
+    const int len = 2000;
+
+    Mat a(size, len, type), b = (flags & GEMM_2_T) ? Mat(size*2, len, type) : Mat(len, size*2, type);
+    Mat d(size, size*2, type);
+    declare.in(a, b, WARMUP_RNG).out(d);
+
+    TEST_CYCLE() cv::gemm(a, b, 1.0, noArray(), 0, d, flags);
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
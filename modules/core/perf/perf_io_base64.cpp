@@ -83,4 +83,41 @@ PERF_TEST_P(Size_Mat_StrType, DISABLED_fs_base64,
     SANITY_CHECK_NOTHING();
 }
 
+PERF_TEST_P(Size_Mat_StrType, fs_binary,
+            testing::Combine(testing::Values(MAT_SIZES),
+                             testing::Values(MAT_TYPES),
+                             testing::Values(String(".cvbin")))
+             )
+{
+    Size   size = get<0>(GetParam());
+    int    type = get<1>(GetParam());
+    String ext  = get<2>(GetParam());
+
+    Mat src(size.height, size.width, type);
+    Mat dst;
+
+    cv::String file_name = cv::tempfile(ext.c_str());
+    cv::String key       = "test_mat";
+
+    declare.in(src, WARMUP_RNG);
+    TEST_CYCLE_MULTIRUN(2)
+    {
+        {
+            FileStorage fs(file_name, cv::FileStorage::WRITE);
+            fs << key << src;
+            fs.release();
+        }
+        {
+            FileStorage fs(file_name, cv::FileStorage::READ);
+            dst.release();
+            fs[key] >> dst;
+            fs.release();
+        }
+    }
+
+    ASSERT_EQ(0, cvtest::norm(src, dst, NORM_INF));
+    remove(file_name.c_str());
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
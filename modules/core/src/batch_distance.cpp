@@ -100,28 +100,6 @@ void batchDistL2_(const float* src1, const float* src2, size_t step2,
     }
 }
 
-static void batchDistHamming(const uchar* src1, const uchar* src2, size_t step2,
-                             int nvecs, int len, int* dist, const uchar* mask)
-{
-    step2 /= sizeof(src2[0]);
-    if( !mask )
-    {
-        for( int i = 0; i < nvecs; i++ )
-             dist[i] = hal::normHamming(src1, src2 + step2*i, len);
-    }
-    else
-    {
-        int val0 = INT_MAX;
-        for( int i = 0; i < nvecs; i++ )
-        {
-            if (mask[i])
-                dist[i] = hal::normHamming(src1, src2 + step2*i, len);
-            else
-                dist[i] = val0;
-        }
-    }
-}
-
 static void batchDistHamming2(const uchar* src1, const uchar* src2, size_t step2,
                               int nvecs, int len, int* dist, const uchar* mask)
 {
@@ -196,6 +174,29 @@ typedef void (*BatchDistFunc)(const uchar* src1, const uchar* src2, size_t step2
                               int nvecs, int len, uchar* dist, const uchar* mask);
 
 
+// inserts distances d[0..n) of train rows j0, j0+1, ... into the sorted K-nearest lists.
+// since positive float's can be compared just like int's,
+// we handle both CV_32S and CV_32F cases with a single branch
+static inline void updateKNearest(const int* d, int n, int j0,
+                                  int* distptr, int* nidxptr, int K)
+{
+    for( int j = 0; j < n; j++ )
+    {
+        int dj = d[j];
+        if( dj < distptr[K-1] )
+        {
+            int k;
+            for( k = K-2; k >= 0 && distptr[k] > dj; k-- )
+            {
+                nidxptr[k+1] = nidxptr[k];
+                distptr[k+1] = distptr[k];
+            }
+            nidxptr[k+1] = j0 + j;
+            distptr[k+1] = dj;
+        }
+    }
+}
+
 struct BatchDistInvoker : public ParallelLoopBody
 {
     BatchDistInvoker( const Mat& _src1, const Mat& _src2,
@@ -224,27 +225,71 @@ struct BatchDistInvoker : public ParallelLoopBody
                  K > 0 ? (uchar*)bufptr : dist->ptr(i), mask->data ? mask->ptr(i) : 0);
 
             if( K > 0 )
+                updateKNearest(bufptr, src2->rows, update, (int*)dist->ptr(i), nidx->ptr<int>(i), K);
+        }
+    }
+
+    const Mat *src1;
+    const Mat *src2;
+    Mat *dist;
+    Mat *nidx;
+    const Mat *mask;
+    int K;
+    int update;
+    BatchDistFunc func;
+};
+
+
+// Blocked query x train Hamming distance computation.
+// A block of train descriptors is kept in cache while it is compared with a block of queries;
+// in the K-nearest mode the distance tile is reduced immediately, so the full
+// query x train distance matrix is never written.
+struct BatchDistHammingInvoker : public ParallelLoopBody
+{
+    BatchDistHammingInvoker( const Mat& _src1, const Mat& _src2,
+                             Mat& _dist, Mat& _nidx, int _K,
+                             const Mat& _mask, int _update )
+    {
+        src1 = &_src1;
+        src2 = &_src2;
+        dist = &_dist;
+        nidx = &_nidx;
+        K = _K;
+        mask = &_mask;
+        update = _update;
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int len = src2->cols, ntrain = src2->rows;
+        const int qblock = 8;
+        const int tblock = std::max(16, std::min(1024, (1 << 14) / std::max(len, 1)));
+        AutoBuffer<int> buf(K > 0 ? qblock*tblock : 1);
+
+        for( int i0 = range.start; i0 < range.end; i0 += qblock )
+        {
+            int qn = std::min(qblock, range.end - i0);
+            for( int j0 = 0; j0 < ntrain; j0 += tblock )
             {
-                int* nidxptr = nidx->ptr<int>(i);
-                // since positive float's can be compared just like int's,
-                // we handle both CV_32S and CV_32F cases with a single branch
-                int* distptr = (int*)dist->ptr(i);
+                int tn = std::min(tblock, ntrain - j0);
+                int* d = K > 0 ? buf.data() : dist->ptr<int>(i0) + j0;
+                size_t dstep = K > 0 ? (size_t)tn : dist->step1();
 
-                int j, k;
+                hal::normHammingBatch(src1->ptr(i0), src1->step, qn,
+                                      src2->ptr(j0), src2->step, tn, len, d, dstep);
 
-                for( j = 0; j < src2->rows; j++ )
+                for( int q = 0; q < qn; q++ )
                 {
-                    int d = bufptr[j];
-                    if( d < distptr[K-1] )
+                    int* dq = d + q*dstep;
+                    if( mask->data )
                     {
-                        for( k = K-2; k >= 0 && distptr[k] > d; k-- )
-                        {
-                            nidxptr[k+1] = nidxptr[k];
-                            distptr[k+1] = distptr[k];
-                        }
-                        nidxptr[k+1] = j + update;
-                        distptr[k+1] = d;
+                        const uchar* m = mask->ptr(i0 + q) + j0;
+                        for( int j = 0; j < tn; j++ )
+                            if( !m[j] )
+                                dq[j] = INT_MAX;
                     }
+                    if( K > 0 )
+                        updateKNearest(dq, tn, j0 + update, dist->ptr<int>(i0 + q), nidx->ptr<int>(i0 + q), K);
                 }
             }
         }
@@ -257,7 +302,6 @@ struct BatchDistInvoker : public ParallelLoopBody
     const Mat *mask;
     int K;
     int update;
-    BatchDistFunc func;
 };
 
 }
@@ -348,6 +392,14 @@ void cv::batchDistance( InputArray _src1, InputArray _src2,
         return;
     }
 
+    if( type == CV_8U && normType == NORM_HAMMING && dtype == CV_32S )
+    {
+        parallel_for_(Range(0, src1.rows),
+                      BatchDistHammingInvoker(src1, src2, dist, nidx, K, mask, update),
+                      (double)src1.rows * src2.rows * src2.cols * (1. / (1 << 22)));
+        return;
+    }
+
     BatchDistFunc func = 0;
     if( type == CV_8U )
     {
@@ -361,8 +413,6 @@ void cv::batchDistance( InputArray _src1, InputArray _src2,
             func = (BatchDistFunc)batchDistL2Sqr_8u32f;
         else if( normType == NORM_L2 && dtype == CV_32F )
             func = (BatchDistFunc)batchDistL2_8u32f;
-        else if( normType == NORM_HAMMING && dtype == CV_32S )
-            func = (BatchDistFunc)batchDistHamming;
         else if( normType == NORM_HAMMING2 && dtype == CV_32S )
             func = (BatchDistFunc)batchDistHamming2;
     }
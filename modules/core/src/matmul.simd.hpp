@@ -42,6 +42,7 @@
 //M*/
 
 #include "precomp.hpp"
+#include "opencv2/core/utils/configuration.private.hpp"
 
 #ifdef HAVE_LAPACK
 #define CV_GEMM_BASELINE_ONLY
@@ -741,6 +742,262 @@ static void GEMMStore_64fc( const Complexd* c_data, size_t c_step,
     GEMMStore(c_data, c_step, d_buf, d_buf_step, d_data, d_step, d_size, alpha, beta, flags);
 }
 
+#if CV_SIMD
+/****************************************************************************************\
+*                            Packed register-blocked GEMM                                *
+\****************************************************************************************/
+
+// The scheme follows dnn/src/layers/cpu_kernels/fast_gemm: a block of op(A) (MC x KC) and
+// a block of op(B) (KC x NC) are packed into contiguous panels of GEMM_PACKED_MR rows and
+// NR = 2*nlanes columns, then every MR x NR tile of D is accumulated in registers by
+// the micro-kernel. Macro tiles of D (MC x NC) are distributed between threads.
+
+#define GEMM_PACKED_STORAGE (1 << 18)
+#define GEMM_PACKED_MR 6
+#define GEMM_PACKED_MC 72
+#define GEMM_PACKED_NC 256
+
+template<typename T> struct GEMMPackedVec { enum { enabled = 0 }; };
+
+template<> struct GEMMPackedVec<float>
+{
+    enum { enabled = 1 };
+    typedef v_float32 vtype;
+    static inline vtype setall(float v) { return vx_setall_f32(v); }
+};
+
+#if CV_SIMD_64F
+template<> struct GEMMPackedVec<double>
+{
+    enum { enabled = 1 };
+    typedef v_float64 vtype;
+    static inline vtype setall(double v) { return vx_setall_f64(v); }
+};
+#endif
+
+template<typename T> static inline void
+GEMMPacked_microKernel( int kc, const T* a, const T* b, T* c, size_t ldc, T alpha )
+{
+    typedef GEMMPackedVec<T> VecT;
+    typedef typename VecT::vtype VT;
+    const int nlanes = VTraits<VT>::vlanes();
+
+    VT s00 = VecT::setall(0), s01 = s00, s10 = s00, s11 = s00, s20 = s00, s21 = s00,
+       s30 = s00, s31 = s00, s40 = s00, s41 = s00, s50 = s00, s51 = s00;
+
+    for( int p = 0; p < kc; p++, a += GEMM_PACKED_MR, b += nlanes*2 )
+    {
+        VT b0 = vx_load(b), b1 = vx_load(b + nlanes);
+
+        VT a0 = VecT::setall(a[0]);
+        s00 = v_fma(b0, a0, s00);
+        s01 = v_fma(b1, a0, s01);
+        VT a1 = VecT::setall(a[1]);
+        s10 = v_fma(b0, a1, s10);
+        s11 = v_fma(b1, a1, s11);
+        VT a2 = VecT::setall(a[2]);
+        s20 = v_fma(b0, a2, s20);
+        s21 = v_fma(b1, a2, s21);
+
+        a0 = VecT::setall(a[3]);
+        s30 = v_fma(b0, a0, s30);
+        s31 = v_fma(b1, a0, s31);
+        a1 = VecT::setall(a[4]);
+        s40 = v_fma(b0, a1, s40);
+        s41 = v_fma(b1, a1, s41);
+        a2 = VecT::setall(a[5]);
+        s50 = v_fma(b0, a2, s50);
+        s51 = v_fma(b1, a2, s51);
+    }
+
+    VT v_alpha = VecT::setall(alpha);
+#define GEMM_PACKED_FINALE(row) \
+    v_store(c + row*ldc, v_fma(s##row##0, v_alpha, vx_load(c + row*ldc))); \
+    v_store(c + row*ldc + nlanes, v_fma(s##row##1, v_alpha, vx_load(c + row*ldc + nlanes)))
+
+    GEMM_PACKED_FINALE(0);
+    GEMM_PACKED_FINALE(1);
+    GEMM_PACKED_FINALE(2);
+    GEMM_PACKED_FINALE(3);
+    GEMM_PACKED_FINALE(4);
+    GEMM_PACKED_FINALE(5);
+#undef GEMM_PACKED_FINALE
+}
+
+// packs m x k block of A (lda0 - row stride, lda1 - column stride) into MR-row panels
+template<typename T> static void
+GEMMPacked_packA( int m, int k, const T* A, size_t lda0, size_t lda1, T* packA )
+{
+    for( int i = 0; i < m; i += GEMM_PACKED_MR )
+    {
+        int mr = std::min(m - i, GEMM_PACKED_MR);
+        const T* a = A + i*lda0;
+        for( int p = 0; p < k; p++, packA += GEMM_PACKED_MR )
+        {
+            const T* ap = a + p*lda1;
+            int r = 0;
+            for( ; r < mr; r++ )
+                packA[r] = ap[r*lda0];
+            for( ; r < GEMM_PACKED_MR; r++ )
+                packA[r] = 0;
+        }
+    }
+}
+
+// packs k x n block of B (ldb0 - row stride, ldb1 - column stride) into NR-column panels
+template<typename T> static void
+GEMMPacked_packB( int n, int k, const T* B, size_t ldb0, size_t ldb1, T* packB, int NR )
+{
+    for( int j = 0; j < n; j += NR )
+    {
+        int nr = std::min(n - j, NR);
+        const T* b = B + j*ldb1;
+        for( int p = 0; p < k; p++, packB += NR )
+        {
+            const T* bp = b + p*ldb0;
+            int c = 0;
+            if( ldb1 == 1 )
+            {
+                memcpy(packB, bp, nr*sizeof(T));
+                c = nr;
+            }
+            else
+            {
+                for( ; c < nr; c++ )
+                    packB[c] = bp[c*ldb1];
+            }
+            for( ; c < NR; c++ )
+                packB[c] = 0;
+        }
+    }
+}
+
+template<typename T> static void
+GEMMPacked_macroKernel( int m, int n, int k, const T* packA, const T* packB,
+                        T alpha, T* c, size_t ldc )
+{
+    typedef typename GEMMPackedVec<T>::vtype VT;
+    const int NR = VTraits<VT>::vlanes()*2;
+    T tempC[GEMM_PACKED_MR*VTraits<VT>::max_nlanes*2];
+
+    for( int i = 0; i < m; i += GEMM_PACKED_MR )
+    {
+        int mr = std::min(m - i, GEMM_PACKED_MR);
+        for( int j = 0; j < n; j += NR )
+        {
+            int nr = std::min(n - j, NR);
+            T* cptr = c + i*ldc + j;
+            const T* a = packA + (size_t)i*k;
+            const T* b = packB + (size_t)j*k;
+            if( mr == GEMM_PACKED_MR && nr == NR )
+            {
+                GEMMPacked_microKernel(k, a, b, cptr, ldc, alpha);
+                continue;
+            }
+
+            memset(tempC, 0, sizeof(tempC));
+            for( int p = 0; p < mr; p++ )
+                memcpy(tempC + p*NR, cptr + p*ldc, nr*sizeof(T));
+            GEMMPacked_microKernel(k, a, b, tempC, (size_t)NR, alpha);
+            for( int p = 0; p < mr; p++ )
+                memcpy(cptr + p*ldc, tempC + p*NR, nr*sizeof(T));
+        }
+    }
+}
+
+// D = alpha*op(A)*op(B) + beta*op(C); D must not share memory with A or B
+template<typename T> static void
+GEMMPacked( const Mat& A, const Mat& B, T alpha, const Mat& C, T beta, Mat& D, int flags )
+{
+    typedef typename GEMMPackedVec<T>::vtype VT;
+    const int GEMM_MR = GEMM_PACKED_MR, GEMM_NR = VTraits<VT>::vlanes()*2;
+    const int M = D.rows, N = D.cols, K = (flags & GEMM_1_T) ? A.rows : A.cols;
+    const size_t esz = sizeof(T);
+
+    size_t a_step = A.step/esz, b_step = B.step/esz, c_step = C.step/esz, d_step = D.step/esz;
+    size_t lda0 = a_step, lda1 = 1, ldb0 = b_step, ldb1 = 1, ldc0 = c_step, ldc1 = 1;
+    if( flags & GEMM_1_T )
+        std::swap(lda0, lda1);
+    if( flags & GEMM_2_T )
+        std::swap(ldb0, ldb1);
+    if( flags & GEMM_3_T )
+        std::swap(ldc0, ldc1);
+
+    const T* a_data = A.ptr<T>();
+    const T* b_data = B.ptr<T>();
+    const T* c_data = C.empty() || beta == 0 ? 0 : C.ptr<T>();
+    T* d_data = D.ptr<T>();
+
+    int MC = ((std::min(GEMM_PACKED_MC, M) + GEMM_MR - 1) / GEMM_MR) * GEMM_MR;
+    int NC = ((std::min(GEMM_PACKED_NC, N) + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
+    int KC = GEMM_PACKED_STORAGE / (int)((MC + NC) * esz);
+    KC = std::max(KC, 8);
+    KC = std::min(KC, K);
+
+    int m_tiles = (M + MC - 1) / MC;
+    int n_tiles = (N + NC - 1) / NC;
+    int total_tiles = m_tiles * n_tiles;
+
+    auto fn = [&](const Range& r)
+    {
+        AutoBuffer<T> buf((size_t)KC*(MC + NC));
+        T* packA = buf.data();
+        T* packB = packA + (size_t)KC*MC;
+
+        for( int tile_idx = r.start; tile_idx < r.end; tile_idx++ )
+        {
+            int i0 = (tile_idx / n_tiles) * MC;
+            int j0 = (tile_idx % n_tiles) * NC;
+            int mc = std::min(M - i0, MC);
+            int nc = std::min(N - j0, NC);
+            T* d_block = d_data + i0*d_step + j0;
+
+            for( int i = 0; i < mc; i++ )
+            {
+                T* d = d_block + i*d_step;
+                if( !c_data )
+                    memset(d, 0, nc*esz);
+                else
+                {
+                    const T* c = c_data + (i0 + i)*ldc0 + j0*ldc1;
+                    for( int j = 0; j < nc; j++ )
+                        d[j] = c[j*ldc1]*beta;
+                }
+            }
+
+            for( int k0 = 0; k0 < K; k0 += KC )
+            {
+                int kc = std::min(K - k0, KC);
+                GEMMPacked_packA(mc, kc, a_data + i0*lda0 + k0*lda1, lda0, lda1, packA);
+                GEMMPacked_packB(nc, kc, b_data + k0*ldb0 + j0*ldb1, ldb0, ldb1, packB, GEMM_NR);
+                GEMMPacked_macroKernel(mc, nc, kc, packA, packB, alpha, d_block, d_step);
+            }
+        }
+    };
+
+    double nstripes = (double)M * N * K * (1. / (1 << 20));
+    parallel_for_(Range(0, total_tiles), fn, nstripes);
+}
+
+static bool GEMMPacked_useFor( const Mat& A, const Mat& B, const Mat& C, const Mat& D,
+                               int type, Size d_size, int len )
+{
+    static const bool param_enable = utils::getConfigurationParameterBool("OPENCV_CORE_GEMM_PACKED", true);
+    if( !param_enable )
+        return false;
+    if( type == CV_32FC1 ? !GEMMPackedVec<float>::enabled :
+        type == CV_64FC1 ? !GEMMPackedVec<double>::enabled : true )
+        return false;
+    // small or skinny products are faster with the straightforward loops below
+    if( d_size.width < 16 || d_size.height < GEMM_PACKED_MR*2 || len < 16 ||
+        (double)d_size.width * d_size.height * len < 32768. )
+        return false;
+    size_t esz = CV_ELEM_SIZE(type);
+    return A.step % esz == 0 && B.step % esz == 0 && D.step % esz == 0 &&
+           (C.empty() || C.step % esz == 0);
+}
+#endif // CV_SIMD
+
 static void gemmImpl( Mat A, Mat B, double alpha,
            Mat C, double beta, Mat D, int flags )
 {
@@ -1033,6 +1290,19 @@ static void gemmImpl( Mat A, Mat B, double alpha,
         }
     }
 
+#if CV_SIMD
+    if( GEMMPacked_useFor(A, B, C, D, type, d_size, len) )
+    {
+        if( type == CV_32FC1 )
+            GEMMPacked<float>(A, B, (float)alpha, C, (float)beta, D, flags);
+#if CV_SIMD_64F
+        else
+            GEMMPacked<double>(A, B, alpha, C, beta, D, flags);
+#endif
+        return;
+    }
+#endif
+
     {
     size_t b_step = B.step;
     GEMMSingleMulFunc singleMulFunc;
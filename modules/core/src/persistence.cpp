@@ -405,6 +405,9 @@ void FileStorage::Impl::init() {
 
     filename.clear();
     lineno = 0;
+
+    mapping.release();
+    expanded_raw_seqs.clear();
 }
 
 FileStorage::Impl::Impl(FileStorage *_fs) {
@@ -495,6 +498,17 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
     if (mem_mode && append)
         CV_Error(cv::Error::StsBadFlag, "FileStorage::APPEND and FileStorage::MEMORY are not currently compatible");
 
+    // binary format is detected before opening the file, as it must be written in binary mode
+    bool write_binary = false;
+    if (write_mode) {
+        int format = _flags & FileStorage::FORMAT_MASK;
+        const char *dot_pos = strrchr(filename.c_str(), '.');
+        write_binary = format == FileStorage::FORMAT_BINARY ||
+                       (format == FileStorage::FORMAT_AUTO && dot_pos && fs::strcasecmp(dot_pos, ".cvbin") == 0);
+        if (write_binary && append)
+            CV_Error(cv::Error::StsNotImplemented, "Appending data to binary file is not implemented");
+    }
+
     flags = _flags;
 
     if (!mem_mode) {
@@ -506,6 +520,9 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
             if (append) {
                 CV_Error(cv::Error::StsNotImplemented, "Appending data to compressed file is not implemented");
             }
+            if (write_binary) {
+                CV_Error(cv::Error::StsNotImplemented, "Compression of binary file is not implemented");
+            }
             isGZ = true;
             compression = dot_pos[3];
             if (compression)
@@ -513,7 +530,7 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
         }
 
         if (!isGZ) {
-            file = fopen(filename.c_str(), !write_mode ? "rt" : !append ? "wt" : "a+t");
+            file = fopen(filename.c_str(), !write_mode ? "rt" : write_binary ? "wb" : !append ? "wt" : "a+t");
             if (!file)
             {
                 CV_LOG_ERROR(NULL, "Can't open file: '" << filename << "' in " << (!write_mode ? "read" : !append ? "write" : "append") << " mode");
@@ -547,7 +564,9 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
         if (mem_mode)
             outbuf.clear();
 
-        if (fmt == FileStorage::FORMAT_AUTO && !filename.empty()) {
+        if (write_binary) {
+            fmt = FileStorage::FORMAT_BINARY;
+        } else if (fmt == FileStorage::FORMAT_AUTO && !filename.empty()) {
             const char *dot_pos = NULL;
             const char *dot_pos2 = NULL;
             // like strrchr() implementation, but save two last positions simultaneously
@@ -585,7 +604,7 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
         buffer.reserve(buf_size + 1024);
         buffer.resize(buf_size);
         bufofs = 0;
-        is_using_base64 = write_base64;
+        is_using_base64 = write_base64 && fmt != FileStorage::FORMAT_BINARY;
         state_of_writing_base64 = FileStorage_API::Base64State::Uncertain;
 
         if (fmt == FileStorage::FORMAT_XML) {
@@ -648,6 +667,8 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
                 puts("...\n---\n");
 
             emitter_do_not_use_direct_dereference = createYAMLEmitter(this);
+        } else if (fmt == FileStorage::FORMAT_BINARY) {
+            emitter_do_not_use_direct_dereference = createBinaryEmitter(this);
         } else {
             CV_Assert(fmt == FileStorage::FORMAT_JSON);
             if (!append)
@@ -691,6 +712,7 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
         const char *yaml_signature = "%YAML";
         const char *json_signature = "{";
         const char *xml_signature = "<?xml";
+        const char *binary_signature = "%OCVBIN";
         char *buf = this->gets(16);
         CV_Assert(buf);
         char *bufPtr = cv_skip_BOM(buf);
@@ -702,11 +724,16 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
             fmt = FileStorage::FORMAT_JSON;
         else if (strncmp(bufPtr, xml_signature, strlen(xml_signature)) == 0)
             fmt = FileStorage::FORMAT_XML;
+        else if (strncmp(bufPtr, binary_signature, strlen(binary_signature)) == 0)
+            fmt = FileStorage::FORMAT_BINARY;
         else if (strbufsize == bufOffset)
             CV_Error(cv::Error::StsBadArg, "Input file is invalid");
         else
             CV_Error(cv::Error::StsBadArg, "Unsupported file storage format");
 
+        if (fmt == FileStorage::FORMAT_BINARY && (mem_mode || gzfile))
+            CV_Error(cv::Error::StsNotImplemented, "Binary file storage can be read from uncompressed file only");
+
         rewind();
         strbufpos = bufOffset;
         bufofs = 0;
@@ -733,6 +760,12 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
                 case FileStorage::FORMAT_JSON:
                     parser_do_not_use_direct_dereference = createJSONParser(this);
                     break;
+                case FileStorage::FORMAT_BINARY:
+                    mapping = FileStorageMapping::create(filename);
+                    if (!mapping)
+                        CV_Error(cv::Error::StsError, "Can't read file: '" + filename + "'");
+                    parser_do_not_use_direct_dereference = createBinaryParser(this, mapping->data(), mapping->size());
+                    break;
                 default:
                     parser_do_not_use_direct_dereference = Ptr<FileStorageParser>();
             }
@@ -784,6 +817,38 @@ void FileStorage::Impl::puts(const char *str) {
         CV_Error(cv::Error::StsError, "The storage is not opened");
 }
 
+void FileStorage::Impl::putBytes(const void *data, size_t len) {
+    CV_Assert(write_mode);
+    const char *ptr = (const char *) data;
+    if (mem_mode)
+        std::copy(ptr, ptr + len, std::back_inserter(outbuf));
+    else if (file) {
+        if (fwrite(data, 1, len, file) != len)
+            CV_Error(cv::Error::StsError, "Can't write to file: '" + filename + "'");
+    } else
+        CV_Error(cv::Error::StsError, "The storage is not opened");
+}
+
+void FileStorage::Impl::patchBytes(size_t pos, const void *data, size_t len) {
+    CV_Assert(write_mode);
+    const char *ptr = (const char *) data;
+    if (mem_mode) {
+        CV_Assert(pos + len <= outbuf.size());
+        std::copy(ptr, ptr + len, outbuf.begin() + pos);
+    } else if (file) {
+#ifdef _WIN32
+        bool ok = _fseeki64(file, (__int64) pos, SEEK_SET) == 0;
+#else
+        bool ok = fseeko(file, (off_t) pos, SEEK_SET) == 0;
+#endif
+        ok = ok && fwrite(data, 1, len, file) == len;
+        ok = fseek(file, 0, SEEK_END) == 0 && ok;
+        if (!ok)
+            CV_Error(cv::Error::StsError, "Can't write to file: '" + filename + "'");
+    } else
+        CV_Error(cv::Error::StsError, "The storage is not opened");
+}
+
 char *FileStorage::Impl::getsFromFile(char *buf, int count) {
     if (file)
         return fgets(buf, count, file);
@@ -988,6 +1053,12 @@ void FileStorage::Impl::startWriteStruct_helper(const char *key, int struct_flag
 
 void FileStorage::Impl::startWriteStruct(const char *key, int struct_flags,
                                          const char *type_name) {
+    if (fmt == FileStorage::FORMAT_BINARY) {
+        // raw data is always stored as binary blocks, no Base64 handling
+        startWriteStruct_helper(key, struct_flags, type_name);
+        return;
+    }
+
     check_if_write_struct_is_delayed(false);
     if (state_of_writing_base64 == FileStorage_API::NotUse)
         switch_to_Base64_state(FileStorage_API::Uncertain);
@@ -1057,6 +1128,11 @@ void FileStorage::Impl::write(const String &key, const String &value) {
 void FileStorage::Impl::writeRawData(const std::string &dt, const void *_data, size_t len) {
     CV_Assert(write_mode);
 
+    if (fmt == FileStorage::FORMAT_BINARY) {
+        getEmitter().writeRawData(dt.c_str(), _data, len);
+        return;
+    }
+
     if (is_using_base64 || state_of_writing_base64 == FileStorage_API::Base64State::InUse) {
         writeRawDataBase64(_data, len, dt.c_str());
         return;
@@ -1517,6 +1593,18 @@ unsigned FileStorage::Impl::getStringOfs(const std::string &key) const {
     return it != str_hash.end() ? it->second : 0;
 }
 
+unsigned FileStorage::Impl::addStringOfs(const std::string &key) {
+    unsigned strofs = getStringOfs(key);
+    if (!strofs) {
+        strofs = (unsigned) str_hash_data.size();
+        size_t keysize = key.size() + 1;
+        str_hash_data.resize(strofs + keysize);
+        memcpy(&str_hash_data[0] + strofs, &key[0], keysize);
+        str_hash.insert(std::make_pair(key, strofs));
+    }
+    return strofs;
+}
+
 FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key,
                                     int elem_type, const void *value, int len) {
     FileStorage_API *fs = this;
@@ -1528,16 +1616,8 @@ FileNode FileStorage::Impl::addNode(FileNode &collection, const std::string &key
         CV_PARSE_ERROR_CPP(noname ? "Map element should have a name" :
                            "Sequence element should not have name (use <_></_>)");
     unsigned strofs = 0;
-    if (!noname) {
-        strofs = getStringOfs(key);
-        if (!strofs) {
-            strofs = (unsigned) str_hash_data.size();
-            size_t keysize = key.size() + 1;
-            str_hash_data.resize(strofs + keysize);
-            memcpy(&str_hash_data[0] + strofs, &key[0], keysize);
-            str_hash.insert(std::make_pair(key, strofs));
-        }
-    }
+    if (!noname)
+        strofs = addStringOfs(key);
 
     uchar *cp = collection.ptr();
 
@@ -1595,6 +1675,110 @@ void FileStorage::Impl::finalizeCollection(FileNode &collection) {
     writeInt(ptr, (int) rawSize);
 }
 
+// The raw sequence node of binary format (see CV_FS_RAW_SEQ) is stored as:
+// tag, [name], raw size (24), number of elements, format string offset, data offset and data size (8 bytes each)
+void FileStorage::Impl::setRawSeq(FileNode &node, const std::string &dt, size_t nelems, size_t dataOfs, size_t dataSize) {
+    CV_Assert(node.type() == FileNode::NONE);
+    CV_Assert(nelems <= (size_t) INT_MAX);
+    bool named = node.isNamed();
+    unsigned dtofs = addStringOfs(dt);
+    uchar *ptr = reserveNodeSpace(node, 1 + (named ? 4 : 0) + 4 + 24);
+    *ptr++ = (uchar) (FileNode::SEQ | CV_FS_RAW_SEQ | (named ? FileNode::NAMED : 0));
+    if (named)
+        ptr += 4;
+    writeInt(ptr, 24);
+    writeInt(ptr + 4, (int) nelems);
+    writeInt(ptr + 8, (int) dtofs);
+    writeInt(ptr + 12, (int) (uint64) dataOfs);
+    writeInt(ptr + 16, (int) ((uint64) dataOfs >> 32));
+    writeInt(ptr + 20, (int) (uint64) dataSize);
+    writeInt(ptr + 24, (int) ((uint64) dataSize >> 32));
+}
+
+bool FileStorage::Impl::getRawSeqData(const FileNode &node, std::string &dt, const uchar *&data, size_t &size) const {
+    const uchar *ptr = node.ptr();
+    if (!ptr || !(*ptr & CV_FS_RAW_SEQ))
+        return false;
+    CV_Assert(mapping);
+    ptr += (*ptr & FileNode::NAMED) ? 5 : 1;
+    dt = getName((unsigned) readInt(ptr + 8));
+    uint64 dataOfs = (unsigned) readInt(ptr + 12) | ((uint64) (unsigned) readInt(ptr + 16) << 32);
+    uint64 dataSize = (unsigned) readInt(ptr + 20) | ((uint64) (unsigned) readInt(ptr + 24) << 32);
+    CV_Assert(dataOfs <= mapping->size() && dataSize <= mapping->size() - dataOfs);
+    data = mapping->data() + dataOfs;
+    size = (size_t) dataSize;
+    return true;
+}
+
+bool FileStorage::Impl::readRawSeq(const FileNode &node, const std::string &format, void *vec, size_t len) const {
+    std::string dt;
+    const uchar *data = 0;
+    size_t size = 0;
+    if (!getRawSeqData(node, dt, data, size))
+        return false;
+
+    int fmt_pairs[CV_FS_MAX_FMT_PAIRS * 2], dt_pairs[CV_FS_MAX_FMT_PAIRS * 2];
+    int fmt_pair_count = fs::decodeFormat(format.c_str(), fmt_pairs, CV_FS_MAX_FMT_PAIRS);
+    int dt_pair_count = fs::decodeFormat(dt.c_str(), dt_pairs, CV_FS_MAX_FMT_PAIRS);
+    if (fmt_pair_count == 1 && dt_pair_count == 1) {
+        // plain arrays of numbers: copy or convert element-wise
+        int sdepth = dt_pairs[1], ddepth = fmt_pairs[1];
+        size_t count = std::min(len / CV_ELEM_SIZE1(ddepth), size / CV_ELEM_SIZE1(sdepth));
+        CV_Assert(count <= (size_t) INT_MAX);
+        if (sdepth == ddepth)
+            memcpy(vec, data, count * CV_ELEM_SIZE1(sdepth));
+        else if (count > 0) {
+            Mat dst(1, (int) count, ddepth, vec);
+            Mat(1, (int) count, sdepth, (void *) data).convertTo(dst, ddepth);
+        }
+        return true;
+    }
+    if (fmt_pair_count == dt_pair_count &&
+        std::equal(fmt_pairs, fmt_pairs + fmt_pair_count * 2, dt_pairs)) {
+        memcpy(vec, data, std::min(len, size));
+        return true;
+    }
+    return false;
+}
+
+FileNode FileStorage::Impl::expandRawSeq(const FileNode &node) {
+    std::pair<size_t, size_t> key(node.blockIdx, node.ofs);
+    std::map<std::pair<size_t, size_t>, FileNode>::const_iterator it = expanded_raw_seqs.find(key);
+    if (it != expanded_raw_seqs.end())
+        return it->second;
+
+    std::string dt;
+    const uchar *data = 0;
+    size_t size = 0;
+    CV_Assert(getRawSeqData(node, dt, data, size));
+
+    FileNode seq(this, fs_data_ptrs.size() - 1, freeSpaceOfs);
+    uchar *ptr = reserveNodeSpace(seq, 1 + 4 + 4);
+    *ptr = FileNode::SEQ;
+    writeInt(ptr + 1, 4);
+    writeInt(ptr + 5, 0);
+    fs::addRawDataNodes(this, seq, dt.c_str(), data, size);
+    finalizeCollection(seq);
+
+    expanded_raw_seqs[key] = seq;
+    return seq;
+}
+
+Mat fs::getMappedMat(const FileNode &node, int dims, const int *sizes, int type) {
+    FileStorage::Impl *fs = node.fs;
+    std::string dt;
+    const uchar *data = 0;
+    size_t size = 0;
+    if (!fs || !fs->getRawSeqData(node, dt, data, size) || fs::decodeSimpleFormat(dt.c_str()) != type)
+        return Mat();
+    size_t total = CV_ELEM_SIZE(type);
+    for (int i = 0; i < dims; i++)
+        total *= (size_t) sizes[i];
+    if (total != size)
+        return Mat();
+    return FileStorageMapping::wrap(fs->mapping, data, dims, sizes, type);
+}
+
 void FileStorage::Impl::normalizeNodeOfs(size_t &blockIdx, size_t &ofs) const {
     while (ofs >= fs_data_blksz[blockIdx]) {
         if (blockIdx == fs_data_blksz.size() - 1) {
@@ -2326,6 +2510,8 @@ FileNodeIterator FileNode::end() const   { return FileNodeIterator(*this, true);
 
 void FileNode::readRaw( const std::string& fmt, void* vec, size_t len ) const
 {
+    if( fs && fs->readRawSeq(*this, fmt, vec, len) )
+        return;
     FileNodeIterator it = begin();
     it.readRaw( fmt, vec, len );
 }
@@ -2463,6 +2649,12 @@ FileNodeIterator::FileNodeIterator( const FileNode& node, bool seekEnd )
                 ofs += node.rawSize();
             }
         }
+        else if( *node.ptr() & CV_FS_RAW_SEQ )
+        {
+            // element-wise access to the binary format raw data
+            *this = FileNodeIterator(fs->expandRawSeq(node), seekEnd);
+            return;
+        }
         else
         {
             nodeNElems = node.size();
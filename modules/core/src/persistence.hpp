@@ -44,6 +44,12 @@ enum
 #define CV_FS_MAX_LEN 4096
 #define CV_FS_MAX_FMT_PAIRS  128
 
+// FileNode tag flag of the binary format sequences, which elements are stored in mapped raw data block.
+// Such node keeps: number of elements, format string offset, offset and size of the data block.
+#define CV_FS_RAW_SEQ 64
+
+#define CV_FS_BINARY_SIGNATURE "%OCVBIN\n"
+
 /****************************************************************************************\
 *                            Common macros and type definitions                          *
 \****************************************************************************************/
@@ -97,6 +103,31 @@ int decodeFormat( const char* dt, int* fmt_pairs, int max_len );
 int decodeSimpleFormat( const char* dt );
 }
 
+/** Read-only view of a binary format file. Memory mapped (copy-on-write) when the platform supports it.
+Mats read from the binary format hold a reference to the view.
+*/
+class FileStorageMapping
+{
+public:
+    static Ptr<FileStorageMapping> create(const std::string& filename);
+    ~FileStorageMapping();
+
+    const uchar* data() const { return data_; }
+    size_t size() const { return size_; }
+
+    //! Mat header over the mapped data (no copy)
+    static Mat wrap(const Ptr<FileStorageMapping>& mapping, const uchar* data, int dims, const int* sizes, int type);
+private:
+    FileStorageMapping();
+
+    uchar* data_;
+    size_t size_;
+    bool mapped;
+#ifdef _WIN32
+    void* handle;
+#endif
+};
+
 
 #ifdef CV_STATIC_ANALYSIS
 #define CV_PARSE_ERROR_CPP(errmsg) do { (void)fs; abort(); } while (0)
@@ -138,6 +169,8 @@ public:
     virtual FileStorage* getFS() = 0;
 
     virtual void puts( const char* str ) = 0;
+    virtual void putBytes( const void* data, size_t len ) = 0;
+    virtual void patchBytes( size_t pos, const void* data, size_t len ) = 0;
     virtual char* gets() = 0;
     virtual bool eof() = 0;
     virtual void setEof() = 0;
@@ -158,6 +191,7 @@ public:
     virtual FileNode addNode( FileNode& collection, const std::string& key,
                                int type, const void* value=0, int len=-1 ) = 0;
     virtual void finalizeCollection( FileNode& collection ) = 0;
+    virtual void setRawSeq( FileNode& node, const std::string& dt, size_t nelems, size_t dataOfs, size_t dataSize ) = 0;
     virtual double strtod(char* ptr, char** endptr) = 0;
 
     virtual char* parseBase64(char* ptr, int indent, FileNode& collection) = 0;
@@ -198,6 +232,10 @@ public:
     virtual void writeScalar(const char* key, const char* value) = 0;
     virtual void writeComment(const char* comment, bool eol_comment) = 0;
     virtual void startNextStream() = 0;
+    virtual void writeRawData(const char* /*dt*/, const void* /*data*/, size_t /*len*/)
+    {
+        CV_Error(cv::Error::StsNotImplemented, "");
+    }
 };
 
 class FileStorageParser
@@ -211,10 +249,20 @@ public:
 Ptr<FileStorageEmitter> createXMLEmitter(FileStorage_API* fs);
 Ptr<FileStorageEmitter> createYAMLEmitter(FileStorage_API* fs);
 Ptr<FileStorageEmitter> createJSONEmitter(FileStorage_API* fs);
+Ptr<FileStorageEmitter> createBinaryEmitter(FileStorage_API* fs);
 
 Ptr<FileStorageParser> createXMLParser(FileStorage_API* fs);
 Ptr<FileStorageParser> createYAMLParser(FileStorage_API* fs);
 Ptr<FileStorageParser> createJSONParser(FileStorage_API* fs);
+Ptr<FileStorageParser> createBinaryParser(FileStorage_API* fs, const uchar* data, size_t size);
+
+namespace fs
+{
+//! adds elements of the binary format raw data block to the sequence
+void addRawDataNodes(FileStorage_API* fs, FileNode& collection, const char* dt, const uchar* data, size_t size);
+//! binary format: matrix referencing the mapped data of "data" node or empty Mat if the data can't be used as is
+Mat getMappedMat(const FileNode& node, int dims, const int* sizes, int type);
+}
 
 }
 
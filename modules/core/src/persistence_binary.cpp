@@ -0,0 +1,616 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html
+
+#include "precomp.hpp"
+#include "persistence.hpp"
+
+#if defined _WIN32
+#include <windows.h>
+#elif defined __unix__ || defined __APPLE__
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#define CV_FS_HAVE_MMAP 1
+#endif
+
+/*
+Binary format layout (integers are little-endian):
+
+  header:  "%OCVBIN\n" signature, uint32 version, uint32 reserved
+  records: uint8 tag, key (uint32 length + characters, empty for sequence elements), payload:
+    INT     int32
+    REAL    float64
+    STRING  uint32 length + characters
+    SEQ/MAP child records terminated by END record (tag only)
+    RAW     format string (as above), uint64 size in bytes, zero padding up to the next
+            BINARY_DATA_ALIGN boundary of the file offset, raw data in host byte order
+    NEXT_STREAM (tag only) starts the next top-level mapping
+*/
+
+namespace cv
+{
+
+enum
+{
+    BINARY_VERSION = 1,
+    BINARY_HEADER_SIZE = 16,
+    BINARY_DATA_ALIGN = 64,
+    BINARY_MAX_DEPTH = 1024
+};
+
+enum BinaryTag
+{
+    BINARY_TAG_INT = 1,
+    BINARY_TAG_REAL = 2,
+    BINARY_TAG_STRING = 3,
+    BINARY_TAG_SEQ = 4,
+    BINARY_TAG_MAP = 5,
+    BINARY_TAG_END = 6,
+    BINARY_TAG_RAW = 7,
+    BINARY_TAG_NEXT_STREAM = 8
+};
+
+static inline void storeU32(uchar* p, unsigned v)
+{
+    p[0] = (uchar)v; p[1] = (uchar)(v >> 8); p[2] = (uchar)(v >> 16); p[3] = (uchar)(v >> 24);
+}
+
+static inline void storeU64(uchar* p, uint64 v)
+{
+    storeU32(p, (unsigned)v);
+    storeU32(p + 4, (unsigned)(v >> 32));
+}
+
+static inline unsigned loadU32(const uchar* p)
+{
+    return (unsigned)p[0] | ((unsigned)p[1] << 8) | ((unsigned)p[2] << 16) | ((unsigned)p[3] << 24);
+}
+
+static inline uint64 loadU64(const uchar* p)
+{
+    return (uint64)loadU32(p) | ((uint64)loadU32(p + 4) << 32);
+}
+
+class BinaryEmitter : public FileStorageEmitter
+{
+public:
+    BinaryEmitter(FileStorage_API* _fs) : fs(_fs), pos(0), rawSizePos(0), rawSize(0)
+    {
+        uchar header[BINARY_HEADER_SIZE] = {0};
+        memcpy(header, CV_FS_BINARY_SIGNATURE, 8);
+        storeU32(header + 8, BINARY_VERSION);
+        put(header, sizeof(header));
+    }
+    virtual ~BinaryEmitter() {}
+
+    FStructData startWriteStruct( const FStructData&, const char* key,
+                                  int struct_flags, const char* /*type_name*/ )
+    {
+        struct_flags = (struct_flags & (FileNode::TYPE_MASK|FileNode::FLOW)) | FileNode::EMPTY;
+        if( !FileNode::isCollection(struct_flags))
+            CV_Error( cv::Error::StsBadArg,
+                     "Some collection type - FileNode::SEQ or FileNode::MAP, must be specified" );
+
+        writeHeader(FileNode::isMap(struct_flags) ? BINARY_TAG_MAP : BINARY_TAG_SEQ, key);
+        return FStructData("", struct_flags, 0);
+    }
+
+    void endWriteStruct(const FStructData&)
+    {
+        closeRawData();
+        putTag(BINARY_TAG_END);
+    }
+
+    void write(const char* key, int value)
+    {
+        uchar buf[4];
+        writeHeader(BINARY_TAG_INT, key);
+        storeU32(buf, (unsigned)value);
+        put(buf, sizeof(buf));
+    }
+
+    void write( const char* key, double value )
+    {
+        Cv64suf v;
+        uchar buf[8];
+        v.f = value;
+        writeHeader(BINARY_TAG_REAL, key);
+        storeU64(buf, v.u);
+        put(buf, sizeof(buf));
+    }
+
+    void write(const char* key, const char* str, bool /*quote*/)
+    {
+        if( !str )
+            CV_Error( cv::Error::StsNullPtr, "Null string pointer" );
+        writeHeader(BINARY_TAG_STRING, key);
+        putString(str);
+    }
+
+    void writeScalar(const char* key, const char* data)
+    {
+        write(key, data, false);
+    }
+
+    void writeComment(const char*, bool)
+    {
+        // comments are not stored
+    }
+
+    void startNextStream()
+    {
+        closeRawData();
+        putTag(BINARY_TAG_NEXT_STREAM);
+    }
+
+    void writeRawData(const char* dt, const void* data, size_t len)
+    {
+        CV_Assert(dt);
+        if( len == 0 )
+            return;
+        if( !data )
+            CV_Error( cv::Error::StsNullPtr, "Null data pointer" );
+
+        // consecutive blocks of the same format (e.g. matrix rows) are merged into a single record
+        if( rawSizePos == 0 || rawFormat != dt )
+        {
+            writeHeader(BINARY_TAG_RAW, 0);
+            putString(dt);
+            rawFormat = dt;
+            rawSizePos = pos;
+            rawSize = 0;
+            uchar buf[8 + BINARY_DATA_ALIGN] = {0};
+            size_t padding = alignSize(pos + 8, BINARY_DATA_ALIGN) - (pos + 8);
+            put(buf, 8 + padding);
+        }
+        put(data, len);
+        rawSize += len;
+    }
+
+protected:
+    void put(const void* data, size_t len)
+    {
+        fs->putBytes(data, len);
+        pos += len;
+    }
+
+    void putTag(int tag)
+    {
+        uchar c = (uchar)tag;
+        put(&c, 1);
+    }
+
+    void putString(const char* str)
+    {
+        uchar buf[4];
+        size_t len = strlen(str);
+        storeU32(buf, (unsigned)len);
+        put(buf, sizeof(buf));
+        put(str, len);
+    }
+
+    void closeRawData()
+    {
+        if( rawSizePos == 0 )
+            return;
+        uchar buf[8];
+        storeU64(buf, rawSize);
+        fs->patchBytes(rawSizePos, buf, sizeof(buf));
+        rawSizePos = 0;
+        rawFormat.clear();
+    }
+
+    void writeHeader(int tag, const char* key)
+    {
+        closeRawData();
+        if( key && *key == '\0' )
+            key = 0;
+        if( key && strlen(key) > CV_FS_MAX_LEN )
+            CV_Error( cv::Error::StsBadArg, "The key is too long" );
+        if( FileNode::isSeq(fs->getCurrentStruct().flags) == (key != 0) )
+            CV_Error( cv::Error::StsBadArg, "An attempt to add element without a key to a map, "
+                     "or add element with key to sequence" );
+        fs->setNonEmpty();
+        putTag(tag);
+        putString(key ? key : "");
+    }
+
+    FileStorage_API* fs;
+    size_t pos;
+    size_t rawSizePos; // position of the current raw data record size field, 0 if there is no such record
+    uint64 rawSize;
+    std::string rawFormat;
+};
+
+class BinaryParser : public FileStorageParser
+{
+public:
+    BinaryParser(FileStorage_API* _fs, const uchar* _data, size_t _size) :
+        fs(_fs), data(_data), size(_size), pos(0)
+    {
+    }
+    virtual ~BinaryParser() {}
+
+    bool getBase64Row(char*, int, char*&, char*&)
+    {
+        return false;
+    }
+
+    bool parse( char* )
+    {
+        if( size < BINARY_HEADER_SIZE || memcmp(data, CV_FS_BINARY_SIGNATURE, 8) != 0 )
+            CV_PARSE_ERROR_CPP( "Invalid binary file signature" );
+        if( loadU32(data + 8) != BINARY_VERSION )
+            CV_PARSE_ERROR_CPP( "Unsupported binary format version" );
+        pos = BINARY_HEADER_SIZE;
+
+        FileNode root_collection(fs->getFS(), 0, 0);
+        for(;;)
+        {
+            FileNode root_node = fs->addNode(root_collection, std::string(), FileNode::NONE);
+            fs->convertToCollection(FileNode::MAP, root_node);
+            bool next_stream = parseCollection(root_node, 0);
+            fs->finalizeCollection(root_node);
+            if( !next_stream )
+                break;
+        }
+        return true;
+    }
+
+protected:
+    void require(size_t n)
+    {
+        if( n > size - pos )
+            CV_PARSE_ERROR_CPP( "Unexpected end of file" );
+    }
+
+    unsigned readU32()
+    {
+        require(4);
+        unsigned v = loadU32(data + pos);
+        pos += 4;
+        return v;
+    }
+
+    uint64 readU64()
+    {
+        require(8);
+        uint64 v = loadU64(data + pos);
+        pos += 8;
+        return v;
+    }
+
+    std::string readString()
+    {
+        size_t len = readU32();
+        require(len);
+        std::string str((const char*)data + pos, len);
+        pos += len;
+        return str;
+    }
+
+    // reads RAW record after the tag
+    void readRawData(std::string& dt, size_t& dataOfs, size_t& dataSize)
+    {
+        if( !readString().empty() )
+            CV_PARSE_ERROR_CPP( "Raw data can't have a name" );
+        dt = readString();
+        uint64 sz = readU64();
+        size_t padding = alignSize(pos, BINARY_DATA_ALIGN) - pos;
+        require(padding);
+        pos += padding;
+        if( sz > (uint64)(size - pos) )
+            CV_PARSE_ERROR_CPP( "Unexpected end of file" );
+        dataOfs = pos;
+        dataSize = (size_t)sz;
+        size_t esz = (size_t)fs::calcStructSize(dt.c_str(), 0);
+        if( esz == 0 || dataSize % esz != 0 )
+            CV_PARSE_ERROR_CPP( "Invalid raw data size" );
+        pos += dataSize;
+    }
+
+    static size_t countElements(const std::string& dt, size_t dataSize)
+    {
+        int fmt_pairs[CV_FS_MAX_FMT_PAIRS*2];
+        int fmt_pair_count = fs::decodeFormat(dt.c_str(), fmt_pairs, CV_FS_MAX_FMT_PAIRS);
+        size_t cn = 0;
+        for( int k = 0; k < fmt_pair_count; k++ )
+            cn += fmt_pairs[k*2];
+        return dataSize / fs::calcStructSize(dt.c_str(), 0) * cn;
+    }
+
+    // sequence which consists of a single raw data record is kept as a reference to the data block
+    bool parseRawSeq(FileNode& node)
+    {
+        size_t pos0 = pos;
+        if( pos < size && data[pos] == BINARY_TAG_RAW )
+        {
+            pos++;
+            std::string dt;
+            size_t dataOfs = 0, dataSize = 0;
+            readRawData(dt, dataOfs, dataSize);
+            if( pos < size && data[pos] == BINARY_TAG_END )
+            {
+                pos++;
+                fs->setRawSeq(node, dt, countElements(dt, dataSize), dataOfs, dataSize);
+                return true;
+            }
+        }
+        pos = pos0;
+        return false;
+    }
+
+    // returns true if the next stream follows
+    bool parseCollection(FileNode& collection, int depth)
+    {
+        if( depth > BINARY_MAX_DEPTH )
+            CV_PARSE_ERROR_CPP( "Too many nested collections" );
+        bool is_map = collection.isMap();
+        while( pos < size )
+        {
+            int tag = data[pos++];
+            if( tag == BINARY_TAG_END || tag == BINARY_TAG_NEXT_STREAM )
+            {
+                if( (tag == BINARY_TAG_END) != (depth > 0) )
+                    CV_PARSE_ERROR_CPP( "Unexpected end of collection" );
+                return tag == BINARY_TAG_NEXT_STREAM;
+            }
+            if( tag == BINARY_TAG_RAW )
+            {
+                if( is_map )
+                    CV_PARSE_ERROR_CPP( "Raw data can be stored in sequences only" );
+                std::string dt;
+                size_t dataOfs = 0, dataSize = 0;
+                readRawData(dt, dataOfs, dataSize);
+                fs::addRawDataNodes(fs, collection, dt.c_str(), data + dataOfs, dataSize);
+                continue;
+            }
+
+            std::string key = readString();
+            if( is_map == key.empty() )
+                CV_PARSE_ERROR_CPP( is_map ? "Map element should have a name" :
+                                    "Sequence element should not have name" );
+            FileNode node = fs->addNode(collection, key, FileNode::NONE);
+            switch( tag )
+            {
+            case BINARY_TAG_INT:
+            {
+                int ival = (int)readU32();
+                node.setValue(FileNode::INT, &ival);
+                break;
+            }
+            case BINARY_TAG_REAL:
+            {
+                Cv64suf v;
+                v.u = readU64();
+                node.setValue(FileNode::REAL, &v.f);
+                break;
+            }
+            case BINARY_TAG_STRING:
+            {
+                std::string str = readString();
+                node.setValue(FileNode::STRING, str.c_str(), (int)str.size());
+                break;
+            }
+            case BINARY_TAG_SEQ:
+            case BINARY_TAG_MAP:
+                if( tag == BINARY_TAG_SEQ && parseRawSeq(node) )
+                    break;
+                fs->convertToCollection(tag == BINARY_TAG_SEQ ? FileNode::SEQ : FileNode::MAP, node);
+                parseCollection(node, depth + 1);
+                fs->finalizeCollection(node);
+                break;
+            default:
+                CV_PARSE_ERROR_CPP( "Unknown record type" );
+            }
+        }
+        if( depth > 0 )
+            CV_PARSE_ERROR_CPP( "Unexpected end of file" );
+        return false;
+    }
+
+    FileStorage_API* fs;
+    const uchar* data;
+    size_t size;
+    size_t pos;
+};
+
+Ptr<FileStorageEmitter> createBinaryEmitter(FileStorage_API* fs)
+{
+    return makePtr<BinaryEmitter>(fs);
+}
+
+Ptr<FileStorageParser> createBinaryParser(FileStorage_API* fs, const uchar* data, size_t size)
+{
+    return makePtr<BinaryParser>(fs, data, size);
+}
+
+void fs::addRawDataNodes(FileStorage_API* fs, FileNode& collection, const char* dt, const uchar* data, size_t size)
+{
+    int fmt_pairs[CV_FS_MAX_FMT_PAIRS*2];
+    int fmt_pair_count = fs::decodeFormat(dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS);
+    size_t esz = (size_t)fs::calcStructSize(dt, 0);
+    CV_Assert(esz > 0 && size % esz == 0);
+
+    for( const uchar* data0 = data; data0 < data + size; data0 += esz )
+    {
+        size_t offset = 0;
+        for( int k = 0; k < fmt_pair_count; k++ )
+        {
+            int count = fmt_pairs[k*2];
+            int elem_type = fmt_pairs[k*2+1];
+            int elem_size = CV_ELEM_SIZE(elem_type);
+
+            offset = alignSize(offset, elem_size);
+            const uchar* p = data0 + offset;
+            for( int i = 0; i < count; i++, p += elem_size )
+            {
+                int ival = 0;
+                double fval = 0;
+                switch( elem_type )
+                {
+                case CV_8U: ival = *p; break;
+                case CV_8S: ival = *(const schar*)p; break;
+                case CV_16U: ival = *(const ushort*)p; break;
+                case CV_16S: ival = *(const short*)p; break;
+                case CV_32S: ival = *(const int*)p; break;
+                case CV_32F: fval = *(const float*)p; break;
+                case CV_64F: fval = *(const double*)p; break;
+                case CV_16F: fval = (float)*(const hfloat*)p; break;
+                default:
+                    CV_Error( cv::Error::StsUnsupportedFormat, "Unsupported type" );
+                }
+                if( elem_type <= CV_32S )
+                    fs->addNode(collection, std::string(), FileNode::INT, &ival);
+                else
+                    fs->addNode(collection, std::string(), FileNode::REAL, &fval);
+            }
+            offset = (size_t)(p - data0);
+        }
+    }
+}
+
+/////////////////////////////////// file mapping ///////////////////////////////////
+
+FileStorageMapping::FileStorageMapping() : data_(0), size_(0), mapped(false)
+#ifdef _WIN32
+    , handle(0)
+#endif
+{
+}
+
+FileStorageMapping::~FileStorageMapping()
+{
+    if( mapped )
+    {
+#if defined _WIN32
+        UnmapViewOfFile(data_);
+        CloseHandle((HANDLE)handle);
+#elif defined CV_FS_HAVE_MMAP
+        munmap(data_, size_);
+#endif
+    }
+    else
+        fastFree(data_);
+}
+
+Ptr<FileStorageMapping> FileStorageMapping::create(const std::string& filename)
+{
+    Ptr<FileStorageMapping> m(new FileStorageMapping());
+#if defined _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if( file != INVALID_HANDLE_VALUE )
+    {
+        LARGE_INTEGER sz;
+        if( GetFileSizeEx(file, &sz) && sz.QuadPart > 0 )
+        {
+            HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+            if( mapping )
+            {
+                void* ptr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+                if( ptr )
+                {
+                    m->data_ = (uchar*)ptr;
+                    m->size_ = (size_t)sz.QuadPart;
+                    m->mapped = true;
+                    m->handle = mapping;
+                }
+                else
+                    CloseHandle(mapping);
+            }
+        }
+        CloseHandle(file);
+        if( m->mapped )
+            return m;
+    }
+#elif defined CV_FS_HAVE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if( fd >= 0 )
+    {
+        struct stat st;
+        if( fstat(fd, &st) == 0 && st.st_size > 0 )
+        {
+            // private writable mapping: matrices can be modified in-place without touching the file
+            void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if( ptr != MAP_FAILED )
+            {
+                m->data_ = (uchar*)ptr;
+                m->size_ = (size_t)st.st_size;
+                m->mapped = true;
+            }
+        }
+        ::close(fd);
+        if( m->mapped )
+            return m;
+    }
+#endif
+    // fallback: read the whole file into an aligned buffer
+    FILE* f = fopen(filename.c_str(), "rb");
+    if( !f )
+        return Ptr<FileStorageMapping>();
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if( sz > 0 )
+    {
+        m->data_ = (uchar*)fastMalloc((size_t)sz);
+        m->size_ = (size_t)sz;
+        if( fread(m->data_, 1, m->size_, f) != m->size_ )
+            m.release();
+    }
+    fclose(f);
+    return m;
+}
+
+/** Keeps the file mapping alive while there are matrices referencing it
+(similar to the allocators of external buffers, e.g. numpy arrays in Python bindings)
+*/
+class FileStorageMappingAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int dims, const int* sizes, int type, void* data, size_t* step,
+                       AccessFlag flags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(dims, sizes, type, data, step, flags, usageFlags);
+    }
+    bool allocate(UMatData* u, AccessFlag accessFlags, UMatUsageFlags usageFlags) const CV_OVERRIDE
+    {
+        return Mat::getStdAllocator()->allocate(u, accessFlags, usageFlags);
+    }
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if( !u )
+            return;
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        delete (Ptr<FileStorageMapping>*)u->userdata;
+        u->userdata = 0;
+        delete u;
+    }
+};
+
+static FileStorageMappingAllocator& getFileStorageMappingAllocator()
+{
+    CV_SINGLETON_LAZY_INIT_REF(FileStorageMappingAllocator, new FileStorageMappingAllocator())
+}
+
+Mat FileStorageMapping::wrap(const Ptr<FileStorageMapping>& mapping, const uchar* data, int dims, const int* sizes, int type)
+{
+    CV_Assert(mapping && mapping->data() <= data && data <= mapping->data() + mapping->size());
+    Mat m(dims, sizes, type, (void*)data);
+    CV_Assert(data + m.total()*m.elemSize() <= mapping->data() + mapping->size());
+    MatAllocator* allocator = &getFileStorageMappingAllocator();
+    UMatData* u = new UMatData(allocator);
+    u->data = u->origdata = (uchar*)data;
+    u->size = m.total()*m.elemSize();
+    u->userdata = new Ptr<FileStorageMapping>(mapping);
+    m.u = u;
+    m.addref();
+    m.allocator = allocator;
+    return m;
+}
+
+}
@@ -8,6 +8,7 @@
 #include "persistence.hpp"
 #include "persistence_base64_encoding.hpp"
 #include <unordered_map>
+#include <map>
 #include <iterator>
 
 
@@ -37,6 +38,10 @@ public:
 
     void puts( const char* str );
 
+    void putBytes( const void* data, size_t len );
+
+    void patchBytes( size_t pos, const void* data, size_t len );
+
     char* getsFromFile( char* buf, int count );
 
     char* gets( size_t maxCount );
@@ -124,11 +129,23 @@ public:
 
     unsigned getStringOfs( const std::string& key ) const;
 
+    unsigned addStringOfs( const std::string& key );
+
     FileNode addNode( FileNode& collection, const std::string& key,
                       int elem_type, const void* value, int len );
 
     void finalizeCollection( FileNode& collection );
 
+    void setRawSeq( FileNode& node, const std::string& dt, size_t nelems, size_t dataOfs, size_t dataSize );
+
+    // binary format raw sequences (see CV_FS_RAW_SEQ)
+    bool getRawSeqData( const FileNode& node, std::string& dt, const uchar*& data, size_t& size ) const;
+
+    bool readRawSeq( const FileNode& node, const std::string& fmt, void* vec, size_t len ) const;
+
+    // creates (once) a regular sequence with the elements of raw sequence for element-wise access
+    FileNode expandRawSeq( const FileNode& node );
+
     void normalizeNodeOfs(size_t& blockIdx, size_t& ofs) const;
 
     Base64State get_state_of_writing_base64();
@@ -237,6 +254,9 @@ public:
     str_hash_t str_hash;
     std::vector<char> str_hash_data;
 
+    Ptr<FileStorageMapping> mapping;
+    std::map<std::pair<size_t, size_t>, FileNode> expanded_raw_seqs;
+
     std::vector<char> strbufv;
     char* strbuf;
     size_t strbufsize;
@@ -129,27 +129,44 @@ void read(const FileNode& node, Mat& m, const Mat& default_mat)
 
     elem_type = fs::decodeSimpleFormat( dt.c_str() );
 
+    int sizes[CV_MAX_DIM] = {0}, dims;
     read(node["rows"], rows, -1);
     if( rows >= 0 )
     {
         read(node["cols"], cols, -1);
-        m.create(rows, cols, elem_type);
+        dims = 2;
+        sizes[0] = rows;
+        sizes[1] = cols;
     }
     else
     {
-        int sizes[CV_MAX_DIM] = {0}, dims;
         FileNode sizes_node = node["sizes"];
         CV_Assert( !sizes_node.empty() );
 
         dims = (int)sizes_node.size();
+        CV_Assert( 0 < dims && dims <= CV_MAX_DIM );
         sizes_node.readRaw("i", sizes, dims*sizeof(sizes[0]));
-
-        m.create(dims, sizes, elem_type);
     }
 
     FileNode data_node = node["data"];
     CV_Assert(!data_node.empty());
 
+    // binary storage: share the memory-mapped data unless the destination is already allocated
+    bool allocated = m.type() == elem_type && m.dims == dims && !m.empty();
+    for( int i = 0; allocated && i < dims; i++ )
+        allocated = m.size[i] == sizes[i];
+    if( !allocated )
+    {
+        Mat mapped = fs::getMappedMat(data_node, dims, sizes, elem_type);
+        if( !mapped.empty() )
+        {
+            m = mapped;
+            return;
+        }
+    }
+
+    m.create(dims, sizes, elem_type);
+
     size_t nelems = data_node.size();
     CV_Assert(nelems == m.total()*m.channels());
 
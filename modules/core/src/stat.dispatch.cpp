@@ -4,6 +4,7 @@
 
 #include "precomp.hpp"
 
+#include "stat.hpp"
 #include "stat.simd.hpp"
 #include "stat.simd_declarations.hpp" // defines CV_CPU_DISPATCH_MODES_ALL=AVX2,...,BASELINE based on CMakeLists.txt content
 
@@ -25,4 +26,12 @@ int normHamming(const uchar* a, const uchar* b, int n)
         CV_CPU_DISPATCH_MODES_ALL);
 }
 
+void normHammingBatch(const uchar* a, size_t astep, int na,
+                      const uchar* b, size_t bstep, int nb,
+                      int n, int* dist, size_t dstep)
+{
+    CV_CPU_DISPATCH(normHammingBatch, (a, astep, na, b, bstep, nb, n, dist, dstep),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
 }} //cv::hal
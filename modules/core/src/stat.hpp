@@ -38,6 +38,13 @@ template <typename T> Scalar ocl_part_sum(Mat m)
 typedef int (*SumFunc)(const uchar*, const uchar* mask, uchar*, int, int);
 SumFunc getSumFunc(int depth);
 
+namespace hal {
+//! computes na x nb matrix of Hamming distances between rows of a and b, dist is stored with dstep (in elements)
+void normHammingBatch(const uchar* a, size_t astep, int na,
+                      const uchar* b, size_t bstep, int nb,
+                      int n, int* dist, size_t dstep);
+}
+
 }
 
 #endif // SRC_STAT_HPP
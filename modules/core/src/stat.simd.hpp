@@ -13,6 +13,9 @@ CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
 // forward declarations
 int normHamming(const uchar* a, int n);
 int normHamming(const uchar* a, const uchar* b, int n);
+void normHammingBatch(const uchar* a, size_t astep, int na,
+                      const uchar* b, size_t bstep, int nb,
+                      int n, int* dist, size_t dstep);
 
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
@@ -115,6 +118,74 @@ int normHamming(const uchar* a, const uchar* b, int n)
     return result;
 }
 
+static inline int normHammingTail(const uchar* a, const uchar* b, int i, int n)
+{
+    int result = 0;
+#if CV_POPCNT
+#  if defined CV_POPCNT_U64
+    for(; i <= n - 8; i += 8)
+        result += (int)CV_POPCNT_U64(*(uint64*)(a + i) ^ *(uint64*)(b + i));
+#  endif
+    for(; i <= n - 4; i += 4)
+        result += CV_POPCNT_U32(*(uint*)(a + i) ^ *(uint*)(b + i));
+#endif
+    for(; i < n; i++)
+        result += popCountTable[a[i] ^ b[i]];
+    return result;
+}
+
+// Computes na x nb tile of Hamming distances between the rows of a and b.
+// Every chunk of the query row is loaded once and compared with 4 train rows at a time.
+void normHammingBatch(const uchar* a, size_t astep, int na,
+                      const uchar* b, size_t bstep, int nb,
+                      int n, int* dist, size_t dstep)
+{
+    CV_AVX_GUARD;
+
+    for (int i = 0; i < na; i++, a += astep, dist += dstep)
+    {
+        int j = 0;
+        const uchar* b0 = b;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int vlanes = VTraits<v_uint8>::vlanes();
+        for (; j <= nb - 4; j += 4, b0 += bstep*4)
+        {
+            const uchar* b1 = b0 + bstep;
+            const uchar* b2 = b1 + bstep;
+            const uchar* b3 = b2 + bstep;
+            v_uint64 s0 = vx_setzero_u64(), s1 = s0, s2 = s0, s3 = s0;
+            int k = 0;
+            for (; k <= n - vlanes; k += vlanes)
+            {
+                v_uint8 q = vx_load(a + k);
+                s0 = v_add(s0, v_popcount(v_reinterpret_as_u64(v_xor(q, vx_load(b0 + k)))));
+                s1 = v_add(s1, v_popcount(v_reinterpret_as_u64(v_xor(q, vx_load(b1 + k)))));
+                s2 = v_add(s2, v_popcount(v_reinterpret_as_u64(v_xor(q, vx_load(b2 + k)))));
+                s3 = v_add(s3, v_popcount(v_reinterpret_as_u64(v_xor(q, vx_load(b3 + k)))));
+            }
+            dist[j] = (int)v_reduce_sum(s0) + normHammingTail(a, b0, k, n);
+            dist[j+1] = (int)v_reduce_sum(s1) + normHammingTail(a, b1, k, n);
+            dist[j+2] = (int)v_reduce_sum(s2) + normHammingTail(a, b2, k, n);
+            dist[j+3] = (int)v_reduce_sum(s3) + normHammingTail(a, b3, k, n);
+        }
+#endif
+        for (; j < nb; j++, b0 += bstep)
+        {
+            int k = 0, result = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            v_uint64 s0 = vx_setzero_u64();
+            for (; k <= n - vlanes; k += vlanes)
+                s0 = v_add(s0, v_popcount(v_reinterpret_as_u64(v_xor(vx_load(a + k), vx_load(b0 + k)))));
+            result = (int)v_reduce_sum(s0);
+#endif
+            dist[j] = result + normHammingTail(a, b0, k, n);
+        }
+    }
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    vx_cleanup();
+#endif
+}
+
 #endif // CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
 CV_CPU_OPTIMIZATION_NAMESPACE_END
@@ -15,6 +15,7 @@
 #include <sstream>
 #include <ostream>
 #include <fstream>
+#include <map>
 
 #if 0
 #define CV_LOG(...) CV_LOG_INFO(NULL, __VA_ARGS__)
@@ -80,6 +81,20 @@ static const cv::String& getParameterTraceLocation()
     return param_traceLocation;
 }
 
+// "txt" (default): text files; "chrome": Chrome Trace Event JSON (chrome://tracing, Perfetto UI)
+static bool getParameterTraceFormatChrome()
+{
+    static cv::String param_traceFormat = utils::getConfigurationParameterString("OPENCV_TRACE_FORMAT", "txt");
+    return param_traceFormat == "chrome" || param_traceFormat == "json";
+}
+
+// ring buffer capacity (records per thread) for the "chrome" format
+static size_t getParameterTraceBufferSize()
+{
+    static size_t param_traceBufferSize = utils::getConfigurationParameterSizeT("OPENCV_TRACE_BUFFER_SIZE", 1 << 16);
+    return param_traceBufferSize;
+}
+
 #ifdef HAVE_OPENCL
 static bool param_synchronizeOpenCL = utils::getConfigurationParameterBool("OPENCV_TRACE_SYNC_OPENCL", false);
 #endif
@@ -374,6 +389,16 @@ void Region::Impl::leaveRegion(TraceManagerThreadLocal& ctx)
         msg.formatRegionLeave(region, result);
         s->put(msg);
     }
+    TraceEventBuffer* events = ctx.getEventBuffer();
+    if (events)
+    {
+        TraceEvent& e = events->next();
+        e.type = TraceEvent::EVENT_COMPLETE;
+        e.regionID = global_region_id;
+        e.timestamp = beginTimestamp;
+        e.ptr = &location;
+        e.value.i = endTimestamp;
+    }
 
     if (location.flags & REGION_FLAG_FUNCTION)
     {
@@ -828,12 +853,153 @@ TraceStorage* TraceManagerThreadLocal::getStorage() const
     return storage.get();
 }
 
+TraceEventBuffer* TraceManagerThreadLocal::getEventBuffer() const
+{
+    if (eventBuffer.empty() && getTraceManager().trace_events)
+        eventBuffer.reset(new TraceEventBuffer(getParameterTraceBufferSize()));
+    return eventBuffer.get();
+}
+
+static void writeJSONString(std::ostream& out, const char* str)
+{
+    out << '"';
+    for (const char* p = str; *p; p++)
+    {
+        const char c = *p;
+        if (c == '"' || c == '\\')
+            out << '\\' << c;
+        else if ((unsigned char)c < 0x20)
+            out << cv::format("\\u%04x", (int)(unsigned char)c);
+        else
+            out << c;
+    }
+    out << '"';
+}
+
+static void writeJSONTimestamp(std::ostream& out, int64 timestampNS)
+{
+    out << cv::format("%lld.%03d", (long long)(timestampNS / 1000), (int)(timestampNS % 1000));
+}
+
+static const char* getLocationCategory(const Region::LocationStaticStorage& location)
+{
+    switch (location.flags & REGION_FLAG_IMPL_MASK)
+    {
+    case REGION_FLAG_IMPL_IPP: return "opencv,ipp";
+    case REGION_FLAG_IMPL_OPENCL: return "opencv,opencl";
+    case REGION_FLAG_IMPL_OPENVX: return "opencv,openvx";
+    default: break;
+    }
+    return (location.flags & REGION_FLAG_APP_CODE) ? "app" : "opencv";
+}
+
+static void writeEventArg(std::ostream& out, const TraceEvent& e)
+{
+    writeJSONString(out, (const char*)e.ptr);
+    out << ':';
+    switch (e.type)
+    {
+    case TraceEvent::EVENT_ARG_INT: out << e.value.i; break;
+    case TraceEvent::EVENT_ARG_DOUBLE:
+        if (cvIsNaN(e.value.d) || cvIsInf(e.value.d))
+            writeJSONString(out, cv::format("%g", e.value.d).c_str());
+        else
+            out << cv::format("%.17g", e.value.d);
+        break;
+    case TraceEvent::EVENT_ARG_STRING: writeJSONString(out, e.value.s); break;
+    default: CV_Error(Error::StsInternal, "");
+    }
+}
+
+/** Writes collected per-thread records in Chrome Trace Event format:
+https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+Regions are "complete" (ph=X) events, parallel_for_ bodies are linked to the root region by flow events.
+*/
+static void writeChromeTrace(const std::string& filename, const std::vector<TraceManagerThreadLocal*>& threads_ctx)
+{
+    std::ofstream out(filename.c_str(), std::ios::trunc);
+    if (!out.is_open())
+    {
+        CV_LOG_ERROR(NULL, "Trace: can't open file: " << filename);
+        return;
+    }
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" << std::endl;
+    out << "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\",\"args\":{\"name\":\"OpenCV\"}}";
+    int flowID = 0;
+    uint64 lostEvents = 0;
+    std::map<int, std::vector<const TraceEvent*> > args;  // regionID => pending args
+    for (size_t t = 0; t < threads_ctx.size(); t++)
+    {
+        const TraceManagerThreadLocal* ctx = threads_ctx[t];
+        if (!ctx || ctx->eventBuffer.empty())
+            continue;
+        const TraceEventBuffer& events = *ctx->eventBuffer;
+        const int tid = ctx->threadID;
+        lostEvents += events.totalWritten() - events.size();
+        out << ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"name\":\"thread_name\",\"args\":{\"name\":\""
+            << cv::format("OpenCVThread-%03d", tid) << "\"}}";
+        args.clear();
+        for (size_t i = 0; i < events.size(); i++)
+        {
+            const TraceEvent& e = events.at(i);
+            switch (e.type)
+            {
+            case TraceEvent::EVENT_COMPLETE:
+            {
+                const Region::LocationStaticStorage& location = *(const Region::LocationStaticStorage*)e.ptr;
+                out << ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+                writeJSONTimestamp(out, e.timestamp);
+                out << ",\"dur\":";
+                writeJSONTimestamp(out, e.value.i - e.timestamp);
+                out << ",\"name\":";
+                writeJSONString(out, location.name ? location.name : "<unknown>");
+                out << ",\"cat\":\"" << getLocationCategory(location) << "\"";
+                std::map<int, std::vector<const TraceEvent*> >::iterator it = args.find(e.regionID);
+                if (it != args.end())
+                {
+                    out << ",\"args\":{";
+                    for (size_t j = 0; j < it->second.size(); j++)
+                    {
+                        if (j > 0)
+                            out << ',';
+                        writeEventArg(out, *it->second[j]);
+                    }
+                    out << '}';
+                    args.erase(it);
+                }
+                out << '}';
+                break;
+            }
+            case TraceEvent::EVENT_FLOW:
+                ++flowID;
+                out << ",\n{\"ph\":\"s\",\"pid\":1,\"tid\":" << e.value.root.threadID << ",\"ts\":";
+                writeJSONTimestamp(out, e.value.root.beginTimestamp);
+                out << ",\"id\":" << flowID << ",\"name\":\"parallel_for\",\"cat\":\"parallel_for\"}";
+                out << ",\n{\"ph\":\"f\",\"bp\":\"e\",\"pid\":1,\"tid\":" << tid << ",\"ts\":";
+                writeJSONTimestamp(out, e.timestamp);
+                out << ",\"id\":" << flowID << ",\"name\":\"parallel_for\",\"cat\":\"parallel_for\"}";
+                break;
+            default:
+                args[e.regionID].push_back(&e);
+                break;
+            }
+        }
+    }
+    out << "\n]}" << std::endl;
+    if (lostEvents)
+    {
+        CV_LOG_WARNING(NULL, "Trace: " << lostEvents << " oldest events are overwritten. "
+                             "Increase OPENCV_TRACE_BUFFER_SIZE to capture longer traces");
+    }
+}
+
 
 
 static bool activated = false;
 static bool isInitialized = false;
 
-TraceManager::TraceManager()
+TraceManager::TraceManager() :
+    trace_events(false)
 {
     (void)cv::getTimestampNS();
 
@@ -844,7 +1010,12 @@ TraceManager::TraceManager()
     activated = getParameterTraceEnable();
 
     if (activated)
-        trace_storage.reset(new SyncTraceStorage(std::string(getParameterTraceLocation()) + ".txt"));
+    {
+        if (getParameterTraceFormatChrome())
+            trace_events = true;
+        else
+            trace_storage.reset(new SyncTraceStorage(std::string(getParameterTraceLocation()) + ".txt"));
+    }
 
 #ifdef OPENCV_WITH_ITT
     if (isITTEnabled())
@@ -885,6 +1056,10 @@ TraceManager::~TraceManager()
     {
         CV_LOG_WARNING(NULL, "Trace: Total skipped events: " << totalSkippedEvents);
     }
+    if (trace_events)
+    {
+        writeChromeTrace(std::string(getParameterTraceLocation()) + ".json", threads_ctx);
+    }
 
     // This is a global static object, so process starts shutdown here
     // Turn off trace
@@ -964,6 +1139,19 @@ void parallelForAttachNestedRegion(const Region& rootRegion)
     if (!region)
         return;
 
+    TraceEventBuffer* events = ctx.getEventBuffer();
+    if (events && region->pImpl && rootRegion.pImpl)
+    {
+        TraceEvent& e = events->next();
+        e.type = TraceEvent::EVENT_FLOW;
+        e.regionID = region->pImpl->global_region_id;
+        e.timestamp = region->pImpl->beginTimestamp;
+        e.ptr = NULL;
+        e.value.root.threadID = rootRegion.pImpl->threadID;
+        e.value.root.regionID = rootRegion.pImpl->global_region_id;
+        e.value.root.beginTimestamp = rootRegion.pImpl->beginTimestamp;
+    }
+
 #ifdef OPENCV_WITH_ITT
     if (!rootRegion.pImpl || !rootRegion.pImpl->itt_id_registered)
         return;
@@ -1061,6 +1249,18 @@ static void initTraceArg(TraceManagerThreadLocal& ctx, const TraceArg& arg)
         }
     }
 }
+static inline TraceEvent* recordTraceArg(TraceManagerThreadLocal& ctx, const Region& region, const TraceArg& arg, TraceEvent::Type type)
+{
+    TraceEventBuffer* events = ctx.getEventBuffer();
+    if (!events)
+        return NULL;
+    TraceEvent& e = events->next();
+    e.type = type;
+    e.regionID = region.pImpl->global_region_id;
+    e.timestamp = 0;
+    e.ptr = arg.name;
+    return &e;
+}
 void traceArg(const TraceArg& arg, const char* value)
 {
     TraceManagerThreadLocal& ctx = getTraceManager().tls.getRef();
@@ -1071,6 +1271,11 @@ void traceArg(const TraceArg& arg, const char* value)
     initTraceArg(ctx, arg);
     if (!value)
         value = "<null>";
+    if (TraceEvent* e = recordTraceArg(ctx, *region, arg, TraceEvent::EVENT_ARG_STRING))
+    {
+        strncpy(e->value.s, value, sizeof(e->value.s) - 1);
+        e->value.s[sizeof(e->value.s) - 1] = 0;
+    }
 #ifdef OPENCV_WITH_ITT
     if (isITTEnabled())
     {
@@ -1086,13 +1291,13 @@ void traceArg(const TraceArg& arg, int value)
         return;
     CV_Assert(region->pImpl);
     initTraceArg(ctx, arg);
+    if (TraceEvent* e = recordTraceArg(ctx, *region, arg, TraceEvent::EVENT_ARG_INT))
+        e->value.i = value;
 #ifdef OPENCV_WITH_ITT
     if (isITTEnabled())
     {
         __itt_metadata_add(domain, region->pImpl->itt_id, (*arg.ppExtra)->ittHandle_name, sizeof(int) == 4 ? __itt_metadata_s32 : __itt_metadata_s64, 1, &value);
     }
-#else
-    CV_UNUSED(value);
 #endif
 }
 void traceArg(const TraceArg& arg, int64 value)
@@ -1103,13 +1308,13 @@ void traceArg(const TraceArg& arg, int64 value)
         return;
     CV_Assert(region->pImpl);
     initTraceArg(ctx, arg);
+    if (TraceEvent* e = recordTraceArg(ctx, *region, arg, TraceEvent::EVENT_ARG_INT))
+        e->value.i = value;
 #ifdef OPENCV_WITH_ITT
     if (isITTEnabled())
     {
         __itt_metadata_add(domain, region->pImpl->itt_id, (*arg.ppExtra)->ittHandle_name, __itt_metadata_s64, 1, &value);
     }
-#else
-    CV_UNUSED(value);
 #endif
 }
 void traceArg(const TraceArg& arg, double value)
@@ -1120,13 +1325,13 @@ void traceArg(const TraceArg& arg, double value)
         return;
     CV_Assert(region->pImpl);
     initTraceArg(ctx, arg);
+    if (TraceEvent* e = recordTraceArg(ctx, *region, arg, TraceEvent::EVENT_ARG_DOUBLE))
+        e->value.d = value;
 #ifdef OPENCV_WITH_ITT
     if (isITTEnabled())
     {
         __itt_metadata_add(domain, region->pImpl->itt_id, (*arg.ppExtra)->ittHandle_name, __itt_metadata_double, 1, &value);
     }
-#else
-    CV_UNUSED(value);
 #endif
 }
 
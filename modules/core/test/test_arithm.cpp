@@ -2519,6 +2519,46 @@ TEST(Core_Norm, NORM_L2_8UC4)
     EXPECT_EQ(kNorm, cv::norm(a, b, NORM_L2));
 }
 
+TEST(Core_BatchDistance, hamming_blocked)
+{
+    // odd descriptor length and row counts to cover tails of all blocks
+    const int len = 37, nquery = 21, ntrain = 1237, K = 5;
+    RNG& rng = theRNG();
+    Mat query(nquery, len, CV_8UC1), train(ntrain, len, CV_8UC1), mask(nquery, ntrain, CV_8UC1);
+    rng.fill(query, RNG::UNIFORM, 0, 256);
+    rng.fill(train, RNG::UNIFORM, 0, 256);
+    rng.fill(mask, RNG::UNIFORM, 0, 2);
+
+    Mat dist;
+    batchDistance(query, train, dist, CV_32S, noArray(), NORM_HAMMING, 0, mask);
+    ASSERT_EQ(Size(ntrain, nquery), dist.size());
+    for (int i = 0; i < nquery; i++)
+        for (int j = 0; j < ntrain; j++)
+        {
+            int expected = mask.at<uchar>(i, j) ? (int)cv::norm(query.row(i), train.row(j), NORM_HAMMING) : INT_MAX;
+            ASSERT_EQ(expected, dist.at<int>(i, j)) << "i=" << i << " j=" << j;
+        }
+
+    Mat kdist, kidx;
+    batchDistance(query, train, kdist, CV_32S, kidx, NORM_HAMMING, K, mask);
+    ASSERT_EQ(Size(K, nquery), kdist.size());
+    for (int i = 0; i < nquery; i++)
+    {
+        // reference: stable sort of the full distance row
+        std::vector<std::pair<int, int> > row;
+        for (int j = 0; j < ntrain; j++)
+            if (mask.at<uchar>(i, j))
+                row.push_back(std::make_pair(dist.at<int>(i, j), j));
+        std::stable_sort(row.begin(), row.end(),
+                         [](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
+        for (int k = 0; k < K; k++)
+        {
+            EXPECT_EQ(row[k].first, kdist.at<int>(i, k)) << "i=" << i << " k=" << k;
+            EXPECT_EQ(row[k].second, kidx.at<int>(i, k)) << "i=" << i << " k=" << k;
+        }
+    }
+}
+
 TEST(Core_ConvertTo, regression_12121)
 {
     {
@@ -1599,6 +1599,13 @@ TEST(Core_InputOutput, FileStorage_format_yml_gz)
     EXPECT_EQ(FileStorage::FORMAT_YAML, fs.getFormat());
 }
 
+TEST(Core_InputOutput, FileStorage_format_cvbin)
+{
+    FileStorage fs;
+    fs.open("opencv_storage.cvbin", FileStorage::WRITE | FileStorage::MEMORY);
+    EXPECT_EQ(FileStorage::FORMAT_BINARY, fs.getFormat());
+}
+
 TEST(Core_InputOutput, FileStorage_json_named_nodes)
 {
     std::string test =
@@ -1682,7 +1689,7 @@ TEST(Core_InputOutput, FileStorage_free_file_after_exception)
 
 TEST(Core_InputOutput, FileStorage_write_to_sequence)
 {
-    const std::vector<std::string> formatExts = { ".yml", ".json", ".xml" };
+    const std::vector<std::string> formatExts = { ".yml", ".json", ".xml", ".cvbin" };
     for (const auto& ext : formatExts)
     {
         const std::string name = tempfile(ext.c_str());
@@ -1966,5 +1973,109 @@ TEST(Core_InputOutput, FileStorage_invalid_path_regression_21448_JSON)
     fs.release();
 }
 
+TEST(Core_InputOutput, FileStorage_binary_roundtrip)
+{
+    const std::string name = cv::tempfile(".cvbin");
+    RNG& rng = theRNG();
+
+    Mat m8u(17, 23, CV_8UC3), m16s(5, 7, CV_16SC2), m64f(9, 4, CV_64FC1);
+    rng.fill(m8u, RNG::UNIFORM, 0, 256);
+    rng.fill(m16s, RNG::UNIFORM, -30000, 30000);
+    rng.fill(m64f, RNG::UNIFORM, -1e10, 1e10);
+    Mat big(64, 80, CV_32FC1);
+    rng.fill(big, RNG::UNIFORM, -1, 1);
+    Mat roi = big(Rect(3, 5, 31, 17));
+    int sz[] = { 4, 3, 5 };
+    Mat nd(3, sz, CV_32SC2);
+    rng.fill(nd, RNG::UNIFORM, -100000, 100000);
+    SparseMat sm(3, sz, CV_32F);
+    sm.ref<float>(1, 2, 3) = 5.f;
+    sm.ref<float>(3, 0, 4) = -1.5f;
+    std::vector<float> vf = { 1.f, -2.5f, 3.25f };
+    std::vector<Point2i> pts = { Point2i(1, 2), Point2i(-3, 4) };
+
+    {
+        FileStorage fs(name, FileStorage::WRITE);
+        ASSERT_EQ(FileStorage::FORMAT_BINARY, fs.getFormat());
+        fs << "i" << 42 << "r" << 0.125 << "s" << "text \"with\" quotes";
+        fs << "nested" << "{" << "seq" << "[" << 1 << "two" << 3.5 << "]" << "empty" << "[" << "]" << "}";
+        fs.writeComment("comments are ignored");
+        fs << "m8u" << m8u << "m16s" << m16s << "m64f" << m64f << "roi" << roi;
+        fs << "nd" << nd << "sm" << sm << "vf" << vf << "pts" << pts;
+    }
+
+    FileStorage fs(name, FileStorage::READ);
+    ASSERT_TRUE(fs.isOpened());
+    EXPECT_EQ(FileStorage::FORMAT_BINARY, fs.getFormat());
+    EXPECT_EQ(42, (int)fs["i"]);
+    EXPECT_EQ(0.125, (double)fs["r"]);
+    EXPECT_EQ("text \"with\" quotes", (std::string)fs["s"]);
+    FileNode seq = fs["nested"]["seq"];
+    ASSERT_EQ(3u, seq.size());
+    EXPECT_EQ(1, (int)seq[0]);
+    EXPECT_EQ("two", (std::string)seq[1]);
+    EXPECT_EQ(3.5, (double)seq[2]);
+    EXPECT_TRUE(fs["nested"]["empty"].isSeq());
+    EXPECT_EQ(0u, fs["nested"]["empty"].size());
+
+    Mat r8u, r16s, r64f, rroi, rnd;
+    SparseMat rsm;
+    std::vector<float> rvf;
+    std::vector<Point2i> rpts;
+    fs["m8u"] >> r8u;
+    fs["m16s"] >> r16s;
+    fs["m64f"] >> r64f;
+    fs["roi"] >> rroi;
+    fs["nd"] >> rnd;
+    fs["sm"] >> rsm;
+    fs["vf"] >> rvf;
+    fs["pts"] >> rpts;
+    EXPECT_EQ(0, cvtest::norm(m8u, r8u, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(m16s, r16s, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(m64f, r64f, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(roi, rroi, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(nd, rnd, NORM_INF));
+    EXPECT_EQ(2u, rsm.nzcount());
+    EXPECT_EQ(5.f, rsm.value<float>(1, 2, 3));
+    EXPECT_EQ(-1.5f, rsm.value<float>(3, 0, 4));
+    EXPECT_EQ(vf, rvf);
+    EXPECT_EQ(pts, rpts);
+
+    // element-wise access and conversion of the raw data
+    FileNode data = fs["m16s"]["data"];
+    ASSERT_EQ(m16s.total() * 2, data.size());
+    EXPECT_EQ((int)m16s.at<Vec2s>(0, 1)[1], (int)data[3]);
+    std::vector<int> ivals;
+    for (FileNodeIterator it = data.begin(); it != data.end(); ++it)
+        ivals.push_back((int)*it);
+    ASSERT_EQ(data.size(), ivals.size());
+    EXPECT_EQ((int)m16s.at<Vec2s>(4, 6)[0], ivals[ivals.size() - 2]);
+    Mat converted(m64f.size(), CV_32F);
+    fs["m64f"]["data"].readRaw("f", converted.ptr(), converted.total() * sizeof(float));
+    Mat expected;
+    m64f.convertTo(expected, CV_32F);
+    EXPECT_EQ(0, cvtest::norm(expected, converted, NORM_INF));
+
+    // mapped matrices stay valid after the storage is released and are not shared with the file
+    fs.release();
+    EXPECT_EQ(0, cvtest::norm(m64f, r64f, NORM_INF));
+    r8u.setTo(Scalar::all(7));
+    FileStorage fs2(name, FileStorage::READ);
+    Mat r8u2;
+    fs2["m8u"] >> r8u2;
+    EXPECT_EQ(0, cvtest::norm(m8u, r8u2, NORM_INF));
+    fs2.release();
+
+    EXPECT_EQ(0, remove(name.c_str()));
+}
+
+TEST(Core_InputOutput, FileStorage_binary_memory_write)
+{
+    FileStorage fs("test.cvbin", FileStorage::WRITE | FileStorage::MEMORY);
+    fs << "a" << 1;
+    std::string buf = fs.releaseAndGetString();
+    EXPECT_EQ(0u, buf.find("%OCVBIN"));
+    EXPECT_ANY_THROW(FileStorage(buf, FileStorage::READ | FileStorage::MEMORY));
+}
 
 }} // namespace
@@ -2789,6 +2789,33 @@ TEST(Core_SVD, flt)
 }
 
 
+TEST(Core_GEMM, packed_flags)
+{
+    // sizes are chosen to produce partial micro-tiles and several k-blocks
+    const int M = 131, N = 97, K = 517;
+    RNG& rng = theRNG();
+    for (int depth = CV_32F; depth <= CV_64F; depth++)
+    {
+        for (int flags = 0; flags < 8; flags++)
+        {
+            SCOPED_TRACE(cv::format("depth=%d flags=%d", depth, flags));
+            Mat A0((flags & GEMM_1_T) ? K : M, ((flags & GEMM_1_T) ? M : K) + 3, depth);
+            Mat B0((flags & GEMM_2_T) ? N : K, ((flags & GEMM_2_T) ? K : N) + 5, depth);
+            Mat C0((flags & GEMM_3_T) ? N : M, (flags & GEMM_3_T) ? M : N, depth);
+            rng.fill(A0, RNG::UNIFORM, -1, 1);
+            rng.fill(B0, RNG::UNIFORM, -1, 1);
+            rng.fill(C0, RNG::UNIFORM, -1, 1);
+            // non-continuous inputs
+            Mat A = A0.colRange(0, A0.cols - 3), B = B0.colRange(0, B0.cols - 5);
+
+            Mat D, D_ref;
+            cv::gemm(A, B, 0.5, C0, -2, D, flags);
+            cvtest::gemm(A, B, 0.5, C0, -2, D_ref, flags);
+            EXPECT_LE(cvtest::norm(D, D_ref, NORM_L2 | NORM_RELATIVE), depth == CV_32F ? 1e-5 : 1e-12);
+        }
+    }
+}
+
 // TODO: eigenvv, invsqrt, cbrt, fastarctan, (round, floor, ceil(?)),
 
 enum
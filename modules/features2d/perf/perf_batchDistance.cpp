@@ -129,6 +129,33 @@ PERF_TEST_P(Norm_CrossCheck, batchDistance_32F,
     if (isCrossCheck) SANITY_CHECK(ndix);
 }
 
+typedef tuple<int, int> DescSize_TrainCount_t;
+typedef perf::TestBaseWithParam<DescSize_TrainCount_t> DescSize_TrainCount;
+
+PERF_TEST_P(DescSize_TrainCount, batchDistance_Hamming_knn,
+            testing::Combine(testing::Values(32, 64),
+                             testing::Values(10000, 100000)
+                             )
+            )
+{
+    const int len = get<0>(GetParam());
+    const int trainCount = get<1>(GetParam());
+    const int knn = 2;
+
+    Mat queryDescriptors(500, len, CV_8U);
+    Mat trainDescriptors(trainCount, len, CV_8U);
+    Mat dist, ndix;
+    declare.in(queryDescriptors, trainDescriptors, WARMUP_RNG);
+
+    TEST_CYCLE()
+    {
+        batchDistance(queryDescriptors, trainDescriptors, dist, CV_32S, ndix,
+                      NORM_HAMMING, knn, Mat(), 0, false);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 void generateData( Mat& query, Mat& train, const int sourceType )
 {
     const int dim = 500;
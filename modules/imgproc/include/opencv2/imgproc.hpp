@@ -1516,8 +1516,9 @@ In-place operation is supported.
 
 @note The median filter uses #BORDER_REPLICATE internally to cope with border pixels, see #BorderTypes
 
-@param src input 1-, 3-, or 4-channel image; when ksize is 3 or 5, the image depth should be
-CV_8U, CV_16U, or CV_32F, for larger aperture sizes, it can only be CV_8U.
+@param src input 1-, 3-, or 4-channel image; the image depth should be CV_8U, CV_16U, CV_16S or
+CV_32F. For aperture sizes larger than 5, 16-bit and floating-point images are processed with a
+sliding histogram whose cost grows linearly with ksize, and ksize must not exceed 255.
 @param dst destination array of the same size and type as src.
 @param ksize aperture linear size; it must be odd and greater than 1, for example: 3, 5, 7 ...
 @sa  bilateralFilter, blur, boxFilter, GaussianBlur
@@ -1548,6 +1549,31 @@ CV_EXPORTS_W void GaussianBlur( InputArray src, OutputArray dst, Size ksize,
                                 double sigmaX, double sigmaY = 0,
                                 int borderType = BORDER_DEFAULT );
 
+/** @brief Blurs an image using a recursive approximation of the Gaussian filter.
+
+The function implements the 3rd order recursive filter of Young and van Vliet, so its cost per
+pixel does not depend on sigma, unlike #GaussianBlur whose kernel grows linearly with it. The result
+approximates #GaussianBlur with the full kernel (ksize = 2*ceil(4*sigma) + 1): for sigma >= 5 the
+8-bit outputs differ by at most 2-3 levels and the response to a step edge deviates by less than 2.5%
+of the step height. The error grows for smaller sigma (up to ~2% of the step height on a single edge
+at sigma = 2), where #GaussianBlur is not slower anyway.
+Use #GaussianBlur when the exact result is required.
+
+@param src input image; the image can have any number of channels, which are processed
+independently, but the depth should be CV_8U, CV_16U, CV_16S or CV_32F.
+@param dst output image of the same size and type as src.
+@param sigmaX Gaussian kernel standard deviation in X direction; it must be at least 0.5.
+@param sigmaY Gaussian kernel standard deviation in Y direction; if sigmaY is zero, it is set to be
+equal to sigmaX.
+@param borderType pixel extrapolation method, one of #BORDER_CONSTANT, #BORDER_REPLICATE,
+#BORDER_REFLECT and #BORDER_REFLECT_101, optionally combined with #BORDER_ISOLATED.
+
+@sa  GaussianBlur, stackBlur
+ */
+CV_EXPORTS_W void recursiveGaussianBlur( InputArray src, OutputArray dst,
+                                         double sigmaX, double sigmaY = 0,
+                                         int borderType = BORDER_DEFAULT );
+
 /** @brief Applies the bilateral filter to an image.
 
 The function applies bilateral filtering to the input image, as described in
@@ -1580,6 +1606,27 @@ CV_EXPORTS_W void bilateralFilter( InputArray src, OutputArray dst, int d,
                                    double sigmaColor, double sigmaSpace,
                                    int borderType = BORDER_DEFAULT );
 
+/** @brief Applies a fast approximation of the bilateral filter using a bilateral grid.
+
+The image is splatted into a coarse 3D grid sampled every sigmaSpace pixels in x and y and every
+sigmaColor in value, the grid is blurred and then sliced back with trilinear interpolation. The
+processing time does not depend on the spatial extent of the filter, so the function is intended
+for large sigmaSpace values where bilateralFilter becomes slow. On natural images the result
+usually stays within a few gray levels of bilateralFilter with `d = 0`.
+
+For 3-channel images the color distance is measured on the sum of the channels, i.e. pixels of
+different colors with the same channel sum are averaged together. Pixels outside of the image are
+not used, so no border extrapolation is performed.
+
+@param src Source 8-bit or floating-point, 1-channel or 3-channel image.
+@param dst Destination image of the same size and type as src.
+@param sigmaColor Filter sigma in the color space (for 3-channel images, of the channel sum).
+@param sigmaSpace Filter sigma in the coordinate space, in pixels.
+@sa bilateralFilter
+ */
+CV_EXPORTS_W void bilateralGridFilter( InputArray src, OutputArray dst,
+                                       double sigmaColor, double sigmaSpace );
+
 /** @brief Blurs an image using the box filter.
 
 The function smooths an image using the kernel:
@@ -1860,6 +1907,72 @@ CV_EXPORTS_W void Laplacian( InputArray src, OutputArray dst, int ddepth,
                              int ksize = 1, double scale = 1, double delta = 0,
                              int borderType = BORDER_DEFAULT );
 
+/** @brief Sequence of filters applied in one pass over the image.
+
+A typical pre-filtering chain such as Gaussian blur, Sobel derivatives, gradient magnitude and threshold
+writes every intermediate image to memory when it is done with separate calls. The chain instead
+processes the image by bands of rows: each stage keeps only the few rows its aperture needs in a ring
+buffer and passes its output rows to the next stage right away. The bands are processed in parallel,
+the rows shared by the apertures of neighbouring bands are computed by both of them.
+
+The result is the same as calling the corresponding functions one after another on whole images with
+the border type of the chain. The only exception is the Gaussian stage on 8-bit and 16-bit images: it is
+computed like #sepFilter2D with Gaussian kernels and may differ by 1 from the bit-exact #GaussianBlur.
+
+The stages are removed with Algorithm::clear.
+
+@sa createFilterChain
+ */
+class CV_EXPORTS_W FilterChain : public Algorithm
+{
+public:
+    /** @brief Adds Gaussian smoothing, see #GaussianBlur. The output type is the input type. */
+    CV_WRAP virtual void addGaussianBlur(Size ksize, double sigmaX, double sigmaY = 0) = 0;
+
+    /** @brief Adds a separable linear filter, see #sepFilter2D.
+
+    @param ddepth Output depth, -1 to keep the input depth.
+    @param kernelX Coefficients for filtering each row.
+    @param kernelY Coefficients for filtering each column.
+    @param delta Value added to the filtered results.
+     */
+    CV_WRAP virtual void addSepFilter2D(int ddepth, InputArray kernelX, InputArray kernelY, double delta = 0) = 0;
+
+    /** @brief Adds an image derivative, see #Sobel for the parameters. */
+    CV_WRAP virtual void addSobel(int ddepth, int dx, int dy, int ksize = 3, double scale = 1, double delta = 0) = 0;
+
+    /** @brief Adds the gradient magnitude computed from the first x and y Sobel derivatives.
+
+    The output is CV_32F with the input number of channels.
+    @param ksize Aperture size of the Sobel operator, see #Sobel.
+    @param L2gradient Use \f$\sqrt{(dI/dx)^2 + (dI/dy)^2}\f$ when true, \f$|dI/dx|+|dI/dy|\f$ otherwise.
+     */
+    CV_WRAP virtual void addGradientMagnitude(int ksize = 3, bool L2gradient = true) = 0;
+
+    /** @brief Adds a fixed-level threshold, see #threshold. #THRESH_OTSU and #THRESH_TRIANGLE are not supported. */
+    CV_WRAP virtual void addThreshold(double thresh, double maxval, int type) = 0;
+
+    /** @brief Adds a conversion with optional scaling, see Mat::convertTo. */
+    CV_WRAP virtual void addConvertTo(int ddepth, double alpha = 1, double beta = 0) = 0;
+
+    /** @brief Returns the number of stages. */
+    CV_WRAP virtual int getStageCount() const = 0;
+
+    /** @brief Runs the chain.
+
+    @param src Source image. The whole image is filtered, pixels outside of a ROI are not used.
+    @param dst Destination image of the size of src and the type produced by the last stage.
+     */
+    CV_WRAP virtual void apply(InputArray src, OutputArray dst) = 0;
+};
+
+/** @brief Creates an empty FilterChain.
+
+@param borderType Pixel extrapolation method used by all the stages, see #BorderTypes.
+#BORDER_WRAP is not supported.
+ */
+CV_EXPORTS_W Ptr<FilterChain> createFilterChain(int borderType = BORDER_DEFAULT);
+
 //! @} imgproc_filter
 
 //! @addtogroup imgproc_feature
@@ -2559,6 +2672,78 @@ CV_EXPORTS_W void convertMaps( InputArray map1, InputArray map2,
                                OutputArray dstmap1, OutputArray dstmap2,
                                int dstmap1type, bool nninterpolation = false );
 
+/** @brief Precomputed geometric transformation that is applied to many images.
+
+When the same maps (for example the output of initUndistortRectifyMap) or the same matrix are used
+for every frame, the plan converts them once to the fixed-point representation used by #remap and
+keeps it split into tiles, together with the source area read by each tile. Applying the plan then
+only runs the interpolation: tiles that read nothing from the source image are filled with the border
+value (or left untouched for #BORDER_TRANSPARENT) without sampling.
+
+The maps can optionally be packed as 8-bit offsets from a per-tile base point, which reduces the map
+memory from 6 to 4 bytes per pixel (from 4 to 2 for #INTER_NEAREST). Tiles with a larger source extent
+keep the full map. The result is the same in both cases and is bit-exact with #remap, #warpAffine and
+#warpPerspective called with the same arguments.
+
+@sa createRemapPlan, createWarpAffinePlan, createWarpPerspectivePlan
+ */
+class CV_EXPORTS_W WarpPlan : public Algorithm
+{
+public:
+    /** @brief Applies the transformation.
+
+    @param src Source image of any size and of a type supported by #remap.
+    @param dst Destination image of the plan size and the type of src.
+     */
+    CV_WRAP virtual void apply(InputArray src, OutputArray dst) const = 0;
+
+    /** @brief Returns the size of the destination image. */
+    CV_WRAP virtual Size getDstSize() const = 0;
+
+    /** @brief Returns the number of bytes used by the stored maps. */
+    CV_WRAP virtual size_t getMapMemory() const = 0;
+};
+
+/** @brief Creates a WarpPlan from the maps of #remap.
+
+@param map1 The first map of type CV_16SC2, CV_32FC1 or CV_32FC2, see #remap. Relative maps are not supported.
+@param map2 The second map of type CV_16UC1, CV_32FC1 or none (empty matrix), respectively.
+@param interpolation Interpolation method, see #InterpolationFlags. #INTER_LINEAR_EXACT and
+#INTER_NEAREST_EXACT are not supported.
+@param borderMode Pixel extrapolation method, see #BorderTypes.
+@param borderValue Value used with the constant border.
+@param packMaps Store the maps as tile-local 8-bit offsets.
+ */
+CV_EXPORTS_W Ptr<WarpPlan> createRemapPlan( InputArray map1, InputArray map2, int interpolation,
+                                            int borderMode = BORDER_CONSTANT,
+                                            const Scalar& borderValue = Scalar(), bool packMaps = false );
+
+/** @brief Creates a WarpPlan that does the same as #warpAffine with the given arguments.
+
+@param M \f$2\times 3\f$ transformation matrix.
+@param dsize Size of the destination image.
+@param flags Combination of the interpolation method and #WARP_INVERSE_MAP, see #warpAffine.
+@param borderMode Pixel extrapolation method, see #BorderTypes.
+@param borderValue Value used with the constant border.
+@param packMaps Store the maps as tile-local 8-bit offsets.
+ */
+CV_EXPORTS_W Ptr<WarpPlan> createWarpAffinePlan( InputArray M, Size dsize, int flags = INTER_LINEAR,
+                                                 int borderMode = BORDER_CONSTANT,
+                                                 const Scalar& borderValue = Scalar(), bool packMaps = false );
+
+/** @brief Creates a WarpPlan that does the same as #warpPerspective with the given arguments.
+
+@param M \f$3\times 3\f$ transformation matrix.
+@param dsize Size of the destination image.
+@param flags Combination of the interpolation method and #WARP_INVERSE_MAP, see #warpPerspective.
+@param borderMode Pixel extrapolation method, see #BorderTypes.
+@param borderValue Value used with the constant border.
+@param packMaps Store the maps as tile-local 8-bit offsets.
+ */
+CV_EXPORTS_W Ptr<WarpPlan> createWarpPerspectivePlan( InputArray M, Size dsize, int flags = INTER_LINEAR,
+                                                      int borderMode = BORDER_CONSTANT,
+                                                      const Scalar& borderValue = Scalar(), bool packMaps = false );
+
 /** @brief Calculates an affine matrix of 2D rotation.
 
 The function calculates the following matrix:
@@ -2666,6 +2851,63 @@ source image. The center must be inside the image.
 CV_EXPORTS_W void getRectSubPix( InputArray image, Size patchSize,
                                  Point2f center, OutputArray patch, int patchType = -1 );
 
+//! memory layout of the blob produced by #cropResizeBatch
+enum CropResizeLayout
+{
+    CROP_RESIZE_LAYOUT_NCHW = 0, //!< one plane per channel: N x C x H x W
+    CROP_RESIZE_LAYOUT_NHWC = 1  //!< interleaved channels: N x H x W x C
+};
+
+/** @brief Crops, resizes and normalizes a set of image regions into one 4-dimensional blob.
+
+The function replaces a sequence of crop, #resize, channel swap and #convertTo calls per region,
+typical for the preprocessing of detections before a neural network. For each region it samples
+a size.width x size.height patch and stores
+
+\f[\texttt{blob}(i, c, y, x) = (\texttt{patch}_i(x, y)_{c'} - \texttt{mean}_c) \cdot \texttt{scale}_c\f]
+
+where \f$c'\f$ is \f$c\f$, or the swapped R and B channel if swapRB is set. The regions are processed in
+parallel.
+
+The sampling positions are computed like in #resize, clamped to the region, rotated by the region
+angle and rounded to the fixed-point grid of #warpAffine (1/#INTER_TAB_SIZE of a pixel). Pixels
+outside of the image replicate its border. Axis-aligned integer regions inside the image are
+sampled with the #resize kernels and match #resize of the crop exactly with #INTER_LINEAR.
+
+@param image Source image, CV_8U, CV_16U or CV_32F with 1, 3 or 4 channels.
+@param rois Regions to sample. RotatedRect::center uses the coordinate system where pixel (x, y)
+covers the square [x, x+1) x [y, y+1), as in RotatedRect(Rect).
+@param blob Output CV_32F blob of N x C x H x W or N x H x W x C elements, N = rois.size().
+@param size Size of the patch sampled from each region.
+@param mean Value subtracted from each output channel.
+@param scale Factor applied to each output channel after the mean subtraction.
+@param swapRB Swap the first and the third channel of 3- and 4-channel images.
+@param interpolation #INTER_LINEAR or #INTER_NEAREST (rounding to the nearest pixel center).
+@param layout Blob layout, see #CropResizeLayout.
+
+@sa resize, warpAffine, getRectSubPix
+ */
+CV_EXPORTS_W void cropResizeBatch( InputArray image, const std::vector<RotatedRect>& rois, OutputArray blob,
+                                   Size size, const Scalar& mean = Scalar(), const Scalar& scale = Scalar::all(1),
+                                   bool swapRB = false, int interpolation = INTER_LINEAR,
+                                   int layout = CROP_RESIZE_LAYOUT_NCHW );
+
+/** @overload
+@param image Source image.
+@param rois Axis-aligned regions to sample.
+@param blob Output blob.
+@param size Size of the patch sampled from each region.
+@param mean Value subtracted from each output channel.
+@param scale Factor applied to each output channel after the mean subtraction.
+@param swapRB Swap the first and the third channel of 3- and 4-channel images.
+@param interpolation #INTER_LINEAR or #INTER_NEAREST.
+@param layout Blob layout, see #CropResizeLayout.
+*/
+CV_EXPORTS void cropResizeBatch( InputArray image, const std::vector<Rect>& rois, OutputArray blob,
+                                 Size size, const Scalar& mean = Scalar(), const Scalar& scale = Scalar::all(1),
+                                 bool swapRB = false, int interpolation = INTER_LINEAR,
+                                 int layout = CROP_RESIZE_LAYOUT_NCHW );
+
 /** @example samples/cpp/polar_transforms.cpp
 An example using the cv::linearPolar and cv::logPolar operations
 */
@@ -3427,6 +3669,23 @@ size as image .
  */
 CV_EXPORTS_W void watershed( InputArray image, InputOutputArray markers );
 
+/** @brief Performs a marker-based image segmentation using a parallel, tiled watershed.
+
+The image is split into tileSize x tileSize tiles that are flooded in parallel. The flooding order
+of #watershed is followed within a tile, while the flood crosses the tile borders only between the
+synchronized rounds of the algorithm. Thus the segmentation is deterministic: it depends on
+tileSize, but not on the number of threads. Where several paths of the same height compete, the
+boundaries may be placed differently than by #watershed; when a single tile covers the image, the
+result is the same.
+
+@param image Input 8-bit 3-channel image.
+@param markers Input/output 32-bit single-channel image (map) of markers, see #watershed.
+@param tileSize Size of the tiles.
+
+@sa watershed
+ */
+CV_EXPORTS_W void watershedTiled( InputArray image, InputOutputArray markers, int tileSize = 256 );
+
 //! @} imgproc_segmentation
 
 //! @addtogroup imgproc_filter
@@ -3550,9 +3809,9 @@ distinct labels. When labelType==#DIST_LABEL_PIXEL, the function scans through t
 marks all the zero pixels with distinct labels.
 
 In this mode, the complexity is still linear. That is, the function provides a very fast way to
-compute the Voronoi diagram for a binary image. Currently, the second variant can use only the
-approximate distance transform algorithm, i.e. maskSize=#DIST_MASK_PRECISE is not supported
-yet.
+compute the Voronoi diagram for a binary image. With maskSize=#DIST_MASK_PRECISE and
+distanceType=#DIST_L2 the labels follow the precise algorithm; otherwise the \f$5\times 5\f$
+approximation is used.
 
 @param src 8-bit, single-channel (binary) source image.
 @param dst Output image with calculated distances. It is a 8-bit or 32-bit floating-point,
@@ -3561,7 +3820,7 @@ single-channel image of the same size as src.
 CV_32SC1 and the same size as src.
 @param distanceType Type of distance, see #DistanceTypes
 @param maskSize Size of the distance transform mask, see #DistanceTransformMasks.
-#DIST_MASK_PRECISE is not supported by this variant. In case of the #DIST_L1 or #DIST_C distance type,
+#DIST_MASK_PRECISE is supported by this variant for #DIST_L2 only. In case of the #DIST_L1 or #DIST_C distance type,
 the parameter is forced to 3 because a \f$3\times 3\f$ mask gives the same result as \f$5\times
 5\f$ or any larger aperture.
 @param labelType Type of the label array to build, see #DistanceTransformLabelTypes.
@@ -3783,6 +4042,30 @@ The function can do the following transformations:
 */
 CV_EXPORTS_W void demosaicing(InputArray src, OutputArray dst, int code, int dstCn = 0);
 
+/** @brief Demosaics a Bayer image, applies white balance and a color matrix and optionally bins it, in one pass.
+
+The function is equivalent to bilinear #demosaicing followed by the per-channel multiplication by
+gains, the 3x3 color matrix transform and the downscaling by averaging binning x binning blocks
+(#INTER_AREA), but the image is processed in bands of rows, so the full-resolution color image is
+never stored. The result is rounded and saturated once, at the end.
+
+\f[\texttt{dst} (x,y) =  \texttt{saturate} ( \texttt{colorMatrix} \cdot \texttt{diag} (\texttt{gains}) \cdot \texttt{avg} (x,y))\f]
+
+where avg(x,y) is the mean of the demosaiced pixels of the block (x*binning, y*binning).
+
+@param src input 8-bit or 16-bit single-channel Bayer image.
+@param dst output 3-channel image of the same depth as src and of size (src.cols/binning, src.rows/binning).
+@param code one of #COLOR_BayerBG2BGR , #COLOR_BayerGB2BGR , #COLOR_BayerRG2BGR , #COLOR_BayerGR2BGR
+and their RGB aliases; the channel order of gains and colorMatrix is the order of the output channels.
+@param gains white balance gains of the output channels.
+@param colorMatrix optional 3x3 floating-point color correction matrix, identity if empty.
+@param binning 1, 2 or 4.
+@sa demosaicing
+*/
+CV_EXPORTS_W void demosaicingPipeline(InputArray src, OutputArray dst, int code,
+                                      const Scalar& gains = Scalar::all(1),
+                                      InputArray colorMatrix = noArray(), int binning = 1);
+
 //! @} imgproc_color_conversions
 
 //! @addtogroup imgproc_shape
@@ -3911,6 +4194,44 @@ is \f$W \times H\f$ and templ is \f$w \times h\f$ , then result is \f$(W-w+1) \t
 CV_EXPORTS_W void matchTemplate( InputArray image, InputArray templ,
                                  OutputArray result, int method, InputArray mask = noArray() );
 
+/** @brief Matches a set of templates against one image.
+
+The class computes the same maps as #matchTemplate without a mask, for every template at once. The
+spectrum of each image block is computed once and shared by all the templates, the template spectra
+are cached between the calls of match() while the image size stays the same, and the blocks are
+processed in parallel. The results may differ from #matchTemplate by floating-point rounding.
+
+@sa matchTemplate, createTemplateMatcher
+ */
+class CV_EXPORTS_W TemplateMatcher : public Algorithm
+{
+public:
+    /** @brief Replaces the templates.
+
+    @param templs Templates of the same type, 8-bit or 32-bit floating-point, possibly of different
+    sizes. The templates are copied.
+     */
+    CV_WRAP virtual void setTemplates(InputArrayOfArrays templs) = 0;
+
+    /** @brief Compares all the templates against the image.
+
+    @param image Image of the same type as the templates, not smaller than any of them.
+    @param results Vector of comparison maps, one per template, see #matchTemplate.
+     */
+    CV_WRAP virtual void match(InputArray image, OutputArrayOfArrays results) = 0;
+
+    /** @brief Sets the comparison method, see #TemplateMatchModes. */
+    CV_WRAP virtual void setMethod(int method) = 0;
+    CV_WRAP virtual int getMethod() const = 0;
+};
+
+/** @brief Creates a TemplateMatcher for a set of templates.
+
+@param templs Templates, see TemplateMatcher::setTemplates.
+@param method Comparison method, see #TemplateMatchModes.
+ */
+CV_EXPORTS_W Ptr<TemplateMatcher> createTemplateMatcher(InputArrayOfArrays templs, int method = TM_CCOEFF_NORMED);
+
 //! @}
 
 //! @addtogroup imgproc_shape
@@ -3995,6 +4316,55 @@ CV_EXPORTS_W int connectedComponentsWithStats(InputArray image, OutputArray labe
                                               OutputArray stats, OutputArray centroids,
                                               int connectivity = 8, int ltype = CV_32S);
 
+/** @brief Connected components labeling of a sequence of binary images that change in small regions.
+
+The image is split into square tiles. Every tile is labeled on its own with the Spaghetti algorithm
+@cite Bolelli2019 and the tile components are joined into the image components through the pixels
+on the tile borders. When the next frame arrives, only the tiles that changed are labeled again and
+only the components that touch them are rebuilt, so the cost follows the changed area rather than
+the image area.
+
+The labels are persistent: a component keeps its label while it exists, when two components merge
+the smaller label survives, and the labels of removed components are reused later. Therefore the
+labels are not consecutive; stats rows of unused labels have zero area. Label 0 is the background,
+its stats row holds the background area and the whole image as the bounding box.
+
+@sa connectedComponentsWithStats, createIncrementalConnectedComponents
+ */
+class CV_EXPORTS_W IncrementalConnectedComponents : public Algorithm
+{
+public:
+    /** @brief Labels the next frame.
+
+    @param image 8-bit single-channel image; non-zero pixels are the foreground. A frame of a new
+    size starts a new sequence.
+    @param changeMask 8-bit single-channel mask of the pixels that changed since the previous frame.
+    If it is empty, the changed tiles are found by comparing the frame with the previous one.
+    @return the number of labels N, i.e. the number of rows of the stats.
+     */
+    CV_WRAP virtual int apply(InputArray image, InputArray changeMask = noArray()) = 0;
+
+    /** @brief Labels the next frame that differs from the previous one only inside dirtyRects. */
+    CV_WRAP virtual int applyRegions(InputArray image, const std::vector<Rect>& dirtyRects) = 0;
+
+    /** @brief Returns the CV_32S labels of the last frame. The matrix shares data with the object. */
+    CV_WRAP virtual void getLabels(OutputArray labels) const = 0;
+
+    /** @brief Returns the statistics of the labels, see #connectedComponentsWithStats. */
+    CV_WRAP virtual void getStats(OutputArray stats, OutputArray centroids = noArray()) const = 0;
+
+    CV_WRAP virtual int getConnectivity() const = 0;
+    CV_WRAP virtual int getTileSize() const = 0;
+};
+
+/** @brief Creates a cv::IncrementalConnectedComponents object.
+
+@param connectivity 8 or 4 for 8-way or 4-way connectivity respectively.
+@param tileSize Side of the tiles that are relabeled when any of their pixels changes.
+ */
+CV_EXPORTS_W Ptr<IncrementalConnectedComponents> createIncrementalConnectedComponents(int connectivity = 8,
+                                                                                       int tileSize = 64);
+
 
 /** @brief Finds contours in a binary image.
 
@@ -4128,6 +4498,34 @@ visit the @ref tutorial_bounding_rotated_ellipses "tutorial on Creating Bounding
  */
 CV_EXPORTS_W void boxPoints(RotatedRect box, OutputArray points);
 
+/** @brief Computes shape descriptors of many contours at once.
+
+The function computes the requested descriptors of every contour in one pass over its points, the
+contours are processed in parallel. Every descriptor is stored in its own array, one column per
+contour and one row per field, so that a field can be used directly for filtering, e.g.
+`areas > 100` or `rects.row(2)` for the widths. Pass noArray() for the descriptors that are not needed.
+
+The values are the same as those of #contourArea, #arcLength, #boundingRect, #moments and
+#minAreaRect called on each contour, up to the rounding of the floating-point sums.
+
+@param contours Input contours, e.g. the output of #findContours. Each contour is a vector of
+2D points (CV_32SC2 or CV_32FC2).
+@param areas Output 1xN CV_64F array of the contour areas, see #contourArea (not oriented).
+@param arcLengths Output 1xN CV_64F array of the contour perimeters, see #arcLength.
+@param boundingRects Output 4xN CV_32S array with the rows x, y, width, height, see #boundingRect.
+@param moments Output 10xN CV_64F array of the spatial moments m00, m10, m01, m20, m11, m02, m30,
+m21, m12, m03, see #moments.
+@param minAreaRects Output 5xN CV_32F array with the rows center.x, center.y, width, height, angle,
+see #minAreaRect.
+@param closed Flag indicating whether the curves are closed, used for the arc lengths.
+ */
+CV_EXPORTS_W void contourDescriptors( InputArrayOfArrays contours, OutputArray areas,
+                                      OutputArray arcLengths = noArray(),
+                                      OutputArray boundingRects = noArray(),
+                                      OutputArray moments = noArray(),
+                                      OutputArray minAreaRects = noArray(),
+                                      bool closed = true );
+
 /** @brief Finds a circle of the minimum area enclosing a 2D point set.
 
 The function finds the minimal enclosing circle of a 2D point set using an iterative algorithm.
@@ -4900,6 +5298,59 @@ CV_EXPORTS_W double getFontScaleFromHeight(const int fontFace,
                                            const int pixelHeight,
                                            const int thickness = 1);
 
+/** @brief Records drawing primitives and renders them in one pass.
+
+The primitives are drawn in the order they were added. The image is split into bands of rows that
+are rendered in parallel; every band draws the primitives that may touch it, clipped to its rows.
+The result is the same as calling the corresponding drawing functions one after another, which
+makes the class useful for images with many annotations (boxes, labels, tracks).
+
+The colors are converted when the list is rendered, so the same list can be drawn on images of
+different types. The primitives are removed with Algorithm::clear.
+
+@sa createDrawList
+ */
+class CV_EXPORTS_W DrawList : public Algorithm
+{
+public:
+    /** @brief Adds a line segment, see #line. */
+    CV_WRAP virtual void addLine(Point pt1, Point pt2, const Scalar& color,
+                                 int thickness = 1, int lineType = LINE_8, int shift = 0) = 0;
+
+    /** @brief Adds a rectangle, see #rectangle. A negative thickness fills it. */
+    CV_WRAP virtual void addRectangle(Rect rec, const Scalar& color,
+                                      int thickness = 1, int lineType = LINE_8, int shift = 0) = 0;
+
+    /** @brief Adds a circle, see #circle. A negative thickness fills it. */
+    CV_WRAP virtual void addCircle(Point center, int radius, const Scalar& color,
+                                   int thickness = 1, int lineType = LINE_8, int shift = 0) = 0;
+
+    /** @brief Adds polygonal curves, see #polylines. */
+    CV_WRAP virtual void addPolylines(InputArrayOfArrays pts, bool isClosed, const Scalar& color,
+                                      int thickness = 1, int lineType = LINE_8, int shift = 0) = 0;
+
+    /** @brief Adds the area bounded by one or more polygons, see #fillPoly. */
+    CV_WRAP virtual void addFillPoly(InputArrayOfArrays pts, const Scalar& color,
+                                     int lineType = LINE_8, int shift = 0, Point offset = Point()) = 0;
+
+    /** @brief Adds a text string, see #putText. */
+    CV_WRAP virtual void addText(const String& text, Point org, int fontFace, double fontScale,
+                                 const Scalar& color, int thickness = 1, int lineType = LINE_8,
+                                 bool bottomLeftOrigin = false) = 0;
+
+    /** @brief Returns the number of recorded primitives. */
+    CV_WRAP virtual int getPrimitiveCount() const = 0;
+
+    /** @brief Draws the recorded primitives.
+
+    @param img Image to draw on.
+     */
+    CV_WRAP virtual void render(InputOutputArray img) const = 0;
+};
+
+/** @brief Creates an empty cv::DrawList. */
+CV_EXPORTS_W Ptr<DrawList> createDrawList();
+
 /** @brief Class for iterating over all pixels on a raster line segment.
 
 The class LineIterator is used to get each pixel of a raster line connecting
@@ -35,4 +35,30 @@ PERF_TEST_P( TestBilateralFilter, BilateralFilter,
     SANITY_CHECK(dst, .01, ERROR_RELATIVE);
 }
 
+typedef TestBaseWithParam< tuple<Size, double, Mat_Type> > TestBilateralGridFilter;
+
+PERF_TEST_P( TestBilateralGridFilter, BilateralGridFilter,
+             Combine(
+                Values( szVGA, sz1080p ), // image size
+                Values( 4., 8., 16. ), // sigmaSpace
+                Values( (int)CV_8UC1, (int)CV_8UC3, (int)CV_32FC1 ) // image type
+             )
+)
+{
+    Size sz = get<0>(GetParam());
+    double sigmaSpace = get<1>(GetParam());
+    int type = get<2>(GetParam());
+    const double sigmaColor = 30.;
+
+    Mat src(sz, type);
+    Mat dst(sz, type);
+    randu(src, 0, 256); // the grid size follows the value range
+
+    declare.in(src).out(dst).time(20);
+
+    TEST_CYCLE() bilateralGridFilter(src, dst, sigmaColor, sigmaSpace);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
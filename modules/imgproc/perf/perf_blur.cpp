@@ -33,6 +33,29 @@ PERF_TEST_P(Size_MatType_kSize, medianBlur,
     SANITY_CHECK(dst);
 }
 
+PERF_TEST_P(Size_MatType_kSize, medianBlur_large,
+            testing::Combine(
+                testing::Values(szVGA, sz1080p),
+                testing::Values(CV_8UC1, CV_16UC1, CV_32FC1),
+                testing::Values(7, 11, 15)
+                )
+            )
+{
+    Size size = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int ksize = get<2>(GetParam());
+
+    Mat src(size, type);
+    Mat dst(size, type);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+    declare.time(30);
+
+    TEST_CYCLE() medianBlur(src, dst, ksize);
+
+    SANITY_CHECK_NOTHING();
+}
+
 CV_ENUM(BorderType3x3, BORDER_REPLICATE, BORDER_CONSTANT)
 CV_ENUM(BorderType, BORDER_REPLICATE, BORDER_CONSTANT, BORDER_REFLECT, BORDER_REFLECT101)
 
@@ -300,5 +323,50 @@ PERF_TEST_P(Size_MatType, stackblur101x101,
     SANITY_CHECK_NOTHING();
 }
 
+///////////// Large sigma Gaussian ////////////////////////
+typedef tuple<MatType, double> MatType_Sigma_t;
+typedef perf::TestBaseWithParam<MatType_Sigma_t> MatType_Sigma;
+
+PERF_TEST_P(MatType_Sigma, gaussianBlurLargeSigma,
+            testing::Combine(
+                    testing::Values(CV_8UC1, CV_8UC3, CV_32FC1),
+                    testing::Values(5., 20.)
+            )
+)
+{
+    int type = get<0>(GetParam());
+    double sigma = get<1>(GetParam());
+    int ksize = 2*cvCeil(sigma*4) + 1;
+
+    Mat src(sz1080p, type);
+    Mat dst(sz1080p, type);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() GaussianBlur(src, dst, Size(ksize, ksize), sigma);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(MatType_Sigma, recursiveGaussianBlur,
+            testing::Combine(
+                    testing::Values(CV_8UC1, CV_8UC3, CV_32FC1),
+                    testing::Values(5., 20., 50.)
+            )
+)
+{
+    int type = get<0>(GetParam());
+    double sigma = get<1>(GetParam());
+
+    Mat src(sz1080p, type);
+    Mat dst(sz1080p, type);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() recursiveGaussianBlur(src, dst, sigma);
+
+    SANITY_CHECK_NOTHING();
+}
+
 
 } // namespace
@@ -84,6 +84,42 @@ PERF_TEST_P(TestFindContoursFF, findContours,
     SANITY_CHECK_NOTHING();
 }
 
+typedef TestBaseWithParam< tuple<Size, RetrMode, ApproxMode, int> > TestFindContoursLarge;
+
+PERF_TEST_P(TestFindContoursLarge, findContours,
+            Combine(
+               Values( Size(5472, 3648) ), // 20MP mask
+               Values( (int)RETR_EXTERNAL, (int)RETR_TREE ), // retrieval mode
+               Values( (int)CHAIN_APPROX_NONE, (int)CHAIN_APPROX_SIMPLE ), // approximation method
+               Values( 100, 10000 ) // blob count
+            )
+           )
+{
+    Size img_size = get<0>(GetParam());
+    int retr_mode = get<1>(GetParam());
+    int approx_method = get<2>(GetParam());
+    int blob_count = get<3>(GetParam());
+
+    RNG rng;
+    Mat img = Mat::zeros(img_size, CV_8UC1);
+    for(int i = 0; i < blob_count; i++ )
+    {
+        Point center((unsigned)rng % img.cols, (unsigned)rng % img.rows);
+        int max_radius = std::max(img.cols / (int)std::sqrt((double)blob_count) / 2, 4);
+        Size axes((unsigned)rng % max_radius + 2, (unsigned)rng % max_radius + 2);
+        double angle = (unsigned)rng % 180;
+        int brightness = (unsigned)rng % 2;
+
+        ellipse( img, center, axes, angle, 0., 360., Scalar(brightness), -1);
+    }
+    vector< vector<Point> > contours;
+    vector< Vec4i > hierarchy;
+
+    TEST_CYCLE() findContours( img, contours, hierarchy, retr_mode, approx_method );
+
+    SANITY_CHECK_NOTHING();
+}
+
 typedef TestBaseWithParam< tuple<MatDepth, int> > TestBoundingRect;
 
 PERF_TEST_P(TestBoundingRect, BoundingRect,
@@ -106,4 +142,45 @@ PERF_TEST_P(TestBoundingRect, BoundingRect,
     SANITY_CHECK_NOTHING();
 }
 
+typedef TestBaseWithParam< tuple<int, bool> > TestContourDescriptors;
+
+// per-blob analysis: area, perimeter, bounding box and moments of every contour
+PERF_TEST_P(TestContourDescriptors, contourDescriptors,
+            Combine(Values(500, 5000), // blob count
+                    testing::Bool()) // batched or separate calls
+           )
+{
+    int blob_count = get<0>(GetParam());
+    bool batched = get<1>(GetParam());
+
+    RNG rng;
+    Mat img = Mat::zeros(sz1080p, CV_8UC1);
+    for (int i = 0; i < blob_count; i++)
+        ellipse(img, Point(rng.uniform(0, img.cols), rng.uniform(0, img.rows)),
+                Size(rng.uniform(2, 30), rng.uniform(2, 30)), rng.uniform(0, 180), 0., 360., Scalar(255), -1);
+    vector< vector<Point> > contours;
+    findContours(img, contours, RETR_LIST, CHAIN_APPROX_NONE);
+    Mat areas, lengths, rects, moms;
+
+    TEST_CYCLE()
+    {
+        if (batched)
+            contourDescriptors(contours, areas, lengths, rects, moms);
+        else
+        {
+            areas.create(1, (int)contours.size(), CV_64F);
+            lengths.create(1, (int)contours.size(), CV_64F);
+            for (size_t i = 0; i < contours.size(); i++)
+            {
+                areas.at<double>((int)i) = contourArea(contours[i]);
+                lengths.at<double>((int)i) = arcLength(contours[i], true);
+                boundingRect(contours[i]);
+                moments(contours[i]);
+            }
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 } } // namespace
@@ -430,6 +430,31 @@ PERF_TEST_P(Size_CvtMode_Bayer, cvtColorBayer8u,
     SANITY_CHECK_NOTHING();
 }
 
+typedef perf::TestBaseWithParam< tuple<Size, MatDepth, int> > Size_Depth_Binning;
+
+PERF_TEST_P(Size_Depth_Binning, demosaicingPipeline,
+            testing::Combine(
+                testing::Values(::perf::sz1080p, ::perf::sz2160p),
+                testing::Values(CV_8U, CV_16U),
+                testing::Values(1, 2, 4)
+                )
+            )
+{
+    Size sz = get<0>(GetParam());
+    int depth = get<1>(GetParam());
+    int binning = get<2>(GetParam());
+
+    Mat src(sz, CV_MAKETYPE(depth, 1));
+    Mat dst(sz.height / binning, sz.width / binning, CV_MAKETYPE(depth, 3));
+    Matx33f ccm(1.6f, -0.4f, -0.2f, -0.3f, 1.5f, -0.2f, -0.1f, -0.5f, 1.6f);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() demosaicingPipeline(src, dst, COLOR_BayerBG2BGR, Scalar(1.5, 1.0, 2.0), ccm, binning);
+
+    SANITY_CHECK_NOTHING();
+}
+
 typedef tuple<Size, CvtMode2> Size_CvtMode2_t;
 typedef perf::TestBaseWithParam<Size_CvtMode2_t> Size_CvtMode2;
 
@@ -76,4 +76,36 @@ PERF_TEST_P(DistanceTransform_NeedLabels_Test, distanceTransform_NeedLabels,
     SANITY_CHECK(dst, eps);
 }
 
+typedef perf::TestBaseWithParam< tuple<Size, bool> > DistanceTransform_Precise;
+
+PERF_TEST_P(DistanceTransform_Precise, distanceTransform_precise,
+            testing::Combine(
+                testing::Values(cv::Size(3840, 2160), cv::Size(7680, 4320)),
+                testing::Bool() // labels
+                )
+    )
+{
+    Size srcSize = get<0>(GetParam());
+    bool withLabels = get<1>(GetParam());
+
+    Mat src(srcSize, CV_8U);
+    randu(src, 0, 256);
+    src = src > 2; // about 1% of obstacles
+    Mat label(srcSize, CV_32S);
+    Mat dst(srcSize, CV_32F);
+
+    declare.in(src).out(dst).time(60);
+
+    if (withLabels)
+    {
+        TEST_CYCLE() distanceTransform(src, dst, label, DIST_L2, DIST_MASK_PRECISE, DIST_LABEL_PIXEL);
+    }
+    else
+    {
+        TEST_CYCLE() distanceTransform(src, dst, DIST_L2, DIST_MASK_PRECISE, CV_32F);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -0,0 +1,76 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "perf_precomp.hpp"
+
+namespace opencv_test {
+
+// detection overlays: a box and a label per object
+static void makeBoxes(Size sz, int count, std::vector<Rect>& boxes, std::vector<Scalar>& colors)
+{
+    RNG rng(0x1234);
+    boxes.resize(count);
+    colors.resize(count);
+    for (int i = 0; i < count; i++)
+    {
+        int w = rng.uniform(20, 200), h = rng.uniform(20, 200);
+        boxes[i] = Rect(rng.uniform(0, sz.width - w), rng.uniform(0, sz.height - h), w, h);
+        colors[i] = Scalar(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256));
+    }
+}
+
+typedef TestBaseWithParam< tuple<Size, int, int> > Size_Count_LineType;
+
+PERF_TEST_P(Size_Count_LineType, draw_boxes_sequential,
+            Combine(Values(sz1080p), Values(500, 3000), Values((int)LINE_8, (int)LINE_AA)))
+{
+    Size sz = get<0>(GetParam());
+    int count = get<1>(GetParam()), lineType = get<2>(GetParam());
+    std::vector<Rect> boxes;
+    std::vector<Scalar> colors;
+    makeBoxes(sz, count, boxes, colors);
+    Mat img(sz, CV_8UC3, Scalar::all(0));
+
+    declare.in(img).time(30);
+
+    TEST_CYCLE()
+    {
+        for (int i = 0; i < count; i++)
+        {
+            cv::rectangle(img, boxes[i], colors[i], 2, lineType);
+            cv::putText(img, "person 0.87", boxes[i].tl() + Point(2, 14), FONT_HERSHEY_SIMPLEX, 0.5, colors[i], 1, lineType);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_Count_LineType, draw_boxes_DrawList,
+            Combine(Values(sz1080p), Values(500, 3000), Values((int)LINE_8, (int)LINE_AA)))
+{
+    Size sz = get<0>(GetParam());
+    int count = get<1>(GetParam()), lineType = get<2>(GetParam());
+    std::vector<Rect> boxes;
+    std::vector<Scalar> colors;
+    makeBoxes(sz, count, boxes, colors);
+    Mat img(sz, CV_8UC3, Scalar::all(0));
+    Ptr<DrawList> list = createDrawList();
+
+    declare.in(img).time(30);
+
+    TEST_CYCLE()
+    {
+        list->clear();
+        for (int i = 0; i < count; i++)
+        {
+            list->addRectangle(boxes[i], colors[i], 2, lineType);
+            list->addText("person 0.87", boxes[i].tl() + Point(2, 14), FONT_HERSHEY_SIMPLEX, 0.5, colors[i], 1, lineType);
+        }
+        list->render(img);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
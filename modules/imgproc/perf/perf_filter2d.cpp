@@ -97,4 +97,39 @@ PERF_TEST_P( Image_KernelSize, GaborFilter2d,
     SANITY_CHECK(filteredImage, 1e-6, ERROR_RELATIVE);
 }
 
+typedef TestBaseWithParam< Size > FilterChainSize;
+
+PERF_TEST_P(FilterChainSize, gradientSeparateCalls, Values(szVGA, sz1080p))
+{
+    Size sz = GetParam();
+    Mat src(sz, CV_8UC1), blurred, gx, gy, mag, dst;
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE()
+    {
+        GaussianBlur(src, blurred, Size(5, 5), 1.2);
+        Sobel(blurred, gx, CV_32F, 1, 0);
+        Sobel(blurred, gy, CV_32F, 0, 1);
+        magnitude(gx, gy, mag);
+        cv::threshold(mag, dst, 100, 255, THRESH_BINARY);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(FilterChainSize, gradientFilterChain, Values(szVGA, sz1080p))
+{
+    Size sz = GetParam();
+    Mat src(sz, CV_8UC1), dst;
+    Ptr<FilterChain> chain = createFilterChain();
+    chain->addGaussianBlur(Size(5, 5), 1.2);
+    chain->addGradientMagnitude(3, true);
+    chain->addThreshold(100, 255, THRESH_BINARY);
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() chain->apply(src, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
@@ -0,0 +1,58 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "perf_precomp.hpp"
+
+namespace opencv_test {
+
+typedef TestBaseWithParam< tuple<Size, bool> > GeneralizedHoughFixture;
+
+PERF_TEST_P(GeneralizedHoughFixture, GeneralizedHough,
+            Combine(Values(szVGA, sz720p), testing::Bool()))
+{
+    const Size size = get<0>(GetParam());
+    const bool guil = get<1>(GetParam());
+
+    Mat templ = Mat::zeros(64, 64, CV_8UC1);
+    rectangle(templ, Rect(12, 16, 40, 32), Scalar::all(255), FILLED);
+    circle(templ, Point(32, 16), 10, Scalar::all(255), FILLED);
+
+    Mat image = Mat::zeros(size, CV_8UC1);
+    RNG& rng = theRNG();
+    for (int i = 0; i < 10; i++)
+    {
+        Point pt(rng.uniform(40, size.width - 40), rng.uniform(40, size.height - 40));
+        rectangle(image, Rect(pt.x - 20, pt.y - 16, 40, 32), Scalar::all(255), FILLED);
+        circle(image, Point(pt.x, pt.y - 16), 10, Scalar::all(255), FILLED);
+    }
+
+    Ptr<GeneralizedHough> hough;
+    if (guil)
+    {
+        Ptr<GeneralizedHoughGuil> g = createGeneralizedHoughGuil();
+        g->setMaxBufferSize(1000);
+        g->setMaxAngle(30);
+        g->setMinScale(0.8);
+        g->setMaxScale(1.2);
+        g->setAngleThresh(1000);
+        g->setScaleThresh(50);
+        g->setPosThresh(50);
+        hough = g;
+    }
+    else
+    {
+        Ptr<GeneralizedHoughBallard> b = createGeneralizedHoughBallard();
+        b->setVotesThreshold(30);
+        hough = b;
+    }
+    hough->setTemplate(templ);
+
+    Mat positions(1, 1, CV_32FC4), votes(1, 1, CV_32SC3);
+    declare.time(60);
+
+    TEST_CYCLE() hough->detect(image, positions, votes);
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
@@ -41,6 +41,33 @@ PERF_TEST_P(Size_Source, calcHist1d,
     SANITY_CHECK(hist);
 }
 
+PERF_TEST_P(Size_Source, calcHist1d_4096bins,
+            testing::Combine(testing::Values(szVGA, sz1080p),
+                             testing::Values(CV_16U, CV_32F) )
+            )
+{
+    Size size = get<0>(GetParam());
+    MatType type = get<1>(GetParam());
+    Mat source(size.height, size.width, type);
+    Mat hist;
+    int channels [] = {0};
+    int histSize [] = {4096};
+
+    const float range[] = {0.f, 4096.f};
+    const float* ranges[] = {range};
+
+    randu(source, 0, 4096);
+
+    declare.in(source);
+
+    TEST_CYCLE_MULTIRUN(3)
+    {
+        calcHist(&source, 1, channels, Mat(), hist, 1, histSize, ranges);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST_P(Size_Source, calcHist2d,
             testing::Combine(testing::Values(sz3MP, sz5MP),
                              testing::Values(CV_8UC2, CV_16UC2, CV_32FC2) )
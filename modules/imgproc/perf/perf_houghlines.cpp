@@ -112,4 +112,45 @@ PERF_TEST_P(Image_RhoStep_ThetaStep_Threshold, HoughLines3f,
     SANITY_CHECK_NOTHING();
 }
 
+// lane-like edge maps: long segments and edge noise
+static Mat makeEdgeMap(Size sz)
+{
+    Mat image(sz, CV_8UC1, Scalar::all(0));
+    RNG rng(0x4c414e45);
+    for (int i = 0; i < 40; i++)
+        line(image, Point(rng.uniform(0, sz.width), rng.uniform(0, sz.height)),
+             Point(rng.uniform(0, sz.width), rng.uniform(0, sz.height)), Scalar::all(255));
+    for (int i = 0; i < sz.area()/100; i++)
+        image.at<uchar>(rng.uniform(0, sz.height), rng.uniform(0, sz.width)) = 255;
+    return image;
+}
+
+typedef perf::TestBaseWithParam< tuple<Size, double> > Size_ThetaStep;
+
+PERF_TEST_P(Size_ThetaStep, HoughLines_synthetic,
+            testing::Combine(testing::Values(sz1080p, Size(3840, 2160)), testing::Values(CV_PI/180, 0.01)))
+{
+    Mat image = makeEdgeMap(get<0>(GetParam()));
+    double thetaStep = get<1>(GetParam());
+    vector<Vec2f> lines;
+    declare.in(image).time(60);
+
+    TEST_CYCLE() HoughLines(image, lines, 1, thetaStep, 300);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(Size_ThetaStep, HoughLinesP_synthetic,
+            testing::Combine(testing::Values(sz1080p, Size(3840, 2160)), testing::Values(CV_PI/180, 0.01)))
+{
+    Mat image = makeEdgeMap(get<0>(GetParam()));
+    double thetaStep = get<1>(GetParam());
+    vector<Vec4i> lines;
+    declare.in(image).time(60);
+
+    TEST_CYCLE() HoughLinesP(image, lines, 1, thetaStep, 80, 50, 5);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
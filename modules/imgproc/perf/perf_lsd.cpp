@@ -0,0 +1,40 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "perf_precomp.hpp"
+
+namespace opencv_test {
+
+typedef TestBaseWithParam< tuple<Size, int> > LineSegmentDetectorFixture;
+
+PERF_TEST_P(LineSegmentDetectorFixture, LineSegmentDetector,
+            Combine(Values(szVGA, sz1080p),
+                    Values((int)LSD_REFINE_NONE, (int)LSD_REFINE_STD, (int)LSD_REFINE_ADV)))
+{
+    const Size size = get<0>(GetParam());
+    const int refine = get<1>(GetParam());
+
+    // a synthetic document: table rules, boxes and text over a noisy background
+    Mat image(size, CV_8UC1, Scalar::all(230));
+    RNG& rng = theRNG();
+    for (int y = size.height / 10; y < size.height; y += size.height / 10)
+        line(image, Point(size.width / 20, y), Point(size.width * 19 / 20, y), Scalar::all(40), 2);
+    for (int x = size.width / 20; x < size.width; x += size.width / 5)
+        line(image, Point(x, size.height / 10), Point(x, size.height * 9 / 10), Scalar::all(40), 2);
+    for (int i = 0; i < 50; i++)
+        putText(image, "Cell 12.50", Point(rng.uniform(0, size.width - 100), rng.uniform(20, size.height)),
+                FONT_HERSHEY_SIMPLEX, 0.6, Scalar::all(20), 1, LINE_AA);
+    Mat noise(size, CV_8SC1);
+    rng.fill(noise, RNG::NORMAL, 0, 5);
+    cv::add(image, noise, image, noArray(), CV_8U);
+
+    Ptr<LineSegmentDetector> lsd = createLineSegmentDetector(refine);
+    std::vector<Vec4f> lines;
+    declare.in(image);
+
+    TEST_CYCLE() lsd->detect(image, lines);
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
@@ -81,4 +81,63 @@ PERF_TEST_P(ImgSize_TmplSize_Method, matchTemplateBig,
     SANITY_CHECK(result, eps);
 }
 
+typedef tuple<Size, int> ImgSize_TemplCount_t;
+typedef perf::TestBaseWithParam<ImgSize_TemplCount_t> ImgSize_TemplCount;
+
+static std::vector<Mat> makeTemplates(int count)
+{
+    std::vector<Mat> templs(count);
+    RNG rng(0x12345);
+    for (int i = 0; i < count; i++)
+    {
+        templs[i].create(rng.uniform(16, 49), rng.uniform(16, 49), CV_8UC1);
+        rng.fill(templs[i], RNG::UNIFORM, 0, 256);
+    }
+    return templs;
+}
+
+PERF_TEST_P(ImgSize_TemplCount, matchTemplateSeparateCalls,
+            testing::Combine(
+                testing::Values(cv::Size(640, 480), cv::Size(1280, 720)),
+                testing::Values(10, 50)
+                )
+            )
+{
+    Size imgSz = get<0>(GetParam());
+    std::vector<Mat> templs = makeTemplates(get<1>(GetParam()));
+
+    Mat img(imgSz, CV_8UC1);
+    std::vector<Mat> results(templs.size());
+
+    declare.in(img, WARMUP_RNG);
+
+    TEST_CYCLE()
+    {
+        for (size_t i = 0; i < templs.size(); i++)
+            matchTemplate(img, templs[i], results[i], TM_CCOEFF_NORMED);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(ImgSize_TemplCount, matchTemplateBatch,
+            testing::Combine(
+                testing::Values(cv::Size(640, 480), cv::Size(1280, 720)),
+                testing::Values(10, 50)
+                )
+            )
+{
+    Size imgSz = get<0>(GetParam());
+    Ptr<TemplateMatcher> matcher = createTemplateMatcher(makeTemplates(get<1>(GetParam())), TM_CCOEFF_NORMED);
+
+    Mat img(imgSz, CV_8UC1);
+    std::vector<Mat> results;
+
+    declare.in(img, WARMUP_RNG);
+
+    TEST_CYCLE() matcher->match(img, results);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
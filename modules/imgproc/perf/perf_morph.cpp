@@ -39,4 +39,24 @@ PERF_TEST_P(Size_MatType, dilate, TYPICAL_MATS_MORPH)
     SANITY_CHECK(dst);
 }
 
+typedef tuple<MatType, Size> MatType_KernelSize;
+typedef perf::TestBaseWithParam<MatType_KernelSize> MatType_KernelSize_Morph;
+
+PERF_TEST_P(MatType_KernelSize_Morph, erode_large_rect,
+            testing::Combine(testing::Values(CV_8UC1, CV_32FC1),
+                             testing::Values(Size(51, 51), Size(101, 1), Size(1, 101), Size(21, 21))))
+{
+    int type = get<0>(GetParam());
+    Size ksize = get<1>(GetParam());
+
+    Mat src(sz1080p, type), dst(sz1080p, type);
+    Mat kernel = getStructuringElement(MORPH_RECT, ksize);
+
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() cv::erode(src, dst, kernel);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
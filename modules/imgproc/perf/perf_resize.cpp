@@ -280,4 +280,55 @@ PERF_TEST_P(MatInfo_Size_Scale_NN, ResizeNNExact,
     SANITY_CHECK_NOTHING();
 }
 
+typedef perf::TestBaseWithParam<int> CropResizeCount;
+
+static std::vector<Rect> makeCropRects(int count, Size imgSize)
+{
+    std::vector<Rect> rois(count);
+    RNG rng(0x4321);
+    for (int i = 0; i < count; i++)
+    {
+        int w = rng.uniform(24, 256), h = rng.uniform(24, 256);
+        rois[i] = Rect(rng.uniform(0, imgSize.width - w), rng.uniform(0, imgSize.height - h), w, h);
+    }
+    return rois;
+}
+
+PERF_TEST_P(CropResizeCount, cropResizeSeparateCalls, testing::Values(50, 300))
+{
+    std::vector<Rect> rois = makeCropRects(GetParam(), sz1080p);
+    Mat src(sz1080p, CV_8UC3), patch, fpatch;
+    const Size size(64, 64);
+    int sz[] = { (int)rois.size(), 3, size.height, size.width };
+    Mat blob(4, sz, CV_32F);
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE()
+    {
+        for (size_t i = 0; i < rois.size(); i++)
+        {
+            resize(src(rois[i]), patch, size, 0, 0, INTER_LINEAR);
+            cvtColor(patch, patch, COLOR_BGR2RGB);
+            patch.convertTo(fpatch, CV_32F, 1/255.);
+            std::vector<Mat> planes;
+            for (int c = 0; c < 3; c++)
+                planes.push_back(Mat(size, CV_32F, blob.ptr<float>((int)i, c)));
+            split(fpatch, planes);
+        }
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(CropResizeCount, cropResizeBatch, testing::Values(50, 300))
+{
+    std::vector<Rect> rois = makeCropRects(GetParam(), sz1080p);
+    Mat src(sz1080p, CV_8UC3), blob;
+    declare.in(src, WARMUP_RNG);
+
+    TEST_CYCLE() cropResizeBatch(src, rois, blob, Size(64, 64), Scalar(), Scalar::all(1/255.), true);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
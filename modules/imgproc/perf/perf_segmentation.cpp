@@ -0,0 +1,71 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+#include "perf_precomp.hpp"
+
+namespace opencv_test {
+
+static void makeSegmentationInput(Size sz, Mat& img, Mat& markers)
+{
+    RNG rng(12345);
+    img.create(sz, CV_8UC3);
+    rng.fill(img, RNG::UNIFORM, 0, 256);
+    GaussianBlur(img, img, Size(0, 0), 5);
+    markers = Mat::zeros(sz, CV_32SC1);
+    for (int k = 1; k <= 256; k++)
+        circle(markers, Point(rng.uniform(0, sz.width), rng.uniform(0, sz.height)), 4, Scalar::all(k), FILLED);
+}
+
+typedef TestBaseWithParam< tuple<Size, bool> > TestWatershed;
+
+PERF_TEST_P(TestWatershed, watershed,
+            testing::Combine(
+                testing::Values(szVGA, sz1080p, Size(4000, 3000)),
+                testing::Bool() // tiled
+            )
+)
+{
+    Size sz = get<0>(GetParam());
+    bool tiled = get<1>(GetParam());
+    Mat img, markers0, markers;
+    makeSegmentationInput(sz, img, markers0);
+
+    declare.in(img, markers0).time(60);
+
+    TEST_CYCLE()
+    {
+        markers0.copyTo(markers);
+        if (tiled)
+            watershedTiled(img, markers);
+        else
+            watershed(img, markers);
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+typedef TestBaseWithParam< tuple<Size, double, int> > TestPyrMeanShiftFiltering;
+
+PERF_TEST_P(TestPyrMeanShiftFiltering, pyrMeanShiftFiltering,
+            testing::Combine(
+                testing::Values(szVGA, sz720p),
+                testing::Values(5., 20.), // sp
+                testing::Values(1, 2) // maxLevel
+            )
+)
+{
+    Size sz = get<0>(GetParam());
+    double sp = get<1>(GetParam());
+    int maxLevel = get<2>(GetParam());
+    Mat img, markers;
+    makeSegmentationInput(sz, img, markers);
+    Mat dst(sz, CV_8UC3);
+
+    declare.in(img).out(dst).time(60);
+
+    TEST_CYCLE() pyrMeanShiftFiltering(img, dst, sp, 30., maxLevel);
+
+    SANITY_CHECK_NOTHING();
+}
+
+} // namespace
@@ -278,6 +278,51 @@ void update_map(const Mat& src, Mat& map_x, Mat& map_y, const int remapMode, boo
     }
 }
 
+typedef TestBaseWithParam< tuple<Size, InterType, bool> > TestWarpPlan;
+
+static void makeLensMaps(Size sz, Mat& mapx, Mat& mapy)
+{
+    mapx.create(sz, CV_32FC1);
+    mapy.create(sz, CV_32FC1);
+    for (int y = 0; y < sz.height; y++)
+        for (int x = 0; x < sz.width; x++)
+        {
+            float u = (x - sz.width*0.5f)/sz.width, v = (y - sz.height*0.5f)/sz.height;
+            float k = 0.9f + 0.3f*(u*u + v*v);
+            mapx.at<float>(y, x) = sz.width*(0.5f + u*k);
+            mapy.at<float>(y, x) = sz.height*(0.5f + v*k);
+        }
+}
+
+PERF_TEST_P(TestWarpPlan, remapFloatMaps,
+            Combine(Values(szVGA, sz1080p), InterType::all(), Values(false)))
+{
+    Size sz = get<0>(GetParam());
+    int interType = get<1>(GetParam());
+    Mat src(sz, CV_8UC3), dst(sz, CV_8UC3), mapx, mapy;
+    makeLensMaps(sz, mapx, mapy);
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() remap(src, dst, mapx, mapy, interType, BORDER_CONSTANT);
+
+    SANITY_CHECK_NOTHING();
+}
+
+PERF_TEST_P(TestWarpPlan, WarpPlan,
+            Combine(Values(szVGA, sz1080p), InterType::all(), testing::Bool()))
+{
+    Size sz = get<0>(GetParam());
+    int interType = get<1>(GetParam());
+    Mat src(sz, CV_8UC3), dst(sz, CV_8UC3), mapx, mapy;
+    makeLensMaps(sz, mapx, mapy);
+    Ptr<WarpPlan> plan = createRemapPlan(mapx, mapy, interType, BORDER_CONSTANT, Scalar(), get<2>(GetParam()));
+    declare.in(src, WARMUP_RNG).out(dst);
+
+    TEST_CYCLE() plan->apply(src, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
 PERF_TEST(Transform, getPerspectiveTransform_1000)
 {
     unsigned int size = 8;
@@ -0,0 +1,285 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+/*
+ Bilateral grid (Paris & Durand, Chen et al.). The homogeneous vector (channels, 1) of every pixel
+ is added to the nearest cell of a coarse 3D grid (x/sigmaSpace, y/sigmaSpace, value/sigmaColor).
+ The grid is blurred with a separable Gaussian of one cell and sliced back at the pixel positions
+ with trilinear interpolation. The cost depends on the image size and on the grid size, but not on
+ the spatial extent of the filter.
+
+ Grid rows (the y axis) are stored one after another; a row holds the value bins of all x
+ positions, and a bin holds (cn + 1) floats. Two cells of zero padding on every side keep the 5-tap
+ blur inside the buffer, so each blur pass is a plain strided sum over a contiguous range.
+*/
+
+namespace cv {
+
+namespace {
+
+const int GRID_PAD = 2;
+
+struct BilateralGrid
+{
+    BilateralGrid(const Mat& _src, double sigmaColor, double sigmaSpace)
+        : src(_src), cn(_src.channels()), C(_src.channels() + 1)
+    {
+        double vmin = 0, vmax = 0;
+        if( src.depth() == CV_8U )
+            vmax = 255.*cn;
+        else
+        {
+            minMaxLoc(src.reshape(1), &vmin, &vmax);
+            vmin *= cn; vmax *= cn;
+        }
+        guideMin = (float)vmin;
+        invSpace = (float)(1./sigmaSpace);
+        invColor = (float)(1./sigmaColor);
+
+        gx = cvFloor((src.cols - 1)*invSpace) + 2 + GRID_PAD*2;
+        gy = cvFloor((src.rows - 1)*invSpace) + 2 + GRID_PAD*2;
+        gz = cvFloor((vmax - vmin)*invColor) + 2 + GRID_PAD*2;
+        rowLen = (size_t)gx*gz*C;
+        CV_Assert( (double)rowLen*gy < (double)INT_MAX );
+
+        grid.create(1, (int)(rowLen*gy), CV_32F);
+        tmp.create(1, (int)(rowLen*gy), CV_32F);
+
+        xofs.resize(src.cols);
+        xnear.resize(src.cols);
+        xalpha.resize(src.cols);
+        for( int x = 0; x < src.cols; x++ )
+        {
+            float fx = x*invSpace;
+            int ix = std::min(cvFloor(fx), gx - GRID_PAD*2 - 2);
+            xofs[x] = (ix + GRID_PAD)*gz*C;
+            xnear[x] = (cvRound(fx) + GRID_PAD)*gz*C;
+            xalpha[x] = fx - ix;
+        }
+    }
+
+    // guide value of a pixel: the sum of its channels
+    template<typename T, int CN> static float guide(const T* p)
+    {
+        return CN == 1 ? (float)p[0] : (float)p[0] + (float)p[1] + (float)p[2];
+    }
+
+    void zbin(float g, int& iz, float& az) const
+    {
+        float fz = (g - guideMin)*invColor;
+        iz = std::min(std::max(cvFloor(fz), 0), gz - GRID_PAD*2 - 2);
+        az = std::min(std::max(fz - iz, 0.f), 1.f);
+    }
+
+    void yrow(int y, int& iy, float& ay) const
+    {
+        float fy = y*invSpace;
+        iy = std::min(cvFloor(fy), gy - GRID_PAD*2 - 2);
+        ay = fy - iy;
+        iy += GRID_PAD;
+    }
+
+    // clears grid rows [r0, r1) and splats the image rows that fall into them
+    template<typename T, int CN> void splat(int r0, int r1)
+    {
+        const int C1 = CN + 1;
+        float* G = grid.ptr<float>();
+        memset(G + r0*rowLen, 0, (r1 - r0)*rowLen*sizeof(G[0]));
+        int ystart = std::max(cvFloor((r0 - GRID_PAD - 1)/invSpace), 0);
+        int yend = std::min(cvCeil((r1 - GRID_PAD + 1)/invSpace), src.rows);
+        int zmax = gz - GRID_PAD*2 - 1;
+
+        for( int y = ystart; y < yend; y++ )
+        {
+            int iy = cvRound(y*invSpace) + GRID_PAD;
+            if( iy < r0 || iy >= r1 )
+                continue;
+
+            const T* sptr = src.ptr<T>(y);
+            float* grow = G + (size_t)iy*rowLen;
+            for( int x = 0; x < src.cols; x++, sptr += CN )
+            {
+                int iz = std::min(std::max(cvRound((guide<T, CN>(sptr) - guideMin)*invColor), 0), zmax);
+                float* cell = grow + xnear[x] + (iz + GRID_PAD)*C1;
+                for( int c = 0; c < CN; c++ )
+                    cell[c] += (float)sptr[c];
+                cell[CN] += 1.f;
+            }
+        }
+    }
+
+    // dst[i] = sum_k w_k*src[i + k*stride], k = -2..2, for i in [0, len)
+    static void blurLine(const float* s, float* d, int len, size_t stride)
+    {
+        const float w1 = 0.60653066f, w2 = 0.13533528f; // exp(-1/2), exp(-2)
+        const float* sm2 = s - stride*2;
+        const float* sm1 = s - stride;
+        const float* sp1 = s + stride;
+        const float* sp2 = s + stride*2;
+        int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int VECSZ = VTraits<v_float32>::vlanes();
+        v_float32 vw1 = vx_setall_f32(w1), vw2 = vx_setall_f32(w2);
+        for( ; i <= len - VECSZ; i += VECSZ )
+        {
+            v_float32 r = v_fma(v_add(vx_load(sm1 + i), vx_load(sp1 + i)), vw1, vx_load(s + i));
+            r = v_fma(v_add(vx_load(sm2 + i), vx_load(sp2 + i)), vw2, r);
+            v_store(d + i, r);
+        }
+#endif
+        for( ; i < len; i++ )
+            d[i] = s[i] + (sm1[i] + sp1[i])*w1 + (sm2[i] + sp2[i])*w2;
+    }
+
+    void blur()
+    {
+        float* G = grid.ptr<float>();
+        float* B = tmp.ptr<float>();
+        size_t zstride = C, xstride = (size_t)gz*C;
+
+        // value and x axes stay within a grid row: grid -> tmp -> grid
+        parallel_for_(Range(0, gy), [&](const Range& range)
+        {
+            for( int r = range.start; r < range.end; r++ )
+            {
+                float* g = G + r*rowLen;
+                float* t = B + r*rowLen;
+                memset(t, 0, zstride*2*sizeof(t[0]));
+                memset(t + rowLen - zstride*2, 0, zstride*2*sizeof(t[0]));
+                blurLine(g + zstride*2, t + zstride*2, (int)(rowLen - zstride*4), zstride);
+                blurLine(t + xstride*2, g + xstride*2, (int)(rowLen - xstride*4), xstride);
+            }
+        });
+
+        // y axis: grid -> tmp
+        parallel_for_(Range(GRID_PAD, gy - GRID_PAD), [&](const Range& range)
+        {
+            for( int r = range.start; r < range.end; r++ )
+                blurLine(G + r*rowLen, B + r*rowLen, (int)rowLen, rowLen);
+        });
+    }
+
+    template<typename T, int CN> void slice(Mat& dst, const Range& rows) const
+    {
+        const int C1 = CN + 1;
+        const float* G = tmp.ptr<float>();
+        size_t zs = C1, xs = (size_t)gz*C1;
+
+        for( int y = rows.start; y < rows.end; y++ )
+        {
+            int iy; float ay;
+            yrow(y, iy, ay);
+            const T* sptr = src.ptr<T>(y);
+            T* dptr = dst.ptr<T>(y);
+            const float* row0 = G + (size_t)iy*rowLen;
+            const float* row1 = row0 + rowLen;
+
+            for( int x = 0; x < src.cols; x++, sptr += CN, dptr += CN )
+            {
+                int iz; float az;
+                zbin(guide<T, CN>(sptr), iz, az);
+                float ax = xalpha[x];
+                float w00 = (1.f - ay)*(1.f - ax), w01 = (1.f - ay)*ax, w10 = ay*(1.f - ax), w11 = ay*ax;
+                size_t ofs = xofs[x] + (size_t)(iz + GRID_PAD)*C1;
+                const float* p00 = row0 + ofs;
+                const float* p01 = p00 + xs;
+                const float* p10 = row1 + ofs;
+                const float* p11 = p10 + xs;
+                float acc[4];
+#if CV_SIMD128
+                if( CN == 1 )
+                {
+                    // (value, weight) of the bins iz and iz + 1 are adjacent
+                    v_float32x4 vz(1.f - az, 1.f - az, az, az);
+                    v_float32x4 a = v_mul(v_load(p00), v_mul(vz, v_setall_f32(w00)));
+                    a = v_fma(v_load(p01), v_mul(vz, v_setall_f32(w01)), a);
+                    a = v_fma(v_load(p10), v_mul(vz, v_setall_f32(w10)), a);
+                    a = v_fma(v_load(p11), v_mul(vz, v_setall_f32(w11)), a);
+                    v_store(acc, a);
+                    acc[0] += acc[2];
+                    acc[1] += acc[3];
+                }
+                else
+                {
+                    v_float32x4 z0 = v_setall_f32(1.f - az), z1 = v_setall_f32(az);
+                    v_float32x4 a = v_add(v_mul(v_load(p00), z0), v_mul(v_load(p00 + zs), z1));
+                    v_float32x4 b = v_add(v_mul(v_load(p01), z0), v_mul(v_load(p01 + zs), z1));
+                    v_float32x4 c = v_add(v_mul(v_load(p10), z0), v_mul(v_load(p10 + zs), z1));
+                    v_float32x4 d = v_add(v_mul(v_load(p11), z0), v_mul(v_load(p11 + zs), z1));
+                    a = v_fma(a, v_setall_f32(w00), v_fma(b, v_setall_f32(w01),
+                        v_fma(c, v_setall_f32(w10), v_mul(d, v_setall_f32(w11)))));
+                    v_store(acc, a);
+                }
+#else
+                for( int c = 0; c < C1; c++ )
+                    acc[c] = ((p00[c]*w00 + p01[c]*w01 + p10[c]*w10 + p11[c]*w11)*(1.f - az) +
+                              (p00[c + zs]*w00 + p01[c + zs]*w01 + p10[c + zs]*w10 + p11[c + zs]*w11)*az);
+#endif
+
+                float scale = 1.f/std::max(acc[CN], FLT_EPSILON);
+                for( int c = 0; c < CN; c++ )
+                    dptr[c] = saturate_cast<T>(acc[c]*scale);
+            }
+        }
+    }
+
+    template<typename T, int CN> void run(Mat& dst)
+    {
+        int nstripes = std::max(1, std::min(getNumThreads()*2, gy/4));
+        parallel_for_(Range(0, nstripes), [&](const Range& range)
+        {
+            for( int i = range.start; i < range.end; i++ )
+                splat<T, CN>(i*gy/nstripes, (i + 1)*gy/nstripes);
+        });
+
+        blur();
+
+        parallel_for_(Range(0, src.rows), [&](const Range& range)
+        {
+            slice<T, CN>(dst, range);
+        });
+    }
+
+    const Mat& src;
+    int cn, C;
+    int gx, gy, gz;
+    size_t rowLen;
+    float guideMin, invSpace, invColor;
+    Mat grid, tmp;
+    std::vector<int> xofs, xnear;
+    std::vector<float> xalpha;
+};
+
+} // namespace
+
+void bilateralGridFilter( InputArray _src, OutputArray _dst, double sigmaColor, double sigmaSpace )
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat();
+    int type = src.type(), depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+    CV_Assert( !src.empty() );
+    CV_Assert( (depth == CV_8U || depth == CV_32F) && (cn == 1 || cn == 3) );
+    CV_Assert( sigmaColor > 0 && sigmaSpace > 0 );
+
+    _dst.create(src.size(), type);
+    Mat dst = _dst.getMat();
+    if( dst.data == src.data )
+        src = src.clone();
+
+    BilateralGrid bg(src, sigmaColor, sigmaSpace);
+    if( depth == CV_8U && cn == 1 )
+        bg.run<uchar, 1>(dst);
+    else if( depth == CV_8U )
+        bg.run<uchar, 3>(dst);
+    else if( cn == 1 )
+        bg.run<float, 1>(dst);
+    else
+        bg.run<float, 3>(dst);
+}
+
+} // namespace cv
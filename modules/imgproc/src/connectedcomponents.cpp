@@ -5767,3 +5767,614 @@ int cv::connectedComponentsWithStats(InputArray img_, OutputArray _labels, Outpu
         return 0;
     }
 }
+
+namespace cv {
+
+namespace connectedcomponents {
+
+// statistics of a component of one tile, in image coordinates
+struct TileNode
+{
+    int left, top, right, bottom, area;
+    int64 sx, sy;
+};
+
+struct TileStatsOp
+{
+    std::vector<TileNode>* nodes;
+    int x0, y0;
+
+    TileStatsOp(std::vector<TileNode>* _nodes, int _x0, int _y0) : nodes(_nodes), x0(_x0), y0(_y0) {}
+
+    void init(int nlabels)
+    {
+        TileNode empty = { INT_MAX, INT_MAX, INT_MIN, INT_MIN, 0, 0, 0 };
+        nodes->assign(nlabels, empty);
+    }
+
+    inline void initElement(const int /*nlabels*/) {}
+
+    inline void operator()(int r, int c, int l)
+    {
+        if( l == 0 )
+            return;
+        TileNode& n = (*nodes)[l];
+        c += x0;
+        r += y0;
+        n.left = std::min(n.left, c);
+        n.right = std::max(n.right, c);
+        n.top = std::min(n.top, r);
+        n.bottom = std::max(n.bottom, r);
+        n.area++;
+        n.sx += c;
+        n.sy += r;
+    }
+
+    void finish() {}
+
+    inline void setNextLoc(const int /*nextLoc*/) {}
+
+    inline static void mergeStats(const cv::Mat& /*imgLabels*/, TileStatsOp* /*sopArray*/, TileStatsOp& /*sop*/, const int& /*nLabels*/) {}
+};
+
+} // namespace connectedcomponents
+
+namespace {
+
+/*
+ Every tile keeps its own labels (local_) and the statistics of its components (nodes). The
+ components of neighbouring tiles that touch each other are listed per border: right, down, and,
+ for 8-connectivity, the down-right and down-left corners. An image component (comps_) is a set of
+ tile components; its label is written to labels_ through the per-tile table gid.
+
+ When tiles change, they are labeled again and their borders are rebuilt. The components that had
+ nodes in them or that touch them through the new borders are dissolved and their nodes, together
+ with the new nodes of the changed tiles, are joined again with a union-find over the border lists.
+*/
+class IncrementalConnectedComponentsImpl CV_FINAL : public IncrementalConnectedComponents
+{
+public:
+    IncrementalConnectedComponentsImpl(int connectivity, int tileSize)
+        : connectivity_(connectivity), tileSize_(tileSize)
+    {
+        CV_Assert( connectivity == 8 || connectivity == 4 );
+        CV_Assert( tileSize >= 2 );
+        clear();
+    }
+
+    void clear() CV_OVERRIDE
+    {
+        size_ = Size();
+        tilesX_ = tilesY_ = 0;
+        tiles_.clear();
+        comps_.assign(1, Component());
+        freeLabels_.clear();
+        local_.release();
+        labels_.release();
+        fgArea_ = fgSx_ = fgSy_ = 0;
+    }
+
+    int apply(InputArray _image, InputArray _changeMask) CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        Mat img = _image.getMat();
+        CV_Assert( img.type() == CV_8UC1 && !img.empty() );
+        if( img.size() != size_ )
+            return restart(img);
+
+        int ntiles = (int)tiles_.size();
+        std::vector<uchar> dirty(ntiles, 0);
+        if( !_changeMask.empty() )
+        {
+            Mat mask = _changeMask.getMat();
+            CV_Assert( mask.type() == CV_8UC1 && mask.size() == size_ );
+            parallel_for_(Range(0, ntiles), [&](const Range& range)
+            {
+                for( int t = range.start; t < range.end; t++ )
+                    dirty[t] = hasNonZero(mask(tiles_[t].rect));
+            });
+        }
+        else
+        {
+            parallel_for_(Range(0, ntiles), [&](const Range& range)
+            {
+                for( int t = range.start; t < range.end; t++ )
+                    dirty[t] = tileChanged(img, tiles_[t].rect);
+            });
+        }
+        return update(img, dirty);
+    }
+
+    int applyRegions(InputArray _image, const std::vector<Rect>& dirtyRects) CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        Mat img = _image.getMat();
+        CV_Assert( img.type() == CV_8UC1 && !img.empty() );
+        if( img.size() != size_ )
+            return restart(img);
+
+        std::vector<uchar> dirty(tiles_.size(), 0);
+        for( size_t i = 0; i < dirtyRects.size(); i++ )
+        {
+            Rect r = dirtyRects[i] & Rect(Point(), size_);
+            if( r.empty() )
+                continue;
+            for( int ty = r.y/tileSize_; ty <= (r.y + r.height - 1)/tileSize_; ty++ )
+                for( int tx = r.x/tileSize_; tx <= (r.x + r.width - 1)/tileSize_; tx++ )
+                    dirty[ty*tilesX_ + tx] = 1;
+        }
+        return update(img, dirty);
+    }
+
+    void getLabels(OutputArray labels) const CV_OVERRIDE
+    {
+        labels.assign(labels_);
+    }
+
+    void getStats(OutputArray _stats, OutputArray _centroids) const CV_OVERRIDE
+    {
+        int n = (int)comps_.size();
+        _stats.create(n, CC_STAT_MAX, CV_32S);
+        Mat stats = _stats.getMat(), centroids;
+        if( _centroids.needed() )
+        {
+            _centroids.create(n, 2, CV_64F);
+            centroids = _centroids.getMat();
+        }
+
+        for( int l = 0; l < n; l++ )
+        {
+            int* row = stats.ptr<int>(l);
+            double cx = std::numeric_limits<double>::quiet_NaN(), cy = cx;
+            if( l == 0 )
+            {
+                int64 area = (int64)size_.area() - fgArea_;
+                row[CC_STAT_LEFT] = row[CC_STAT_TOP] = area > 0 ? 0 : -1;
+                row[CC_STAT_WIDTH] = area > 0 ? size_.width : 0;
+                row[CC_STAT_HEIGHT] = area > 0 ? size_.height : 0;
+                row[CC_STAT_AREA] = (int)area;
+                if( area > 0 )
+                {
+                    int64 sx = (int64)size_.height*size_.width*(size_.width - 1)/2 - fgSx_;
+                    int64 sy = (int64)size_.width*size_.height*(size_.height - 1)/2 - fgSy_;
+                    cx = (double)sx/area;
+                    cy = (double)sy/area;
+                }
+            }
+            else
+            {
+                const Component& c = comps_[l];
+                row[CC_STAT_LEFT] = c.area > 0 ? c.left : -1;
+                row[CC_STAT_TOP] = c.area > 0 ? c.top : -1;
+                row[CC_STAT_WIDTH] = c.area > 0 ? c.right - c.left + 1 : 0;
+                row[CC_STAT_HEIGHT] = c.area > 0 ? c.bottom - c.top + 1 : 0;
+                row[CC_STAT_AREA] = c.area;
+                if( c.area > 0 )
+                {
+                    cx = (double)c.sx/c.area;
+                    cy = (double)c.sy/c.area;
+                }
+            }
+            if( !centroids.empty() )
+            {
+                centroids.at<double>(l, 0) = cx;
+                centroids.at<double>(l, 1) = cy;
+            }
+        }
+    }
+
+    int getConnectivity() const CV_OVERRIDE { return connectivity_; }
+    int getTileSize() const CV_OVERRIDE { return tileSize_; }
+
+protected:
+    struct Tile
+    {
+        Rect rect;
+        std::vector<connectedcomponents::TileNode> nodes; // indexed by the tile label, 0 is the background
+        std::vector<int> gid;                             // image label of every tile label
+        std::vector<Vec2i> edges[4];                      // (tile label, neighbour tile label) pairs
+        std::vector<int> ufIndex;                         // scratch: union-find index or -1
+    };
+
+    struct Component
+    {
+        Component() : left(INT_MAX), top(INT_MAX), right(INT_MIN), bottom(INT_MIN), area(0), sx(0), sy(0) {}
+
+        int left, top, right, bottom, area;
+        int64 sx, sy;
+        std::vector<Vec2i> members; // (tile index, tile label)
+    };
+
+    int restart(const Mat& img)
+    {
+        clear();
+        size_ = img.size();
+        tilesX_ = (size_.width + tileSize_ - 1)/tileSize_;
+        tilesY_ = (size_.height + tileSize_ - 1)/tileSize_;
+        tiles_.resize((size_t)tilesX_*tilesY_);
+        for( int ty = 0; ty < tilesY_; ty++ )
+            for( int tx = 0; tx < tilesX_; tx++ )
+                tiles_[ty*tilesX_ + tx].rect = Rect(tx*tileSize_, ty*tileSize_, tileSize_, tileSize_) & Rect(Point(), size_);
+        local_.create(size_, CV_32S);
+        labels_.create(size_, CV_32S);
+        labels_.setTo(Scalar::all(0));
+        return update(img, std::vector<uchar>(tiles_.size(), 1));
+    }
+
+    // neighbour of tile t across border k, or -1
+    int neighbour(int t, int k) const
+    {
+        static const int dx[] = { 1, 0, 1, -1 }, dy[] = { 0, 1, 1, 1 };
+        if( k >= 2 && connectivity_ == 4 )
+            return -1;
+        int tx = t % tilesX_ + dx[k], ty = t / tilesX_ + dy[k];
+        return (unsigned)tx < (unsigned)tilesX_ && (unsigned)ty < (unsigned)tilesY_ ? ty*tilesX_ + tx : -1;
+    }
+
+    bool tileChanged(const Mat& img, const Rect& r) const
+    {
+        for( int y = r.y; y < r.y + r.height; y++ )
+        {
+            const uchar* sptr = img.ptr(y);
+            const int* lptr = local_.ptr<int>(y);
+            for( int x = r.x; x < r.x + r.width; x++ )
+                if( (sptr[x] != 0) != (lptr[x] != 0) )
+                    return true;
+        }
+        return false;
+    }
+
+    void labelTile(const Mat& img, Tile& tile)
+    {
+        Mat src = img(tile.rect), dst = local_(tile.rect);
+        connectedcomponents::TileStatsOp sop(&tile.nodes, tile.rect.x, tile.rect.y);
+        if( connectivity_ == 8 )
+            connectedcomponents::LabelingBolelli<int, uchar, connectedcomponents::TileStatsOp>()(src, dst, 8, sop);
+        else
+            connectedcomponents::LabelingBolelli4C<int, uchar, connectedcomponents::TileStatsOp>()(src, dst, 4, sop);
+        tile.ufIndex.assign(tile.nodes.size(), -1);
+
+        // until the components are joined, gid holds the smallest previous label under each node
+        std::vector<int>& gid = tile.gid;
+        gid.assign(tile.nodes.size(), INT_MAX);
+        gid[0] = 0;
+        const Rect& r = tile.rect;
+        for( int y = r.y; y < r.y + r.height; y++ )
+        {
+            const int* lptr = local_.ptr<int>(y);
+            const int* prev = labels_.ptr<int>(y);
+            for( int x = r.x; x < r.x + r.width; x++ )
+                if( lptr[x] > 0 && prev[x] > 0 && prev[x] < gid[lptr[x]] )
+                    gid[lptr[x]] = prev[x];
+        }
+        for( size_t l = 1; l < gid.size(); l++ )
+            if( gid[l] == INT_MAX )
+                gid[l] = 0;
+    }
+
+    void buildBorder(int t, int k)
+    {
+        std::vector<Vec2i>& edges = tiles_[t].edges[k];
+        edges.clear();
+        int u = neighbour(t, k);
+        if( u < 0 )
+            return;
+
+        const Rect& a = tiles_[t].rect;
+        const Rect& b = tiles_[u].rect;
+        int d = connectivity_ == 8 ? 1 : 0;
+        if( k == 0 )
+        {
+            int xa = a.x + a.width - 1, xb = b.x;
+            for( int y = a.y; y < a.y + a.height; y++ )
+            {
+                int la = local_.at<int>(y, xa);
+                if( la == 0 )
+                    continue;
+                for( int yb = std::max(y - d, a.y); yb <= std::min(y + d, a.y + a.height - 1); yb++ )
+                {
+                    int lb = local_.at<int>(yb, xb);
+                    if( lb != 0 )
+                        edges.push_back(Vec2i(la, lb));
+                }
+            }
+        }
+        else if( k == 1 )
+        {
+            const int* ra = local_.ptr<int>(a.y + a.height - 1);
+            const int* rb = local_.ptr<int>(b.y);
+            for( int x = a.x; x < a.x + a.width; x++ )
+            {
+                if( ra[x] == 0 )
+                    continue;
+                for( int xb = std::max(x - d, a.x); xb <= std::min(x + d, a.x + a.width - 1); xb++ )
+                    if( rb[xb] != 0 )
+                        edges.push_back(Vec2i(ra[x], rb[xb]));
+            }
+        }
+        else
+        {
+            int la = local_.at<int>(a.y + a.height - 1, k == 2 ? a.x + a.width - 1 : a.x);
+            int lb = local_.at<int>(b.y, k == 2 ? b.x : b.x + b.width - 1);
+            if( la != 0 && lb != 0 )
+                edges.push_back(Vec2i(la, lb));
+        }
+
+        std::sort(edges.begin(), edges.end(), [](const Vec2i& p, const Vec2i& q)
+                  { return p[0] < q[0] || (p[0] == q[0] && p[1] < q[1]); });
+        edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+    }
+
+    static int findRoot(std::vector<int>& parent, int i)
+    {
+        while( parent[i] != i )
+        {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    int update(const Mat& img, const std::vector<uchar>& dirty)
+    {
+        int ntiles = (int)tiles_.size();
+        std::vector<int> dirtyTiles;
+        for( int t = 0; t < ntiles; t++ )
+            if( dirty[t] )
+                dirtyTiles.push_back(t);
+        if( dirtyTiles.empty() )
+            return (int)comps_.size();
+
+        // the components that lose the nodes of the changed tiles
+        std::vector<uchar> affected(comps_.size(), 0);
+        std::vector<int> affectedList;
+        for( int t : dirtyTiles )
+            for( int g : tiles_[t].gid )
+                if( g > 0 && !affected[g] )
+                {
+                    affected[g] = 1;
+                    affectedList.push_back(g);
+                }
+
+        parallel_for_(Range(0, (int)dirtyTiles.size()), [&](const Range& range)
+        {
+            for( int i = range.start; i < range.end; i++ )
+                labelTile(img, tiles_[dirtyTiles[i]]);
+        });
+
+        // borders of the changed tiles
+        std::vector<uchar> borderMark((size_t)ntiles*4, 0);
+        std::vector<int> borders;
+        for( int t : dirtyTiles )
+        {
+            int tx = t % tilesX_, ty = t / tilesX_;
+            const int owners[][3] = { { tx, ty, 0 }, { tx, ty, 1 }, { tx, ty, 2 }, { tx, ty, 3 },
+                                      { tx - 1, ty, 0 }, { tx, ty - 1, 1 }, { tx - 1, ty - 1, 2 }, { tx + 1, ty - 1, 3 } };
+            for( int j = 0; j < 8; j++ )
+            {
+                int ox = owners[j][0], oy = owners[j][1], k = owners[j][2];
+                if( (unsigned)ox >= (unsigned)tilesX_ || (unsigned)oy >= (unsigned)tilesY_ )
+                    continue;
+                int b = (oy*tilesX_ + ox)*4 + k;
+                if( !borderMark[b] && neighbour(b/4, k) >= 0 )
+                {
+                    borderMark[b] = 1;
+                    borders.push_back(b);
+                }
+            }
+        }
+        parallel_for_(Range(0, (int)borders.size()), [&](const Range& range)
+        {
+            for( int i = range.start; i < range.end; i++ )
+                buildBorder(borders[i]/4, borders[i] % 4);
+        });
+
+        // unchanged components that touch the changed tiles
+        for( int b : borders )
+        {
+            int t = b/4, k = b % 4, u = neighbour(t, k);
+            for( const Vec2i& e : tiles_[t].edges[k] )
+            {
+                int ga = tiles_[t].gid[e[0]], gb = tiles_[u].gid[e[1]];
+                if( ga > 0 && !affected[ga] )
+                {
+                    affected[ga] = 1;
+                    affectedList.push_back(ga);
+                }
+                if( gb > 0 && !affected[gb] )
+                {
+                    affected[gb] = 1;
+                    affectedList.push_back(gb);
+                }
+            }
+        }
+
+        // the nodes to join again
+        std::vector<Vec2i> nodes;
+        for( int g : affectedList )
+        {
+            Component& c = comps_[g];
+            for( const Vec2i& m : c.members )
+                if( !dirty[m[0]] )
+                    nodes.push_back(m);
+            fgArea_ -= c.area;
+            fgSx_ -= c.sx;
+            fgSy_ -= c.sy;
+        }
+        for( int t : dirtyTiles )
+            for( int l = 1; l < (int)tiles_[t].nodes.size(); l++ )
+                nodes.push_back(Vec2i(t, l));
+
+        int nnodes = (int)nodes.size();
+        std::vector<uchar> touched(ntiles, 0);
+        std::vector<int> touchedTiles;
+        for( int i = 0; i < nnodes; i++ )
+        {
+            int t = nodes[i][0];
+            tiles_[t].ufIndex[nodes[i][1]] = i;
+            if( !touched[t] )
+            {
+                touched[t] = 1;
+                touchedTiles.push_back(t);
+            }
+        }
+
+        std::vector<int> parent(nnodes);
+        for( int i = 0; i < nnodes; i++ )
+            parent[i] = i;
+        for( int t : touchedTiles )
+            for( int k = 0; k < 4; k++ )
+            {
+                int u = neighbour(t, k);
+                if( u < 0 || !touched[u] )
+                    continue;
+                for( const Vec2i& e : tiles_[t].edges[k] )
+                {
+                    int a = tiles_[t].ufIndex[e[0]], b = tiles_[u].ufIndex[e[1]];
+                    if( a < 0 || b < 0 )
+                        continue;
+                    a = findRoot(parent, a);
+                    b = findRoot(parent, b);
+                    if( a != b )
+                        parent[std::max(a, b)] = std::min(a, b);
+                }
+            }
+
+        // new components
+        std::vector<int> groupOf(nnodes, -1);
+        std::vector<Component> groups;
+        std::vector<std::vector<int> > oldLabels;
+        for( int i = 0; i < nnodes; i++ )
+        {
+            int r = findRoot(parent, i);
+            if( groupOf[r] < 0 )
+            {
+                groupOf[r] = (int)groups.size();
+                groups.push_back(Component());
+                oldLabels.push_back(std::vector<int>());
+            }
+            int gi = groupOf[r];
+            Component& c = groups[gi];
+            const Tile& tile = tiles_[nodes[i][0]];
+            const connectedcomponents::TileNode& n = tile.nodes[nodes[i][1]];
+            c.left = std::min(c.left, n.left);
+            c.top = std::min(c.top, n.top);
+            c.right = std::max(c.right, n.right);
+            c.bottom = std::max(c.bottom, n.bottom);
+            c.area += n.area;
+            c.sx += n.sx;
+            c.sy += n.sy;
+            c.members.push_back(nodes[i]);
+            int g = tile.gid[nodes[i][1]];
+            if( g > 0 )
+                oldLabels[gi].push_back(g);
+        }
+
+        // a group keeps the smallest free label of its old components, larger groups choose first
+        int ngroups = (int)groups.size();
+        std::vector<int> order(ngroups), newLabel(ngroups, 0);
+        for( int i = 0; i < ngroups; i++ )
+            order[i] = i;
+        std::sort(order.begin(), order.end(), [&](int a, int b)
+                  { return groups[a].area > groups[b].area || (groups[a].area == groups[b].area && a < b); });
+        for( int gi : order )
+        {
+            std::vector<int>& ol = oldLabels[gi];
+            std::sort(ol.begin(), ol.end());
+            for( int g : ol )
+                if( affected[g] == 1 )
+                {
+                    affected[g] = 2;
+                    newLabel[gi] = g;
+                    break;
+                }
+        }
+        std::vector<int> released;
+        for( int g : affectedList )
+            if( affected[g] == 1 )
+            {
+                comps_[g] = Component();
+                released.push_back(g);
+            }
+        for( int gi : order )
+            if( newLabel[gi] == 0 )
+            {
+                if( !freeLabels_.empty() )
+                {
+                    newLabel[gi] = freeLabels_.back();
+                    freeLabels_.pop_back();
+                }
+                else
+                {
+                    newLabel[gi] = (int)comps_.size();
+                    comps_.push_back(Component());
+                }
+            }
+        freeLabels_.insert(freeLabels_.end(), released.rbegin(), released.rend());
+
+        // labels of the nodes and of the pixels
+        std::vector<uchar> repaint(dirty);
+        for( int gi = 0; gi < ngroups; gi++ )
+        {
+            int g = newLabel[gi];
+            Component& c = groups[gi];
+            for( const Vec2i& m : c.members )
+            {
+                Tile& tile = tiles_[m[0]];
+                if( tile.gid[m[1]] != g )
+                {
+                    tile.gid[m[1]] = g;
+                    repaint[m[0]] = 1;
+                }
+                tile.ufIndex[m[1]] = -1;
+            }
+            fgArea_ += c.area;
+            fgSx_ += c.sx;
+            fgSy_ += c.sy;
+            std::swap(comps_[g], c);
+        }
+
+        std::vector<int> repaintTiles;
+        for( int t = 0; t < ntiles; t++ )
+            if( repaint[t] )
+                repaintTiles.push_back(t);
+        parallel_for_(Range(0, (int)repaintTiles.size()), [&](const Range& range)
+        {
+            for( int i = range.start; i < range.end; i++ )
+            {
+                const Tile& tile = tiles_[repaintTiles[i]];
+                const Rect& r = tile.rect;
+                const int* gid = tile.gid.data();
+                for( int y = r.y; y < r.y + r.height; y++ )
+                {
+                    const int* lptr = local_.ptr<int>(y);
+                    int* dptr = labels_.ptr<int>(y);
+                    for( int x = r.x; x < r.x + r.width; x++ )
+                        dptr[x] = gid[lptr[x]];
+                }
+            }
+        });
+
+        return (int)comps_.size();
+    }
+
+    int connectivity_, tileSize_;
+    Size size_;
+    int tilesX_, tilesY_;
+    Mat local_, labels_;
+    std::vector<Tile> tiles_;
+    std::vector<Component> comps_;   // indexed by the label, 0 is the background
+    std::vector<int> freeLabels_;
+    int64 fgArea_, fgSx_, fgSy_;
+};
+
+} // namespace
+
+Ptr<IncrementalConnectedComponents> createIncrementalConnectedComponents(int connectivity, int tileSize)
+{
+    return makePtr<IncrementalConnectedComponentsImpl>(connectivity, tileSize);
+}
+
+} // namespace cv
@@ -0,0 +1,336 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+
+namespace {
+
+enum { NUM_MOMENTS = 10 };
+
+// the sums of contourMoments() over the edges (x[k], y[k]) -> (x[k+1], y[k+1]), k in [k0, k1)
+static void accumulateMoments( const double* x, const double* y, int k0, int k1, double* a )
+{
+    for( int k = k0; k < k1; k++ )
+    {
+        double xi_1 = x[k], yi_1 = y[k], xi = x[k+1], yi = y[k+1];
+        double xi2 = xi * xi, yi2 = yi * yi, xi_12 = xi_1 * xi_1, yi_12 = yi_1 * yi_1;
+        double dxy = xi_1 * yi - xi * yi_1;
+        double xii_1 = xi_1 + xi, yii_1 = yi_1 + yi;
+
+        a[0] += dxy;
+        a[1] += dxy * xii_1;
+        a[2] += dxy * yii_1;
+        a[3] += dxy * (xi_1 * xii_1 + xi2);
+        a[4] += dxy * (xi_1 * (yii_1 + yi_1) + xi * (yii_1 + yi));
+        a[5] += dxy * (yi_1 * yii_1 + yi2);
+        a[6] += dxy * xii_1 * (xi_12 + xi2);
+        a[7] += dxy * (xi_12 * (3 * yi_1 + yi) + 2 * xi * xi_1 * yii_1 + xi2 * (yi_1 + 3 * yi));
+        a[8] += dxy * (yi_12 * (3 * xi_1 + xi) + 2 * yi * yi_1 * xii_1 + yi2 * (xi_1 + 3 * xi));
+        a[9] += dxy * yii_1 * (yi_12 + yi2);
+    }
+}
+
+// the points of a contour as float and double, with the closing point in front
+struct ContourBuffers
+{
+    std::vector<float> fx, fy, len;
+    std::vector<double> dx, dy;
+};
+
+struct ContourDescriptorsBody
+{
+    const std::vector<Mat>& contours;
+    double *areas, *lengths, *moments;
+    int *rects;
+    float *minRects;
+    int ncontours;
+    bool closed;
+
+    void operator()( const Range& range ) const
+    {
+        ContourBuffers buf;
+        for( int i = range.start; i < range.end; i++ )
+            process(i, buf);
+    }
+
+    static void load( const Mat& c, int n, Rect& bbox, ContourBuffers& buf )
+    {
+        std::vector<float>& fx = buf.fx;
+        std::vector<float>& fy = buf.fy;
+        std::vector<double>& dx = buf.dx;
+        std::vector<double>& dy = buf.dy;
+        std::vector<float>& len = buf.len;
+        fx.resize(n + 1); fy.resize(n + 1);
+        dx.resize(n + 1); dy.resize(n + 1);
+        len.resize(n + 1);
+        bool isFloat = c.depth() == CV_32F;
+        int k = 0;
+
+        if( !isFloat )
+        {
+            const int* p = c.ptr<int>();
+            int xmin = p[0], xmax = p[0], ymin = p[1], ymax = p[1];
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            const int VECSZ = VTraits<v_int32>::vlanes();
+            v_int32 vxmin = vx_setall_s32(xmin), vxmax = vxmin, vymin = vx_setall_s32(ymin), vymax = vymin;
+            for( ; k <= n - VECSZ; k += VECSZ )
+            {
+                v_int32 x, y;
+                v_load_deinterleave(p + k*2, x, y);
+                vxmin = v_min(vxmin, x); vxmax = v_max(vxmax, x);
+                vymin = v_min(vymin, y); vymax = v_max(vymax, y);
+                v_store(&fx[k + 1], v_cvt_f32(x));
+                v_store(&fy[k + 1], v_cvt_f32(y));
+            }
+            xmin = v_reduce_min(vxmin); xmax = v_reduce_max(vxmax);
+            ymin = v_reduce_min(vymin); ymax = v_reduce_max(vymax);
+#endif
+            for( ; k < n; k++ )
+            {
+                int x = p[k*2], y = p[k*2 + 1];
+                xmin = std::min(xmin, x); xmax = std::max(xmax, x);
+                ymin = std::min(ymin, y); ymax = std::max(ymax, y);
+                fx[k + 1] = (float)x;
+                fy[k + 1] = (float)y;
+            }
+            bbox = Rect(xmin, ymin, xmax - xmin + 1, ymax - ymin + 1);
+        }
+        else
+        {
+            const float* p = c.ptr<float>();
+            float xmin = p[0], xmax = p[0], ymin = p[1], ymax = p[1];
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            const int VECSZ = VTraits<v_float32>::vlanes();
+            v_float32 vxmin = vx_setall_f32(xmin), vxmax = vxmin, vymin = vx_setall_f32(ymin), vymax = vymin;
+            for( ; k <= n - VECSZ; k += VECSZ )
+            {
+                v_float32 x, y;
+                v_load_deinterleave(p + k*2, x, y);
+                vxmin = v_min(vxmin, x); vxmax = v_max(vxmax, x);
+                vymin = v_min(vymin, y); vymax = v_max(vymax, y);
+                v_store(&fx[k + 1], x);
+                v_store(&fy[k + 1], y);
+            }
+            xmin = v_reduce_min(vxmin); xmax = v_reduce_max(vxmax);
+            ymin = v_reduce_min(vymin); ymax = v_reduce_max(vymax);
+#endif
+            for( ; k < n; k++ )
+            {
+                float x = p[k*2], y = p[k*2 + 1];
+                xmin = std::min(xmin, x); xmax = std::max(xmax, x);
+                ymin = std::min(ymin, y); ymax = std::max(ymax, y);
+                fx[k + 1] = x;
+                fy[k + 1] = y;
+            }
+            // the right and bottom sides are not inclusive, see boundingRect
+            int x0 = cvFloor(xmin), y0 = cvFloor(ymin);
+            bbox = Rect(x0, y0, cvFloor(xmax) - x0 + 1, cvFloor(ymax) - y0 + 1);
+        }
+
+        fx[0] = fx[n];
+        fy[0] = fy[n];
+        for( k = 0; k <= n; k++ )
+        {
+            dx[k] = fx[k];
+            dy[k] = fy[k];
+        }
+    }
+
+    void process( int i, ContourBuffers& buf ) const
+    {
+        const Mat& c = contours[i];
+        int n = c.empty() ? 0 : c.checkVector(2);
+        CV_Assert( n >= 0 && (n == 0 || c.depth() == CV_32S || c.depth() == CV_32F) );
+
+        Rect bbox;
+        double a[NUM_MOMENTS] = {};
+        double perimeter = 0;
+
+        if( n > 0 )
+        {
+            load(c, n, bbox, buf);
+            const std::vector<float>& fx = buf.fx;
+            const std::vector<float>& fy = buf.fy;
+            const std::vector<double>& dx = buf.dx;
+            const std::vector<double>& dy = buf.dy;
+            std::vector<float>& len = buf.len;
+
+            // edge lengths in float, as in arcLength
+            if( lengths && n > 1 )
+            {
+                int k = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+                const int VECSZ = VTraits<v_float32>::vlanes();
+                for( ; k <= n - VECSZ; k += VECSZ )
+                {
+                    v_float32 ex = v_sub(vx_load(&fx[k + 1]), vx_load(&fx[k]));
+                    v_float32 ey = v_sub(vx_load(&fy[k + 1]), vx_load(&fy[k]));
+                    v_store(&len[k], v_sqrt(v_add(v_mul(ex, ex), v_mul(ey, ey))));
+                }
+#endif
+                for( ; k < n; k++ )
+                {
+                    float ex = fx[k + 1] - fx[k], ey = fy[k + 1] - fy[k];
+                    len[k] = std::sqrt(ex*ex + ey*ey);
+                }
+                // an open curve has no closing edge
+                for( k = closed ? 0 : 1; k < n; k++ )
+                    perimeter += len[k];
+            }
+
+            if( moments )
+            {
+                int k = 0;
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+                const int VECSZ = VTraits<v_float64>::vlanes();
+                v_float64 s[NUM_MOMENTS];
+                for( int j = 0; j < NUM_MOMENTS; j++ )
+                    s[j] = vx_setzero_f64();
+                v_float64 v2 = vx_setall_f64(2.), v3 = vx_setall_f64(3.);
+                for( ; k <= n - VECSZ; k += VECSZ )
+                {
+                    v_float64 xi_1 = vx_load(&dx[k]), yi_1 = vx_load(&dy[k]);
+                    v_float64 xi = vx_load(&dx[k + 1]), yi = vx_load(&dy[k + 1]);
+                    v_float64 xi2 = v_mul(xi, xi), yi2 = v_mul(yi, yi);
+                    v_float64 xi_12 = v_mul(xi_1, xi_1), yi_12 = v_mul(yi_1, yi_1);
+                    v_float64 dxy = v_sub(v_mul(xi_1, yi), v_mul(xi, yi_1));
+                    v_float64 xii_1 = v_add(xi_1, xi), yii_1 = v_add(yi_1, yi);
+
+                    s[0] = v_add(s[0], dxy);
+                    s[1] = v_add(s[1], v_mul(dxy, xii_1));
+                    s[2] = v_add(s[2], v_mul(dxy, yii_1));
+                    s[3] = v_add(s[3], v_mul(dxy, v_add(v_mul(xi_1, xii_1), xi2)));
+                    s[4] = v_add(s[4], v_mul(dxy, v_add(v_mul(xi_1, v_add(yii_1, yi_1)), v_mul(xi, v_add(yii_1, yi)))));
+                    s[5] = v_add(s[5], v_mul(dxy, v_add(v_mul(yi_1, yii_1), yi2)));
+                    s[6] = v_add(s[6], v_mul(v_mul(dxy, xii_1), v_add(xi_12, xi2)));
+                    s[7] = v_add(s[7], v_mul(dxy, v_add(v_add(v_mul(xi_12, v_add(v_mul(v3, yi_1), yi)),
+                                                              v_mul(v_mul(v_mul(v2, xi), xi_1), yii_1)),
+                                                        v_mul(xi2, v_add(yi_1, v_mul(v3, yi))))));
+                    s[8] = v_add(s[8], v_mul(dxy, v_add(v_add(v_mul(yi_12, v_add(v_mul(v3, xi_1), xi)),
+                                                              v_mul(v_mul(v_mul(v2, yi), yi_1), xii_1)),
+                                                        v_mul(yi2, v_add(xi_1, v_mul(v3, xi))))));
+                    s[9] = v_add(s[9], v_mul(v_mul(dxy, yii_1), v_add(yi_12, yi2)));
+                }
+                for( int j = 0; j < NUM_MOMENTS; j++ )
+                    a[j] = v_reduce_sum(s[j]);
+#endif
+                accumulateMoments(&dx[0], &dy[0], k, n, a);
+            }
+            else if( areas )
+            {
+                int k = 0;
+#if (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+                const int VECSZ = VTraits<v_float64>::vlanes();
+                v_float64 s = vx_setzero_f64();
+                for( ; k <= n - VECSZ; k += VECSZ )
+                    s = v_add(s, v_sub(v_mul(vx_load(&dx[k]), vx_load(&dy[k + 1])),
+                                       v_mul(vx_load(&dy[k]), vx_load(&dx[k + 1]))));
+                a[0] = v_reduce_sum(s);
+#endif
+                for( ; k < n; k++ )
+                    a[0] += dx[k] * dy[k + 1] - dy[k] * dx[k + 1];
+            }
+        }
+
+        if( areas )
+            areas[i] = std::fabs(a[0] * 0.5);
+        if( lengths )
+            lengths[i] = perimeter;
+        if( rects )
+        {
+            rects[i] = bbox.x;
+            rects[i + ncontours] = bbox.y;
+            rects[i + ncontours*2] = bbox.width;
+            rects[i + ncontours*3] = bbox.height;
+        }
+        if( moments )
+        {
+            // the same scaling as in contourMoments
+            static const double scale[NUM_MOMENTS] = { 1./2, 1./6, 1./6, 1./12, 1./24, 1./12, 1./20, 1./60, 1./60, 1./20 };
+            bool nonzero = std::fabs(a[0]) > FLT_EPSILON;
+            double sign = a[0] > 0 ? 1. : -1.;
+            for( int j = 0; j < NUM_MOMENTS; j++ )
+                moments[i + ncontours*j] = nonzero ? a[j] * (scale[j] * sign) : 0.;
+        }
+        if( minRects && n > 0 )
+        {
+            RotatedRect r = minAreaRect(c);
+            minRects[i] = r.center.x;
+            minRects[i + ncontours] = r.center.y;
+            minRects[i + ncontours*2] = r.size.width;
+            minRects[i + ncontours*3] = r.size.height;
+            minRects[i + ncontours*4] = r.angle;
+        }
+        else if( minRects )
+        {
+            for( int j = 0; j < 5; j++ )
+                minRects[i + ncontours*j] = 0.f;
+        }
+    }
+};
+
+} // namespace
+
+void contourDescriptors( InputArrayOfArrays _contours, OutputArray _areas, OutputArray _arcLengths,
+                         OutputArray _boundingRects, OutputArray _moments, OutputArray _minAreaRects,
+                         bool closed )
+{
+    CV_INSTRUMENT_REGION();
+
+    bool manyContours = _contours.kind() == _InputArray::STD_VECTOR_VECTOR ||
+                        _contours.kind() == _InputArray::STD_VECTOR_MAT;
+    int ncontours = _contours.empty() ? 0 : manyContours ? (int)_contours.total() : 1;
+
+    std::vector<Mat> contours(ncontours);
+    double totalPoints = 0;
+    for( int i = 0; i < ncontours; i++ )
+    {
+        contours[i] = _contours.getMat(manyContours ? i : -1);
+        totalPoints += (double)contours[i].total();
+    }
+
+    Mat areas, lengths, rects, moments, minRects;
+    if( _areas.needed() )
+    {
+        _areas.create(1, ncontours, CV_64F);
+        areas = _areas.getMat();
+    }
+    if( _arcLengths.needed() )
+    {
+        _arcLengths.create(1, ncontours, CV_64F);
+        lengths = _arcLengths.getMat();
+    }
+    if( _boundingRects.needed() )
+    {
+        _boundingRects.create(4, ncontours, CV_32S);
+        rects = _boundingRects.getMat();
+    }
+    if( _moments.needed() )
+    {
+        _moments.create(NUM_MOMENTS, ncontours, CV_64F);
+        moments = _moments.getMat();
+    }
+    if( _minAreaRects.needed() )
+    {
+        _minAreaRects.create(5, ncontours, CV_32F);
+        minRects = _minAreaRects.getMat();
+    }
+    if( ncontours == 0 )
+        return;
+    CV_Assert( (rects.empty() || rects.isContinuous()) && (moments.empty() || moments.isContinuous()) &&
+               (minRects.empty() || minRects.isContinuous()) );
+
+    ContourDescriptorsBody body = { contours,
+        areas.empty() ? 0 : areas.ptr<double>(), lengths.empty() ? 0 : lengths.ptr<double>(),
+        moments.empty() ? 0 : moments.ptr<double>(), rects.empty() ? 0 : rects.ptr<int>(),
+        minRects.empty() ? 0 : minRects.ptr<float>(), ncontours, closed };
+
+    double nstripes = std::max(1., std::min((double)ncontours, totalPoints / (1 << 12)));
+    parallel_for_(Range(0, ncontours), body, nstripes);
+}
+
+} // namespace cv
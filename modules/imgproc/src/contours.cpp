@@ -1813,6 +1813,462 @@ cvFindContours( void*  img,  CvMemStorage*  storage,
     return cvFindContours_Impl(img, storage, firstContour, cntHeaderSize, mode, method, offset, 1);
 }
 
+/*
+   Parallel border following for 8-bit images in RETR_EXTERNAL, RETR_LIST, RETR_CCOMP and RETR_TREE modes.
+
+   Every border found by the raster scan separates an 8-connected component of non-zero pixels
+   from a 4-connected component of zero pixels. The border is found at the first pixel (in the raster
+   order) of the component (outer border) or of the hole (hole border), and its parent is the hole
+   enclosing the component or the component surrounding the hole. So the image is split into horizontal
+   bands, the runs of non-zero and zero pixels are labeled in every band in parallel, the labels are
+   stitched across the band seams and then all the borders are followed independently.
+   Contours, their order and the hierarchy are the same as the ones of the serial scan.
+*/
+namespace {
+
+struct ContourBand
+{
+    int y0, y1;                 // rows of the bordered image
+    std::vector<int> rowOfs;    // index of the first non-zero run of every row, y1 - y0 + 1 values
+    std::vector<cv::Vec2i> runs;// [x0, x1) of the non-zero runs
+    std::vector<int> fgLink;    // union-find links of the non-zero runs (local indices)
+    std::vector<int> bgLink;    // union-find links of the zero runs, every row has one zero run more
+    int fgOfs, bgOfs;           // global index of the first run of the band
+    std::vector<int> fgRoots, bgRoots;
+};
+
+struct ContourStart
+{
+    cv::Point pt;   // starting pixel of the border following
+    int fgRoot;     // component of non-zero pixels
+    int bgRoot;     // component of zero pixels
+    int isHole;
+};
+
+// union-find over the run indices, the root is always the first run of the component in the raster order
+static inline int findRunRoot( std::vector<int>& link, int i )
+{
+    int r = i;
+    while( link[r] != r )
+        r = link[r];
+    while( link[i] != r )
+    {
+        int next = link[i];
+        link[i] = r;
+        i = next;
+    }
+    return r;
+}
+
+static inline void uniteRuns( std::vector<int>& link, int a, int b )
+{
+    a = findRunRoot( link, a );
+    b = findRunRoot( link, b );
+    if( a < b )
+        link[b] = a;
+    else if( b < a )
+        link[a] = b;
+}
+
+// i-th zero run of the row with n non-zero runs
+static inline cv::Vec2i getZeroRun( const cv::Vec2i* runs, int n, int i, int width )
+{
+    return cv::Vec2i( i == 0 ? 0 : runs[i - 1][1], i == n ? width : runs[i][0] );
+}
+
+// unites the overlapping runs of two neighbor rows,
+// non-zero runs touching by a corner are connected as well
+static void connectRuns( const ContourBand& bandA, int rowA, const ContourBand& bandB, int rowB,
+                         bool global, int width, std::vector<int>& fgLink, std::vector<int>& bgLink )
+{
+    const cv::Vec2i* a = bandA.runs.data() + bandA.rowOfs[rowA];
+    const cv::Vec2i* b = bandB.runs.data() + bandB.rowOfs[rowB];
+    int na = bandA.rowOfs[rowA + 1] - bandA.rowOfs[rowA];
+    int nb = bandB.rowOfs[rowB + 1] - bandB.rowOfs[rowB];
+    int fgA = bandA.rowOfs[rowA] + (global ? bandA.fgOfs : 0);
+    int fgB = bandB.rowOfs[rowB] + (global ? bandB.fgOfs : 0);
+    int bgA = bandA.rowOfs[rowA] + rowA + (global ? bandA.bgOfs : 0);
+    int bgB = bandB.rowOfs[rowB] + rowB + (global ? bandB.bgOfs : 0);
+
+    for( int i = 0, j = 0; i < na && j < nb; )
+    {
+        if( a[i][0] <= b[j][1] && b[j][0] <= a[i][1] )
+            uniteRuns( fgLink, fgA + i, fgB + j );
+        if( a[i][1] < b[j][1] )
+            i++;
+        else
+            j++;
+    }
+
+    for( int i = 0, j = 0; i <= na && j <= nb; )
+    {
+        cv::Vec2i za = getZeroRun( a, na, i, width ), zb = getZeroRun( b, nb, j, width );
+        if( za[0] < zb[1] && zb[0] < za[1] )
+            uniteRuns( bgLink, bgA + i, bgB + j );
+        if( za[1] < zb[1] )
+            i++;
+        else
+            j++;
+    }
+}
+
+// the same as icvFetchContour, but the image is not modified
+static void followBorder( const uchar* ptr, int step, cv::Point pt, int isHole, int method,
+                          std::vector<cv::Point>& points, std::vector<schar>& codes )
+{
+    int deltas[MAX_SIZE];
+    const uchar *i0 = ptr, *i1, *i3, *i4 = 0;
+    int prev_s = -1, s, s_end;
+
+    CV_INIT_3X3_DELTAS( deltas, step, 1 );
+    memcpy( deltas + 8, deltas, 8 * sizeof( deltas[0] ));
+
+    s_end = s = isHole ? 0 : 4;
+
+    do
+    {
+        s = (s - 1) & 7;
+        i1 = i0 + deltas[s];
+    }
+    while( *i1 == 0 && s != s_end );
+
+    if( s == s_end )            /* single pixel domain */
+    {
+        if( method != CV_CHAIN_CODE )
+            points.push_back( pt );
+        return;
+    }
+
+    i3 = i0;
+    prev_s = s ^ 4;
+
+    /* follow border */
+    for( ;; )
+    {
+        s_end = s;
+        s = std::min(s, MAX_SIZE - 1);
+
+        while( s < MAX_SIZE - 1 )
+        {
+            i4 = i3 + deltas[++s];
+            if( *i4 != 0 )
+                break;
+        }
+        s &= 7;
+
+        if( method == CV_CHAIN_CODE )
+            codes.push_back( (schar)s );
+        else
+        {
+            if( s != prev_s || method == CV_CHAIN_APPROX_NONE )
+            {
+                points.push_back( pt );
+                prev_s = s;
+            }
+
+            pt.x += icvCodeDeltas[s].x;
+            pt.y += icvCodeDeltas[s].y;
+        }
+
+        if( i4 == i0 && i3 == i1 )
+            break;
+
+        i3 = i4;
+        s = (s + 4) & 7;
+    }
+}
+
+static bool useParallelFindContours( const cv::Mat& image, int mode, int method )
+{
+    return image.type() == CV_8UC1 && mode >= CV_RETR_EXTERNAL && mode <= CV_RETR_TREE &&
+           method >= CV_CHAIN_APPROX_NONE && method <= CV_CHAIN_APPROX_TC89_KCOS &&
+           cv::getNumThreads() > 1 && image.total() >= (size_t)(1 << 20) &&
+           (double)(image.rows + 2) * (image.cols + 2) < INT_MAX / 2;
+}
+
+static void findContoursParallel( const cv::Mat& src, cv::OutputArrayOfArrays _contours, cv::OutputArray _hierarchy,
+                                  int mode, int method, cv::Point offset )
+{
+    using namespace cv;
+
+    int width = src.cols + 2, height = src.rows + 2;
+    Mat img( height, width, CV_8UC1 );
+    CvSize size = cvSize( width, height );
+    int step = (int)img.step;
+
+    int nbands = std::max( std::min( height / 32, getNumThreads() * 4 ), 1 );
+    std::vector<ContourBand> bands( nbands );
+    for( int b = 0; b < nbands; b++ )
+    {
+        bands[b].y0 = (int)((int64)height * b / nbands);
+        bands[b].y1 = (int)((int64)height * (b + 1) / nbands);
+    }
+
+    // copy the image with zero border, collect the runs and label them within the bands
+    parallel_for_(Range(0, nbands), [&](const Range& range)
+    {
+        for( int b = range.start; b < range.end; b++ )
+        {
+            ContourBand& band = bands[b];
+            int nrows = band.y1 - band.y0;
+            band.rowOfs.assign( nrows + 1, 0 );
+            for( int y = band.y0; y < band.y1; y++ )
+            {
+                uchar* row = img.ptr<uchar>(y);
+                if( y == 0 || y == height - 1 )
+                    memset( row, 0, width );
+                else
+                {
+                    row[0] = row[width - 1] = 0;
+                    memcpy( row + 1, src.ptr<uchar>(y - 1), width - 2 );
+                }
+
+                for( int x = 1; (x = findStartContourPoint( row, size, x )) < width; )
+                {
+                    int x1 = findEndContourPoint( row, size, x );
+                    band.runs.push_back( Vec2i( x, x1 ) );
+                    x = x1;
+                }
+                band.rowOfs[y - band.y0 + 1] = (int)band.runs.size();
+            }
+
+            int nruns = (int)band.runs.size();
+            band.fgLink.resize( nruns );
+            band.bgLink.resize( nruns + nrows );
+            for( int i = 0; i < nruns; i++ )
+                band.fgLink[i] = i;
+            for( int i = 0; i < nruns + nrows; i++ )
+                band.bgLink[i] = i;
+
+            for( int r = 0; r + 1 < nrows; r++ )
+                connectRuns( band, r, band, r + 1, false, width, band.fgLink, band.bgLink );
+        }
+    });
+
+    int totalFg = 0, totalBg = 0;
+    for( int b = 0; b < nbands; b++ )
+    {
+        bands[b].fgOfs = totalFg;
+        bands[b].bgOfs = totalBg;
+        totalFg += (int)bands[b].fgLink.size();
+        totalBg += (int)bands[b].bgLink.size();
+    }
+
+    // links always point backward, so a single pass flattens them
+    std::vector<int> fgLink( totalFg ), bgLink( totalBg );
+    parallel_for_(Range(0, nbands), [&](const Range& range)
+    {
+        for( int b = range.start; b < range.end; b++ )
+        {
+            ContourBand& band = bands[b];
+            for( int k = 0; k < 2; k++ )
+            {
+                std::vector<int>& local = k == 0 ? band.fgLink : band.bgLink;
+                std::vector<int>& roots = k == 0 ? band.fgRoots : band.bgRoots;
+                int* global = (k == 0 ? fgLink.data() + band.fgOfs : bgLink.data() + band.bgOfs);
+                int ofs = k == 0 ? band.fgOfs : band.bgOfs;
+                for( int i = 0; i < (int)local.size(); i++ )
+                {
+                    int l = local[i] = local[local[i]];
+                    if( l == i )
+                        roots.push_back( i + ofs );
+                    global[i] = l + ofs;
+                }
+                std::vector<int>().swap( local );
+            }
+        }
+    });
+
+    // stitch the labels across the band seams
+    for( int b = 1; b < nbands; b++ )
+        connectRuns( bands[b - 1], bands[b - 1].y1 - bands[b - 1].y0 - 1, bands[b], 0, true, width, fgLink, bgLink );
+
+    for( int b = 0; b < nbands; b++ )
+    {
+        for( size_t i = 0; i < bands[b].fgRoots.size(); i++ )
+        {
+            int r = bands[b].fgRoots[i];
+            fgLink[r] = fgLink[fgLink[r]];
+        }
+        for( size_t i = 0; i < bands[b].bgRoots.size(); i++ )
+        {
+            int r = bands[b].bgRoots[i];
+            bgLink[r] = bgLink[bgLink[r]];
+        }
+    }
+
+    // resolve the labels and find the starting points of the borders
+    std::vector<std::vector<ContourStart> > bandStarts( nbands );
+    parallel_for_(Range(0, nbands), [&](const Range& range)
+    {
+        for( int b = range.start; b < range.end; b++ )
+        {
+            ContourBand& band = bands[b];
+            int nrows = band.y1 - band.y0, nruns = (int)band.runs.size();
+            // only the band roots are read by the other bands, and they are final already
+            for( int i = band.fgOfs; i < band.fgOfs + nruns; i++ )
+            {
+                int l = fgLink[i], r = fgLink[l];
+                if( r != l )
+                    fgLink[i] = r;
+            }
+            for( int i = band.bgOfs; i < band.bgOfs + nruns + nrows; i++ )
+            {
+                int l = bgLink[i], r = bgLink[l];
+                if( r != l )
+                    bgLink[i] = r;
+            }
+
+            std::vector<ContourStart>& starts = bandStarts[b];
+            for( int r = 0; r < nrows; r++ )
+            {
+                const Vec2i* runs = band.runs.data() + band.rowOfs[r];
+                int n = band.rowOfs[r + 1] - band.rowOfs[r], y = band.y0 + r;
+                int fg0 = band.fgOfs + band.rowOfs[r], bg0 = band.bgOfs + band.rowOfs[r] + r;
+                for( int k = 0; k <= n; k++ )
+                {
+                    // the zero component of the first run is the frame
+                    int bg = bg0 + k;
+                    if( bgLink[bg] == bg && bg != 0 )
+                    {
+                        ContourStart s = { Point( runs[k - 1][1] - 1, y ), fgLink[fg0 + k - 1], bg, 1 };
+                        starts.push_back( s );
+                    }
+                    int fg = fg0 + k;
+                    if( k < n && fgLink[fg] == fg )
+                    {
+                        ContourStart s = { Point( runs[k][0], y ), fg, bgLink[bg], 0 };
+                        starts.push_back( s );
+                    }
+                }
+            }
+        }
+    });
+
+    // the links are not needed anymore, so the roots keep the indices of their contours
+    std::vector<ContourStart> starts;
+    std::vector<int> parents;
+    for( int b = 0; b < nbands; b++ )
+    {
+        for( size_t i = 0; i < bandStarts[b].size(); i++ )
+        {
+            const ContourStart& s = bandStarts[b][i];
+            int parent = -1;
+            if( mode == CV_RETR_EXTERNAL )
+            {
+                if( s.isHole || s.bgRoot != 0 )
+                    continue;
+            }
+            else if( mode == CV_RETR_CCOMP )
+            {
+                if( s.isHole )
+                    parent = fgLink[s.fgRoot];
+            }
+            else if( mode == CV_RETR_TREE )
+            {
+                parent = s.isHole ? fgLink[s.fgRoot] : s.bgRoot != 0 ? bgLink[s.bgRoot] : -1;
+            }
+            (s.isHole ? bgLink[s.bgRoot] : fgLink[s.fgRoot]) = (int)starts.size();
+            starts.push_back( s );
+            parents.push_back( parent );
+        }
+        std::vector<ContourStart>().swap( bandStarts[b] );
+    }
+
+    int total = (int)starts.size();
+    if( total == 0 )
+    {
+        _contours.clear();
+        return;
+    }
+
+    // follow the borders
+    Point offset0 = offset - Point( 1, 1 );
+    std::vector<std::vector<Point> > points( total );
+    parallel_for_(Range(0, total), [&](const Range& range)
+    {
+        int method1 = method == CV_CHAIN_APPROX_TC89_L1 || method == CV_CHAIN_APPROX_TC89_KCOS ? CV_CHAIN_CODE : method;
+        MemStorage storage( method1 == CV_CHAIN_CODE ? cvCreateMemStorage() : 0 );
+        std::vector<schar> codes;
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const ContourStart& s = starts[i];
+            Point origin = s.pt + offset0;
+            codes.clear();
+            followBorder( img.ptr<uchar>(s.pt.y) + s.pt.x, step, origin, s.isHole, method1, points[i], codes );
+            if( method1 == CV_CHAIN_CODE )
+            {
+                CvSeq* chain = cvCreateSeq( CV_SEQ_CHAIN_CONTOUR, sizeof(CvChain), sizeof(char), storage );
+                chain->flags |= s.isHole ? CV_SEQ_FLAG_HOLE : 0;
+                if( !codes.empty() )
+                    cvSeqPushMulti( chain, &codes[0], (int)codes.size() );
+                ((CvChain*)chain)->origin = cvPoint( origin );
+                CvSeq* contour = icvApproximateChainTC89( (CvChain*)chain, sizeof(CvContour), storage, method );
+                points[i].resize( contour->total );
+                if( contour->total > 0 )
+                    cvCvtSeqToArray( contour, &points[i][0] );
+                cvClearMemStorage( storage );
+            }
+        }
+    }, std::max( 1., total / 256. ));
+
+    // the same order as cvTreeToNodeSeq() gives for the tree of the serial scan,
+    // where every new contour is inserted as the first child of its parent
+    std::vector<int> firstChild( total, -1 ), next( total, -1 ), prev( total, -1 ), order, outIdx( total );
+    int firstTop = -1;
+    for( int i = 0; i < total; i++ )
+    {
+        int& head = parents[i] < 0 ? firstTop : firstChild[parents[i]];
+        next[i] = head;
+        if( head >= 0 )
+            prev[head] = i;
+        head = i;
+    }
+    order.reserve( total );
+    for( int i = firstTop; i >= 0; )
+    {
+        outIdx[i] = (int)order.size();
+        order.push_back( i );
+        if( firstChild[i] >= 0 )
+        {
+            i = firstChild[i];
+            continue;
+        }
+        while( i >= 0 && next[i] < 0 )
+            i = parents[i];
+        if( i >= 0 )
+            i = next[i];
+    }
+    CV_Assert( (int)order.size() == total );
+
+    _contours.create( total, 1, 0, -1, true );
+    for( int k = 0; k < total; k++ )
+    {
+        const std::vector<Point>& pts = points[order[k]];
+        _contours.create( (int)pts.size(), 1, CV_32SC2, k, true );
+        Mat ci = _contours.getMat( k );
+        CV_Assert( ci.isContinuous() );
+        if( !pts.empty() )
+            memcpy( ci.ptr(), &pts[0], pts.size() * sizeof(pts[0]) );
+    }
+
+    if( _hierarchy.needed() )
+    {
+        _hierarchy.create( 1, total, CV_32SC4, -1, true );
+        Vec4i* hierarchy = _hierarchy.getMat().ptr<Vec4i>();
+        for( int k = 0; k < total; k++ )
+        {
+            int i = order[k];
+            hierarchy[k] = Vec4i( next[i] >= 0 ? outIdx[next[i]] : -1,
+                                  prev[i] >= 0 ? outIdx[prev[i]] : -1,
+                                  firstChild[i] >= 0 ? outIdx[firstChild[i]] : -1,
+                                  parents[i] >= 0 ? outIdx[parents[i]] : -1 );
+        }
+    }
+}
+
+} // namespace
+
 void cv::findContours( InputArray _image, OutputArrayOfArrays _contours,
                    OutputArray _hierarchy, int mode, int method, Point offset )
 {
@@ -1825,6 +2281,14 @@ void cv::findContours( InputArray _image, OutputArrayOfArrays _contours,
     CV_Assert(_contours.empty() || (_contours.channels() == 2 && _contours.depth() == CV_32S));
 
     Mat image0 = _image.getMat(), image;
+    if( useParallelFindContours(image0, mode, method) )
+    {
+        if( _hierarchy.needed() )
+            _hierarchy.clear();
+        findContoursParallel(image0, _contours, _hierarchy, mode, method, offset);
+        return;
+    }
+
     Point offset0(0, 0);
     if(method != CV_LINK_RUNS)
     {
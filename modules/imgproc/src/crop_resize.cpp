@@ -0,0 +1,279 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+
+namespace {
+
+struct CropResizeParams
+{
+    Size size;
+    int layout;
+    bool nearest;
+    int chmap[4];
+    float mean[4], scale[4];
+};
+
+// normalizes one interleaved row of samples and stores it into the blob item
+template<int CN>
+static void cropResizeStoreRow(const float* buf, float* dst, int y, const CropResizeParams& p)
+{
+    const int W = p.size.width;
+    float a[4], b[4];
+    for( int k = 0; k < CN; k++ )
+    {
+        a[k] = p.scale[k];
+        b[k] = -p.mean[k]*p.scale[k];
+    }
+
+    if( p.layout == CROP_RESIZE_LAYOUT_NCHW )
+    {
+        const size_t planeSize = (size_t)W*p.size.height;
+        float* D[4];
+        for( int k = 0; k < CN; k++ )
+            D[k] = dst + planeSize*k + (size_t)y*W;
+        int x = 0;
+#if CV_SIMD
+        const int VL = VTraits<v_float32>::vlanes();
+        v_float32 v[4];
+        for( ; x <= W - VL; x += VL )
+        {
+            if( CN == 1 )
+                v[0] = vx_load(buf + x);
+            else if( CN == 3 )
+                v_load_deinterleave(buf + x*3, v[0], v[1], v[2]);
+            else
+                v_load_deinterleave(buf + x*4, v[0], v[1], v[2], v[3]);
+            for( int k = 0; k < CN; k++ )
+                v_store(D[k] + x, v_fma(v[p.chmap[k]], vx_setall_f32(a[k]), vx_setall_f32(b[k])));
+        }
+#endif
+        for( ; x < W; x++ )
+            for( int k = 0; k < CN; k++ )
+                D[k][x] = buf[x*CN + p.chmap[k]]*a[k] + b[k];
+    }
+    else
+    {
+        float* D = dst + (size_t)y*W*CN;
+        for( int x = 0; x < W; x++, D += CN, buf += CN )
+            for( int k = 0; k < CN; k++ )
+                D[k] = buf[p.chmap[k]]*a[k] + b[k];
+    }
+}
+
+/*
+ Samples one ROI into the blob item `dst` (C*H*W floats for NCHW or H*W*C for NHWC).
+ The sampling positions are computed in ROI-local pixel coordinates the same way as resize does,
+ clamped to the ROI, rotated around its center and converted to the fixed-point form
+ with INTER_BITS fractional bits used by warpAffine.
+*/
+template<typename T, int CN>
+static void cropResizeOne(const Mat& src, const RotatedRect& roi, float* dst, const CropResizeParams& p)
+{
+    const int W = p.size.width, H = p.size.height;
+    const double angle = roi.angle*CV_PI/180;
+    const double ca = std::cos(angle), sa = std::sin(angle);
+    const double rw = roi.size.width, rh = roi.size.height;
+    // ROI pixel (0, 0) is at center - (size - 1)/2 in the rotated frame, pixel centers are integer
+    const double cx = roi.center.x - 0.5, cy = roi.center.y - 0.5;
+    const int half = p.nearest ? INTER_TAB_SIZE/2 : 0;
+    const int maxX = src.cols - 1, maxY = src.rows - 1;
+
+    // an integer rectangle inside the image is exactly a resize of the crop, use its vectorized kernels
+    Rect r((int)(roi.center.x - rw*0.5), (int)(roi.center.y - rh*0.5), (int)rw, (int)rh);
+    if( !p.nearest && roi.angle == 0 && r.width > 0 && r.height > 0 && r.width == rw && r.height == rh &&
+        r.x + rw*0.5 == roi.center.x && r.y + rh*0.5 == roi.center.y && (r & Rect(0, 0, src.cols, src.rows)) == r )
+    {
+        Mat patch, fpatch;
+        resize(src(r), patch, p.size, 0, 0, INTER_LINEAR);
+        if( patch.depth() == CV_32F )
+            fpatch = patch;
+        else
+            patch.convertTo(fpatch, CV_32F);
+        for( int y = 0; y < H; y++ )
+            cropResizeStoreRow<CN>(fpatch.ptr<float>(y), dst, y, p);
+        return;
+    }
+
+    AutoBuffer<int> _xtab(W*4);
+    AutoBuffer<float> _buf(W*CN + W);
+    int* xa = _xtab.data();
+    int* ya = xa + W;
+    float* buf = _buf.data();
+    float* wx = buf + W*CN;
+    float wtab[INTER_TAB_SIZE];
+    for( int i = 0; i < INTER_TAB_SIZE; i++ )
+        wtab[i] = (float)i/INTER_TAB_SIZE;
+
+    for( int x = 0; x < W; x++ )
+    {
+        double u = (x + 0.5)*rw/W - 0.5;
+        u = std::min(std::max(u, 0.), std::max(rw - 1, 0.)) - (rw - 1)*0.5;
+        xa[x] = saturate_cast<int>(ca*u*INTER_TAB_SIZE);
+        ya[x] = saturate_cast<int>(sa*u*INTER_TAB_SIZE);
+    }
+
+    // rows of the axis-aligned ROIs are resized with the precomputed horizontal taps
+    bool aligned = true;
+    for( int x = 0; x < W && aligned; x++ )
+        aligned = ya[x] == 0;
+    int* xofs0 = xa + W*2;
+    int* xofs1 = xofs0 + W;
+    if( aligned )
+    {
+        int xb = saturate_cast<int>(cx*INTER_TAB_SIZE) + half;
+        for( int x = 0; x < W; x++ )
+        {
+            int X = xa[x] + xb, sx = X >> INTER_BITS;
+            xofs0[x] = std::min(std::max(sx, 0), maxX)*CN;
+            xofs1[x] = std::min(std::max(sx + 1, 0), maxX)*CN;
+            wx[x] = p.nearest ? 0.f : wtab[X & (INTER_TAB_SIZE - 1)];
+        }
+    }
+
+    for( int y = 0; y < H; y++ )
+    {
+        double v = (y + 0.5)*rh/H - 0.5;
+        v = std::min(std::max(v, 0.), std::max(rh - 1, 0.)) - (rh - 1)*0.5;
+        int xb = saturate_cast<int>((cx - sa*v)*INTER_TAB_SIZE) + half;
+        int yb = saturate_cast<int>((cy + ca*v)*INTER_TAB_SIZE) + half;
+
+        if( aligned )
+        {
+            int sy = yb >> INTER_BITS;
+            float fy = p.nearest ? 0.f : wtab[yb & (INTER_TAB_SIZE - 1)];
+            const T* S0 = src.ptr<T>(std::min(std::max(sy, 0), maxY));
+            const T* S1 = src.ptr<T>(std::min(std::max(sy + 1, 0), maxY));
+            for( int x = 0; x < W; x++ )
+            {
+                const T *a0 = S0 + xofs0[x], *a1 = S0 + xofs1[x];
+                const T *b0 = S1 + xofs0[x], *b1 = S1 + xofs1[x];
+                float fx = wx[x];
+                for( int k = 0; k < CN; k++ )
+                {
+                    float t0 = a0[k] + fx*((float)a1[k] - a0[k]);
+                    float t1 = b0[k] + fx*((float)b1[k] - b0[k]);
+                    buf[x*CN + k] = t0 + fy*(t1 - t0);
+                }
+            }
+        }
+        else
+        {
+            for( int x = 0; x < W; x++ )
+            {
+                int X = xa[x] + xb, Y = ya[x] + yb;
+                int sx = X >> INTER_BITS, sy = Y >> INTER_BITS;
+                int x0 = std::min(std::max(sx, 0), maxX)*CN;
+                const T* S0 = src.ptr<T>(std::min(std::max(sy, 0), maxY));
+                if( p.nearest )
+                {
+                    for( int k = 0; k < CN; k++ )
+                        buf[x*CN + k] = (float)S0[x0 + k];
+                    continue;
+                }
+                float fx = wtab[X & (INTER_TAB_SIZE - 1)], fy = wtab[Y & (INTER_TAB_SIZE - 1)];
+                int x1 = std::min(std::max(sx + 1, 0), maxX)*CN;
+                const T* S1 = src.ptr<T>(std::min(std::max(sy + 1, 0), maxY));
+                for( int k = 0; k < CN; k++ )
+                {
+                    float t0 = S0[x0 + k] + fx*((float)S0[x1 + k] - S0[x0 + k]);
+                    float t1 = S1[x0 + k] + fx*((float)S1[x1 + k] - S1[x0 + k]);
+                    buf[x*CN + k] = t0 + fy*(t1 - t0);
+                }
+            }
+        }
+
+        cropResizeStoreRow<CN>(buf, dst, y, p);
+    }
+}
+
+template<typename T>
+static void cropResizeOne(const Mat& src, const RotatedRect& roi, float* dst, const CropResizeParams& p)
+{
+    int cn = src.channels();
+    if( cn == 1 )
+        cropResizeOne<T, 1>(src, roi, dst, p);
+    else if( cn == 3 )
+        cropResizeOne<T, 3>(src, roi, dst, p);
+    else
+        cropResizeOne<T, 4>(src, roi, dst, p);
+}
+
+} // namespace
+
+void cropResizeBatch( InputArray _src, const std::vector<RotatedRect>& rois, OutputArray _blob,
+                      Size size, const Scalar& mean, const Scalar& scale, bool swapRB,
+                      int interpolation, int layout )
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat();
+    int depth = src.depth(), cn = src.channels();
+    CV_Assert( !src.empty() && src.dims == 2 );
+    CV_Assert( depth == CV_8U || depth == CV_16U || depth == CV_32F );
+    CV_Assert( cn == 1 || cn == 3 || cn == 4 );
+    CV_Assert( size.width > 0 && size.height > 0 );
+    CV_Assert( interpolation == INTER_LINEAR || interpolation == INTER_NEAREST );
+    CV_Assert( layout == CROP_RESIZE_LAYOUT_NCHW || layout == CROP_RESIZE_LAYOUT_NHWC );
+
+    int n = (int)rois.size();
+    int sz[] = { n, cn, size.height, size.width };
+    if( layout == CROP_RESIZE_LAYOUT_NHWC )
+    {
+        sz[1] = size.height;
+        sz[2] = size.width;
+        sz[3] = cn;
+    }
+    _blob.create(4, sz, CV_32F);
+    if( n == 0 )
+        return;
+    Mat blob = _blob.getMat();
+    CV_Assert( blob.isContinuous() );
+
+    CropResizeParams p;
+    p.size = size;
+    p.layout = layout;
+    p.nearest = interpolation == INTER_NEAREST;
+    for( int k = 0; k < 4; k++ )
+    {
+        p.chmap[k] = swapRB && cn >= 3 && k < 3 ? 2 - k : k;
+        p.mean[k] = (float)mean[k];
+        p.scale[k] = (float)scale[k];
+    }
+
+    size_t itemSize = (size_t)size.area()*cn;
+    float* data = blob.ptr<float>();
+    parallel_for_(Range(0, n), [&](const Range& range)
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            float* dst = data + itemSize*i;
+            if( depth == CV_8U )
+                cropResizeOne<uchar>(src, rois[i], dst, p);
+            else if( depth == CV_16U )
+                cropResizeOne<ushort>(src, rois[i], dst, p);
+            else
+                cropResizeOne<float>(src, rois[i], dst, p);
+        }
+    });
+}
+
+void cropResizeBatch( InputArray src, const std::vector<Rect>& rois, OutputArray blob,
+                      Size size, const Scalar& mean, const Scalar& scale, bool swapRB,
+                      int interpolation, int layout )
+{
+    std::vector<RotatedRect> rrois(rois.size());
+    for( size_t i = 0; i < rois.size(); i++ )
+    {
+        const Rect& r = rois[i];
+        rrois[i] = RotatedRect(Point2f(r.x + r.width*0.5f, r.y + r.height*0.5f),
+                               Size2f((float)r.width, (float)r.height), 0.f);
+    }
+    cropResizeBatch(src, rrois, blob, size, mean, scale, swapRB, interpolation, layout);
+}
+
+} // namespace cv
@@ -1676,6 +1676,184 @@ static void Bayer2RGB_EdgeAware_T(const Mat& src, Mat& dst, int code)
             firstRow[x] = lastRow[x] = 0;
 }
 
+//////////////////////////// Fused demosaicing pipeline /////////////////////////////
+
+// acc[X] = sum of the b x b block of the 3-channel pixels at (X*b, 0) of the rows
+template<typename T> static void
+bayerPipelineBinRow( const T* const* rows, int b, float* acc, int dwidth )
+{
+    if( b == 1 )
+    {
+        for( int x = 0; x < dwidth*3; x++ )
+            acc[x] = rows[0][x];
+        return;
+    }
+
+    for( int x = 0; x < dwidth*3; x++ )
+        acc[x] = 0.f;
+    for( int k = 0; k < b; k++ )
+    {
+        const T* row = rows[k];
+        for( int x = 0; x < dwidth; x++, row += b*3 )
+        {
+            int s0 = 0, s1 = 0, s2 = 0;
+            for( int dx = 0; dx < b*3; dx += 3 )
+            {
+                s0 += row[dx]; s1 += row[dx + 1]; s2 += row[dx + 2];
+            }
+            acc[x*3] += (float)s0; acc[x*3 + 1] += (float)s1; acc[x*3 + 2] += (float)s2;
+        }
+    }
+}
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+static inline void bayerPipelineMix( const v_float32& b, const v_float32& g, const v_float32& r,
+                                     const v_float32* m, int c, v_float32& y )
+{
+    y = v_fma(m[c*3], b, v_fma(m[c*3 + 1], g, v_mul(m[c*3 + 2], r)));
+}
+
+static int bayerPipelineColorRow_SIMD( const float* acc, uchar* dst, int width, const float* mtx )
+{
+    const int VECSZ = VTraits<v_float32>::vlanes();
+    v_float32 m[9];
+    for( int i = 0; i < 9; i++ )
+        m[i] = vx_setall_f32(mtx[i]);
+
+    int x = 0;
+    for( ; x <= width - VECSZ*4; x += VECSZ*4 )
+    {
+        v_float32 b[4], g[4], r[4];
+        for( int k = 0; k < 4; k++ )
+            v_load_deinterleave(acc + (x + k*VECSZ)*3, b[k], g[k], r[k]);
+
+        v_uint8 out[3];
+        for( int c = 0; c < 3; c++ )
+        {
+            v_int32 i[4];
+            for( int k = 0; k < 4; k++ )
+            {
+                v_float32 y;
+                bayerPipelineMix(b[k], g[k], r[k], m, c, y);
+                i[k] = v_round(y);
+            }
+            out[c] = v_pack_u(v_pack(i[0], i[1]), v_pack(i[2], i[3]));
+        }
+        v_store_interleave(dst + x*3, out[0], out[1], out[2]);
+    }
+    return x;
+}
+
+static int bayerPipelineColorRow_SIMD( const float* acc, ushort* dst, int width, const float* mtx )
+{
+    const int VECSZ = VTraits<v_float32>::vlanes();
+    v_float32 m[9];
+    for( int i = 0; i < 9; i++ )
+        m[i] = vx_setall_f32(mtx[i]);
+
+    int x = 0;
+    for( ; x <= width - VECSZ*2; x += VECSZ*2 )
+    {
+        v_float32 b0, g0, r0, b1, g1, r1;
+        v_load_deinterleave(acc + x*3, b0, g0, r0);
+        v_load_deinterleave(acc + (x + VECSZ)*3, b1, g1, r1);
+
+        v_uint16 out[3];
+        for( int c = 0; c < 3; c++ )
+        {
+            v_float32 y0, y1;
+            bayerPipelineMix(b0, g0, r0, m, c, y0);
+            bayerPipelineMix(b1, g1, r1, m, c, y1);
+            out[c] = v_pack_u(v_round(y0), v_round(y1));
+        }
+        v_store_interleave(dst + x*3, out[0], out[1], out[2]);
+    }
+    return x;
+}
+#endif
+
+// dst[x] = saturate(mtx * acc[x]) for the 3-channel pixels of a row
+template<typename T> static void
+bayerPipelineColorRow( const float* acc, T* dst, int width, const float* mtx )
+{
+    int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    x = bayerPipelineColorRow_SIMD(acc, dst, width, mtx);
+#endif
+    for( ; x < width; x++ )
+    {
+        float b = acc[x*3], g = acc[x*3 + 1], r = acc[x*3 + 2];
+        for( int c = 0; c < 3; c++ )
+            dst[x*3 + c] = saturate_cast<T>(mtx[c*3]*b + mtx[c*3 + 1]*g + mtx[c*3 + 2]*r);
+    }
+}
+
+// Bilinear demosaicing of bands of rows into a small buffer, followed by binning and the color
+// transform of every output row while the band is in cache
+template<typename T, class SIMDInterpolator>
+static void demosaicingPipeline_( const Mat& src, Mat& dst, int code, const Matx33f& mtx, int binning )
+{
+    const int width = src.cols, height = src.rows;
+    const int dwidth = dst.cols;
+    const int blue0 = (code == COLOR_BayerBG2BGR || code == COLOR_BayerGB2BGR) ? -1 : 1;
+    const int start_with_green0 = (code == COLOR_BayerGB2BGR || code == COLOR_BayerGR2BGR);
+    const int bandRows = std::max(1, 16 / binning);
+
+    if( width < 3 || height < 3 )
+    {
+        Mat rgb;
+        demosaicing(src, rgb, code, 3);
+        std::vector<float> acc(dwidth*3);
+        std::vector<const T*> rows(binning);
+        for( int y = 0; y < dst.rows; y++ )
+        {
+            for( int k = 0; k < binning; k++ )
+                rows[k] = rgb.ptr<T>(y*binning + k);
+            bayerPipelineBinRow(&rows[0], binning, &acc[0], dwidth);
+            bayerPipelineColorRow(&acc[0], dst.ptr<T>(y), dwidth, mtx.val);
+        }
+        return;
+    }
+
+    parallel_for_(Range(0, dst.rows), [&](const Range& range)
+    {
+        Mat buf;
+        std::vector<float> acc(dwidth*3);
+        std::vector<const T*> rows(binning);
+
+        for( int y0 = range.start; y0 < range.end; y0 += bandRows )
+        {
+            int y1 = std::min(y0 + bandRows, range.end);
+
+            // the interior rows [r0, r1) of the band; the first and the last image rows repeat their neighbours
+            int r0 = std::min(std::max(y0*binning, 1), height - 2);
+            int r1 = std::min(std::max(y1*binning - 1, 1), height - 2) + 1;
+            int blue = blue0, start_with_green = start_with_green0;
+            if( (r0 - 1) % 2 )
+            {
+                blue = -blue;
+                start_with_green = !start_with_green;
+            }
+
+            buf.create(r1 - r0 + 2, width, dst.type());
+            Bayer2RGB_Invoker<T, SIMDInterpolator> invoker(src.rowRange(r0 - 1, r1 + 1), buf,
+                                                           start_with_green, blue, Size(width - 2, r1 - r0));
+            invoker(Range(0, r1 - r0));
+
+            for( int y = y0; y < y1; y++ )
+            {
+                for( int k = 0; k < binning; k++ )
+                {
+                    int r = std::min(std::max(y*binning + k, 1), height - 2);
+                    rows[k] = buf.ptr<T>(r - r0 + 1);
+                }
+                bayerPipelineBinRow(&rows[0], binning, &acc[0], dwidth);
+                bayerPipelineColorRow(&acc[0], dst.ptr<T>(y), dwidth, mtx.val);
+            }
+        }
+    }, dst.total()/static_cast<double>(1<<16));
+}
+
 } // end namespace cv
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -1766,3 +1944,41 @@ void cv::demosaicing(InputArray _src, OutputArray _dst, int code, int dcn)
         CV_Error( cv::Error::StsBadFlag, "Unknown / unsupported color conversion code" );
     }
 }
+
+void cv::demosaicingPipeline(InputArray _src, OutputArray _dst, int code, const Scalar& gains,
+                             InputArray _colorMatrix, int binning)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat();
+    int depth = src.depth();
+
+    CV_Assert(!src.empty() && src.channels() == 1);
+    CV_Assert(depth == CV_8U || depth == CV_16U);
+    CV_Assert(code == COLOR_BayerBG2BGR || code == COLOR_BayerGB2BGR ||
+              code == COLOR_BayerRG2BGR || code == COLOR_BayerGR2BGR);
+    CV_Assert(binning == 1 || binning == 2 || binning == 4);
+    CV_Assert(src.cols >= binning && src.rows >= binning);
+
+    Matx33f mtx = Matx33f::eye();
+    if (!_colorMatrix.empty())
+    {
+        Mat m = _colorMatrix.getMat();
+        CV_Assert(m.total() == 9 && m.channels() == 1 && (m.depth() == CV_32F || m.depth() == CV_64F));
+        m.reshape(1, 3).convertTo(mtx, CV_32F);
+    }
+
+    // the gains and the averaging of the binned pixels are folded into the matrix
+    const float scale = 1.f / (binning*binning);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++)
+            mtx(i, j) *= (float)gains[j] * scale;
+
+    _dst.create(src.rows / binning, src.cols / binning, CV_MAKETYPE(depth, 3));
+    Mat dst = _dst.getMat();
+
+    if (depth == CV_8U)
+        demosaicingPipeline_<uchar, SIMDBayerInterpolator_8u>(src, dst, code, mtx, binning);
+    else
+        demosaicingPipeline_<ushort, SIMDBayerStubInterpolator_<ushort> >(src, dst, code, mtx, binning);
+}
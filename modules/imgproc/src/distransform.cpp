@@ -40,6 +40,7 @@
 //
 //M*/
 #include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
 
 namespace cv
 {
@@ -452,61 +453,161 @@ static void getDistanceTransformMask( int maskType, float *metrics )
     }
 }
 
+static const int PRECISE_DIST_MAX = 1 << 16;
+
+// Stage 1 of the precise transform: squared distance to the nearest zero pixel of the same column.
+// The columns are processed in blocks of BLOCK, row by row, so both scans walk along contiguous
+// memory. Distances are clamped to dist_max = min(rows, PRECISE_DIST_MAX); anything at or beyond
+// it is "infinite". In the label mode the row of the nearest zero pixel is stored to `nearest`
+// (-1 if the column has no zero pixels).
 struct DTColumnInvoker : ParallelLoopBody
 {
-    DTColumnInvoker( const Mat* _src, Mat* _dst, const int* _sat_tab, const unsigned int* _sqr_tab)
+    enum { BLOCK = 64 };
+
+    DTColumnInvoker( const Mat* _src, Mat* _dst, Mat* _nearest )
     {
         src = _src;
         dst = _dst;
-        sat_tab = _sat_tab + src->rows*2 + 1;
-        sqr_tab = _sqr_tab;
+        nearest = _nearest;
+        dist_max = std::min(src->rows, PRECISE_DIST_MAX);
+    }
+
+    float sqrDist( int d ) const
+    {
+        return d >= dist_max ? (float)UINT_MAX : (float)d*d;
     }
 
     void operator()(const Range& range) const CV_OVERRIDE
     {
-        int i, i1 = range.start, i2 = range.end;
-        int m = src->rows;
-        size_t sstep = src->step, dstep = dst->step/sizeof(float);
-        AutoBuffer<int> _d(m);
+        AutoBuffer<int> _d(BLOCK);
         int* d = _d.data();
 
-        for( i = i1; i < i2; i++ )
+        for( int b = range.start; b < range.end; b++ )
         {
-            const uchar* sptr = src->ptr(m-1) + i;
-            float* dptr = dst->ptr<float>() + i;
-            int j, dist = m-1;
+            int c0 = b*BLOCK, w = std::min((int)BLOCK, src->cols - c0);
+            if( nearest )
+                nearestRows(d, c0, w);
+            else
+                distances(d, c0, w);
+        }
+    }
+
+    void distances( int* d, int c0, int w ) const
+    {
+        int i, j, m = src->rows;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int VECSZ = VTraits<v_int32>::vlanes();
+        v_int32 v_one = vx_setall_s32(1), v_max = vx_setall_s32(dist_max), v_zero = vx_setzero_s32();
+        v_float32 v_inf = vx_setall_f32((float)UINT_MAX);
+#endif
 
-            for( j = m-1; j >= 0; j--, sptr -= sstep )
+        // upwards: distance to the zero pixel below, kept in dst
+        for( j = 0; j < w; j++ )
+            d[j] = dist_max;
+        for( i = m - 1; i >= 0; i-- )
+        {
+            const uchar* sptr = src->ptr(i) + c0;
+            float* dptr = dst->ptr<float>(i) + c0;
+            j = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            for( ; j <= w - VECSZ; j += VECSZ )
             {
-                dist = (dist + 1) & (sptr[0] == 0 ? 0 : -1);
+                v_int32 s = v_reinterpret_as_s32(vx_load_expand_q(sptr + j));
+                v_int32 dist = v_select(v_eq(s, v_zero), v_zero, v_min(v_add(vx_load(d + j), v_one), v_max));
+                v_store(d + j, dist);
+                v_store(dptr + j, v_cvt_f32(dist));
+            }
+#endif
+            for( ; j < w; j++ )
+            {
+                int dist = sptr[j] == 0 ? 0 : std::min(d[j] + 1, dist_max);
                 d[j] = dist;
+                dptr[j] = (float)dist;
             }
+        }
 
-            dist = m-1;
-            for( j = 0; j < m; j++, dptr += dstep )
+        // downwards: the smaller of the two distances, squared
+        for( j = 0; j < w; j++ )
+            d[j] = dist_max;
+        for( i = 0; i < m; i++ )
+        {
+            float* dptr = dst->ptr<float>(i) + c0;
+            j = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            for( ; j <= w - VECSZ; j += VECSZ )
             {
-                dist = dist + 1 - sat_tab[dist - d[j]];
+                v_int32 dist = v_min(v_add(vx_load(d + j), v_one), v_round(vx_load(dptr + j)));
+                v_store(d + j, dist);
+                v_float32 fd = v_cvt_f32(dist);
+                v_store(dptr + j, v_select(v_reinterpret_as_f32(v_lt(dist, v_max)), v_mul(fd, fd), v_inf));
+            }
+#endif
+            for( ; j < w; j++ )
+            {
+                int dist = std::min(d[j] + 1, cvRound(dptr[j]));
                 d[j] = dist;
-                dptr[0] = (float)sqr_tab[dist];
+                dptr[j] = sqrDist(dist);
+            }
+        }
+    }
+
+    void nearestRows( int* d, int c0, int w ) const
+    {
+        int i, j, m = src->rows;
+
+        for( j = 0; j < w; j++ )
+            d[j] = -1;
+        for( i = m - 1; i >= 0; i-- )
+        {
+            const uchar* sptr = src->ptr(i) + c0;
+            int* nptr = nearest->ptr<int>(i) + c0;
+            for( j = 0; j < w; j++ )
+            {
+                if( sptr[j] == 0 )
+                    d[j] = i;
+                nptr[j] = d[j];
+            }
+        }
+
+        for( j = 0; j < w; j++ )
+            d[j] = -1;
+        for( i = 0; i < m; i++ )
+        {
+            const uchar* sptr = src->ptr(i) + c0;
+            int* nptr = nearest->ptr<int>(i) + c0;
+            float* dptr = dst->ptr<float>(i) + c0;
+            for( j = 0; j < w; j++ )
+            {
+                if( sptr[j] == 0 )
+                    d[j] = i;
+                int up = d[j], down = nptr[j];
+                int dup = up >= 0 ? i - up : INT_MAX;
+                int ddown = down >= 0 ? down - i : INT_MAX;
+                nptr[j] = dup <= ddown ? up : down;
+                dptr[j] = sqrDist(std::min(dup, ddown));
             }
         }
     }
 
     const Mat* src;
     Mat* dst;
-    const int* sat_tab;
-    const unsigned int* sqr_tab;
+    Mat* nearest;
+    int dist_max;
 };
 
-static const int PRECISE_DIST_MAX = 1 << 16;
-
+// Stage 2: lower envelope of the parabolas along each row. In the label mode the label of the
+// zero pixel that defines the chosen parabola (row nearest(i, p), column p) is copied to labels.
 struct DTRowInvoker : ParallelLoopBody
 {
-    DTRowInvoker( Mat* _dst, const unsigned int* _sqr_tab, const float* _inv_tab )
+    DTRowInvoker( Mat* _dst, const unsigned int* _sqr_tab, const float* _inv_tab,
+                  const Mat* _nearest = 0, const Mat* _zlabels = 0, Mat* _labels = 0 )
     {
         dst = _dst;
         sqr_tab = _sqr_tab;
         inv_tab = _inv_tab;
+        nearest = _nearest;
+        zlabels = _zlabels;
+        labels = _labels;
     }
 
     void operator()(const Range& range) const CV_OVERRIDE
@@ -575,16 +676,35 @@ struct DTRowInvoker : ParallelLoopBody
                 p = v[k];
                 d[q] = std::sqrt(sqr_tab[std::abs(q - p)] + f[p]);
             }
+
+            if( labels )
+            {
+                const int* nptr = nearest->ptr<int>(i);
+                int* lptr = labels->ptr<int>(i);
+                for( q = 0, k = 0; q < n; q++ )
+                {
+                    while( z[k+1] < q )
+                        k++;
+                    p = v[k];
+                    int r = nptr[p];
+                    lptr[q] = r >= 0 ? zlabels->ptr<int>(r)[p] : 0;
+                }
+            }
         }
     }
 
     Mat* dst;
     const unsigned int* sqr_tab;
     const float* inv_tab;
+    const Mat* nearest;
+    const Mat* zlabels;
+    Mat* labels;
 };
 
+// zlabels holds the labels of the zero pixels; if it is given, labels receives for every pixel the
+// label of its nearest zero pixel
 static void
-trueDistTrans( const Mat& src, Mat& dst )
+trueDistTrans( const Mat& src, Mat& dst, const Mat* zlabels = 0, Mat* labels = 0 )
 {
     const unsigned int inf = UINT_MAX;
 
@@ -593,25 +713,17 @@ trueDistTrans( const Mat& src, Mat& dst )
     CV_Assert( src.type() == CV_8UC1 && dst.type() == CV_32FC1 );
     int i, m = src.rows, n = src.cols;
 
-    cv::AutoBuffer<uchar> _buf(std::max(m*2*sizeof(int) + (m*3+1)*sizeof(int), n*2*sizeof(float)));
     // stage 1: compute 1d distance transform of each column
-    unsigned int* sqr_tab = (unsigned int*)_buf.data();
-    int* sat_tab = cv::alignPtr((int*)(sqr_tab + m*2), sizeof(int));
-    int shift = m*2;
-
-    for( i = 0; i < m; i++ )
-        sqr_tab[i] = i >= PRECISE_DIST_MAX ? inf : static_cast<unsigned int>(i) * i;
-    for( i = m; i < m*2; i++ )
-        sqr_tab[i] = inf;
-    for( i = 0; i < shift; i++ )
-        sat_tab[i] = 0;
-    for( ; i <= m*3; i++ )
-        sat_tab[i] = i - shift;
-
-    cv::parallel_for_(cv::Range(0, n), cv::DTColumnInvoker(&src, &dst, sat_tab, sqr_tab), src.total()/(double)(1<<16));
+    Mat nearest;
+    if( labels )
+        nearest.create(src.size(), CV_32S);
+    int nblocks = (n + DTColumnInvoker::BLOCK - 1)/DTColumnInvoker::BLOCK;
+    cv::parallel_for_(cv::Range(0, nblocks), cv::DTColumnInvoker(&src, &dst, labels ? &nearest : 0));
 
     // stage 2: compute modified distance transform for each row
-    float* inv_tab = (float*)sqr_tab + n;
+    cv::AutoBuffer<uchar> _buf(n*(sizeof(unsigned int) + sizeof(float)));
+    unsigned int* sqr_tab = (unsigned int*)_buf.data();
+    float* inv_tab = (float*)(sqr_tab + n);
 
     inv_tab[0] = 0.f;
     sqr_tab[0] = 0;
@@ -621,7 +733,44 @@ trueDistTrans( const Mat& src, Mat& dst )
         sqr_tab[i] = i >= PRECISE_DIST_MAX ? inf : static_cast<unsigned int>(i) * i;
     }
 
-    cv::parallel_for_(cv::Range(0, m), cv::DTRowInvoker(&dst, sqr_tab, inv_tab));
+    cv::parallel_for_(cv::Range(0, m), cv::DTRowInvoker(&dst, sqr_tab, inv_tab, labels ? &nearest : 0, zlabels, labels));
+}
+
+// labels of the zero pixels: connected components (DIST_LABEL_CCOMP) or 1, 2, ... in the raster
+// order (DIST_LABEL_PIXEL); all other pixels get 0
+static void
+labelZeroPixels( const Mat& src, Mat& labels, int labelType )
+{
+    if( labelType == cv::DIST_LABEL_CCOMP )
+    {
+        Mat zpix = src == 0;
+        connectedComponents(zpix, labels, 8, CV_32S, CCL_WU);
+        return;
+    }
+
+    int m = src.rows, n = src.cols;
+    std::vector<int> ofs(m + 1);
+    ofs[0] = 1;
+    cv::parallel_for_(cv::Range(0, m), [&](const cv::Range& range)
+    {
+        for( int i = range.start; i < range.end; i++ )
+            ofs[i + 1] = n - countNonZero(src.row(i));
+    });
+    for( int i = 0; i < m; i++ )
+        ofs[i + 1] += ofs[i];
+
+    cv::parallel_for_(cv::Range(0, m), [&](const cv::Range& range)
+    {
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const uchar* srcptr = src.ptr(i);
+            int* labelptr = labels.ptr<int>(i);
+            int k = ofs[i];
+
+            for( int j = 0; j < n; j++ )
+                labelptr[j] = srcptr[j] == 0 ? k++ : 0;
+        }
+    });
 }
 
 
@@ -760,7 +909,8 @@ void cv::distanceTransform( InputArray _src, OutputArray _dst, OutputArray _labe
 
         _labels.create(src.size(), CV_32S);
         labels = _labels.getMat();
-        maskSize = cv::DIST_MASK_5;
+        if( maskSize != cv::DIST_MASK_PRECISE || distType != cv::DIST_L2 )
+            maskSize = cv::DIST_MASK_5;
     }
 
     float _mask[5] = {0};
@@ -773,6 +923,13 @@ void cv::distanceTransform( InputArray _src, OutputArray _dst, OutputArray _labe
 
     if( maskSize == cv::DIST_MASK_PRECISE )
     {
+        if( need_labels )
+        {
+            Mat zlabels(src.size(), CV_32S);
+            labelZeroPixels( src, zlabels, labelType );
+            trueDistTrans( src, dst, &zlabels, &labels );
+            return;
+        }
 
 #ifdef HAVE_IPP
         CV_IPP_CHECK()
@@ -862,26 +1019,7 @@ void cv::distanceTransform( InputArray _src, OutputArray _dst, OutputArray _labe
     }
     else
     {
-        labels.setTo(Scalar::all(0));
-
-        if( labelType == cv::DIST_LABEL_CCOMP )
-        {
-            Mat zpix = src == 0;
-            connectedComponents(zpix, labels, 8, CV_32S, CCL_WU);
-        }
-        else
-        {
-            int k = 1;
-            for( int i = 0; i < src.rows; i++ )
-            {
-                const uchar* srcptr = src.ptr(i);
-                int* labelptr = labels.ptr<int>(i);
-
-                for( int j = 0; j < src.cols; j++ )
-                    if( srcptr[j] == 0 )
-                        labelptr[j] = k++;
-            }
-        }
+        labelZeroPixels( src, labels, labelType );
 
         temp.create(size.height + border*2, size.width + border*2, CV_32SC1);
         distanceTransformEx_5x5( src, temp, dst, labels, _mask );
@@ -60,18 +60,30 @@ struct PolyEdge
 static void
 CollectPolyEdges( Mat& img, const Point2l* v, int npts,
                   std::vector<PolyEdge>& edges, const void* color, int line_type,
-                  int shift, Point offset=Point() );
+                  int shift, Point offset=Point(), const Range& rows=Range::all() );
 
 static void
-FillEdgeCollection( Mat& img, std::vector<PolyEdge>& edges, const void* color, int line_type);
+FillEdgeCollection( Mat& img, std::vector<PolyEdge>& edges, const void* color, int line_type,
+                    const Range& rows=Range::all() );
 
 static void
 PolyLine( Mat& img, const Point2l* v, int npts, bool closed,
-          const void* color, int thickness, int line_type, int shift );
+          const void* color, int thickness, int line_type, int shift,
+          const Range& rows=Range::all() );
 
 static void
 FillConvexPoly( Mat& img, const Point2l* v, int npts,
-                const void* color, int line_type, int shift );
+                const void* color, int line_type, int shift, const Range& rows=Range::all() );
+
+/* The rasterizers below take the range of image rows they may write to. The geometry is always
+   clipped against the whole image and only the output is restricted, so drawing an image band by
+   band gives the same pixels as drawing it at once. */
+static inline void
+clipRows( const Range& rows, int height, int& y0, int& y1 )
+{
+    y0 = std::max(rows.start, 0);
+    y1 = std::max(std::min(rows.end, height), y0);
+}
 
 /****************************************************************************************\
 *                                   Lines                                                *
@@ -261,7 +273,7 @@ void LineIterator::init( const Mat* img, Rect rect, Point pt1_, Point pt2_, int
 
 static void
 Line( Mat& img, Point pt1, Point pt2,
-      const void* _color, int connectivity = 8 )
+      const void* _color, int connectivity = 8, const Range& rows = Range::all() )
 {
     if( connectivity == 0 )
         connectivity = 8;
@@ -272,8 +284,19 @@ Line( Mat& img, Point pt1, Point pt2,
     int i, count = iterator.count;
     int pix_size = (int)img.elemSize();
     const uchar* color = (const uchar*)_color;
+    int y0, y1;
+    clipRows(rows, img.rows, y0, y1);
 
-    if( pix_size == 3 )
+    if( y0 > 0 || y1 < img.rows )
+    {
+        for( i = 0; i < count; i++, ++iterator )
+        {
+            int y = iterator.pos().y;
+            if( y0 <= y && y < y1 )
+                memcpy( *iterator, color, pix_size );
+        }
+    }
+    else if( pix_size == 3 )
     {
         for( i = 0; i < count; i++, ++iterator )
         {
@@ -312,7 +335,7 @@ static const int FilterTable[] = {
 };
 
 static void
-LineAA( Mat& img, Point2l pt1, Point2l pt2, const void* color )
+LineAA( Mat& img, Point2l pt1, Point2l pt2, const void* color, const Range& rows = Range::all() )
 {
     int64 dx, dy;
     int ecount, scount = 0;
@@ -327,10 +350,13 @@ LineAA( Mat& img, Point2l pt1, Point2l pt2, const void* color )
     uchar* ptr = img.ptr();
     size_t step = img.step;
     Size2l size0(img.size()), size = size0;
+    int ry0, ry1;
+    clipRows(rows, img.rows, ry0, ry1);
+    unsigned rh = (unsigned)(ry1 - ry0);
 
     if( !((nch == 1 || nch == 3 || nch == 4) && img.depth() == CV_8U) )
     {
-        Line(img, Point((int)(pt1.x>>XY_SHIFT), (int)(pt1.y>>XY_SHIFT)), Point((int)(pt2.x>>XY_SHIFT), (int)(pt2.y>>XY_SHIFT)), color);
+        Line(img, Point((int)(pt1.x>>XY_SHIFT), (int)(pt1.y>>XY_SHIFT)), Point((int)(pt2.x>>XY_SHIFT), (int)(pt2.y>>XY_SHIFT)), color, 8, rows);
         return;
     }
 
@@ -445,15 +471,15 @@ LineAA( Mat& img, Point2l pt1, Point2l pt2, const void* color )
                 int a, dist = (pt1.y >> (XY_SHIFT - 5)) & 31;
 
                 a = (ep_corr * FilterTable[dist + 32] >> 8) & 0xff;
-                if( (unsigned)y < (unsigned)size0.height )
+                if( (unsigned)(y - ry0) < rh )
                     ICV_PUT_POINT(x, y)
 
                 a = (ep_corr * FilterTable[dist] >> 8) & 0xff;
-                if( (unsigned)(y+1) < (unsigned)size0.height )
+                if( (unsigned)(y+1 - ry0) < rh )
                     ICV_PUT_POINT(x, y+1)
 
                 a = (ep_corr * FilterTable[63 - dist] >> 8) & 0xff;
-                if( (unsigned)(y+2) < (unsigned)size0.height )
+                if( (unsigned)(y+2 - ry0) < rh )
                     ICV_PUT_POINT(x, y+2)
             }
         }
@@ -463,7 +489,7 @@ LineAA( Mat& img, Point2l pt1, Point2l pt2, const void* color )
 
             for( ; ecount >= 0; y++, pt1.x += x_step, scount++, ecount-- )
             {
-                if( (unsigned)y >= (unsigned)size0.height )
+                if( (unsigned)(y - ry0) >= rh )
                     continue;
                 int x = (int)((pt1.x >> XY_SHIFT) - 1);
                 int ep_corr = ep_table[(((scount >= 2) + 1) & (scount | 2)) * 3 +
@@ -511,15 +537,15 @@ LineAA( Mat& img, Point2l pt1, Point2l pt2, const void* color )
                 int a, dist = (pt1.y >> (XY_SHIFT - 5)) & 31;
 
                 a = (ep_corr * FilterTable[dist + 32] >> 8) & 0xff;
-                if( (unsigned)y < (unsigned)size0.height )
+                if( (unsigned)(y - ry0) < rh )
                     ICV_PUT_POINT(x, y)
 
                 a = (ep_corr * FilterTable[dist] >> 8) & 0xff;
-                if( (unsigned)(y+1) < (unsigned)size0.height )
+                if( (unsigned)(y+1 - ry0) < rh )
                     ICV_PUT_POINT(x, y+1)
 
                 a = (ep_corr * FilterTable[63 - dist] >> 8) & 0xff;
-                if( (unsigned)(y+2) < (unsigned)size0.height )
+                if( (unsigned)(y+2 - ry0) < rh )
                     ICV_PUT_POINT(x, y+2)
             }
         }
@@ -529,7 +555,7 @@ LineAA( Mat& img, Point2l pt1, Point2l pt2, const void* color )
 
             for( ; ecount >= 0; y++, pt1.x += x_step, scount++, ecount-- )
             {
-                if( (unsigned)y >= (unsigned)size0.height )
+                if( (unsigned)(y - ry0) >= rh )
                     continue;
                 int x = (int)((pt1.x >> XY_SHIFT) - 1);
                 int ep_corr = ep_table[(((scount >= 2) + 1) & (scount | 2)) * 3 +
@@ -588,15 +614,15 @@ LineAA( Mat& img, Point2l pt1, Point2l pt2, const void* color )
                 int a, dist = (pt1.y >> (XY_SHIFT - 5)) & 31;
 
                 a = (ep_corr * FilterTable[dist + 32] >> 8) & 0xff;
-                if( (unsigned)y < (unsigned)size0.height )
+                if( (unsigned)(y - ry0) < rh )
                     ICV_PUT_POINT(x, y)
 
                 a = (ep_corr * FilterTable[dist] >> 8) & 0xff;
-                if( (unsigned)(y+1) < (unsigned)size0.height )
+                if( (unsigned)(y+1 - ry0) < rh )
                     ICV_PUT_POINT(x, y+1)
 
                 a = (ep_corr * FilterTable[63 - dist] >> 8) & 0xff;
-                if( (unsigned)(y+2) < (unsigned)size0.height )
+                if( (unsigned)(y+2 - ry0) < rh )
                     ICV_PUT_POINT(x, y+2)
             }
         }
@@ -606,7 +632,7 @@ LineAA( Mat& img, Point2l pt1, Point2l pt2, const void* color )
 
             for( ; ecount >= 0; y++, pt1.x += x_step, scount++, ecount-- )
             {
-                if( (unsigned)y >= (unsigned)size0.height )
+                if( (unsigned)(y - ry0) >= rh )
                     continue;
                 int x = (int)((pt1.x >> XY_SHIFT) - 1);
                 int ep_corr = ep_table[(((scount >= 2) + 1) & (scount | 2)) * 3 +
@@ -632,7 +658,7 @@ LineAA( Mat& img, Point2l pt1, Point2l pt2, const void* color )
 
 
 static void
-Line2( Mat& img, Point2l pt1, Point2l pt2, const void* color)
+Line2( Mat& img, Point2l pt1, Point2l pt2, const void* color, const Range& rows = Range::all() )
 {
     int64 dx, dy;
     int ecount;
@@ -647,6 +673,8 @@ Line2( Mat& img, Point2l pt1, Point2l pt2, const void* color)
     uchar *ptr = img.ptr(), *tptr;
     size_t step = img.step;
     Size size = img.size();
+    int ry0, ry1;
+    clipRows(rows, img.rows, ry0, ry1);
 
     //CV_Assert( img && (nch == 1 || nch == 3) && img.depth() == CV_8U );
 
@@ -699,7 +727,7 @@ Line2( Mat& img, Point2l pt1, Point2l pt2, const void* color)
         #define  ICV_PUT_POINT(_x,_y)   \
         x = (_x); y = (_y);             \
         if( 0 <= x && x < size.width && \
-            0 <= y && y < size.height ) \
+            ry0 <= y && y < ry1 ) \
         {                               \
             tptr = ptr + y*step + x*3;  \
             tptr[0] = (uchar)cb;        \
@@ -742,7 +770,7 @@ Line2( Mat& img, Point2l pt1, Point2l pt2, const void* color)
         #define  ICV_PUT_POINT(_x,_y) \
         x = (_x); y = (_y);           \
         if( 0 <= x && x < size.width && \
-            0 <= y && y < size.height ) \
+            ry0 <= y && y < ry1 ) \
         {                           \
             tptr = ptr + y*step + x;\
             tptr[0] = (uchar)cb;    \
@@ -783,7 +811,7 @@ Line2( Mat& img, Point2l pt1, Point2l pt2, const void* color)
         #define  ICV_PUT_POINT(_x,_y)   \
         x = (_x); y = (_y);             \
         if( 0 <= x && x < size.width && \
-            0 <= y && y < size.height ) \
+            ry0 <= y && y < ry1 ) \
         {                               \
             tptr = ptr + y*step + x*pix_size;\
             for( j = 0; j < pix_size; j++ ) \
@@ -1012,7 +1040,7 @@ void ellipse2Poly( Point2d center, Size2d axes, int angle,
 static void
 EllipseEx( Mat& img, Point2l center, Size2l axes,
            int angle, int arc_start, int arc_end,
-           const void* color, int thickness, int line_type )
+           const void* color, int thickness, int line_type, const Range& rows = Range::all() )
 {
     axes.width = std::abs(axes.width), axes.height = std::abs(axes.height);
     int delta = (int)((std::max(axes.width,axes.height)+(XY_ONE>>1))>>XY_SHIFT);
@@ -1042,15 +1070,15 @@ EllipseEx( Mat& img, Point2l center, Size2l axes,
     }
 
     if( thickness >= 0 )
-        PolyLine( img, &v[0], (int)v.size(), false, color, thickness, line_type, XY_SHIFT );
+        PolyLine( img, &v[0], (int)v.size(), false, color, thickness, line_type, XY_SHIFT, rows );
     else if( arc_end - arc_start >= 360 )
-        FillConvexPoly( img, &v[0], (int)v.size(), color, line_type, XY_SHIFT );
+        FillConvexPoly( img, &v[0], (int)v.size(), color, line_type, XY_SHIFT, rows );
     else
     {
         v.push_back(center);
         std::vector<PolyEdge> edges;
-        CollectPolyEdges( img,  &v[0], (int)v.size(), edges, color, line_type, XY_SHIFT );
-        FillEdgeCollection( img, edges, color, line_type );
+        CollectPolyEdges( img,  &v[0], (int)v.size(), edges, color, line_type, XY_SHIFT, Point(), rows );
+        FillEdgeCollection( img, edges, color, line_type, rows );
     }
 }
 
@@ -1092,7 +1120,8 @@ static inline void ICV_HLINE(uchar* ptr, int64_t xl, int64_t xr, const void* col
 
 /* filling convex polygon. v - array of vertices, ntps - number of points */
 static void
-FillConvexPoly( Mat& img, const Point2l* v, int npts, const void* color, int line_type, int shift )
+FillConvexPoly( Mat& img, const Point2l* v, int npts, const void* color, int line_type, int shift,
+                const Range& rows )
 {
     struct
     {
@@ -1111,6 +1140,8 @@ FillConvexPoly( Mat& img, const Point2l* v, int npts, const void* color, int lin
     int pix_size = (int)img.elemSize();
     Point2l p0;
     int delta1, delta2;
+    int ry0, ry1;
+    clipRows(rows, img.rows, ry0, ry1);
 
     if( line_type < cv::LINE_AA )
         delta1 = delta2 = XY_ONE >> 1;
@@ -1150,13 +1181,13 @@ FillConvexPoly( Mat& img, const Point2l* v, int npts, const void* color, int lin
                 pt0.y = (int)(p0.y >> XY_SHIFT);
                 pt1.x = (int)(p.x >> XY_SHIFT);
                 pt1.y = (int)(p.y >> XY_SHIFT);
-                Line( img, pt0, pt1, color, line_type );
+                Line( img, pt0, pt1, color, line_type, rows );
             }
             else
-                Line2( img, p0, p, color );
+                Line2( img, p0, p, color, rows );
         }
         else
-            LineAA( img, p0, p, color );
+            LineAA( img, p0, p, color, rows );
         p0 = p;
     }
 
@@ -1165,10 +1196,10 @@ FillConvexPoly( Mat& img, const Point2l* v, int npts, const void* color, int lin
     ymin = (ymin + delta) >> shift;
     ymax = (ymax + delta) >> shift;
 
-    if( npts < 3 || (int)xmax < 0 || (int)ymax < 0 || (int)xmin >= size.width || (int)ymin >= size.height )
+    if( npts < 3 || (int)xmax < 0 || (int)ymax < ry0 || (int)xmin >= size.width || (int)ymin >= ry1 )
         return;
 
-    ymax = MIN( ymax, size.height - 1 );
+    ymax = MIN( ymax, ry1 - 1 );
     edge[0].idx = edge[1].idx = imin;
 
     edge[0].ye = edge[1].ye = y = (int)ymin;
@@ -1223,7 +1254,7 @@ FillConvexPoly( Mat& img, const Point2l* v, int npts, const void* color, int lin
         if (edges < 0)
             break;
 
-        if (y >= 0)
+        if (y >= ry0)
         {
             int left = 0, right = 1;
             if (edge[0].x > edge[1].x)
@@ -1260,7 +1291,7 @@ FillConvexPoly( Mat& img, const Point2l* v, int npts, const void* color, int lin
 
 static void
 CollectPolyEdges( Mat& img, const Point2l* v, int count, std::vector<PolyEdge>& edges,
-                  const void* color, int line_type, int shift, Point offset )
+                  const void* color, int line_type, int shift, Point offset, const Range& rows )
 {
     int i, delta = offset.y + ((1 << shift) >> 1);
     Point2l pt0 = v[count-1], pt1;
@@ -1285,7 +1316,7 @@ CollectPolyEdges( Mat& img, const Point2l* v, int count, std::vector<PolyEdge>&
             t0.y = pt0.y; t1.y = pt1.y;
             t0.x = (pt0.x + (XY_ONE >> 1)) >> XY_SHIFT;
             t1.x = (pt1.x + (XY_ONE >> 1)) >> XY_SHIFT;
-            Line(img, t0, t1, color, line_type);
+            Line(img, t0, t1, color, line_type, rows);
 
             // use clipped endpoints to create a more accurate PolyEdge
             if ((unsigned)t0.x >= (unsigned)(img.cols) ||
@@ -1313,7 +1344,7 @@ CollectPolyEdges( Mat& img, const Point2l* v, int count, std::vector<PolyEdge>&
             t0.x = pt0.x; t1.x = pt1.x;
             t0.y = pt0.y << XY_SHIFT;
             t1.y = pt1.y << XY_SHIFT;
-            LineAA(img, t0, t1, color);
+            LineAA(img, t0, t1, color, rows);
         }
 
         if (pt0.y == pt1.y)
@@ -1348,7 +1379,8 @@ struct CmpEdges
 /**************** helper macros and functions for sequence/contour processing ***********/
 
 static void
-FillEdgeCollection( Mat& img, std::vector<PolyEdge>& edges, const void* color, int line_type)
+FillEdgeCollection( Mat& img, std::vector<PolyEdge>& edges, const void* color, int line_type,
+                    const Range& rows )
 {
     PolyEdge tmp;
     int i, y, total = (int)edges.size();
@@ -1358,6 +1390,8 @@ FillEdgeCollection( Mat& img, std::vector<PolyEdge>& edges, const void* color, i
     int64 x_max = 0xFFFFFFFFFFFFFFFF, x_min = 0x7FFFFFFFFFFFFFFF;
     int pix_size = (int)img.elemSize();
     int delta;
+    int ry0, ry1;
+    clipRows(rows, img.rows, ry0, ry1);
 
     if (line_type < cv::LINE_AA)
         delta = 0;
@@ -1382,7 +1416,7 @@ FillEdgeCollection( Mat& img, std::vector<PolyEdge>& edges, const void* color, i
         x_max = std::max( x_max, x1 );
     }
 
-    if( y_max < 0 || y_min >= size.height || x_max < 0 || x_min >= ((int64)size.width<<XY_SHIFT) )
+    if( y_max < ry0 || y_min >= ry1 || x_max < 0 || x_min >= ((int64)size.width<<XY_SHIFT) )
         return;
 
     std::sort( edges.begin(), edges.end(), CmpEdges() );
@@ -1394,13 +1428,13 @@ FillEdgeCollection( Mat& img, std::vector<PolyEdge>& edges, const void* color, i
     i = 0;
     tmp.next = 0;
     e = &edges[i];
-    y_max = MIN( y_max, size.height );
+    y_max = MIN( y_max, ry1 );
 
     for( y = e->y0; y < y_max; y++ )
     {
         PolyEdge *last, *prelast, *keep_prelast;
         int draw = 0;
-        int clipline = y < 0;
+        int clipline = y < ry0;
 
         prelast = &tmp;
         last = tmp.next;
@@ -1504,15 +1538,17 @@ FillEdgeCollection( Mat& img, std::vector<PolyEdge>& edges, const void* color, i
 
 /* draws simple or filled circle */
 static void
-Circle( Mat& img, Point center, int radius, const void* color, int fill )
+Circle( Mat& img, Point center, int radius, const void* color, int fill, const Range& rows = Range::all() )
 {
     Size size = img.size();
+    int ry0, ry1;
+    clipRows(rows, img.rows, ry0, ry1);
     size_t step = img.step;
     int pix_size = (int)img.elemSize();
     uchar* ptr = img.ptr();
     int64_t err = 0, dx = radius, dy = 0, plus = 1, minus = (radius << 1) - 1;
     int inside = center.x >= radius && center.x < size.width - radius &&
-        center.y >= radius && center.y < size.height - radius;
+        center.y >= ry0 + radius && center.y < ry1 - radius;
 
     #define ICV_PUT_POINT( ptr, x )     \
         memcpy( ptr + (x)*pix_size, color, pix_size );
@@ -1557,7 +1593,7 @@ Circle( Mat& img, Point center, int radius, const void* color, int fill )
                 ICV_HLINE( tptr1, x21, x22, color, pix_size );
             }
         }
-        else if( x11 < size.width && x12 >= 0 && y21 < size.height && y22 >= 0)
+        else if( x11 < size.width && x12 >= 0 && y21 < ry1 && y22 >= ry0)
         {
             if( fill )
             {
@@ -1565,7 +1601,7 @@ Circle( Mat& img, Point center, int radius, const void* color, int fill )
                 x12 = MIN( x12, size.width - 1 );
             }
 
-            if( y11 >= 0 && y11 < size.height )
+            if( y11 >= ry0 && y11 < ry1 )
             {
                 uchar *tptr = ptr + y11 * step;
 
@@ -1580,7 +1616,7 @@ Circle( Mat& img, Point center, int radius, const void* color, int fill )
                     ICV_HLINE( tptr, x11, x12, color, pix_size );
             }
 
-            if( y12 >= 0 && y12 < size.height )
+            if( y12 >= ry0 && y12 < ry1 )
             {
                 uchar *tptr = ptr + y12 * step;
 
@@ -1603,7 +1639,7 @@ Circle( Mat& img, Point center, int radius, const void* color, int fill )
                     x22 = MIN( x22, size.width - 1 );
                 }
 
-                if( y21 >= 0 && y21 < size.height )
+                if( y21 >= ry0 && y21 < ry1 )
                 {
                     uchar *tptr = ptr + y21 * step;
 
@@ -1618,7 +1654,7 @@ Circle( Mat& img, Point center, int radius, const void* color, int fill )
                         ICV_HLINE( tptr, x21, x22, color, pix_size );
                 }
 
-                if( y22 >= 0 && y22 < size.height )
+                if( y22 >= ry0 && y22 < ry1 )
                 {
                     uchar *tptr = ptr + y22 * step;
 
@@ -1651,7 +1687,7 @@ Circle( Mat& img, Point center, int radius, const void* color, int fill )
 
 static void
 ThickLine( Mat& img, Point2l p0, Point2l p1, const void* color,
-           int thickness, int line_type, int flags, int shift )
+           int thickness, int line_type, int flags, int shift, const Range& rows = Range::all() )
 {
     static const double INV_XY_ONE = 1./XY_ONE;
 
@@ -1670,13 +1706,13 @@ ThickLine( Mat& img, Point2l p0, Point2l p1, const void* color,
                 p0.y = (p0.y + (XY_ONE>>1)) >> XY_SHIFT;
                 p1.x = (p1.x + (XY_ONE>>1)) >> XY_SHIFT;
                 p1.y = (p1.y + (XY_ONE>>1)) >> XY_SHIFT;
-                Line( img, p0, p1, color, line_type );
+                Line( img, p0, p1, color, line_type, rows );
             }
             else
-                Line2( img, p0, p1, color );
+                Line2( img, p0, p1, color, rows );
         }
         else
-            LineAA( img, p0, p1, color );
+            LineAA( img, p0, p1, color, rows );
     }
     else
     {
@@ -1701,7 +1737,7 @@ ThickLine( Mat& img, Point2l p0, Point2l p1, const void* color,
             pt[3].x = p1.x + dp.x;
             pt[3].y = p1.y + dp.y;
 
-            FillConvexPoly( img, pt, 4, color, line_type, XY_SHIFT );
+            FillConvexPoly( img, pt, 4, color, line_type, XY_SHIFT, rows );
         }
 
         for( i = 0; i < 2; i++ )
@@ -1713,12 +1749,12 @@ ThickLine( Mat& img, Point2l p0, Point2l p1, const void* color,
                     Point center;
                     center.x = (int)((p0.x + (XY_ONE>>1)) >> XY_SHIFT);
                     center.y = (int)((p0.y + (XY_ONE>>1)) >> XY_SHIFT);
-                    Circle( img, center, (thickness + (XY_ONE>>1)) >> XY_SHIFT, color, 1 );
+                    Circle( img, center, (thickness + (XY_ONE>>1)) >> XY_SHIFT, color, 1, rows );
                 }
                 else
                 {
                     EllipseEx( img, p0, Size2l(thickness, thickness),
-                               0, 0, 360, color, -1, line_type );
+                               0, 0, 360, color, -1, line_type, rows );
                 }
             }
             p0 = p1;
@@ -1730,7 +1766,7 @@ ThickLine( Mat& img, Point2l p0, Point2l p1, const void* color,
 static void
 PolyLine( Mat& img, const Point2l* v, int count, bool is_closed,
           const void* color, int thickness,
-          int line_type, int shift )
+          int line_type, int shift, const Range& rows )
 {
     if( !v || count <= 0 )
         return;
@@ -1744,7 +1780,7 @@ PolyLine( Mat& img, const Point2l* v, int count, bool is_closed,
     for( i = !is_closed; i < count; i++ )
     {
         Point2l p = v[i];
-        ThickLine( img, p0, p, color, thickness, line_type, flags, shift );
+        ThickLine( img, p0, p, color, thickness, line_type, flags, shift, rows );
         p0 = p;
         flags = 2;
     }
@@ -2290,29 +2326,81 @@ inline void readCheck(int &c, int &i, const String &text, int fontFace)
 
 extern const char* g_HersheyGlyphs[];
 
-void putText( InputOutputArray _img, const String& text, Point org,
-              int fontFace, double fontScale, Scalar color,
-              int thickness, int line_type, bool bottomLeftOrigin )
+/* Hershey glyphs parsed once: the horizontal extent and the strokes (of 2 or more vertices). */
+struct HersheyGlyph
+{
+    int left, right;
+    std::vector<Point> pts;
+    std::vector<int> strokeEnd;
+};
 
+template<size_t N> static int maxGlyphIndex( const int (&ascii)[N] )
 {
-    CV_INSTRUMENT_REGION();
+    return *std::max_element(ascii + 1, ascii + N);
+}
 
-    if ( text.empty() )
+static std::vector<HersheyGlyph> parseHersheyGlyphs()
+{
+    int n = std::max(std::max(std::max(maxGlyphIndex(HersheyPlain), maxGlyphIndex(HersheyPlainItalic)),
+                              std::max(maxGlyphIndex(HersheyComplexSmall), maxGlyphIndex(HersheyComplexSmallItalic))),
+                     std::max(std::max(maxGlyphIndex(HersheySimplex), maxGlyphIndex(HersheyDuplex)),
+                              std::max(maxGlyphIndex(HersheyComplex), maxGlyphIndex(HersheyComplexItalic))));
+    n = std::max(n, std::max(std::max(maxGlyphIndex(HersheyTriplex), maxGlyphIndex(HersheyTriplexItalic)),
+                             std::max(maxGlyphIndex(HersheyScriptSimplex), maxGlyphIndex(HersheyScriptComplex))));
+
+    std::vector<HersheyGlyph> glyphs(n + 1);
+    for( int k = 0; k <= n; k++ )
     {
-        return;
+        HersheyGlyph& g = glyphs[k];
+        const char* ptr = g_HersheyGlyphs[k];
+        if( !ptr[0] || !ptr[1] )
+        {
+            g.left = g.right = 0;
+            continue;
+        }
+        g.left = (uchar)ptr[0] - 'R';
+        g.right = (uchar)ptr[1] - 'R';
+        size_t start = 0;
+
+        for( ptr += 2;; )
+        {
+            if( *ptr == ' ' || !*ptr )
+            {
+                if( g.pts.size() - start > 1 )
+                    g.strokeEnd.push_back((int)g.pts.size());
+                else
+                    g.pts.resize(start);
+                start = g.pts.size();
+                if( !*ptr++ )
+                    break;
+            }
+            else
+            {
+                g.pts.push_back(Point((uchar)ptr[0] - 'R', (uchar)ptr[1] - 'R'));
+                ptr += 2;
+            }
+        }
     }
-    Mat img = _img.getMat();
-    const int* ascii = getFontData(fontFace);
+    return glyphs;
+}
 
-    double buf[4];
-    scalarToRawData(color, buf, img.type(), 0);
+static const std::vector<HersheyGlyph>& getHersheyGlyphs()
+{
+    static const std::vector<HersheyGlyph> glyphs = parseHersheyGlyphs();
+    return glyphs;
+}
+
+/* Calls stroke(pts, npts) for every stroke of the text, with XY_SHIFT fractional bits. */
+template<typename StrokeFn> static void
+forEachTextStroke( const String& text, Point org, int fontFace, double fontScale,
+                   bool bottomLeftOrigin, StrokeFn stroke )
+{
+    const int* ascii = getFontData(fontFace);
+    const std::vector<HersheyGlyph>& glyphs = getHersheyGlyphs();
 
     int base_line = -(ascii[0] & 15);
     int hscale = cvRound(fontScale*XY_ONE), vscale = hscale;
 
-    if( line_type == cv::LINE_AA && img.depth() != CV_8U )
-        line_type = 8;
-
     if( bottomLeftOrigin )
         vscale = -vscale;
 
@@ -2320,44 +2408,55 @@ void putText( InputOutputArray _img, const String& text, Point org,
     int64 view_y = ((int64)org.y << XY_SHIFT) + base_line*vscale;
     std::vector<Point2l> pts;
     pts.reserve(1 << 10);
-    const char **faces = cv::g_HersheyGlyphs;
 
     for( int i = 0; i < (int)text.size(); i++ )
     {
         int c = (uchar)text[i];
-        Point2l p;
 
         readCheck(c, i, text, fontFace);
 
-        const char* ptr = faces[ascii[(c-' ')+1]];
-        p.x = (uchar)ptr[0] - 'R';
-        p.y = (uchar)ptr[1] - 'R';
-        int64 dx = p.y*hscale;
-        view_x -= p.x*hscale;
-        pts.resize(0);
+        const HersheyGlyph& g = glyphs[ascii[(c-' ')+1]];
+        int64 dx = (int64)g.right*hscale;
+        view_x -= (int64)g.left*hscale;
 
-        for( ptr += 2;; )
+        for( size_t k = 0, start = 0; k < g.strokeEnd.size(); k++ )
         {
-            if( *ptr == ' ' || !*ptr )
-            {
-                if( pts.size() > 1 )
-                    PolyLine( img, &pts[0], (int)pts.size(), false, buf, thickness, line_type, XY_SHIFT );
-                if( !*ptr++ )
-                    break;
-                pts.resize(0);
-            }
-            else
-            {
-                p.x = (uchar)ptr[0] - 'R';
-                p.y = (uchar)ptr[1] - 'R';
-                ptr += 2;
-                pts.push_back(Point2l(p.x*hscale + view_x, p.y*vscale + view_y));
-            }
+            size_t end = g.strokeEnd[k];
+            pts.resize(end - start);
+            for( size_t j = start; j < end; j++ )
+                pts[j - start] = Point2l(g.pts[j].x*hscale + view_x, g.pts[j].y*vscale + view_y);
+            stroke(&pts[0], (int)pts.size());
+            start = end;
         }
         view_x += dx;
     }
 }
 
+void putText( InputOutputArray _img, const String& text, Point org,
+              int fontFace, double fontScale, Scalar color,
+              int thickness, int line_type, bool bottomLeftOrigin )
+
+{
+    CV_INSTRUMENT_REGION();
+
+    if ( text.empty() )
+    {
+        return;
+    }
+    Mat img = _img.getMat();
+
+    double buf[4];
+    scalarToRawData(color, buf, img.type(), 0);
+
+    if( line_type == cv::LINE_AA && img.depth() != CV_8U )
+        line_type = 8;
+
+    forEachTextStroke(text, org, fontFace, fontScale, bottomLeftOrigin, [&](const Point2l* pts, int npts)
+    {
+        PolyLine( img, pts, npts, false, buf, thickness, line_type, XY_SHIFT );
+    });
+}
+
 Size getTextSize( const String& text, int fontFace, double fontScale, int thickness, int* _base_line)
 {
     Size size;
@@ -2399,6 +2498,290 @@ double getFontScaleFromHeight(const int fontFace, const int pixelHeight, const i
     return static_cast<double>(pixelHeight - static_cast<double>((thickness + 1)) / 2.0) / static_cast<double>(cap_line + base_line);
 }
 
+/****************************************************************************************\
+*                                   DrawList                                             *
+\****************************************************************************************/
+
+namespace {
+
+class DrawListImpl CV_FINAL : public DrawList
+{
+public:
+    enum { PRIM_LINE, PRIM_RECT, PRIM_CIRCLE, PRIM_POLYLINES, PRIM_FILLPOLY };
+
+    // a recorded primitive; the points of its contours are pts[ofs, ofs + sum(sizes[cofs, cofs + ncontours)))
+    struct Primitive
+    {
+        int kind;
+        Scalar color;
+        int thickness, lineType, shift;
+        bool closed;
+        int ofs, cofs, ncontours;
+        int64 radius;
+        Point offset;
+        int64 y0, y1; // the rows that may be written, a conservative range
+    };
+
+    void addLine(Point pt1, Point pt2, const Scalar& color, int thickness, int lineType, int shift) CV_OVERRIDE
+    {
+        CV_Assert( 0 < thickness && thickness <= MAX_THICKNESS );
+        CV_Assert( 0 <= shift && shift <= XY_SHIFT );
+        Primitive& p = newPrimitive(PRIM_LINE, color, thickness, lineType, shift);
+        pts.push_back(pt1);
+        pts.push_back(pt2);
+        finishPrimitive(p, 2);
+    }
+
+    void addRectangle(Rect rec, const Scalar& color, int thickness, int lineType, int shift) CV_OVERRIDE
+    {
+        CV_Assert( thickness <= MAX_THICKNESS );
+        CV_Assert( 0 <= shift && shift <= XY_SHIFT );
+        // cropped at render time, as in rectangle(img, Rect, ...)
+        Primitive& p = newPrimitive(PRIM_RECT, color, thickness, lineType, shift);
+        pts.push_back(Point2l(rec.x, rec.y));
+        pts.push_back(Point2l((int64)rec.x + rec.width, (int64)rec.y + rec.height));
+        finishPrimitive(p, 2);
+    }
+
+    void addCircle(Point center, int radius, const Scalar& color, int thickness, int lineType, int shift) CV_OVERRIDE
+    {
+        CV_Assert( radius >= 0 && thickness <= MAX_THICKNESS &&
+                   0 <= shift && shift <= XY_SHIFT );
+        Primitive& p = newPrimitive(PRIM_CIRCLE, color, thickness, lineType, shift);
+        p.radius = radius;
+        pts.push_back(center);
+        finishPrimitive(p, 1);
+    }
+
+    void addPolylines(InputArrayOfArrays _pts, bool isClosed, const Scalar& color,
+                      int thickness, int lineType, int shift) CV_OVERRIDE
+    {
+        CV_Assert( 0 <= thickness && thickness <= MAX_THICKNESS &&
+                   0 <= shift && shift <= XY_SHIFT );
+        Primitive& p = newPrimitive(PRIM_POLYLINES, color, thickness, lineType, shift);
+        p.closed = isClosed;
+        finishPrimitive(p, addContours(_pts));
+    }
+
+    void addFillPoly(InputArrayOfArrays _pts, const Scalar& color, int lineType, int shift, Point offset) CV_OVERRIDE
+    {
+        CV_Assert( 0 <= shift && shift <= XY_SHIFT );
+        Primitive& p = newPrimitive(PRIM_FILLPOLY, color, 0, lineType, shift);
+        p.offset = offset;
+        finishPrimitive(p, addContours(_pts));
+    }
+
+    void addText(const String& text, Point org, int fontFace, double fontScale,
+                 const Scalar& color, int thickness, int lineType, bool bottomLeftOrigin) CV_OVERRIDE
+    {
+        CV_Assert( 0 <= thickness && thickness <= MAX_THICKNESS );
+        if( text.empty() )
+            return;
+        // the strokes are expanded here and drawn as polylines with XY_SHIFT fractional bits
+        Primitive& p = newPrimitive(PRIM_POLYLINES, color, thickness, lineType, XY_SHIFT);
+        int total = 0;
+        forEachTextStroke(text, org, fontFace, fontScale, bottomLeftOrigin, [&](const Point2l* v, int n)
+        {
+            pts.insert(pts.end(), v, v + n);
+            sizes.push_back(n);
+            total += n;
+            p.ncontours++;
+        });
+        finishPrimitive(p, total);
+    }
+
+    int getPrimitiveCount() const CV_OVERRIDE
+    {
+        return (int)prims.size();
+    }
+
+    void clear() CV_OVERRIDE
+    {
+        prims.clear();
+        pts.clear();
+        sizes.clear();
+    }
+
+    void render(InputOutputArray _img) const CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        Mat img = _img.getMat();
+        if( prims.empty() || img.empty() )
+            return;
+
+        std::vector<Vec4d> colors(prims.size());
+        for( size_t i = 0; i < prims.size(); i++ )
+            scalarToRawData(prims[i].color, colors[i].val, img.type(), 0);
+
+        int nthreads = getNumThreads();
+        int bandHeight = nthreads <= 1 ? img.rows : std::max(32, img.rows/(nthreads*4));
+        int nbands = (img.rows + bandHeight - 1)/bandHeight;
+        if( nbands <= 1 )
+        {
+            renderBand(img, colors, Range::all());
+            return;
+        }
+
+        parallel_for_(Range(0, nbands), [&](const Range& range)
+        {
+            for( int b = range.start; b < range.end; b++ )
+                renderBand(img, colors, Range(b*bandHeight, std::min((b + 1)*bandHeight, img.rows)));
+        });
+    }
+
+protected:
+    Primitive& newPrimitive(int kind, const Scalar& color, int thickness, int lineType, int shift)
+    {
+        Primitive p;
+        p.kind = kind;
+        p.color = color;
+        p.thickness = thickness;
+        p.lineType = lineType;
+        p.shift = shift;
+        p.closed = false;
+        p.ofs = (int)pts.size();
+        p.cofs = (int)sizes.size();
+        p.ncontours = 0;
+        p.radius = 0;
+        p.y0 = p.y1 = 0;
+        prims.push_back(p);
+        return prims.back();
+    }
+
+    // appends the contours and returns the number of points
+    int addContours(InputArrayOfArrays _pts)
+    {
+        Primitive& p = prims.back();
+        bool manyContours = _pts.kind() == _InputArray::STD_VECTOR_VECTOR ||
+                            _pts.kind() == _InputArray::STD_VECTOR_MAT;
+        int ncontours = manyContours ? (int)_pts.total() : 1, total = 0;
+        for( int i = 0; i < ncontours; i++ )
+        {
+            Mat c = _pts.getMat(manyContours ? i : -1);
+            int n = 0;
+            if( !c.empty() )
+            {
+                CV_Assert( c.checkVector(2, CV_32S) >= 0 );
+                n = (int)(c.total()*c.channels()/2);
+                const Point* v = c.ptr<Point>();
+                pts.insert(pts.end(), v, v + n);
+            }
+            sizes.push_back(n);
+            total += n;
+        }
+        p.ncontours = ncontours;
+        return total;
+    }
+
+    // computes the rows the primitive may write to from its last npts points
+    void finishPrimitive(Primitive& p, int npts)
+    {
+        if( npts == 0 )
+        {
+            p.y0 = 1;
+            p.y1 = 0;
+            return;
+        }
+        int64 ymin = pts[p.ofs].y, ymax = ymin;
+        for( int i = 1; i < npts; i++ )
+        {
+            ymin = std::min(ymin, pts[p.ofs + i].y);
+            ymax = std::max(ymax, pts[p.ofs + i].y);
+        }
+        ymin += p.offset.y - p.radius;
+        ymax += p.offset.y + p.radius;
+        // half of the line width plus the anti-aliasing and rounding margins
+        int64 pad = std::max(p.thickness, 0)/2 + 3;
+        p.y0 = (ymin >> p.shift) - pad;
+        p.y1 = (ymax >> p.shift) + pad + 1;
+    }
+
+    void renderBand(Mat& img, const std::vector<Vec4d>& colors, const Range& rows) const
+    {
+        int64 by0 = rows == Range::all() ? 0 : rows.start;
+        int64 by1 = rows == Range::all() ? img.rows : rows.end;
+        std::vector<PolyEdge> edges;
+        std::vector<Point2l> tmp;
+
+        for( size_t i = 0; i < prims.size(); i++ )
+        {
+            const Primitive& p = prims[i];
+            if( p.y1 <= by0 || p.y0 >= by1 )
+                continue;
+
+            const void* color = colors[i].val;
+            const Point2l* v = &pts[p.ofs];
+            int lineType = p.lineType == LINE_AA && img.depth() != CV_8U ? 8 : p.lineType;
+
+            switch( p.kind )
+            {
+            case PRIM_LINE:
+                ThickLine( img, v[0], v[1], color, p.thickness, lineType, 3, p.shift, rows );
+                break;
+            case PRIM_RECT:
+            {
+                int64 one = (int64)1 << p.shift;
+                Rect rec((int)v[0].x, (int)v[0].y, (int)(v[1].x - v[0].x), (int)(v[1].y - v[0].y));
+                rec &= Rect(-(int)one, -(int)one, (img.cols + 2) << p.shift, (img.rows + 2) << p.shift);
+                if( rec.empty() )
+                    break;
+                Point2l r[4];
+                r[0] = Point2l(rec.x, rec.y);
+                r[2] = Point2l((int64)rec.x + rec.width - one, (int64)rec.y + rec.height - one);
+                r[1] = Point2l(r[2].x, r[0].y);
+                r[3] = Point2l(r[0].x, r[2].y);
+                if( p.thickness >= 0 )
+                    PolyLine( img, r, 4, true, color, p.thickness, lineType, p.shift, rows );
+                else
+                    FillConvexPoly( img, r, 4, color, lineType, p.shift, rows );
+                break;
+            }
+            case PRIM_CIRCLE:
+                if( p.thickness > 1 || lineType != LINE_8 || p.shift > 0 )
+                {
+                    Point2l center(v[0].x << (XY_SHIFT - p.shift), v[0].y << (XY_SHIFT - p.shift));
+                    int64 radius = p.radius << (XY_SHIFT - p.shift);
+                    EllipseEx( img, center, Size2l(radius, radius), 0, 0, 360, color, p.thickness, lineType, rows );
+                }
+                else
+                    Circle( img, Point((int)v[0].x, (int)v[0].y), (int)p.radius, color, p.thickness < 0, rows );
+                break;
+            case PRIM_POLYLINES:
+                for( int k = 0; k < p.ncontours; k++ )
+                {
+                    int n = sizes[p.cofs + k];
+                    PolyLine( img, v, n, p.closed, color, p.thickness, lineType, p.shift, rows );
+                    v += n;
+                }
+                break;
+            case PRIM_FILLPOLY:
+                edges.clear();
+                for( int k = 0; k < p.ncontours; k++ )
+                {
+                    int n = sizes[p.cofs + k];
+                    if( n > 0 )
+                        CollectPolyEdges( img, v, n, edges, color, lineType, p.shift, p.offset, rows );
+                    v += n;
+                }
+                FillEdgeCollection( img, edges, color, lineType, rows );
+                break;
+            }
+        }
+    }
+
+    std::vector<Primitive> prims;
+    std::vector<Point2l> pts;
+    std::vector<int> sizes;
+};
+
+} // namespace
+
+Ptr<DrawList> createDrawList()
+{
+    return makePtr<DrawListImpl>();
+}
+
 }
 
 void cv::fillConvexPoly(InputOutputArray img, InputArray _points,
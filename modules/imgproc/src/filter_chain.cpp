@@ -0,0 +1,368 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "filterengine.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+/*
+ The chain is run on bands of rows. Inside a band the source rows are fed by small portions to the
+ first stage; every stage converts the rows it receives with FilterEngine::proceed (which keeps its
+ own ring buffer of the rows covered by the aperture) or a point-wise operation and immediately passes
+ its output rows to the next stage. Only a few rows of every intermediate image exist at a time.
+
+ The rows that a band needs from the previous stage are found backwards from the last stage with
+ FilterEngine::start, which gives the halo of the band for each aperture.
+*/
+
+namespace cv {
+
+namespace {
+
+enum FilterChainStageKind
+{
+    FILTER_CHAIN_GAUSSIAN,
+    FILTER_CHAIN_SEP_FILTER,
+    FILTER_CHAIN_SOBEL,
+    FILTER_CHAIN_GRADIENT,
+    FILTER_CHAIN_THRESHOLD,
+    FILTER_CHAIN_CONVERT
+};
+
+struct FilterChainStage
+{
+    FilterChainStage(int _kind) : kind(_kind), ddepth(-1), dx(0), dy(0), ksize(3), thresholdType(0),
+        sigma1(0), sigma2(0), scale(1), delta(0), thresh(0), maxval(0), L2gradient(true) {}
+
+    int kind;
+    int ddepth, dx, dy, ksize, thresholdType;
+    Size gksize;
+    double sigma1, sigma2, scale, delta, thresh, maxval;
+    bool L2gradient;
+    Mat kernelX, kernelY;
+};
+
+// number of source rows passed to the first stage at once
+static const int FILTER_CHAIN_CHUNK = 8;
+
+// per-band state of one stage
+struct FilterChainStep
+{
+    const FilterChainStage* stage;
+    int srcType, dstType;
+    Ptr<FilterEngine> f[2];
+    Mat grad[2];        // derivative rows of the gradient stage
+    Mat buf;            // output rows passed to the next stage
+};
+
+static int filterChainOutputType(const FilterChainStage& s, int srcType)
+{
+    int depth = CV_MAT_DEPTH(srcType), cn = CV_MAT_CN(srcType);
+    switch( s.kind )
+    {
+    case FILTER_CHAIN_GAUSSIAN:
+    case FILTER_CHAIN_THRESHOLD:
+        return srcType;
+    case FILTER_CHAIN_GRADIENT:
+        return CV_MAKETYPE(CV_32F, cn);
+    default:
+        return CV_MAKETYPE(s.ddepth < 0 ? depth : s.ddepth, cn);
+    }
+}
+
+static void createFilterChainEngines(FilterChainStep& step, int borderType)
+{
+    const FilterChainStage& s = *step.stage;
+    int sdepth = CV_MAT_DEPTH(step.srcType), ddepth = CV_MAT_DEPTH(step.dstType);
+    if( s.kind == FILTER_CHAIN_GAUSSIAN )
+        step.f[0] = createGaussianFilter(step.srcType, s.gksize, s.sigma1, s.sigma2, borderType);
+    else if( s.kind == FILTER_CHAIN_SEP_FILTER )
+        step.f[0] = createSeparableLinearFilter(step.srcType, step.dstType, s.kernelX, s.kernelY,
+                                                Point(-1, -1), s.delta, borderType);
+    else if( s.kind == FILTER_CHAIN_SOBEL || s.kind == FILTER_CHAIN_GRADIENT )
+    {
+        // the same kernels as Sobel() uses
+        int nf = s.kind == FILTER_CHAIN_SOBEL ? 1 : 2;
+        for( int i = 0; i < nf; i++ )
+        {
+            int dx = s.kind == FILTER_CHAIN_SOBEL ? s.dx : 1 - i, dy = s.kind == FILTER_CHAIN_SOBEL ? s.dy : i;
+            Mat kx, ky;
+            getDerivKernels(kx, ky, dx, dy, s.ksize, false, std::max(CV_32F, std::max(ddepth, sdepth)));
+            if( s.scale != 1 )
+            {
+                if( dx == 0 )
+                    kx *= s.scale;
+                else
+                    ky *= s.scale;
+            }
+            // both derivatives of the gradient have to consume the same rows, so the 1-tap
+            // smoothing part of ksize=1 is padded to the 3 taps of the derivative
+            if( nf == 2 && kx.total() != ky.total() )
+            {
+                Mat& k = kx.total() < ky.total() ? kx : ky;
+                Mat padded = Mat::zeros(3, 1, k.type());
+                k.copyTo(padded.row(1));
+                k = padded;
+            }
+            step.f[i] = createSeparableLinearFilter(step.srcType, step.dstType, kx, ky,
+                                                    Point(-1, -1), s.kind == FILTER_CHAIN_SOBEL ? s.delta : 0, borderType);
+        }
+    }
+}
+
+static void gradientMagnitudeRow(const float* gx, const float* gy, float* dst, int n, bool L2)
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int VL = VTraits<v_float32>::vlanes();
+    for( ; i <= n - VL; i += VL )
+    {
+        v_float32 x = vx_load(gx + i), y = vx_load(gy + i);
+        v_store(dst + i, L2 ? v_sqrt(v_muladd(x, x, v_mul(y, y))) : v_add(v_abs(x), v_abs(y)));
+    }
+#endif
+    for( ; i < n; i++ )
+        dst[i] = L2 ? std::sqrt(gx[i]*gx[i] + gy[i]*gy[i]) : std::abs(gx[i]) + std::abs(gy[i]);
+}
+
+class FilterChainBand
+{
+public:
+    FilterChainBand(const std::vector<FilterChainStage>& stages, const Mat& _src, Mat& _dst, int borderType) :
+        src(_src), dst(_dst), steps(stages.size())
+    {
+        int type = src.type();
+        for( size_t k = 0; k < stages.size(); k++ )
+        {
+            FilterChainStep& step = steps[k];
+            step.stage = &stages[k];
+            step.srcType = type;
+            step.dstType = type = filterChainOutputType(stages[k], type);
+            createFilterChainEngines(step, borderType);
+        }
+    }
+
+    void run(int y0, int y1)
+    {
+        const int width = src.cols, height = src.rows, nsteps = (int)steps.size();
+        // rows [a, b) of the previous image needed to produce the output rows of every stage
+        int a = y0, b = y1;
+        for( int k = nsteps - 1; k >= 0; k-- )
+        {
+            FilterChainStep& step = steps[k];
+            for( int i = 0; i < 2 && step.f[i]; i++ )
+            {
+                step.f[i]->start(Size(width, height), Size(width, b - a), Point(0, a));
+                CV_DbgAssert( i == 0 || (step.f[i]->startY == step.f[0]->startY && step.f[i]->endY == step.f[0]->endY) );
+            }
+            if( step.f[0] )
+            {
+                a = step.f[0]->startY;
+                b = step.f[0]->endY;
+            }
+        }
+
+        // a stage gets at most the chunk size plus the extra rows of the apertures before it at once
+        int maxRows = FILTER_CHAIN_CHUNK;
+        for( int k = 0; k < nsteps; k++ )
+        {
+            FilterChainStep& step = steps[k];
+            if( step.f[0] )
+                maxRows += step.f[0]->ksize.height - 1;
+            if( step.stage->kind == FILTER_CHAIN_GRADIENT )
+                for( int i = 0; i < 2; i++ )
+                    step.grad[i].create(maxRows, width, step.dstType);
+            if( k < nsteps - 1 )
+                step.buf.create(maxRows, width, step.dstType);
+        }
+
+        dstY = y0;
+        for( int y = a; y < b; y += FILTER_CHAIN_CHUNK )
+            push(0, src.ptr(y), src.step, std::min(FILTER_CHAIN_CHUNK, b - y));
+        CV_Assert( dstY == y1 );
+    }
+
+private:
+    // passes `count` input rows to the stage k
+    void push(int k, const uchar* data, size_t step, int count)
+    {
+        FilterChainStep& s = steps[k];
+        const bool last = k == (int)steps.size() - 1;
+        uchar* out = last ? dst.ptr(dstY) : s.buf.ptr();
+        size_t outStep = last ? dst.step : s.buf.step;
+        int width = src.cols, n = count;
+
+        switch( s.stage->kind )
+        {
+        case FILTER_CHAIN_GAUSSIAN:
+        case FILTER_CHAIN_SEP_FILTER:
+        case FILTER_CHAIN_SOBEL:
+            n = s.f[0]->proceed(data, (int)step, count, out, (int)outStep);
+            break;
+        case FILTER_CHAIN_GRADIENT:
+            n = s.f[0]->proceed(data, (int)step, count, s.grad[0].ptr(), (int)s.grad[0].step);
+            s.f[1]->proceed(data, (int)step, count, s.grad[1].ptr(), (int)s.grad[1].step);
+            for( int i = 0; i < n; i++ )
+                gradientMagnitudeRow(s.grad[0].ptr<float>(i), s.grad[1].ptr<float>(i),
+                                     (float*)(out + outStep*i), width*CV_MAT_CN(s.dstType), s.stage->L2gradient);
+            break;
+        case FILTER_CHAIN_THRESHOLD:
+        {
+            Mat outRows(count, width, s.dstType, out, outStep);
+            threshold(Mat(count, width, s.srcType, (void*)data, step), outRows,
+                      s.stage->thresh, s.stage->maxval, s.stage->thresholdType);
+            break;
+        }
+        case FILTER_CHAIN_CONVERT:
+        {
+            Mat outRows(count, width, s.dstType, out, outStep);
+            Mat(count, width, s.srcType, (void*)data, step).convertTo(outRows, s.dstType, s.stage->scale, s.stage->delta);
+            break;
+        }
+        default:
+            CV_Error(Error::StsInternal, "");
+        }
+
+        if( n <= 0 )
+            return;
+        if( last )
+            dstY += n;
+        else
+            push(k + 1, out, outStep, n);
+    }
+
+    const Mat& src;
+    Mat& dst;
+    std::vector<FilterChainStep> steps;
+    int dstY;
+};
+
+class FilterChainImpl CV_FINAL : public FilterChain
+{
+public:
+    FilterChainImpl(int _borderType) : borderType(_borderType) {}
+
+    void addGaussianBlur(Size ksize, double sigmaX, double sigmaY) CV_OVERRIDE
+    {
+        FilterChainStage s(FILTER_CHAIN_GAUSSIAN);
+        s.gksize = ksize;
+        s.sigma1 = sigmaX;
+        s.sigma2 = sigmaY <= 0 ? sigmaX : sigmaY;
+        CV_Assert( (ksize.width > 0 || sigmaX > 0) && (ksize.height > 0 || s.sigma2 > 0) );
+        stages.push_back(s);
+    }
+
+    void addSepFilter2D(int ddepth, InputArray kernelX, InputArray kernelY, double delta) CV_OVERRIDE
+    {
+        FilterChainStage s(FILTER_CHAIN_SEP_FILTER);
+        s.ddepth = ddepth;
+        s.kernelX = kernelX.getMat().clone();
+        s.kernelY = kernelY.getMat().clone();
+        s.delta = delta;
+        CV_Assert( !s.kernelX.empty() && !s.kernelY.empty() && s.kernelX.type() == s.kernelY.type() &&
+                   (s.kernelX.cols == 1 || s.kernelX.rows == 1) && (s.kernelY.cols == 1 || s.kernelY.rows == 1) );
+        stages.push_back(s);
+    }
+
+    void addSobel(int ddepth, int dx, int dy, int ksize, double scale, double delta) CV_OVERRIDE
+    {
+        FilterChainStage s(FILTER_CHAIN_SOBEL);
+        s.ddepth = ddepth;
+        s.dx = dx;
+        s.dy = dy;
+        s.ksize = ksize;
+        s.scale = scale;
+        s.delta = delta;
+        CV_Assert( dx >= 0 && dy >= 0 && dx + dy > 0 );
+        stages.push_back(s);
+    }
+
+    void addGradientMagnitude(int ksize, bool L2gradient) CV_OVERRIDE
+    {
+        FilterChainStage s(FILTER_CHAIN_GRADIENT);
+        s.ksize = ksize;
+        s.L2gradient = L2gradient;
+        stages.push_back(s);
+    }
+
+    void addThreshold(double thresh, double maxval, int type) CV_OVERRIDE
+    {
+        CV_Assert( (type & (THRESH_OTSU | THRESH_TRIANGLE)) == 0 );
+        FilterChainStage s(FILTER_CHAIN_THRESHOLD);
+        s.thresh = thresh;
+        s.maxval = maxval;
+        s.thresholdType = type;
+        stages.push_back(s);
+    }
+
+    void addConvertTo(int ddepth, double alpha, double beta) CV_OVERRIDE
+    {
+        FilterChainStage s(FILTER_CHAIN_CONVERT);
+        s.ddepth = ddepth;
+        s.scale = alpha;
+        s.delta = beta;
+        stages.push_back(s);
+    }
+
+    void clear() CV_OVERRIDE { stages.clear(); }
+
+    int getStageCount() const CV_OVERRIDE { return (int)stages.size(); }
+
+    void apply(InputArray _src, OutputArray _dst) CV_OVERRIDE
+    {
+        CV_INSTRUMENT_REGION();
+
+        Mat src = _src.getMat();
+        CV_Assert( !src.empty() && src.dims <= 2 );
+        if( stages.empty() )
+        {
+            src.copyTo(_dst);
+            return;
+        }
+
+        int dstType = src.type(), halo = 0;
+        for( size_t k = 0; k < stages.size(); k++ )
+        {
+            const FilterChainStage& s = stages[k];
+            dstType = filterChainOutputType(s, dstType);
+            halo += s.kind == FILTER_CHAIN_GAUSSIAN ? std::max(s.gksize.height, cvRound(s.sigma2*8)) :
+                    s.kind == FILTER_CHAIN_SEP_FILTER ? (int)s.kernelY.total() :
+                    s.kind == FILTER_CHAIN_SOBEL || s.kind == FILTER_CHAIN_GRADIENT ? std::max(s.ksize, 3) : 0;
+        }
+        _dst.create(src.size(), dstType);
+        Mat dst = _dst.getMat();
+        if( src.data == dst.data )
+            src = src.clone();
+
+        // bands are several halos high, so the recomputed rows stay a small fraction of the work
+        int nthreads = getNumThreads();
+        int bandHeight = nthreads <= 1 ? src.rows : std::max(std::max(32, halo*8), src.rows/(nthreads*2));
+        int nbands = std::max(1, (src.rows + bandHeight - 1)/bandHeight);
+        bandHeight = (src.rows + nbands - 1)/nbands;
+
+        parallel_for_(Range(0, nbands), [&](const Range& range)
+        {
+            FilterChainBand band(stages, src, dst, borderType);
+            for( int i = range.start; i < range.end; i++ )
+                band.run(i*bandHeight, std::min((i + 1)*bandHeight, src.rows));
+        });
+    }
+
+private:
+    int borderType;
+    std::vector<FilterChainStage> stages;
+};
+
+} // namespace
+
+Ptr<FilterChain> createFilterChain(int borderType)
+{
+    borderType &= ~BORDER_ISOLATED;
+    CV_Check(borderType, borderType == BORDER_CONSTANT || borderType == BORDER_REPLICATE ||
+             borderType == BORDER_REFLECT || borderType == BORDER_REFLECT_101,
+             "FilterChain: unsupported border type");
+    return makePtr<FilterChainImpl>(borderType);
+}
+
+} // namespace cv
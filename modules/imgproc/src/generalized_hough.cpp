@@ -368,7 +368,11 @@ namespace
         int levels_;
         int votesThreshold_;
 
-        std::vector< std::vector<Point> > r_table_;
+        // R-table: the template edge points relative to the center grouped by the gradient
+        // direction, the points of the direction n are [r_table_ofs_[n], r_table_ofs_[n + 1])
+        std::vector<int> r_table_ofs_;
+        std::vector<int> r_table_x_;
+        std::vector<int> r_table_y_;
         Mat hist_;
     };
 
@@ -384,8 +388,8 @@ namespace
 
         const double thetaScale = levels_ / 360.0;
 
-        r_table_.resize(levels_ + 1);
-        std::for_each(r_table_.begin(), r_table_.end(), [](std::vector<Point>& e)->void { e.clear(); });
+        std::vector<int> bins;
+        std::vector<Point> points;
 
         for (int y = 0; y < templSize_.height; ++y)
         {
@@ -401,10 +405,28 @@ namespace
                 {
                     const float theta = fastAtan2(dyRow[x], dxRow[x]);
                     const int n = cvRound(theta * thetaScale);
-                    r_table_[n].push_back(p - templCenter_);
+                    bins.push_back(n);
+                    points.push_back(p - templCenter_);
                 }
             }
         }
+
+        // counting sort by the direction, keeping the raster order within a direction
+        r_table_ofs_.assign(levels_ + 2, 0);
+        for (size_t i = 0; i < bins.size(); ++i)
+            ++r_table_ofs_[bins[i] + 1];
+        for (int n = 0; n <= levels_; ++n)
+            r_table_ofs_[n + 1] += r_table_ofs_[n];
+
+        std::vector<int> pos(r_table_ofs_.begin(), r_table_ofs_.end() - 1);
+        r_table_x_.resize(points.size());
+        r_table_y_.resize(points.size());
+        for (size_t i = 0; i < bins.size(); ++i)
+        {
+            const int k = pos[bins[i]]++;
+            r_table_x_[k] = points[i].x;
+            r_table_y_[k] = points[i].y;
+        }
     }
 
     void GeneralizedHoughBallardImpl::processImage()
@@ -420,7 +442,7 @@ namespace
         CV_Assert( imageEdges_.type() == CV_8UC1 );
         CV_Assert( imageDx_.type() == CV_32FC1 && imageDx_.size() == imageSize_);
         CV_Assert( imageDy_.type() == imageDx_.type() && imageDy_.size() == imageSize_);
-        CV_Assert( levels_ > 0 && r_table_.size() == static_cast<size_t>(levels_ + 1) );
+        CV_Assert( levels_ > 0 && r_table_ofs_.size() == static_cast<size_t>(levels_ + 2) );
         CV_Assert( dp_ > 0.0 );
 
         const double thetaScale = levels_ / 360.0;
@@ -432,36 +454,52 @@ namespace
         const int rows = hist_.rows - 2;
         const int cols = hist_.cols - 2;
 
-        for (int y = 0; y < imageSize_.height; ++y)
-        {
-            const uchar* edgesRow = imageEdges_.ptr(y);
-            const float* dxRow = imageDx_.ptr<float>(y);
-            const float* dyRow = imageDy_.ptr<float>(y);
+        // the image rows are split into blocks voting into their own accumulators
+        const int nstripes = std::max(1, std::min(getNumThreads(), imageSize_.height / 32));
+        std::vector<Mat> hists(nstripes);
+        hists[0] = hist_;
 
-            for (int x = 0; x < imageSize_.width; ++x)
+        parallel_for_(Range(0, nstripes), [&](const Range& range)
+        {
+            for (int s = range.start; s < range.end; ++s)
             {
-                const Point p(x, y);
+                Mat& hist = hists[s];
+                if (hist.empty())
+                    hist = Mat::zeros(hist_.size(), CV_32SC1);
 
-                if (edgesRow[x] && (notNull(dyRow[x]) || notNull(dxRow[x])))
+                const int y0 = imageSize_.height * s / nstripes, y1 = imageSize_.height * (s + 1) / nstripes;
+                for (int y = y0; y < y1; ++y)
                 {
-                    const float theta = fastAtan2(dyRow[x], dxRow[x]);
-                    const int n = cvRound(theta * thetaScale);
+                    const uchar* edgesRow = imageEdges_.ptr(y);
+                    const float* dxRow = imageDx_.ptr<float>(y);
+                    const float* dyRow = imageDy_.ptr<float>(y);
 
-                    const std::vector<Point>& r_row = r_table_[n];
-
-                    for (size_t j = 0; j < r_row.size(); ++j)
+                    for (int x = 0; x < imageSize_.width; ++x)
                     {
-                        Point c = p - r_row[j];
+                        if (edgesRow[x] && (notNull(dyRow[x]) || notNull(dxRow[x])))
+                        {
+                            const float theta = fastAtan2(dyRow[x], dxRow[x]);
+                            const int n = cvRound(theta * thetaScale);
 
-                        c.x = cvRound(c.x * idp);
-                        c.y = cvRound(c.y * idp);
+                            const int* rx = r_table_x_.data();
+                            const int* ry = r_table_y_.data();
 
-                        if (c.x >= 0 && c.x < cols && c.y >= 0 && c.y < rows)
-                            ++hist_.at<int>(c.y + 1, c.x + 1);
+                            for (int j = r_table_ofs_[n]; j < r_table_ofs_[n + 1]; ++j)
+                            {
+                                const int cx = cvRound((x - rx[j]) * idp);
+                                const int cy = cvRound((y - ry[j]) * idp);
+
+                                if (cx >= 0 && cx < cols && cy >= 0 && cy < rows)
+                                    ++hist.at<int>(cy + 1, cx + 1);
+                            }
+                        }
                     }
                 }
             }
-        }
+        });
+
+        for (int s = 1; s < nstripes; ++s)
+            hist_ += hists[s];
     }
 
     void GeneralizedHoughBallardImpl::findPosInHist()
@@ -601,15 +639,32 @@ namespace
             Point2d r2;
         };
 
-        void buildFeatureList(const Mat& edges, const Mat& dx, const Mat& dy, std::vector< std::vector<Feature> >& features, Point2d center = Point2d());
+        // the features grouped by alpha12 with the fields used for voting stored as separate arrays,
+        // the features of the level n are [ofs[n], ofs[n + 1])
+        struct FeatureTable
+        {
+            std::vector<int> ofs;
+            std::vector<double> theta; // p1.theta
+            std::vector<double> d12;
+            std::vector<Point2d> p1;
+            std::vector<Point2d> p2;
+            std::vector<Point2d> r1;
+            std::vector<Point2d> r2;
+
+            int levels() const { return ofs.empty() ? 0 : (int)ofs.size() - 1; }
+            int count(int n) const { return ofs[n + 1] - ofs[n]; }
+        };
+
+        void buildFeatureList(const Mat& edges, const Mat& dx, const Mat& dy, FeatureTable& features, Point2d center = Point2d());
         void getContourPoints(const Mat& edges, const Mat& dx, const Mat& dy, std::vector<ContourPoint>& points);
 
+        std::vector<Range> splitLevels() const;
         void calcOrientation();
         void calcScale(double angle);
         void calcPosition(double angle, int angleVotes, double scale, int scaleVotes);
 
-        std::vector< std::vector<Feature> > templFeatures_;
-        std::vector< std::vector<Feature> > imageFeatures_;
+        FeatureTable templFeatures_;
+        FeatureTable imageFeatures_;
 
         std::vector< std::pair<double, int> > angles_;
         std::vector< std::pair<double, int> > scales_;
@@ -680,7 +735,7 @@ namespace
         }
     }
 
-    void GeneralizedHoughGuilImpl::buildFeatureList(const Mat& edges, const Mat& dx, const Mat& dy, std::vector< std::vector<Feature> >& features, Point2d center)
+    void GeneralizedHoughGuilImpl::buildFeatureList(const Mat& edges, const Mat& dx, const Mat& dy, FeatureTable& features, Point2d center)
     {
         CV_Assert( levels_ > 0 );
 
@@ -691,39 +746,88 @@ namespace
         std::vector<ContourPoint> points;
         getContourPoints(edges, dx, dy, points);
 
-        features.resize(levels_ + 1);
-        std::for_each(features.begin(), features.end(), [=](std::vector<Feature>& e) { e.clear(); e.reserve(maxBufferSize_); });
+        // the pairs are formed in blocks of p1 in parallel; every level keeps its first
+        // maxBufferSize_ features in the order of (p1, p2), as the blocks are merged in order
+        const int npoints = (int)points.size();
+        const int nstripes = std::max(1, std::min(getNumThreads() * 4, npoints / 64));
+        std::vector< std::vector< std::vector<Feature> > > blocks(nstripes);
 
-        for (size_t i = 0; i < points.size(); ++i)
+        parallel_for_(Range(0, nstripes), [&](const Range& range)
         {
-            ContourPoint p1 = points[i];
-
-            for (size_t j = 0; j < points.size(); ++j)
+            for (int s = range.start; s < range.end; ++s)
             {
-                ContourPoint p2 = points[j];
+                std::vector< std::vector<Feature> >& block = blocks[s];
+                block.resize(levels_ + 1);
 
-                if (angleEq(p1.theta - p2.theta, xi_, angleEpsilon_))
+                const int i0 = npoints * s / nstripes, i1 = npoints * (s + 1) / nstripes;
+                for (int i = i0; i < i1; ++i)
                 {
-                    const Point2d d = p1.pos - p2.pos;
+                    ContourPoint p1 = points[i];
 
-                    Feature f;
+                    for (int j = 0; j < npoints; ++j)
+                    {
+                        ContourPoint p2 = points[j];
+
+                        if (angleEq(p1.theta - p2.theta, xi_, angleEpsilon_))
+                        {
+                            const Point2d d = p1.pos - p2.pos;
 
-                    f.p1 = p1;
-                    f.p2 = p2;
+                            Feature f;
 
-                    f.alpha12 = clampAngle(fastAtan2((float)d.y, (float)d.x) - p1.theta);
-                    f.d12 = norm(d);
+                            f.p1 = p1;
+                            f.p2 = p2;
 
-                    if (f.d12 > maxDist)
-                        continue;
+                            f.alpha12 = clampAngle(fastAtan2((float)d.y, (float)d.x) - p1.theta);
+                            f.d12 = norm(d);
 
-                    f.r1 = p1.pos - center;
-                    f.r2 = p2.pos - center;
+                            if (f.d12 > maxDist)
+                                continue;
 
-                    const int n = cvRound(f.alpha12 * alphaScale);
+                            f.r1 = p1.pos - center;
+                            f.r2 = p2.pos - center;
 
-                    if (features[n].size() < static_cast<size_t>(maxBufferSize_))
-                        features[n].push_back(f);
+                            const int n = cvRound(f.alpha12 * alphaScale);
+
+                            if (block[n].size() < static_cast<size_t>(maxBufferSize_))
+                                block[n].push_back(f);
+                        }
+                    }
+                }
+            }
+        });
+
+        features.ofs.assign(levels_ + 2, 0);
+        for (int n = 0; n <= levels_; ++n)
+        {
+            size_t count = 0;
+            for (int s = 0; s < nstripes; ++s)
+                count += blocks[s][n].size();
+            features.ofs[n + 1] = features.ofs[n] + (int)std::min(count, static_cast<size_t>(std::max(maxBufferSize_, 0)));
+        }
+
+        const int total = features.ofs[levels_ + 1];
+        features.theta.resize(total);
+        features.d12.resize(total);
+        features.p1.resize(total);
+        features.p2.resize(total);
+        features.r1.resize(total);
+        features.r2.resize(total);
+
+        for (int n = 0; n <= levels_; ++n)
+        {
+            int k = features.ofs[n];
+            for (int s = 0; s < nstripes && k < features.ofs[n + 1]; ++s)
+            {
+                const std::vector<Feature>& row = blocks[s][n];
+                for (size_t j = 0; j < row.size() && k < features.ofs[n + 1]; ++j, ++k)
+                {
+                    const Feature& f = row[j];
+                    features.theta[k] = f.p1.theta;
+                    features.d12[k] = f.d12;
+                    features.p1[k] = f.p1.pos;
+                    features.p2[k] = f.p2.pos;
+                    features.r1[k] = f.r1;
+                    features.r2[k] = f.r2;
                 }
             }
         }
@@ -759,11 +863,36 @@ namespace
         }
     }
 
+    // splits the levels into ranges of about the same number of feature pairs, one per thread
+    std::vector<Range> GeneralizedHoughGuilImpl::splitLevels() const
+    {
+        const int nlevels = templFeatures_.levels();
+        double total = 0;
+        for (int i = 0; i < nlevels; ++i)
+            total += (double)templFeatures_.count(i) * imageFeatures_.count(i);
+
+        const int nstripes = std::max(1, std::min(getNumThreads(), cvFloor(total / (1 << 16))));
+        std::vector<Range> ranges;
+        double acc = 0;
+        int start = 0;
+        for (int i = 0; i < nlevels; ++i)
+        {
+            acc += (double)templFeatures_.count(i) * imageFeatures_.count(i);
+            if (acc >= total * (ranges.size() + 1) / nstripes && (int)ranges.size() < nstripes - 1)
+            {
+                ranges.push_back(Range(start, i + 1));
+                start = i + 1;
+            }
+        }
+        ranges.push_back(Range(start, nlevels));
+        return ranges;
+    }
+
     void GeneralizedHoughGuilImpl::calcOrientation()
     {
         CV_Assert( levels_ > 0 );
-        CV_Assert( templFeatures_.size() == static_cast<size_t>(levels_ + 1) );
-        CV_Assert( imageFeatures_.size() == templFeatures_.size() );
+        CV_Assert( templFeatures_.levels() == levels_ + 1 );
+        CV_Assert( imageFeatures_.levels() == templFeatures_.levels() );
         CV_Assert( minAngle_ >= 0.0 && minAngle_ < maxAngle_ && maxAngle_ <= 360.0 );
         CV_Assert( angleStep_ > 0.0 && angleStep_ < 360.0 );
         CV_Assert( angleThresh_ > 0 );
@@ -771,29 +900,38 @@ namespace
         const double iAngleStep = 1.0 / angleStep_;
         const int angleRange = cvCeil((maxAngle_ - minAngle_) * iAngleStep);
 
-        std::vector<int> OHist(angleRange + 1, 0);
-        for (int i = 0; i <= levels_; ++i)
-        {
-            const std::vector<Feature>& templRow = templFeatures_[i];
-            const std::vector<Feature>& imageRow = imageFeatures_[i];
+        const std::vector<Range> ranges = splitLevels();
+        std::vector< std::vector<int> > hists(ranges.size(), std::vector<int>(angleRange + 1, 0));
 
-            for (size_t j = 0; j < templRow.size(); ++j)
+        parallel_for_(Range(0, (int)ranges.size()), [&](const Range& range)
+        {
+            for (int s = range.start; s < range.end; ++s)
             {
-                Feature templF = templRow[j];
-
-                for (size_t k = 0; k < imageRow.size(); ++k)
+                std::vector<int>& OHist = hists[s];
+                for (int i = ranges[s].start; i < ranges[s].end; ++i)
                 {
-                    Feature imF = imageRow[k];
-
-                    const double angle = clampAngle(imF.p1.theta - templF.p1.theta);
-                    if (angle >= minAngle_ && angle <= maxAngle_)
+                    for (int j = templFeatures_.ofs[i]; j < templFeatures_.ofs[i + 1]; ++j)
                     {
-                        const int n = cvRound((angle - minAngle_) * iAngleStep);
-                        ++OHist[n];
+                        const double templTheta = templFeatures_.theta[j];
+
+                        for (int k = imageFeatures_.ofs[i]; k < imageFeatures_.ofs[i + 1]; ++k)
+                        {
+                            const double angle = clampAngle(imageFeatures_.theta[k] - templTheta);
+                            if (angle >= minAngle_ && angle <= maxAngle_)
+                            {
+                                const int n = cvRound((angle - minAngle_) * iAngleStep);
+                                ++OHist[n];
+                            }
+                        }
                     }
                 }
             }
-        }
+        });
+
+        std::vector<int>& OHist = hists[0];
+        for (size_t s = 1; s < hists.size(); ++s)
+            for (int n = 0; n <= angleRange; ++n)
+                OHist[n] += hists[s][n];
 
         angles_.clear();
 
@@ -810,8 +948,8 @@ namespace
     void GeneralizedHoughGuilImpl::calcScale(double angle)
     {
         CV_Assert( levels_ > 0 );
-        CV_Assert( templFeatures_.size() == static_cast<size_t>(levels_ + 1) );
-        CV_Assert( imageFeatures_.size() == templFeatures_.size() );
+        CV_Assert( templFeatures_.levels() == levels_ + 1 );
+        CV_Assert( imageFeatures_.levels() == templFeatures_.levels() );
         CV_Assert( minScale_ > 0.0 && minScale_ < maxScale_ );
         CV_Assert( scaleStep_ > 0.0 );
         CV_Assert( scaleThresh_ > 0 );
@@ -819,35 +957,42 @@ namespace
         const double iScaleStep = 1.0 / scaleStep_;
         const int scaleRange = cvCeil((maxScale_ - minScale_) * iScaleStep);
 
-        std::vector<int> SHist(scaleRange + 1, 0);
+        const std::vector<Range> ranges = splitLevels();
+        std::vector< std::vector<int> > hists(ranges.size(), std::vector<int>(scaleRange + 1, 0));
 
-        for (int i = 0; i <= levels_; ++i)
+        parallel_for_(Range(0, (int)ranges.size()), [&](const Range& range)
         {
-            const std::vector<Feature>& templRow = templFeatures_[i];
-            const std::vector<Feature>& imageRow = imageFeatures_[i];
-
-            for (size_t j = 0; j < templRow.size(); ++j)
+            for (int s = range.start; s < range.end; ++s)
             {
-                Feature templF = templRow[j];
-
-                templF.p1.theta += angle;
-
-                for (size_t k = 0; k < imageRow.size(); ++k)
+                std::vector<int>& SHist = hists[s];
+                for (int i = ranges[s].start; i < ranges[s].end; ++i)
                 {
-                    Feature imF = imageRow[k];
-
-                    if (angleEq(imF.p1.theta, templF.p1.theta, angleEpsilon_))
+                    for (int j = templFeatures_.ofs[i]; j < templFeatures_.ofs[i + 1]; ++j)
                     {
-                        const double scale = imF.d12 / templF.d12;
-                        if (scale >= minScale_ && scale <= maxScale_)
+                        const double templTheta = templFeatures_.theta[j] + angle;
+                        const double templD12 = templFeatures_.d12[j];
+
+                        for (int k = imageFeatures_.ofs[i]; k < imageFeatures_.ofs[i + 1]; ++k)
                         {
-                            const int s = cvRound((scale - minScale_) * iScaleStep);
-                            ++SHist[s];
+                            if (angleEq(imageFeatures_.theta[k], templTheta, angleEpsilon_))
+                            {
+                                const double scale = imageFeatures_.d12[k] / templD12;
+                                if (scale >= minScale_ && scale <= maxScale_)
+                                {
+                                    const int n = cvRound((scale - minScale_) * iScaleStep);
+                                    ++SHist[n];
+                                }
+                            }
                         }
                     }
                 }
             }
-        }
+        });
+
+        std::vector<int>& SHist = hists[0];
+        for (size_t s = 1; s < hists.size(); ++s)
+            for (int n = 0; n <= scaleRange; ++n)
+                SHist[n] += hists[s][n];
 
         scales_.clear();
 
@@ -864,8 +1009,8 @@ namespace
     void GeneralizedHoughGuilImpl::calcPosition(double angle, int angleVotes, double scale, int scaleVotes)
     {
         CV_Assert( levels_ > 0 );
-        CV_Assert( templFeatures_.size() == static_cast<size_t>(levels_ + 1) );
-        CV_Assert( imageFeatures_.size() == templFeatures_.size() );
+        CV_Assert( templFeatures_.levels() == levels_ + 1 );
+        CV_Assert( imageFeatures_.levels() == templFeatures_.levels() );
         CV_Assert( dp_ > 0.0 );
         CV_Assert( posThresh_ > 0 );
 
@@ -876,48 +1021,55 @@ namespace
         const int histRows = cvCeil(imageSize_.height * idp);
         const int histCols = cvCeil(imageSize_.width * idp);
 
-        Mat DHist(histRows + 2, histCols + 2, CV_32SC1, Scalar::all(0));
+        const std::vector<Range> ranges = splitLevels();
+        std::vector<Mat> hists(ranges.size());
 
-        for (int i = 0; i <= levels_; ++i)
+        parallel_for_(Range(0, (int)ranges.size()), [&](const Range& range)
         {
-            const std::vector<Feature>& templRow = templFeatures_[i];
-            const std::vector<Feature>& imageRow = imageFeatures_[i];
-
-            for (size_t j = 0; j < templRow.size(); ++j)
+            for (int s = range.start; s < range.end; ++s)
             {
-                Feature templF = templRow[j];
-
-                templF.p1.theta += angle;
+                Mat& DHist = hists[s];
+                DHist = Mat::zeros(histRows + 2, histCols + 2, CV_32SC1);
 
-                templF.r1 *= scale;
-                templF.r2 *= scale;
+                for (int i = ranges[s].start; i < ranges[s].end; ++i)
+                {
+                    for (int j = templFeatures_.ofs[i]; j < templFeatures_.ofs[i + 1]; ++j)
+                    {
+                        const double templTheta = templFeatures_.theta[j] + angle;
 
-                templF.r1 = Point2d(cosVal * templF.r1.x - sinVal * templF.r1.y, sinVal * templF.r1.x + cosVal * templF.r1.y);
-                templF.r2 = Point2d(cosVal * templF.r2.x - sinVal * templF.r2.y, sinVal * templF.r2.x + cosVal * templF.r2.y);
+                        Point2d r1 = templFeatures_.r1[j] * scale;
+                        Point2d r2 = templFeatures_.r2[j] * scale;
 
-                for (size_t k = 0; k < imageRow.size(); ++k)
-                {
-                    Feature imF = imageRow[k];
+                        r1 = Point2d(cosVal * r1.x - sinVal * r1.y, sinVal * r1.x + cosVal * r1.y);
+                        r2 = Point2d(cosVal * r2.x - sinVal * r2.y, sinVal * r2.x + cosVal * r2.y);
 
-                    if (angleEq(imF.p1.theta, templF.p1.theta, angleEpsilon_))
-                    {
-                        Point2d c1, c2;
+                        for (int k = imageFeatures_.ofs[i]; k < imageFeatures_.ofs[i + 1]; ++k)
+                        {
+                            if (angleEq(imageFeatures_.theta[k], templTheta, angleEpsilon_))
+                            {
+                                Point2d c1, c2;
 
-                        c1 = imF.p1.pos - templF.r1;
-                        c1 *= idp;
+                                c1 = imageFeatures_.p1[k] - r1;
+                                c1 *= idp;
 
-                        c2 = imF.p2.pos - templF.r2;
-                        c2 *= idp;
+                                c2 = imageFeatures_.p2[k] - r2;
+                                c2 *= idp;
 
-                        if (fabs(c1.x - c2.x) > 1 || fabs(c1.y - c2.y) > 1)
-                            continue;
+                                if (fabs(c1.x - c2.x) > 1 || fabs(c1.y - c2.y) > 1)
+                                    continue;
 
-                        if (c1.y >= 0 && c1.y < histRows && c1.x >= 0 && c1.x < histCols)
-                            ++DHist.at<int>(cvRound(c1.y) + 1, cvRound(c1.x) + 1);
+                                if (c1.y >= 0 && c1.y < histRows && c1.x >= 0 && c1.x < histCols)
+                                    ++DHist.at<int>(cvRound(c1.y) + 1, cvRound(c1.x) + 1);
+                            }
+                        }
                     }
                 }
             }
-        }
+        });
+
+        Mat DHist = hists[0];
+        for (size_t s = 1; s < hists.size(); ++s)
+            DHist += hists[s];
 
         for(int y = 0; y < histRows; ++y)
         {
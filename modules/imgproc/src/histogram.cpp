@@ -56,12 +56,13 @@ namespace cv
 
 static const size_t OUT_OF_RANGE = (size_t)1 << (sizeof(size_t)*8 - 2);
 
+// tables of the histogram offsets for the integer values [0, high) of every dimension
 static void
-calcHistLookupTables_8u( const Mat& hist, const SparseMat& shist,
-                         int dims, const float** ranges, const double* uniranges,
-                         bool uniform, bool issparse, std::vector<size_t>& _tab )
+calcHistLookupTables( const Mat& hist, const SparseMat& shist,
+                      int dims, const float** ranges, const double* uniranges,
+                      bool uniform, bool issparse, int high, std::vector<size_t>& _tab )
 {
-    const int low = 0, high = 256;
+    const int low = 0;
     int i, j;
     _tab.resize((high-low)*dims);
     size_t* tab = &_tab[0];
@@ -125,6 +126,14 @@ calcHistLookupTables_8u( const Mat& hist, const SparseMat& shist,
     }
 }
 
+static void
+calcHistLookupTables_8u( const Mat& hist, const SparseMat& shist,
+                         int dims, const float** ranges, const double* uniranges,
+                         bool uniform, bool issparse, std::vector<size_t>& _tab )
+{
+    calcHistLookupTables( hist, shist, dims, ranges, uniranges, uniform, issparse, 256, _tab );
+}
+
 
 static void histPrepareImages( const Mat* images, int nimages, const int* channels,
                                const Mat& mask, int dims, const int* histSize,
@@ -224,6 +233,40 @@ static void histPrepareImages( const Mat* images, int nimages, const int* channe
 
 ////////////////////////////////// C A L C U L A T E    H I S T O G R A M ////////////////////////////////////
 
+// 1D uniform histogram of a contiguous row, returns the number of processed elements
+template<typename T> static int
+calcHistRow1D_( const T*, int, int*, double, double, double, double, int )
+{
+    return 0;
+}
+
+#if CV_SIMD && CV_SIMD_64F
+template<> int
+calcHistRow1D_( const float* p, int len, int* H, double a, double b, double v_lo, double v_hi, int sz )
+{
+    // the bin index is computed in double as in the scalar code; NaNs go to the bin 0 there as well
+    const int VECSZ = VTraits<v_float32>::vlanes();
+    const v_float64 va = vx_setall_f64(a), vb = vx_setall_f64(b);
+    const v_float32 lo = vx_setall_f32((float)v_lo), hi = vx_setall_f32((float)v_hi);
+    const v_int32 zero = vx_setzero_s32(), maxidx = vx_setall_s32(sz - 1), outside = vx_setall_s32(-1);
+    int idx[VTraits<v_int32>::max_nlanes];
+    int x = 0;
+    for( ; x <= len - VECSZ; x += VECSZ )
+    {
+        v_float32 v = vx_load(p + x);
+        v_int32 i = v_combine_low(v_floor(v_add(v_mul(v_cvt_f64(v), va), vb)),
+                                  v_floor(v_add(v_mul(v_cvt_f64_high(v), va), vb)));
+        i = v_min(v_max(i, zero), maxidx);
+        v_int32 out = v_reinterpret_as_s32(v_or(v_lt(v, lo), v_ge(v, hi)));
+        v_store(idx, v_select(out, outside, i));
+        for( int k = 0; k < VECSZ; k++ )
+            if( idx[k] >= 0 )
+                H[idx[k]]++;
+    }
+    return x;
+}
+#endif
+
 template<typename T> static void
 calcHist_( std::vector<uchar*>& _ptrs, const std::vector<int>& _deltas,
            Size imsize, Mat& hist, int dims, const float** _ranges,
@@ -260,7 +303,14 @@ calcHist_( std::vector<uchar*>& _ptrs, const std::vector<int>& _deltas,
             for( ; imsize.height--; p0 += step0, mask += mstep )
             {
                 if( !mask )
-                    for( x = 0; x < imsize.width; x++, p0 += d0 )
+                {
+                    x = 0;
+                    if( d0 == 1 )
+                    {
+                        x = calcHistRow1D_(p0, imsize.width, (int*)H, a, b, v0_lo, v0_hi, sz);
+                        p0 += x;
+                    }
+                    for( ; x < imsize.width; x++, p0 += d0 )
                     {
                         double v0 = (double)*p0;
                         int idx = cvFloor(v0*a + b);
@@ -270,6 +320,7 @@ calcHist_( std::vector<uchar*>& _ptrs, const std::vector<int>& _deltas,
                         CV_DbgAssert((unsigned)idx < (unsigned)sz);
                         ((int*)H)[idx]++;
                     }
+                }
                 else
                     for( x = 0; x < imsize.width; x++, p0 += d0 )
                         if( mask[x] )
@@ -490,10 +541,10 @@ calcHist_( std::vector<uchar*>& _ptrs, const std::vector<int>& _deltas,
                     {
                         float v = (float)*ptrs[i];
                         const float* R = ranges[i];
-                        int idx = -1, sz = size[i];
+                        int sz = size[i];
 
-                        while( v >= R[idx+1] && ++idx < sz )
-                            ; // nop
+                        // the last bound not above v; NaNs and values out of [R[0], R[sz]) give -1 or sz
+                        int idx = (int)(std::upper_bound(R, R + sz + 1, v) - R) - 1;
 
                         if( (unsigned)idx >= (unsigned)sz )
                             break;
@@ -688,6 +739,94 @@ calcHist_8u( std::vector<uchar*>& _ptrs, const std::vector<int>& _deltas,
     }
 }
 
+// 16-bit images go through the lookup tables of calcHistLookupTables for the values [0, tabsz),
+// the larger values are out of range
+static void
+calcHist_16u( std::vector<uchar*>& _ptrs, const std::vector<int>& _deltas,
+              Size imsize, Mat& hist, int dims, const std::vector<size_t>& _tab, int tabsz )
+{
+    ushort** ptrs = (ushort**)&_ptrs[0];
+    const int* deltas = &_deltas[0];
+    uchar* H = hist.ptr();
+    int x;
+    const uchar* mask = _ptrs[dims];
+    int mstep = _deltas[dims*2 + 1];
+    const size_t* tab = &_tab[0];
+
+    if( dims == 1 )
+    {
+        // count the values directly, the values above the table go to the extra entry
+        int d0 = deltas[0], step0 = deltas[1];
+        std::vector<int> _matH(tabsz + 1, 0);
+        int* matH = &_matH[0];
+        const ushort* p0 = ptrs[0];
+
+        for( ; imsize.height--; p0 += step0, mask += mstep )
+        {
+            if( !mask )
+                for( x = 0; x < imsize.width; x++, p0 += d0 )
+                    matH[std::min((int)*p0, tabsz)]++;
+            else
+                for( x = 0; x < imsize.width; x++, p0 += d0 )
+                    if( mask[x] )
+                        matH[std::min((int)*p0, tabsz)]++;
+        }
+
+        for( int i = 0; i < tabsz; i++ )
+        {
+            size_t hidx = tab[i];
+            if( hidx < OUT_OF_RANGE )
+                *(int*)(H + hidx) += matH[i];
+        }
+    }
+    else
+    {
+        for( ; imsize.height--; mask += mstep )
+        {
+            for( x = 0; x < imsize.width; x++ )
+            {
+                uchar* Hptr = H;
+                int i = 0;
+                if( !mask || mask[x] )
+                    for( ; i < dims; i++ )
+                    {
+                        int v = *ptrs[i];
+                        size_t idx = v < tabsz ? tab[v + i*tabsz] : OUT_OF_RANGE;
+                        if( idx >= OUT_OF_RANGE )
+                            break;
+                        Hptr += idx;
+                        ptrs[i] += deltas[i*2];
+                    }
+
+                if( i == dims )
+                    ++*((int*)Hptr);
+                else
+                    for( ; i < dims; i++ )
+                        ptrs[i] += deltas[i*2];
+            }
+            for( int i = 0; i < dims; i++ )
+                ptrs[i] += deltas[i*2 + 1];
+        }
+    }
+}
+
+// the pointers to the part [start, end) of the prepared images: rows, or elements of a continuous row
+static void histSplitImages( const std::vector<uchar*>& ptrs, const std::vector<int>& deltas,
+                             Size imsize, int dims, size_t esz1, int start, int end,
+                             std::vector<uchar*>& sptrs, Size& ssize )
+{
+    sptrs = ptrs;
+    bool rows = imsize.height > 1;
+    for( int i = 0; i < dims; i++ )
+    {
+        size_t step = rows ? (size_t)imsize.width*deltas[i*2] + deltas[i*2 + 1] : (size_t)deltas[i*2];
+        sptrs[i] += start*step*esz1;
+    }
+    if( sptrs[dims] )
+        sptrs[dims] += rows ? (size_t)start*deltas[dims*2 + 1] : (size_t)start;
+    ssize = rows ? Size(imsize.width, end - start) : Size(end - start, 1);
+}
+
 #ifdef HAVE_IPP
 
 typedef IppStatus(CV_STDCALL * IppiHistogram_C1)(const void* pSrc, int srcStep,
@@ -997,16 +1136,53 @@ void cv::calcHist( const Mat* images, int nimages, const int* channels,
     const double* _uniranges = uniform ? &uniranges[0] : 0;
 
     int depth = images[0].depth();
-
-    if( depth == CV_8U )
-        calcHist_8u(ptrs, deltas, imsize, ihist, dims, ranges, _uniranges, uniform );
-    else if( depth == CV_16U )
-        calcHist_<ushort>(ptrs, deltas, imsize, ihist, dims, ranges, _uniranges, uniform );
-    else if( depth == CV_32F )
-        calcHist_<float>(ptrs, deltas, imsize, ihist, dims, ranges, _uniranges, uniform );
-    else
+    if( depth != CV_8U && depth != CV_16U && depth != CV_32F )
         CV_Error(cv::Error::StsUnsupportedFormat, "");
 
+    std::vector<size_t> tab16;
+    int tabsz = 0;
+    if( depth == CV_16U )
+    {
+        for( int i = 0; i < dims; i++ )
+            tabsz = std::max(tabsz, cvCeil(uniform ? ranges[i][1] : ranges[i][histSize[i]]));
+        tabsz = std::min(std::max(tabsz, 1), 65536);
+        calcHistLookupTables( ihist, SparseMat(), dims, ranges, _uniranges, uniform, false, tabsz, tab16 );
+    }
+
+    // the parts of the image are counted into private histograms, which are added at the end
+    int len = imsize.height > 1 ? imsize.height : imsize.width;
+    double npixels = (double)imsize.width*imsize.height;
+    int nstripes = 1;
+    if( ihist.isContinuous() && (double)ihist.total()*4 <= npixels )
+        nstripes = std::max(1, std::min(getNumThreads(), std::min(len, (int)(npixels/(1 << 16)))));
+
+    std::vector<Mat> hists(nstripes);
+    hists[0] = ihist;
+    parallel_for_(Range(0, nstripes), [&](const Range& range)
+    {
+        for( int s = range.start; s < range.end; s++ )
+        {
+            Mat& h = hists[s];
+            if( s > 0 )
+                h = Mat::zeros(dims, ihist.size.p, CV_32S);
+
+            std::vector<uchar*> sptrs;
+            Size ssize;
+            histSplitImages( ptrs, deltas, imsize, dims, images[0].elemSize1(),
+                             (int)((int64)len*s/nstripes), (int)((int64)len*(s + 1)/nstripes), sptrs, ssize );
+
+            if( depth == CV_8U )
+                calcHist_8u(sptrs, deltas, ssize, h, dims, ranges, _uniranges, uniform );
+            else if( depth == CV_16U )
+                calcHist_16u(sptrs, deltas, ssize, h, dims, tab16, tabsz );
+            else
+                calcHist_<float>(sptrs, deltas, ssize, h, dims, ranges, _uniranges, uniform );
+        }
+    }, nstripes);
+
+    for( int s = 1; s < nstripes; s++ )
+        ihist += hists[s];
+
     ihist.convertTo(hist, CV_32F);
 }
 
@@ -107,6 +107,83 @@ findLocalMaximums( int numrho, int numangle, int threshold,
         }
 }
 
+// x and y coordinates of the non-zero pixels, in the row-major order
+static void
+collectNonZeroPoints( const Mat& img, std::vector<float>& xs, std::vector<float>& ys )
+{
+    std::vector<Point> nz;
+    findNonZero(img, nz);
+    xs.resize(nz.size());
+    ys.resize(nz.size());
+    for( size_t k = 0; k < nz.size(); k++ )
+    {
+        xs[k] = (float)nz[k].x;
+        ys[k] = (float)nz[k].y;
+    }
+}
+
+/*
+Adds the votes of the points to the accumulator rows of the angles [angles.start, angles.end):
+accum[(n+1)*(numrho+2) + r+1]++ for r = cvRound(x*tabCos[n] + y*tabSin[n] - rbias) + rofs, 0 <= r <= numrho.
+The points are processed in blocks that stay in cache while all the angles are voted.
+*/
+static void
+houghVoteAngles( const float* xs, const float* ys, int npts,
+                 const float* tabCos, const float* tabSin, const Range& angles,
+                 float rbias, int rofs, int numrho, int* accum )
+{
+    const int BLOCK = 1 << 12;
+    for( int k0 = 0; k0 < npts; k0 += BLOCK )
+    {
+        int k1 = std::min(k0 + BLOCK, npts);
+        for( int n = angles.start; n < angles.end; n++ )
+        {
+            int* arow = accum + (n+1) * (numrho+2) + 1;
+            float c = tabCos[n], s = tabSin[n];
+            int k = k0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+            const int VECSZ = VTraits<v_int32>::vlanes();
+            int CV_DECL_ALIGNED(CV_SIMD_WIDTH) rbuf[VTraits<v_int32>::max_nlanes];
+            v_float32 vc = vx_setall_f32(c), vs = vx_setall_f32(s), vbias = vx_setall_f32(rbias);
+            v_int32 vofs = vx_setall_s32(rofs);
+            for( ; k <= k1 - VECSZ; k += VECSZ )
+            {
+                v_float32 v = v_sub(v_add(v_mul(vx_load(xs + k), vc), v_mul(vx_load(ys + k), vs)), vbias);
+                v_store_aligned(rbuf, v_add(v_round(v), vofs));
+                for( int l = 0; l < VECSZ; l++ )
+                    if( (unsigned)rbuf[l] <= (unsigned)numrho )
+                        arow[rbuf[l]]++;
+            }
+#endif
+            for( ; k < k1; k++ )
+            {
+                int r = cvRound( xs[k] * c + ys[k] * s - rbias ) + rofs;
+                if( (unsigned)r <= (unsigned)numrho )
+                    arow[r]++;
+            }
+        }
+    }
+}
+
+/*
+Fills the accumulator in parallel. Every thread owns a block of angles, i.e. a block of accumulator
+rows, so the result does not depend on the number of threads.
+*/
+static void
+houghVote( const std::vector<float>& xs, const std::vector<float>& ys,
+           const float* tabCos, const float* tabSin, int numangle,
+           float rbias, int rofs, int numrho, int* accum )
+{
+    int npts = (int)xs.size();
+    if( npts == 0 )
+        return;
+    double nstripes = (double)npts*numangle < (1 << 16) ? 1 : std::min((double)numangle, getNumThreads()*4.);
+    parallel_for_(Range(0, numangle), [&](const Range& range)
+    {
+        houghVoteAngles(&xs[0], &ys[0], npts, tabCos, tabSin, range, rbias, rofs, numrho, accum);
+    }, nstripes);
+}
+
 /*
 Here image is an input raster;
 step is it's step; size characterizes it's ROI;
@@ -126,14 +203,12 @@ HoughLinesStandard( InputArray src, OutputArray lines, int type,
 
     Mat img = src.getMat();
 
-    int i, j;
+    int i;
     float irho = 1 / rho;
 
     CV_Assert( img.type() == CV_8UC1 );
     CV_Assert( linesMax > 0 );
 
-    const uchar* image = img.ptr();
-    int step = (int)img.step;
     int width = img.cols;
     int height = img.rows;
 
@@ -158,7 +233,7 @@ HoughLinesStandard( InputArray src, OutputArray lines, int type,
         std::vector<Vec2f> _lines(ipp_linesMax);
         IppStatus ok = ippiHoughLineGetSize_8u_C1R(srcSize, delta, ipp_linesMax, &bufferSize);
         Ipp8u* buffer = ippsMalloc_8u_L(bufferSize);
-        if (ok >= 0) {ok = CV_INSTRUMENT_FUN_IPP(ippiHoughLine_Region_8u32f_C1R, image, step, srcSize, (IppPointPolar*) &_lines[0], dstRoi, ipp_linesMax, &linesCount, delta, threshold, buffer);};
+        if (ok >= 0) {ok = CV_INSTRUMENT_FUN_IPP(ippiHoughLine_Region_8u32f_C1R, img.ptr(), (int)img.step, srcSize, (IppPointPolar*) &_lines[0], dstRoi, ipp_linesMax, &linesCount, delta, threshold, buffer);};
         ippsFree(buffer);
         if (ok >= 0)
         {
@@ -184,17 +259,9 @@ HoughLinesStandard( InputArray src, OutputArray lines, int type,
                      irho, tabSin, tabCos);
 
     // stage 1. fill accumulator
-    for( i = 0; i < height; i++ )
-        for( j = 0; j < width; j++ )
-        {
-            if( image[i * step + j] != 0 )
-                for(int n = 0; n < numangle; n++ )
-                {
-                    int r = cvRound( j * tabCos[n] + i * tabSin[n] );
-                    r += (numrho - 1) / 2;
-                    accum[(n+1) * (numrho+2) + r+1]++;
-                }
-        }
+    std::vector<float> xs, ys;
+    collectNonZeroPoints( img, xs, ys );
+    houghVote( xs, ys, tabCos, tabSin, numangle, 0.f, (numrho - 1) / 2, numrho, accum );
 
     // stage 2. find local maximums
     findLocalMaximums( numrho, numangle, threshold, accum, _sort_buf );
@@ -472,6 +539,31 @@ HoughLinesSDiv( InputArray image, OutputArray lines, int type,
 *                              Probabilistic Hough Transform                             *
 \****************************************************************************************/
 
+// the accumulator elements n*numrho + cvRound(x*tabCos[n] + y*tabSin[n]) + (numrho-1)/2 of a point
+static void
+houghPointOffsets( int x, int y, const float* tabCos, const float* tabSin,
+                   int numangle, int numrho, int* ofs )
+{
+    const int rofs = (numrho - 1) / 2;
+    const float fx = (float)x, fy = (float)y;
+    int n = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int VECSZ = VTraits<v_int32>::vlanes();
+    int CV_DECL_ALIGNED(CV_SIMD_WIDTH) rows[VTraits<v_int32>::max_nlanes];
+    for( int l = 0; l < VECSZ; l++ )
+        rows[l] = l * numrho + rofs;
+    v_int32 vrow = vx_load_aligned(rows), vstep = vx_setall_s32(VECSZ * numrho);
+    v_float32 vx = vx_setall_f32(fx), vy = vx_setall_f32(fy);
+    for( ; n <= numangle - VECSZ; n += VECSZ, vrow = v_add(vrow, vstep) )
+    {
+        v_float32 v = v_add(v_mul(vx, vx_load(tabCos + n)), v_mul(vy, vx_load(tabSin + n)));
+        v_store(ofs + n, v_add(v_round(v), vrow));
+    }
+#endif
+    for( ; n < numangle; n++ )
+        ofs[n] = n * numrho + cvRound( fx * tabCos[n] + fy * tabSin[n] ) + rofs;
+}
+
 static void
 HoughLinesProbabilistic( Mat& image,
                          float rho, float theta, int threshold,
@@ -521,15 +613,16 @@ HoughLinesProbabilistic( Mat& image,
 
     Mat accum = Mat::zeros( numangle, numrho, CV_32SC1 );
     Mat mask( height, width, CV_8UC1 );
-    std::vector<float> trigtab(numangle*2);
+    std::vector<float> tabCos(numangle), tabSin(numangle);
+    std::vector<int> pointOfs(numangle);
 
     for( int n = 0; n < numangle; n++ )
     {
-        trigtab[n*2] = (float)(cos((double)n*theta) * irho);
-        trigtab[n*2+1] = (float)(sin((double)n*theta) * irho);
+        tabCos[n] = (float)(cos((double)n*theta) * irho);
+        tabSin[n] = (float)(sin((double)n*theta) * irho);
     }
-    const float* ttab = &trigtab[0];
     uchar* mdata0 = mask.ptr();
+    int* ofs = &pointOfs[0];
     std::vector<Point> nzloc;
 
     // stage 1. collect non-zero image points
@@ -573,11 +666,10 @@ HoughLinesProbabilistic( Mat& image,
             continue;
 
         // update accumulator, find the most probable line
-        for( int n = 0; n < numangle; n++, adata += numrho )
+        houghPointOffsets( j, i, &tabCos[0], &tabSin[0], numangle, numrho, ofs );
+        for( int n = 0; n < numangle; n++ )
         {
-            int r = cvRound( j * ttab[n*2] + i * ttab[n*2+1] );
-            r += (numrho - 1) / 2;
-            int val = ++adata[r];
+            int val = ++adata[ofs[n]];
             if( max_val < val )
             {
                 max_val = val;
@@ -591,8 +683,8 @@ HoughLinesProbabilistic( Mat& image,
 
         // from the current point walk in each direction
         // along the found line and extract the line segment
-        a = -ttab[max_n*2+1];
-        b = ttab[max_n*2];
+        a = -tabSin[max_n];
+        b = tabCos[max_n];
         x0 = j;
         y0 = i;
         if( fabs(a) > fabs(b) )
@@ -693,13 +785,9 @@ HoughLinesProbabilistic( Mat& image,
                 {
                     if( good_line )
                     {
-                        adata = accum.ptr<int>();
-                        for( int n = 0; n < numangle; n++, adata += numrho )
-                        {
-                            int r = cvRound( j1 * ttab[n*2] + i1 * ttab[n*2+1] );
-                            r += (numrho - 1) / 2;
-                            adata[r]--;
-                        }
+                        houghPointOffsets( j1, i1, &tabCos[0], &tabSin[0], numangle, numrho, ofs );
+                        for( int n = 0; n < numangle; n++ )
+                            adata[ofs[n]]--;
                     }
                     *mdata = 0;
                 }
@@ -983,14 +1071,13 @@ void HoughLinesPointSet( InputArray _point, OutputArray _lines, int lines_max, i
                      irho, tabSin, tabCos );
 
     // stage 1. fill accumulator
+    std::vector<float> xs(point.size()), ys(point.size());
     for( i = 0; i < (int)point.size(); i++ )
-        for(int n = 0; n < numangle; n++ )
-        {
-            int r = cvRound( point.at(i).x  * tabCos[n] + point.at(i).y * tabSin[n] - irho_min);
-            if ( r >= 0 && r <= numrho) {
-                accum[(n+1) * (numrho+2) + r+1]++;
-            }
-        }
+    {
+        xs[i] = point[i].x;
+        ys[i] = point[i].y;
+    }
+    houghVote( xs, ys, tabCos, tabSin, numangle, irho_min, 0, numrho, accum );
 
     // stage 2. find local maximums
     findLocalMaximums( numrho, numangle, threshold, accum, _sort_buf );
@@ -92,6 +92,22 @@ void WarpPerspectiveLine_ProcessNN_CV_SIMD(const double *M, short* xy, double X0
 void WarpPerspectiveLine_Process_CV_SIMD(const double *M, short* xy, short* alpha, double X0, double Y0, double W0, int bw);
 #endif
 
+// Computes the fixed-point map of warpPerspective (inverse matrix M) for bw pixels of the row y starting at x.
+// alpha is not used for INTER_NEAREST.
+class WarpPerspectiveLine
+{
+public:
+    WarpPerspectiveLine(const double* M, int interpolation);
+    void operator()(short* xy, short* alpha, int x, int y, int bw) const;
+
+private:
+    const double* M;
+    int interpolation;
+#if CV_TRY_SSE4_1
+    Ptr<opt_SSE4_1::WarpPerspectiveLine_SSE4> pwarp_impl_sse4;
+#endif
+};
+
 }
 #endif
 /* End of file. */
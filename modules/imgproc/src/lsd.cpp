@@ -40,6 +40,7 @@
 //M*/
 
 #include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
 #include <vector>
 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -272,6 +273,15 @@ private:
 
     std::vector<normPoint> ordered_points;
 
+    // The 'used' flags as seen by one region search. A speculative search writes to a private mask
+    // on top of the read-only flags of the committed regions and records every point it adds.
+    struct UsedView
+    {
+        Mat_<uchar>* mask;
+        const Mat_<uchar>* committed;   // NULL if 'mask' holds all the flags
+        std::vector<Point>* grown;      // may be NULL
+    };
+
     struct rect
     {
         double x1, y1, x2, y2;    // first and second point of the line segment
@@ -283,6 +293,13 @@ private:
         double p;                 // probability of a point with angle within 'prec'
     };
 
+    // a region that passed the validation, before the final offset and scaling
+    struct Segment
+    {
+        rect rec;
+        double log_nfa;
+    };
+
     LineSegmentDetectorImpl& operator= (const LineSegmentDetectorImpl&); // to quiet MSVC
 
 /**
@@ -303,6 +320,25 @@ private:
               std::vector<double>& widths, std::vector<double>& precisions,
               std::vector<double>& nfas);
 
+/**
+ * Grows the region of the seed point and validates it as a line segment.
+ *
+ * @param s         Starting point for the region.
+ * @param reg       Return: The points of the region, which are left marked as used.
+ * @param view      The 'used' flags to work with.
+ * @param seg       Return: The found segment.
+ * @return          Whether the region is a line segment.
+ */
+    bool find_segment(const Point2i& s, std::vector<RegionPoint>& reg, UsedView& view, Segment& seg);
+
+/**
+ * Same as the sequential search over the ordered points, but the seeds are processed in batches:
+ * the regions of a batch are grown in parallel against the flags committed before the batch and
+ * then committed in order. A region that could have seen a point taken earlier in its batch is
+ * grown again, so the result is the same as the sequential one.
+ */
+    void find_segments_parallel(std::vector<Segment>& segments, int nthreads);
+
 /**
  * Finds the angles and the gradients of the image. Generates a list of pseudo ordered points.
  *
@@ -321,7 +357,7 @@ private:
  * @param prec      The precision by which each region angle should be aligned to the mean.
  */
     void region_grow(const Point2i& s, std::vector<RegionPoint>& reg,
-                     double& reg_angle, const double& prec);
+                     double& reg_angle, const double& prec, UsedView& view);
 
 /**
  * Finds the bounding rotated rectangle of a region.
@@ -349,7 +385,7 @@ private:
  * 'reduce_region_radius' is called to try to satisfy this condition.
  */
     bool refine(std::vector<RegionPoint>& reg, double reg_angle,
-                const double prec, double p, rect& rec, const double& density_th);
+                const double prec, double p, rect& rec, const double& density_th, UsedView& view);
 
 /**
  * Reduce the region size, by elimination the points far from the starting point, until that leads to
@@ -449,7 +485,6 @@ void LineSegmentDetectorImpl::flsd(std::vector<Vec4f>& lines,
 {
     // Angle tolerance
     const double prec = CV_PI * ANG_TH / 180;
-    const double p = ANG_TH / 180;
     const double rho = QUANT / sin(prec);    // gradient magnitude threshold
 
     if(SCALE != 1)
@@ -471,65 +506,254 @@ void LineSegmentDetectorImpl::flsd(std::vector<Vec4f>& lines,
     }
 
     LOG_NT = 5 * (log10(double(img_width)) + log10(double(img_height))) / 2 + log10(11.0);
-    const size_t min_reg_size = size_t(-LOG_NT/log10(p)); // minimal number of points in region that can give a meaningful event
 
     // // Initialize region only when needed
     // Mat region = Mat::zeros(scaled_image.size(), CV_8UC1);
     used = Mat_<uchar>::zeros(scaled_image.size()); // zeros = NOTUSED
-    std::vector<RegionPoint> reg;
 
     // Search for line segments
-    for(size_t i = 0, points_size = ordered_points.size(); i < points_size; ++i)
+    std::vector<Segment> segments;
+    const int nthreads = getNumThreads();
+    if(nthreads > 1)
+    {
+        find_segments_parallel(segments, nthreads);
+    }
+    else
     {
-        const Point2i& point = ordered_points[i].p;
-        if((used.at<uchar>(point) == NOTUSED) && (angles.at<double>(point) != NOTDEF))
+        std::vector<RegionPoint> reg;
+        UsedView view = { &used, NULL, NULL };
+        for(size_t i = 0, points_size = ordered_points.size(); i < points_size; ++i)
         {
-            double reg_angle;
-            region_grow(ordered_points[i].p, reg, reg_angle, prec);
+            const Point2i& point = ordered_points[i].p;
+            Segment seg;
+            if((used.at<uchar>(point) == NOTUSED) && (angles.at<double>(point) != NOTDEF) &&
+               find_segment(point, reg, view, seg))
+                segments.push_back(seg);
+        }
+    }
 
-            // Ignore small regions
-            if(reg.size() < min_reg_size) { continue; }
+    for(size_t i = 0; i < segments.size(); ++i)
+    {
+        // Found new line
+        rect rec = segments[i].rec;
 
-            // Construct rectangular approximation for the region
-            rect rec;
-            region2rect(reg, reg_angle, prec, p, rec);
+        // Add the offset
+        rec.x1 += 0.5; rec.y1 += 0.5;
+        rec.x2 += 0.5; rec.y2 += 0.5;
 
-            double log_nfa = -1;
-            if(doRefine > LSD_REFINE_NONE)
-            {
-                // At least REFINE_STANDARD lvl.
-                if(!refine(reg, reg_angle, prec, p, rec, DENSITY_TH)) { continue; }
+        // scale the result values if a sub-sampling was performed
+        if(SCALE != 1)
+        {
+            rec.x1 /= SCALE; rec.y1 /= SCALE;
+            rec.x2 /= SCALE; rec.y2 /= SCALE;
+            rec.width /= SCALE;
+        }
+
+        //Store the relevant data
+        lines.push_back(Vec4f(float(rec.x1), float(rec.y1), float(rec.x2), float(rec.y2)));
+        if(w_needed) widths.push_back(rec.width);
+        if(p_needed) precisions.push_back(rec.p);
+        if(n_needed && doRefine >= LSD_REFINE_ADV) nfas.push_back(segments[i].log_nfa);
+    }
+}
+
+bool LineSegmentDetectorImpl::find_segment(const Point2i& s, std::vector<RegionPoint>& reg,
+                                           UsedView& view, Segment& seg)
+{
+    // Angle tolerance
+    const double prec = CV_PI * ANG_TH / 180;
+    const double p = ANG_TH / 180;
+    const size_t min_reg_size = size_t(-LOG_NT/log10(p)); // minimal number of points in region that can give a meaningful event
+
+    double reg_angle;
+    region_grow(s, reg, reg_angle, prec, view);
+
+    // Ignore small regions
+    if(reg.size() < min_reg_size) { return false; }
+
+    // Construct rectangular approximation for the region
+    rect& rec = seg.rec;
+    region2rect(reg, reg_angle, prec, p, rec);
+
+    seg.log_nfa = -1;
+    if(doRefine > LSD_REFINE_NONE)
+    {
+        // At least REFINE_STANDARD lvl.
+        if(!refine(reg, reg_angle, prec, p, rec, DENSITY_TH, view)) { return false; }
+
+        if(doRefine >= LSD_REFINE_ADV)
+        {
+            // Compute NFA
+            seg.log_nfa = rect_improve(rec);
+            if(seg.log_nfa <= LOG_EPS) { return false; }
+        }
+    }
+    return true;
+}
 
-                if(doRefine >= LSD_REFINE_ADV)
+void LineSegmentDetectorImpl::find_segments_parallel(std::vector<Segment>& segments, int nthreads)
+{
+    struct Search
+    {
+        Point2i seed;
+        bool found;
+        Segment seg;
+        std::vector<RegionPoint> reg;
+        std::vector<Point> grown;
+    };
+
+    const int batch_size = nthreads * 4;
+    std::vector<Search> batch(batch_size);
+    std::vector< Mat_<uchar> > masks(nthreads);
+    Mat_<uchar> taken = Mat_<uchar>::zeros(used.size()); // points committed by the current batch
+    std::vector<Point> taken_list;
+    std::vector<RegionPoint> reg;
+    UsedView view = { &used, NULL, NULL };
+
+    for(size_t i = 0, points_size = ordered_points.size(); i < points_size; )
+    {
+        int n = 0;
+        for(; i < points_size && n < batch_size; ++i)
+        {
+            const Point2i& point = ordered_points[i].p;
+            if((used.at<uchar>(point) == NOTUSED) && (angles.at<double>(point) != NOTDEF))
+                batch[n++].seed = point;
+        }
+
+        const int nstripes = std::min(nthreads, n);
+        parallel_for_(Range(0, nstripes), [&](const Range& range)
+        {
+            for(int t = range.start; t < range.end; ++t)
+            {
+                Mat_<uchar>& mask = masks[t];
+                if(mask.empty())
+                    mask = Mat_<uchar>::zeros(used.size());
+                for(int k = t; k < n; k += nstripes)
                 {
-                    // Compute NFA
-                    log_nfa = rect_improve(rec);
-                    if(log_nfa <= LOG_EPS) { continue; }
+                    Search& search = batch[k];
+                    search.grown.clear();
+                    UsedView private_view = { &mask, &used, &search.grown };
+                    search.found = find_segment(search.seed, search.reg, private_view, search.seg);
+                    for(size_t j = 0; j < search.grown.size(); ++j)
+                        mask(search.grown[j]) = NOTUSED;
                 }
             }
-            // Found new line
+        });
 
-            // Add the offset
-            rec.x1 += 0.5; rec.y1 += 0.5;
-            rec.x2 += 0.5; rec.y2 += 0.5;
+        for(int k = 0; k < n; ++k)
+        {
+            Search& search = batch[k];
+            if(used(search.seed) == USED)
+                continue;
 
-            // scale the result values if a sub-sampling was performed
-            if(SCALE != 1)
+            // the search read the flags of the points it grew and of their neighbours
+            bool valid = true;
+            for(size_t j = 0; j < search.grown.size() && valid; ++j)
             {
-                rec.x1 /= SCALE; rec.y1 /= SCALE;
-                rec.x2 /= SCALE; rec.y2 /= SCALE;
-                rec.width /= SCALE;
+                const Point& pt = search.grown[j];
+                for(int yy = std::max(pt.y - 1, 0); yy <= std::min(pt.y + 1, img_height - 1) && valid; ++yy)
+                    for(int xx = std::max(pt.x - 1, 0); xx <= std::min(pt.x + 1, img_width - 1); ++xx)
+                        if(taken(yy, xx))
+                        {
+                            valid = false;
+                            break;
+                        }
             }
 
-            //Store the relevant data
-            lines.push_back(Vec4f(float(rec.x1), float(rec.y1), float(rec.x2), float(rec.y2)));
-            if(w_needed) widths.push_back(rec.width);
-            if(p_needed) precisions.push_back(rec.p);
-            if(n_needed && doRefine >= LSD_REFINE_ADV) nfas.push_back(log_nfa);
+            std::vector<RegionPoint>* final_reg = &search.reg;
+            if(!valid)
+            {
+                search.found = find_segment(search.seed, reg, view, search.seg);
+                final_reg = &reg;
+            }
+            for(size_t j = 0; j < final_reg->size(); ++j)
+            {
+                const Point pt((*final_reg)[j].x, (*final_reg)[j].y);
+                used(pt) = USED;
+                taken(pt) = 1;
+                taken_list.push_back(pt);
+            }
+            if(search.found)
+                segments.push_back(search.seg);
         }
+
+        for(size_t j = 0; j < taken_list.size(); ++j)
+            taken(taken_list[j]) = 0;
+        taken_list.clear();
     }
 }
 
+// Computes the gradient norm and angle of a row, returns the maximal norm above the threshold or -1
+static double ll_angle_row(const uchar* row, const uchar* next_row, double* angles_row, double* modgrad_row,
+                           int width, double threshold)
+{
+    double max_norm = -1;
+    int x = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE) && (CV_SIMD_64F || CV_SIMD_SCALABLE_64F)
+    // fastAtan2 with the same operation order, so the angles are bit-exact
+    const int VECSZ = VTraits<v_float32>::vlanes(), HALF = VTraits<v_float64>::vlanes();
+    const v_float32 eps = vx_setall_f32((float)DBL_EPSILON), z = vx_setzero_f32();
+    const v_float32 p1 = vx_setall_f32(0.9997878412794807f*(float)(180/CV_PI));
+    const v_float32 p3 = vx_setall_f32(-0.3258083974640975f*(float)(180/CV_PI));
+    const v_float32 p5 = vx_setall_f32(0.1555786518463281f*(float)(180/CV_PI));
+    const v_float32 p7 = vx_setall_f32(-0.04432655554792128f*(float)(180/CV_PI));
+    const v_float64 quarter = vx_setall_f64(0.25), thresh = vx_setall_f64(threshold);
+    const v_float64 notdef = vx_setall_f64(NOTDEF), to_rads = vx_setall_f64(DEG_TO_RADS);
+    v_float64 vmax = vx_setall_f64(-1);
+    for( ; x <= width - VECSZ; x += VECSZ )
+    {
+        v_int32 a = v_reinterpret_as_s32(vx_load_expand_q(row + x));
+        v_int32 b = v_reinterpret_as_s32(vx_load_expand_q(row + x + 1));
+        v_int32 c = v_reinterpret_as_s32(vx_load_expand_q(next_row + x));
+        v_int32 d = v_reinterpret_as_s32(vx_load_expand_q(next_row + x + 1));
+        v_int32 DA = v_sub(d, a), BC = v_sub(b, c);
+        v_int32 gx = v_add(DA, BC), gy = v_sub(DA, BC);
+        v_int32 n2 = v_add(v_mul(gx, gx), v_mul(gy, gy));
+
+        v_float32 fy = v_cvt_f32(gx), fx = v_cvt_f32(v_sub(vx_setzero_s32(), gy));
+        v_float32 ax = v_abs(fx), ay = v_abs(fy);
+        v_float32 t = v_div(v_min(ax, ay), v_add(v_max(ax, ay), eps));
+        v_float32 t2 = v_mul(t, t);
+        v_float32 ang = v_mul(v_add(v_mul(v_add(v_mul(v_add(v_mul(p7, t2), p5), t2), p3), t2), p1), t);
+        ang = v_select(v_ge(ax, ay), ang, v_sub(vx_setall_f32(90.f), ang));
+        ang = v_select(v_lt(fx, z), v_sub(vx_setall_f32(180.f), ang), ang);
+        ang = v_select(v_lt(fy, z), v_sub(vx_setall_f32(360.f), ang), ang);
+
+        v_float64 norm0 = v_sqrt(v_mul(v_cvt_f64(n2), quarter));
+        v_float64 norm1 = v_sqrt(v_mul(v_cvt_f64_high(n2), quarter));
+        v_float64 ang0 = v_select(v_le(norm0, thresh), notdef, v_mul(v_cvt_f64(ang), to_rads));
+        v_float64 ang1 = v_select(v_le(norm1, thresh), notdef, v_mul(v_cvt_f64_high(ang), to_rads));
+        vmax = v_max(vmax, v_max(norm0, norm1));
+
+        v_store(modgrad_row + x, norm0);
+        v_store(modgrad_row + x + HALF, norm1);
+        v_store(angles_row + x, ang0);
+        v_store(angles_row + x + HALF, ang1);
+    }
+    double buf[VTraits<v_float64>::max_nlanes];
+    v_store(buf, vmax);
+    for( int i = 0; i < HALF; i++ )
+        max_norm = std::max(max_norm, buf[i]);
+#endif
+    for( ; x < width; ++x )
+    {
+        int DA = next_row[x + 1] - row[x];
+        int BC = row[x + 1] - next_row[x];
+        int gx = DA + BC;    // gradient x component
+        int gy = DA - BC;    // gradient y component
+        double norm = std::sqrt((gx * gx + gy * gy) / 4.0); // gradient norm
+
+        modgrad_row[x] = norm;    // store gradient
+
+        if (norm <= threshold)  // norm too small, gradient no defined
+            angles_row[x] = NOTDEF;
+        else
+            angles_row[x] = fastAtan2(float(gx), float(-gy)) * DEG_TO_RADS;  // gradient angle computation
+        max_norm = std::max(max_norm, norm);
+    }
+    return max_norm > threshold ? max_norm : -1;
+}
+
 void LineSegmentDetectorImpl::ll_angle(const double& threshold,
                                    const unsigned int& n_bins)
 {
@@ -544,70 +768,91 @@ void LineSegmentDetectorImpl::ll_angle(const double& threshold,
     angles.row(img_height - 1).setTo(NOTDEF);
     angles.col(img_width - 1).setTo(NOTDEF);
 
+    const int rows = img_height - 1, cols = img_width - 1;
+    const int nstripes = std::max(1, std::min(getNumThreads() * 2, rows / 16));
+    std::vector<double> max_grads(nstripes, -1);
+
     // Computing gradient for remaining pixels
-    double max_grad = -1;
-    for(int y = 0; y < img_height - 1; ++y)
+    parallel_for_(Range(0, nstripes), [&](const Range& range)
     {
-        const uchar* scaled_image_row = scaled_image.ptr<uchar>(y);
-        const uchar* next_scaled_image_row = scaled_image.ptr<uchar>(y+1);
-        double* angles_row = angles.ptr<double>(y);
-        double* modgrad_row = modgrad.ptr<double>(y);
-        for(int x = 0; x < img_width-1; ++x)
+        for(int s = range.start; s < range.end; ++s)
         {
-            int DA = next_scaled_image_row[x + 1] - scaled_image_row[x];
-            int BC = scaled_image_row[x + 1] - next_scaled_image_row[x];
-            int gx = DA + BC;    // gradient x component
-            int gy = DA - BC;    // gradient y component
-            double norm = std::sqrt((gx * gx + gy * gy) / 4.0); // gradient norm
-
-            modgrad_row[x] = norm;    // store gradient
-
-            if (norm <= threshold)  // norm too small, gradient no defined
+            for(int y = rows * s / nstripes; y < rows * (s + 1) / nstripes; ++y)
             {
-                angles_row[x] = NOTDEF;
+                double max_grad = ll_angle_row(scaled_image.ptr<uchar>(y), scaled_image.ptr<uchar>(y + 1),
+                                               angles.ptr<double>(y), modgrad.ptr<double>(y), cols, threshold);
+                max_grads[s] = std::max(max_grads[s], max_grad);
             }
-            else
+        }
+    });
+    double max_grad = *std::max_element(max_grads.begin(), max_grads.end());
+
+    // Pseudo-order the points by the gradient norm: a counting sort over the bins in decreasing order,
+    // stable within a bin, so region growing and thus overall LSD result is deterministic.
+    double bin_coef = (max_grad > 0) ? double(n_bins - 1) / max_grad : 0; // If all image is smooth, max_grad <= 0
+    std::vector<int> counts((size_t)nstripes * n_bins, 0);
+    parallel_for_(Range(0, nstripes), [&](const Range& range)
+    {
+        for(int s = range.start; s < range.end; ++s)
+        {
+            int* count = &counts[(size_t)s * n_bins];
+            for(int y = rows * s / nstripes; y < rows * (s + 1) / nstripes; ++y)
             {
-                angles_row[x] = fastAtan2(float(gx), float(-gy)) * DEG_TO_RADS;  // gradient angle computation
-                if (norm > max_grad) { max_grad = norm; }
+                const double* modgrad_row = modgrad.ptr<double>(y);
+                for(int x = 0; x < cols; ++x)
+                    ++count[int(modgrad_row[x] * bin_coef)];
             }
-
         }
-    }
+    });
 
-    // Compute histogram of gradient values
-    double bin_coef = (max_grad > 0) ? double(n_bins - 1) / max_grad : 0; // If all image is smooth, max_grad <= 0
-    for(int y = 0; y < img_height - 1; ++y)
+    int ofs = 0;
+    for(int i = (int)n_bins - 1; i >= 0; --i)
     {
-        const double* modgrad_row = modgrad.ptr<double>(y);
-        for(int x = 0; x < img_width - 1; ++x)
+        for(int s = 0; s < nstripes; ++s)
         {
-            normPoint _point;
-            int i = int(modgrad_row[x] * bin_coef);
-            _point.p = Point(x, y);
-            _point.norm = i;
-            ordered_points.push_back(_point);
+            int count = counts[(size_t)s * n_bins + i];
+            counts[(size_t)s * n_bins + i] = ofs;
+            ofs += count;
         }
     }
 
-    // Use stable sort to ensure deterministic region growing and thus overall LSD result determinism.
-    std::stable_sort(ordered_points.begin(), ordered_points.end(), compare_norm);
+    ordered_points.resize(ofs);
+    parallel_for_(Range(0, nstripes), [&](const Range& range)
+    {
+        for(int s = range.start; s < range.end; ++s)
+        {
+            int* pos = &counts[(size_t)s * n_bins];
+            for(int y = rows * s / nstripes; y < rows * (s + 1) / nstripes; ++y)
+            {
+                const double* modgrad_row = modgrad.ptr<double>(y);
+                for(int x = 0; x < cols; ++x)
+                {
+                    int i = int(modgrad_row[x] * bin_coef);
+                    normPoint& _point = ordered_points[pos[i]++];
+                    _point.p = Point(x, y);
+                    _point.norm = i;
+                }
+            }
+        }
+    });
 }
 
 void LineSegmentDetectorImpl::region_grow(const Point2i& s, std::vector<RegionPoint>& reg,
-                                      double& reg_angle, const double& prec)
+                                      double& reg_angle, const double& prec, UsedView& view)
 {
     reg.clear();
+    Mat_<uchar>& used_mask = *view.mask;
 
     // Point to this region
     RegionPoint seed;
     seed.x = s.x;
     seed.y = s.y;
-    seed.used = &used.at<uchar>(s);
+    seed.used = &used_mask.at<uchar>(s);
     reg_angle = angles.at<double>(s);
     seed.angle = reg_angle;
     seed.modgrad = modgrad.at<double>(s);
     reg.push_back(seed);
+    if (view.grown) view.grown->push_back(s);
 
     float sumdx = float(std::cos(reg_angle));
     float sumdy = float(std::sin(reg_angle));
@@ -621,13 +866,14 @@ void LineSegmentDetectorImpl::region_grow(const Point2i& s, std::vector<RegionPo
         int yy_min = std::max(rpoint.y - 1, 0), yy_max = std::min(rpoint.y + 1, img_height - 1);
         for(int yy = yy_min; yy <= yy_max; ++yy)
         {
-            uchar* used_row = used.ptr<uchar>(yy);
+            uchar* used_row = used_mask.ptr<uchar>(yy);
+            const uchar* committed_row = view.committed ? view.committed->ptr<uchar>(yy) : NULL;
             const double* angles_row = angles.ptr<double>(yy);
             const double* modgrad_row = modgrad.ptr<double>(yy);
             for(int xx = xx_min; xx <= xx_max; ++xx)
             {
                 uchar& is_used = used_row[xx];
-                if(is_used != USED &&
+                if(is_used != USED && (!committed_row || committed_row[xx] != USED) &&
                    (isAligned(xx, yy, reg_angle, prec)))
                 {
                     const double& angle = angles_row[xx];
@@ -640,6 +886,7 @@ void LineSegmentDetectorImpl::region_grow(const Point2i& s, std::vector<RegionPo
                     region_point.modgrad = modgrad_row[xx];
                     region_point.angle = angle;
                     reg.push_back(region_point);
+                    if (view.grown) view.grown->push_back(Point(xx, yy));
 
                     // Update region's angle
                     sumdx += cos(float(angle));
@@ -749,7 +996,7 @@ double LineSegmentDetectorImpl::get_theta(const std::vector<RegionPoint>& reg, c
 }
 
 bool LineSegmentDetectorImpl::refine(std::vector<RegionPoint>& reg, double reg_angle,
-                                 const double prec, double p, rect& rec, const double& density_th)
+                                 const double prec, double p, rect& rec, const double& density_th, UsedView& view)
 {
     double density = double(reg.size()) / (dist(rec.x1, rec.y1, rec.x2, rec.y2) * rec.width);
 
@@ -780,7 +1027,7 @@ bool LineSegmentDetectorImpl::refine(std::vector<RegionPoint>& reg, double reg_a
     double tau = 2.0 * sqrt((s_sum - 2.0 * mean_angle * sum) / double(n) + mean_angle * mean_angle);
 
     // Try new region
-    region_grow(Point(reg[0].x, reg[0].y), reg, reg_angle, tau);
+    region_grow(Point(reg[0].x, reg[0].y), reg, reg_angle, tau, view);
 
     if (reg.size() < 2) { return false; }
 
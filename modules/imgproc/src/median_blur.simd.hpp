@@ -838,6 +838,175 @@ medianBlur_SortNet( const Mat& _src, Mat& _dst, int m )
     }
 }
 
+/*
+ * Large-aperture median for 16-bit and floating-point data.
+ *
+ * Every pixel is mapped to an order-preserving code; its upper 16 bits form the
+ * histogram key. A two-tier histogram (256/4096 bins) of the keys is slid along each
+ * row, which costs O(ksize) cache-resident updates per pixel and at most 16 bin visits
+ * to locate the 12-bit bucket holding the median. The few window values that fall into
+ * that bucket are then gathered and the exact median is picked with nth_element.
+ */
+struct MedianKey16u
+{
+    typedef ushort value_type;
+    enum { exact = 1 };
+    static unsigned code(ushort v) { return v; }
+    static ushort value(unsigned k) { return (ushort)k; }
+};
+
+struct MedianKey16s
+{
+    typedef short value_type;
+    enum { exact = 1 };
+    static unsigned code(short v) { return (ushort)v ^ 0x8000u; }
+    static short value(unsigned k) { return (short)(ushort)(k ^ 0x8000u); }
+};
+
+struct MedianKey32f
+{
+    typedef float value_type;
+    enum { exact = 0 };
+    static unsigned code(float v)
+    {
+        Cv32suf u; u.f = v;
+        return (u.u & 0x80000000u) ? ~u.u : (u.u | 0x80000000u);
+    }
+    static float value(unsigned k)
+    {
+        Cv32suf u; u.u = (k & 0x80000000u) ? (k ^ 0x80000000u) : ~k;
+        return u.f;
+    }
+};
+
+template<class KeyOp>
+static void
+medianBlur_SlidingHist( const Mat& _src, Mat& _dst, int ksize, const Range& rows )
+{
+    CV_INSTRUMENT_REGION();
+
+    typedef typename KeyOp::value_type T;
+    const int BAND = 64;
+    const int r = ksize/2, n2 = ksize*ksize/2;
+    const int width = _dst.cols, height = _dst.rows, cn = _dst.channels();
+    const int pw = width + 2*r;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int nlanes = VTraits<v_uint16>::vlanes();
+#else
+    const int nlanes = 1;
+#endif
+
+    AutoBuffer<int> _xofs(pw);
+    int* xofs = _xofs.data();
+    for( int x = 0; x < pw; x++ )
+        xofs[x] = std::min(std::max(x - r, 0), width - 1)*cn;
+
+    // the candidate search may read up to nlanes-1 keys past the last window
+    std::vector<ushort> _keys((size_t)(BAND + 2*r)*pw + nlanes);
+    std::vector<unsigned> _codes(KeyOp::exact ? 0 : _keys.size()), _cand(ksize*ksize);
+    ushort h0[256], h1[4096];
+    memset(h0, 0, sizeof(h0));
+    memset(h1, 0, sizeof(h1));
+
+    for( int y0 = rows.start; y0 < rows.end; y0 += BAND )
+    {
+        int y1 = std::min(y0 + BAND, rows.end);
+        int nrows = y1 - y0 + 2*r;
+
+        for( int c = 0; c < cn; c++ )
+        {
+            // replicate-padded keys (and full codes) of the band rows with the vertical halo
+            for( int i = 0; i < nrows; i++ )
+            {
+                const T* srow = _src.ptr<T>(std::min(std::max(y0 - r + i, 0), height - 1)) + c;
+                ushort* krow = &_keys[(size_t)i*pw];
+                if( KeyOp::exact )
+                {
+                    for( int x = 0; x < pw; x++ )
+                        krow[x] = (ushort)KeyOp::code(srow[xofs[x]]);
+                }
+                else
+                {
+                    unsigned* crow = &_codes[(size_t)i*pw];
+                    for( int x = 0; x < pw; x++ )
+                    {
+                        unsigned code = KeyOp::code(srow[xofs[x]]);
+                        crow[x] = code;
+                        krow[x] = (ushort)(code >> 16);
+                    }
+                }
+            }
+
+            for( int y = y0; y < y1; y++ )
+            {
+                const ushort* win = &_keys[(size_t)(y - y0)*pw];
+                T* drow = _dst.ptr<T>(y) + c;
+                int c0 = 0, below = 0;
+
+                for( int i = 0; i < ksize; i++ )
+                    for( int j = 0; j < ksize; j++ )
+                    {
+                        int k = win[i*pw + j];
+                        h0[k >> 8]++; h1[k >> 4]++;
+                    }
+
+                for( int x = 0; ; x++ )
+                {
+                    while( below > n2 )
+                        below -= h0[--c0];
+                    while( below + h0[c0] <= n2 )
+                        below += h0[c0++];
+                    int s = below, b = c0*16;
+                    while( s + h1[b] <= n2 )
+                        s += h1[b++];
+
+                    // gather the window values of bucket b
+                    unsigned* cand = &_cand[0];
+                    int ncand = 0, total = h1[b];
+                    for( int i = 0; i < ksize && ncand < total; i++ )
+                    {
+                        const ushort* krow = win + i*pw + x;
+                        for( int j = 0; j < ksize; j += nlanes )
+                        {
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+                            if( !v_check_any(v_eq(v_shr<4>(vx_load(krow + j)), vx_setall_u16((ushort)b))) )
+                                continue;
+#endif
+                            for( int jj = j; jj < std::min(j + nlanes, ksize); jj++ )
+                                if( (krow[jj] >> 4) == b )
+                                    cand[ncand++] = KeyOp::exact ? krow[jj] : _codes[(size_t)(y - y0 + i)*pw + x + jj];
+                        }
+                    }
+                    CV_DbgAssert( ncand == total );
+                    if( ncand > 1 )
+                        std::nth_element(cand, cand + (n2 - s), cand + ncand);
+                    drow[x*cn] = KeyOp::value(cand[n2 - s]);
+
+                    if( x == width - 1 )
+                        break;
+
+                    // slide the window one column to the right
+                    for( int i = 0; i < ksize; i++ )
+                    {
+                        int k = win[i*pw + x], k1 = win[i*pw + x + ksize];
+                        h0[k >> 8]--; h1[k >> 4]--;
+                        h0[k1 >> 8]++; h1[k1 >> 4]++;
+                        below += ((k1 >> 8) < c0) - ((k >> 8) < c0);
+                    }
+                }
+
+                // empty the histogram for the next row
+                for( int i = 0; i < ksize; i++ )
+                    for( int j = width - 1; j < pw; j++ )
+                    {
+                        int k = win[i*pw + j];
+                        h0[k >> 8]--; h1[k >> 4]--;
+                    }
+            }
+        }
+    }
+}
+
 } // namespace anon
 
 void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
@@ -871,6 +1040,27 @@ void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
 
         return;
     }
+    else if( src0.depth() != CV_8U )
+    {
+        int depth = src0.depth();
+        CV_Assert( (depth == CV_16U || depth == CV_16S || depth == CV_32F) && ksize <= 255 );
+
+        if( dst.data != src0.data )
+            src = src0;
+        else
+            src0.copyTo(src);
+
+        double nstripes = std::min(getNumThreads()*4.0, std::max(src.rows/(4.0*ksize), 1.0));
+        parallel_for_(Range(0, src.rows), [&](const Range& range)
+        {
+            if( depth == CV_16U )
+                medianBlur_SlidingHist<MedianKey16u>( src, dst, ksize, range );
+            else if( depth == CV_16S )
+                medianBlur_SlidingHist<MedianKey16s>( src, dst, ksize, range );
+            else
+                medianBlur_SlidingHist<MedianKey32f>( src, dst, ksize, range );
+        }, nstripes);
+    }
     else
     {
         // TODO AVX guard (external call)
@@ -880,11 +1070,24 @@ void medianBlur(const Mat& src0, /*const*/ Mat& dst, int ksize)
         CV_Assert( src.depth() == CV_8U && (cn == 1 || cn == 3 || cn == 4) );
 
         double img_size_mp = (double)(src0.total())/(1 << 20);
-        if( ksize <= 3 + (img_size_mp < 1 ? 12 : img_size_mp < 4 ? 6 : 2)*
-            (CV_SIMD ? 1 : 3))
-            medianBlur_8u_Om( src, dst, ksize );
-        else
-            medianBlur_8u_O1( src, dst, ksize );
+        bool useOm = ksize <= 3 + (img_size_mp < 1 ? 12 : img_size_mp < 4 ? 6 : 2)*
+            (CV_SIMD ? 1 : 3);
+
+        // both histogram methods sweep the image vertically, so they are run on
+        // independent column bands; the padded source supplies the horizontal halo
+        int nthreads = getNumThreads();
+        int bandWidth = nthreads <= 1 ? dst.cols :
+            std::max(std::max(64, ksize*4), (dst.cols + nthreads*2 - 1)/(nthreads*2));
+        int nbands = (dst.cols + bandWidth - 1)/bandWidth;
+        parallel_for_(Range(0, nbands), [&](const Range& range)
+        {
+            int x0 = range.start*bandWidth, x1 = std::min(range.end*bandWidth, dst.cols);
+            Mat sband = src.colRange(x0, x1 + ksize - 1), dband = dst.colRange(x0, x1);
+            if( useOm )
+                medianBlur_8u_Om( sband, dband, ksize );
+            else
+                medianBlur_8u_O1( sband, dband, ksize );
+        });
     }
 }
 
@@ -87,6 +87,35 @@ Ptr<BaseFilter> getMorphologyFilter(int op, int type, InputArray _kernel, Point
 }
 
 
+// replaces the default border value with the neutral element of the operation
+static Scalar normalizeMorphologyBorderValue(int op, int type, const Scalar& borderValue)
+{
+    if( borderValue != morphologyDefaultBorderValue() )
+        return borderValue;
+
+    int depth = CV_MAT_DEPTH(type);
+    CV_Assert( depth == CV_8U || depth == CV_16U || depth == CV_16S ||
+               depth == CV_32F || depth == CV_64F );
+    if( op == MORPH_ERODE )
+        return Scalar::all( depth == CV_8U ? (double)UCHAR_MAX :
+                            depth == CV_16U ? (double)USHRT_MAX :
+                            depth == CV_16S ? (double)SHRT_MAX :
+                            depth == CV_32F ? (double)FLT_MAX : DBL_MAX);
+    return Scalar::all( depth == CV_8U || depth == CV_16U ?
+                            0. :
+                        depth == CV_16S ? (double)SHRT_MIN :
+                        depth == CV_32F ? (double)-FLT_MAX : -DBL_MAX);
+}
+
+static void morphologyRectVHGW(int op, const Mat& src, Mat& dst, Size ksize, Point anchor,
+                               int borderType, const Scalar& borderValue)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_CPU_DISPATCH(morphologyRectVHGW, (op, src, dst, ksize, anchor, borderType, borderValue),
+        CV_CPU_DISPATCH_MODES_ALL);
+}
+
 Ptr<FilterEngine> createMorphologyFilter(
         int op, int type, InputArray _kernel,
         Point anchor, int _rowBorderType, int _columnBorderType,
@@ -109,23 +138,8 @@ Ptr<FilterEngine> createMorphologyFilter(
         filter2D = getMorphologyFilter(op, type, kernel, anchor);
 
     Scalar borderValue = _borderValue;
-    if( (_rowBorderType == BORDER_CONSTANT || _columnBorderType == BORDER_CONSTANT) &&
-            borderValue == morphologyDefaultBorderValue() )
-    {
-        int depth = CV_MAT_DEPTH(type);
-        CV_Assert( depth == CV_8U || depth == CV_16U || depth == CV_16S ||
-                   depth == CV_32F || depth == CV_64F );
-        if( op == MORPH_ERODE )
-            borderValue = Scalar::all( depth == CV_8U ? (double)UCHAR_MAX :
-                                       depth == CV_16U ? (double)USHRT_MAX :
-                                       depth == CV_16S ? (double)SHRT_MAX :
-                                       depth == CV_32F ? (double)FLT_MAX : DBL_MAX);
-        else
-            borderValue = Scalar::all( depth == CV_8U || depth == CV_16U ?
-                                           0. :
-                                       depth == CV_16S ? (double)SHRT_MIN :
-                                       depth == CV_32F ? (double)-FLT_MAX : -DBL_MAX);
-    }
+    if( _rowBorderType == BORDER_CONSTANT || _columnBorderType == BORDER_CONSTANT )
+        borderValue = normalizeMorphologyBorderValue(op, type, borderValue);
 
     return makePtr<FilterEngine>(filter2D, rowFilter, columnFilter,
                                  type, type, type, _rowBorderType, _columnBorderType, borderValue );
@@ -431,6 +445,19 @@ static bool ippMorph(int op, int src_type, int dst_type,
 
 // ===== 3. Fallback implementation
 
+// The van Herk/Gil-Werman filter makes the vertical pass independent of the kernel height.
+// Horizontally the vectorized running filter is about as fast, so wide flat kernels only gain
+// from the banded multithreading, or from the constant cost when there is no SIMD (64F).
+static bool useMorphologyRectVHGW(int type, const Mat& kernel, int iterations)
+{
+    const int minKSize = 16;
+    if( iterations != 1 || (kernel.rows < minKSize && kernel.cols < minKSize) )
+        return false;
+    if( kernel.rows < minKSize && CV_MAT_DEPTH(type) != CV_64F && getNumThreads() <= 1 )
+        return false;
+    return countNonZero(kernel) == kernel.rows*kernel.cols;
+}
+
 static void ocvMorph(int op, int src_type, int dst_type,
                      uchar * src_data, size_t src_step,
                      uchar * dst_data, size_t dst_step,
@@ -444,6 +471,20 @@ static void ocvMorph(int op, int src_type, int dst_type,
     Mat kernel(Size(kernel_width, kernel_height), kernel_type, kernel_data, kernel_step);
     Point anchor(anchor_x, anchor_y);
     Vec<double, 4> borderVal(borderValue);
+
+    if( useMorphologyRectVHGW(src_type, kernel, iterations) )
+    {
+        size_t esz = CV_ELEM_SIZE(src_type);
+        Mat whole(Size(roi_width, roi_height), src_type, src_data - roi_y*src_step - roi_x*esz, src_step);
+        Mat dst(Size(width, height), dst_type, dst_data, dst_step);
+        if( dst.datastart < whole.dataend && whole.datastart < dst.dataend )
+            whole = whole.clone(); // the bands are written while their neighbours are still read
+        Mat src = whole(Rect(roi_x, roi_y, width, height));
+        morphologyRectVHGW(op, src, dst, kernel.size(), anchor, borderType,
+                           normalizeMorphologyBorderValue(op, src_type, borderVal));
+        return;
+    }
+
     Ptr<FilterEngine> f = createMorphologyFilter(op, src_type, kernel, anchor, borderType, borderType, borderVal);
     Mat src(Size(width, height), src_type, src_data, src_step);
     Mat dst(Size(width, height), dst_type, dst_data, dst_step);
@@ -54,6 +54,8 @@ CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
 Ptr<BaseRowFilter> getMorphologyRowFilter(int op, int type, int ksize, int anchor);
 Ptr<BaseColumnFilter> getMorphologyColumnFilter(int op, int type, int ksize, int anchor);
 Ptr<BaseFilter> getMorphologyFilter(int op, int type, const Mat& kernel, Point anchor);
+void morphologyRectVHGW(int op, const Mat& src, Mat& dst, Size ksize, Point anchor,
+                        int borderType, const Scalar& borderValue);
 
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
@@ -106,6 +108,11 @@ struct MorphNoVec
     int operator()(uchar**, int, uchar*, int) const { return 0; }
 };
 
+struct MorphMergeNoVec
+{
+    int operator()(const uchar*, const uchar*, uchar*, int) const { return 0; }
+};
+
 #if CV_SIMD // TODO: enable for CV_SIMD_SCALABLE, GCC 13 related
 
 template<class VecUpdate> struct MorphRowVec
@@ -417,6 +424,36 @@ template <typename T> struct VMax
     vtype operator()(const vtype& a, const vtype& b) const { return v_max(a,b); }
 };
 
+// dst[i] = op(a[i], b[i]), used by the van Herk/Gil-Werman filter
+template<class VecUpdate> struct MorphMergeVec
+{
+    typedef typename VecUpdate::vtype vtype;
+    typedef typename VTraits<vtype>::lane_type stype;
+    int operator()(const uchar* _a, const uchar* _b, uchar* _dst, int width) const
+    {
+        const stype* a = (const stype*)_a;
+        const stype* b = (const stype*)_b;
+        stype* dst = (stype*)_dst;
+        const int vlanes = VTraits<vtype>::vlanes();
+        VecUpdate updateOp;
+        int i = 0;
+
+        for( ; i <= width - 2*vlanes; i += 2*vlanes )
+        {
+            vtype s0 = updateOp(vx_load(a + i), vx_load(b + i));
+            vtype s1 = updateOp(vx_load(a + i + vlanes), vx_load(b + i + vlanes));
+            v_store(dst + i, s0);
+            v_store(dst + i + vlanes, s1);
+        }
+        if( i <= width - vlanes )
+        {
+            v_store(dst + i, updateOp(vx_load(a + i), vx_load(b + i)));
+            i += vlanes;
+        }
+        return i;
+    }
+};
+
 typedef MorphRowVec<VMin<v_uint8> > ErodeRowVec8u;
 typedef MorphRowVec<VMax<v_uint8> > DilateRowVec8u;
 typedef MorphRowVec<VMin<v_uint16> > ErodeRowVec16u;
@@ -444,6 +481,15 @@ typedef MorphVec<VMax<v_int16> > DilateVec16s;
 typedef MorphVec<VMin<v_float32> > ErodeVec32f;
 typedef MorphVec<VMax<v_float32> > DilateVec32f;
 
+typedef MorphMergeVec<VMin<v_uint8> > ErodeMergeVec8u;
+typedef MorphMergeVec<VMax<v_uint8> > DilateMergeVec8u;
+typedef MorphMergeVec<VMin<v_uint16> > ErodeMergeVec16u;
+typedef MorphMergeVec<VMax<v_uint16> > DilateMergeVec16u;
+typedef MorphMergeVec<VMin<v_int16> > ErodeMergeVec16s;
+typedef MorphMergeVec<VMax<v_int16> > DilateMergeVec16s;
+typedef MorphMergeVec<VMin<v_float32> > ErodeMergeVec32f;
+typedef MorphMergeVec<VMax<v_float32> > DilateMergeVec32f;
+
 #else
 
 typedef MorphRowNoVec ErodeRowVec8u;
@@ -475,6 +521,15 @@ typedef MorphNoVec DilateVec16s;
 typedef MorphNoVec ErodeVec32f;
 typedef MorphNoVec DilateVec32f;
 
+typedef MorphMergeNoVec ErodeMergeVec8u;
+typedef MorphMergeNoVec DilateMergeVec8u;
+typedef MorphMergeNoVec ErodeMergeVec16u;
+typedef MorphMergeNoVec DilateMergeVec16u;
+typedef MorphMergeNoVec ErodeMergeVec16s;
+typedef MorphMergeNoVec DilateMergeVec16s;
+typedef MorphMergeNoVec ErodeMergeVec32f;
+typedef MorphMergeNoVec DilateMergeVec32f;
+
 #endif
 
 typedef MorphRowNoVec ErodeRowVec64f;
@@ -483,6 +538,8 @@ typedef MorphColumnNoVec ErodeColumnVec64f;
 typedef MorphColumnNoVec DilateColumnVec64f;
 typedef MorphNoVec ErodeVec64f;
 typedef MorphNoVec DilateVec64f;
+typedef MorphMergeNoVec ErodeMergeVec64f;
+typedef MorphMergeNoVec DilateMergeVec64f;
 
 
 template<class Op, class VecOp> struct MorphRowFilter : public BaseRowFilter
@@ -704,6 +761,200 @@ template<class Op, class VecOp> struct MorphFilter : BaseFilter
     VecOp vecOp;
 };
 
+/*
+ van Herk/Gil-Werman min/max filter for rectangular structuring elements.
+ The output is split into bands of rows that are processed independently. Each band
+ filters its source rows horizontally into a ring of 2*ksize.height rows and splits them
+ into blocks of ksize.height rows: the window starting at row i is
+ op(suffix(i), prefix(i + ksize.height - 1)) of the block scans, so the vertical pass
+ costs 3 operations per pixel whatever the kernel height is. The scans work on whole
+ rows and are vectorized across columns. The row scans are sequential, so the horizontal
+ pass uses them only when the running vectorized filter would be slower.
+*/
+template<class Op, class VecOp> struct MorphRectVHGW
+{
+    typedef typename Op::rtype T;
+
+    static void merge(const T* a, const T* b, T* dst, int width)
+    {
+        VecOp vecOp;
+        Op op;
+        int i = vecOp((const uchar*)a, (const uchar*)b, (uchar*)dst, width);
+        for( ; i < width; i++ )
+            dst[i] = op(a[i], b[i]);
+    }
+
+    // horizontal van Herk/Gil-Werman pass over a padded row; buf has 2*(width + ksize - 1)*cn elements
+    static void filterRow(const T* S, T* D, int width, int cn, int ksize, T* buf)
+    {
+        int n = (width + ksize - 1)*cn, K = ksize*cn;
+        T* G = buf;
+        T* H = buf + n;
+        Op op;
+
+        for( int b0 = 0; b0 < n; b0 += K )
+        {
+            int b1 = std::min(b0 + K, n), i;
+            for( i = b0; i < b0 + cn; i++ )
+                G[i] = S[i];
+            for( ; i < b1; i++ )
+                G[i] = op(G[i - cn], S[i]);
+            for( i = b1 - 1; i >= b1 - cn; i-- )
+                H[i] = S[i];
+            for( ; i >= b0; i-- )
+                H[i] = op(H[i + cn], S[i]);
+        }
+        merge(H, G + K - cn, D, width*cn);
+    }
+
+    // vertical pass: count output rows from count + ksize - 1 source rows; buf has 2*width elements
+    static void filterColumns(const uchar** src, uchar* dst, size_t dststep, int count, int width, int ksize, T* buf)
+    {
+        T* R = buf;
+        T* G = buf + width;
+
+        for( int y0 = 0; y0 < count; y0 += ksize )
+        {
+            const T** S = (const T**)src + y0;
+            int nrows = std::min(ksize, count - y0);
+
+            // suffix scan of the block, only the first nrows rows are kept
+            const T* prev = S[ksize - 1];
+            if( nrows == ksize )
+            {
+                T* D = (T*)(dst + dststep*(y0 + ksize - 1));
+                memcpy(D, prev, width*sizeof(T));
+                prev = D;
+            }
+            for( int j = ksize - 2; j >= 0; j-- )
+            {
+                T* D = j < nrows ? (T*)(dst + dststep*(y0 + j)) : R;
+                merge(S[j], prev, D, width);
+                prev = D;
+            }
+
+            // prefix scan of the next block
+            for( int j = 1; j < nrows; j++ )
+            {
+                T* D = (T*)(dst + dststep*(y0 + j));
+                if( j == 1 )
+                    memcpy(G, S[ksize], width*sizeof(T));
+                else
+                    merge(G, S[ksize + j - 1], G, width);
+                merge(D, G, D, width);
+            }
+        }
+    }
+
+    static void apply(int op, const Mat& src, Mat& dst, Size ksize, Point anchor,
+                      int borderType, const Scalar& borderValue)
+    {
+        int type = src.type(), cn = src.channels(), esz = (int)src.elemSize();
+        int width = dst.cols, height = dst.rows, kw = ksize.width, kh = ksize.height;
+        int padWidth = width + kw - 1;
+        Size wholeSize;
+        Point ofs;
+        src.locateROI(wholeSize, ofs);
+
+        // column of the whole image for every padded column, -1 for the constant border
+        std::vector<int> xofs(padWidth);
+        for( int x = 0; x < padWidth; x++ )
+            xofs[x] = borderInterpolate(ofs.x + x - anchor.x, wholeSize.width, borderType);
+        int xin0 = anchor.x, xin1 = anchor.x + width;
+        while( xin0 > 0 && xofs[xin0 - 1] >= 0 && xofs[xin0 - 1] == xofs[xin0] - 1 )
+            xin0--;
+        while( xin1 < padWidth && xofs[xin1] >= 0 && xofs[xin1] == xofs[xin1 - 1] + 1 )
+            xin1++;
+
+        std::vector<T> constRow(padWidth*cn);
+        if( borderType == BORDER_CONSTANT )
+            scalarToRawData(borderValue, &constRow[0], type, padWidth*cn);
+
+        bool vhgwRows = kw >= (sizeof(T) == 8 ? 16 : ROW_KSIZE_PER_LANE*CV_SIMD_WIDTH/(int)sizeof(T));
+        Ptr<BaseRowFilter> rowFilter;
+        if( kw > 1 && !vhgwRows )
+            rowFilter = getMorphologyRowFilter(op, type, kw, anchor.x);
+
+        // every band re-filters ksize.height - 1 source rows of its neighbour
+        double nstripes = std::max(1, height / std::max(kh*4, 64));
+
+        parallel_for_(Range(0, height), [&](const Range& range)
+        {
+            int nrows = range.size() + kh - 1, ringRows = kh > 1 ? kh*2 : 0;
+            AutoBuffer<T> _rowBuf(padWidth*cn*3 + width*cn*2);
+            T* padded = _rowBuf.data();
+            T* scanBuf = padded + padWidth*cn;
+            AutoBuffer<const uchar*> _rows(nrows);
+            const uchar** rows = _rows.data();
+            Mat ring;
+            if( kw > 1 && kh > 1 )
+                ring.create(ringRows, width, type);
+
+            // filters the source rows up to i1 (exclusive)
+            int i = 0;
+            auto prepareRows = [&](int i1)
+            {
+                for( ; i < i1; i++ )
+                {
+                    int sy = borderInterpolate(ofs.y + range.start + i - anchor.y, wholeSize.height, borderType);
+                    const uchar* S = sy < 0 ? (const uchar*)&constRow[0] :
+                                     src.data + (ptrdiff_t)(sy - ofs.y)*(ptrdiff_t)src.step - (ptrdiff_t)ofs.x*esz;
+                    if( kw == 1 )
+                    {
+                        rows[i] = sy < 0 ? S : S + (ptrdiff_t)xofs[0]*esz;
+                        continue;
+                    }
+
+                    // gather the padded row, the inner part is copied in one go
+                    const uchar* P = (const uchar*)padded;
+                    if( sy < 0 )
+                        P = S;
+                    else if( xin0 == 0 && xin1 == padWidth )
+                        P = S + (ptrdiff_t)xofs[0]*esz;
+                    else
+                    {
+                        for( int x = 0; x < padWidth; x++ )
+                        {
+                            if( x == xin0 )
+                            {
+                                memcpy(padded + x*cn, S + (ptrdiff_t)xofs[x]*esz, (xin1 - xin0)*esz);
+                                x = xin1 - 1;
+                                continue;
+                            }
+                            const T* px = xofs[x] < 0 ? &constRow[0] : (const T*)(S + (ptrdiff_t)xofs[x]*esz);
+                            for( int c = 0; c < cn; c++ )
+                                padded[x*cn + c] = px[c];
+                        }
+                    }
+
+                    uchar* D = kh > 1 ? ring.ptr(i % ringRows) : dst.ptr(range.start + i);
+                    if( rowFilter )
+                        (*rowFilter)(P, D, width, cn);
+                    else
+                        filterRow((const T*)P, (T*)D, width, cn, kw, scanBuf);
+                    rows[i] = D;
+                }
+            };
+
+            if( kh == 1 )
+            {
+                prepareRows(nrows);
+                return;
+            }
+            // a block of ksize.height output rows reads its own rows and those of the next block
+            for( int y0 = 0; y0 < range.size(); y0 += kh )
+            {
+                int count = std::min(kh, range.size() - y0);
+                prepareRows(y0 + kh + count - 1);
+                filterColumns(rows + y0, dst.ptr(range.start + y0), dst.step, count, width*cn, kh, scanBuf);
+            }
+        }, nstripes);
+    }
+
+    // the scalar row scans pay off when the kernel is this many times wider than a vector
+    enum { ROW_KSIZE_PER_LANE = 16 };
+};
+
 } // namespace anon
 
 /////////////////////////////////// External Interface /////////////////////////////////////
@@ -841,6 +1092,43 @@ Ptr<BaseFilter> getMorphologyFilter(int op, int type, const Mat& kernel, Point a
     CV_Error_( cv::Error::StsNotImplemented, ("Unsupported data type (=%d)", type));
 }
 
+void morphologyRectVHGW(int op, const Mat& src, Mat& dst, Size ksize, Point anchor,
+                        int borderType, const Scalar& borderValue)
+{
+    CV_INSTRUMENT_REGION();
+
+    int type = src.type(), depth = src.depth();
+    CV_Assert( op == MORPH_ERODE || op == MORPH_DILATE );
+    if( op == MORPH_ERODE )
+    {
+        if( depth == CV_8U )
+            return MorphRectVHGW<MinOp<uchar>, ErodeMergeVec8u>::apply(op, src, dst, ksize, anchor, borderType, borderValue);
+        if( depth == CV_16U )
+            return MorphRectVHGW<MinOp<ushort>, ErodeMergeVec16u>::apply(op, src, dst, ksize, anchor, borderType, borderValue);
+        if( depth == CV_16S )
+            return MorphRectVHGW<MinOp<short>, ErodeMergeVec16s>::apply(op, src, dst, ksize, anchor, borderType, borderValue);
+        if( depth == CV_32F )
+            return MorphRectVHGW<MinOp<float>, ErodeMergeVec32f>::apply(op, src, dst, ksize, anchor, borderType, borderValue);
+        if( depth == CV_64F )
+            return MorphRectVHGW<MinOp<double>, ErodeMergeVec64f>::apply(op, src, dst, ksize, anchor, borderType, borderValue);
+    }
+    else
+    {
+        if( depth == CV_8U )
+            return MorphRectVHGW<MaxOp<uchar>, DilateMergeVec8u>::apply(op, src, dst, ksize, anchor, borderType, borderValue);
+        if( depth == CV_16U )
+            return MorphRectVHGW<MaxOp<ushort>, DilateMergeVec16u>::apply(op, src, dst, ksize, anchor, borderType, borderValue);
+        if( depth == CV_16S )
+            return MorphRectVHGW<MaxOp<short>, DilateMergeVec16s>::apply(op, src, dst, ksize, anchor, borderType, borderValue);
+        if( depth == CV_32F )
+            return MorphRectVHGW<MaxOp<float>, DilateMergeVec32f>::apply(op, src, dst, ksize, anchor, borderType, borderValue);
+        if( depth == CV_64F )
+            return MorphRectVHGW<MaxOp<double>, DilateMergeVec64f>::apply(op, src, dst, ksize, anchor, borderType, borderValue);
+    }
+
+    CV_Error_( cv::Error::StsNotImplemented, ("Unsupported data type (=%d)", type));
+}
+
 #endif
 CV_CPU_OPTIMIZATION_NAMESPACE_END
 } // namespace
@@ -857,27 +857,145 @@ template <> int PyrUpVecVOneRow<float, float>(float** src, float* dst, int width
 
 #endif
 
+// border and decimation tables of the horizontal pyrDown pass
+struct PyrDownTabs
+{
+    enum { PD_SZ = 5 };
+
+    PyrDownTabs(Size ssize, Size dsize, int cn, int borderType)
+        : _tabM(dsize.width * cn), _tabL(cn * (PD_SZ + 2)), _tabR(cn * (PD_SZ + 2))
+    {
+        tabM = _tabM.data(); tabL = _tabL.data(); tabR = _tabR.data();
+        width0 = std::min((ssize.width-PD_SZ/2-1)/2 + 1, dsize.width);
+
+        for (int x = 0; x <= PD_SZ+1; x++)
+        {
+            int sx0 = borderInterpolate(x - PD_SZ/2, ssize.width, borderType)*cn;
+            int sx1 = borderInterpolate(x + width0*2 - PD_SZ/2, ssize.width, borderType)*cn;
+            for (int k = 0; k < cn; k++)
+            {
+                tabL[x*cn + k] = sx0 + k;
+                tabR[x*cn + k] = sx1 + k;
+            }
+        }
+
+        for (int x = 0; x < dsize.width*cn; x++)
+            tabM[x] = (x/cn)*2*cn + x % cn;
+    }
+
+    AutoBuffer<int> _tabM, _tabL, _tabR;
+    int *tabM, *tabL, *tabR;
+    int width0;
+};
+
+// horizontal convolution and decimation of one source row, dwidth and width0 are multiplied by cn
+template<class CastOp> static void
+pyrDownRowH( const typename CastOp::rtype* src, typename CastOp::type1* row, int cn,
+             int dwidth, int width0, const int* tabL, const int* tabR, const int* tabM )
+{
+    typedef typename CastOp::type1 WT;
+    typedef typename CastOp::rtype T;
+
+    int x = 0;
+    for( ; x < cn; x++ )
+    {
+        row[x] = src[tabL[x+cn*2]]*6 + (src[tabL[x+cn]] + src[tabL[x+cn*3]])*4 +
+            src[tabL[x]] + src[tabL[x+cn*4]];
+    }
+
+    if( x == dwidth )
+        return;
+
+    if( cn == 1 )
+    {
+        x += PyrDownVecH<T, WT, 1>(src + x * 2 - 2, row + x, width0 - x);
+        for( ; x < width0; x++ )
+            row[x] = src[x*2]*6 + (src[x*2 - 1] + src[x*2 + 1])*4 +
+                src[x*2 - 2] + src[x*2 + 2];
+    }
+    else if( cn == 2 )
+    {
+        x += PyrDownVecH<T, WT, 2>(src + x * 2 - 4, row + x, width0 - x);
+        for( ; x < width0; x += 2 )
+        {
+            const T* s = src + x*2;
+            WT t0 = s[0] * 6 + (s[-2] + s[2]) * 4 + s[-4] + s[4];
+            WT t1 = s[1] * 6 + (s[-1] + s[3]) * 4 + s[-3] + s[5];
+            row[x] = t0; row[x + 1] = t1;
+        }
+    }
+    else if( cn == 3 )
+    {
+        x += PyrDownVecH<T, WT, 3>(src + x * 2 - 6, row + x, width0 - x);
+        for( ; x < width0; x += 3 )
+        {
+            const T* s = src + x*2;
+            WT t0 = s[0]*6 + (s[-3] + s[3])*4 + s[-6] + s[6];
+            WT t1 = s[1]*6 + (s[-2] + s[4])*4 + s[-5] + s[7];
+            WT t2 = s[2]*6 + (s[-1] + s[5])*4 + s[-4] + s[8];
+            row[x] = t0; row[x+1] = t1; row[x+2] = t2;
+        }
+    }
+    else if( cn == 4 )
+    {
+        x += PyrDownVecH<T, WT, 4>(src + x * 2 - 8, row + x, width0 - x);
+        for( ; x < width0; x += 4 )
+        {
+            const T* s = src + x*2;
+            WT t0 = s[0]*6 + (s[-4] + s[4])*4 + s[-8] + s[8];
+            WT t1 = s[1]*6 + (s[-3] + s[5])*4 + s[-7] + s[9];
+            row[x] = t0; row[x+1] = t1;
+            t0 = s[2]*6 + (s[-2] + s[6])*4 + s[-6] + s[10];
+            t1 = s[3]*6 + (s[-1] + s[7])*4 + s[-5] + s[11];
+            row[x+2] = t0; row[x+3] = t1;
+        }
+    }
+    else
+    {
+        for( ; x < width0; x++ )
+        {
+            int sx = tabM[x];
+            row[x] = src[sx]*6 + (src[sx - cn] + src[sx + cn])*4 +
+                src[sx - cn*2] + src[sx + cn*2];
+        }
+    }
+
+    // tabR
+    for (int x_ = 0; x < dwidth; x++, x_++)
+    {
+        row[x] = src[tabR[x_+cn*2]]*6 + (src[tabR[x_+cn]] + src[tabR[x_+cn*3]])*4 +
+            src[tabR[x_]] + src[tabR[x_+cn*4]];
+    }
+}
+
+// vertical convolution and decimation of five horizontally filtered rows
+template<class CastOp> static void
+pyrDownRowV( typename CastOp::type1** rows, typename CastOp::rtype* dst, int dwidth )
+{
+    typedef typename CastOp::type1 WT;
+    typedef typename CastOp::rtype T;
+    CastOp castOp;
+    const WT *row0 = rows[0], *row1 = rows[1], *row2 = rows[2], *row3 = rows[3], *row4 = rows[4];
+
+    int x = PyrDownVecV<WT, T>(rows, dst, dwidth);
+    for (; x < dwidth; x++ )
+        dst[x] = castOp(row2[x]*6 + (row1[x] + row3[x])*4 + row0[x] + row4[x]);
+}
+
 template<class CastOp>
 struct PyrDownInvoker : ParallelLoopBody
 {
-    PyrDownInvoker(const Mat& src, const Mat& dst, int borderType, int **tabR, int **tabM, int **tabL)
+    PyrDownInvoker(const Mat& src, const Mat& dst, int borderType, const PyrDownTabs& tabs)
+        : _src(&src), _dst(&dst), _borderType(borderType), _tabs(&tabs)
     {
-        _src = &src;
-        _dst = &dst;
-        _borderType = borderType;
-        _tabR = tabR;
-        _tabM = tabM;
-        _tabL = tabL;
     }
 
     void operator()(const Range& range) const CV_OVERRIDE;
 
-    int **_tabR;
-    int **_tabM;
-    int **_tabL;
     const Mat *_src;
     const Mat *_dst;
     int _borderType;
+    const PyrDownTabs* _tabs;
 };
 
 template<class CastOp> void
@@ -888,33 +1006,13 @@ pyrDown_( const Mat& _src, Mat& _dst, int borderType )
     Size ssize = _src.size(), dsize = _dst.size();
     int cn = _src.channels();
 
-    AutoBuffer<int> _tabM(dsize.width * cn), _tabL(cn * (PD_SZ + 2)),
-        _tabR(cn * (PD_SZ + 2));
-    int *tabM = _tabM.data(), *tabL = _tabL.data(), *tabR = _tabR.data();
-
     CV_Assert( ssize.width > 0 && ssize.height > 0 &&
                std::abs(dsize.width*2 - ssize.width) <= 2 &&
                std::abs(dsize.height*2 - ssize.height) <= 2 );
-    int width0 = std::min((ssize.width-PD_SZ/2-1)/2 + 1, dsize.width);
-
-    for (int x = 0; x <= PD_SZ+1; x++)
-    {
-        int sx0 = borderInterpolate(x - PD_SZ/2, ssize.width, borderType)*cn;
-        int sx1 = borderInterpolate(x + width0*2 - PD_SZ/2, ssize.width, borderType)*cn;
-        for (int k = 0; k < cn; k++)
-        {
-            tabL[x*cn + k] = sx0 + k;
-            tabR[x*cn + k] = sx1 + k;
-        }
-    }
-
-    for (int x = 0; x < dsize.width*cn; x++)
-        tabM[x] = (x/cn)*2*cn + x % cn;
-
-    int *tabLPtr = tabL;
-    int *tabRPtr = tabR;
+    CV_StaticAssert( PD_SZ == PyrDownTabs::PD_SZ, "" );
+    PyrDownTabs tabs(ssize, dsize, cn, borderType);
 
-    cv::parallel_for_(Range(0,dsize.height), cv::PyrDownInvoker<CastOp>(_src, _dst, borderType, &tabRPtr, &tabM, &tabLPtr), cv::getNumThreads());
+    cv::parallel_for_(Range(0,dsize.height), cv::PyrDownInvoker<CastOp>(_src, _dst, borderType, tabs), cv::getNumThreads());
 }
 
 template<class CastOp>
@@ -929,9 +1027,8 @@ void PyrDownInvoker<CastOp>::operator()(const Range& range) const
     AutoBuffer<WT> _buf(bufstep*PD_SZ + 16);
     WT* buf = alignPtr((WT*)_buf.data(), 16);
     WT* rows[PD_SZ];
-    CastOp castOp;
 
-    int sy0 = -PD_SZ/2, sy = range.start * 2 + sy0, width0 = std::min((ssize.width-PD_SZ/2-1)/2 + 1, dsize.width);
+    int sy0 = -PD_SZ/2, sy = range.start * 2 + sy0, width0 = _tabs->width0;
 
     ssize.width *= cn;
     dsize.width *= cn;
@@ -940,7 +1037,6 @@ void PyrDownInvoker<CastOp>::operator()(const Range& range) const
     for (int y = range.start; y < range.end; y++)
     {
         T* dst = (T*)_dst->ptr<T>(y);
-        WT *row0, *row1, *row2, *row3, *row4;
 
         // fill the ring buffer (horizontal convolution and decimation)
         int sy_limit = y*2 + 2;
@@ -950,91 +1046,146 @@ void PyrDownInvoker<CastOp>::operator()(const Range& range) const
             int _sy = borderInterpolate(sy, ssize.height, _borderType);
             const T* src = _src->ptr<T>(_sy);
 
-            do {
-                int x = 0;
-                const int* tabL = *_tabL;
-                for( ; x < cn; x++ )
-                {
-                    row[x] = src[tabL[x+cn*2]]*6 + (src[tabL[x+cn]] + src[tabL[x+cn*3]])*4 +
-                        src[tabL[x]] + src[tabL[x+cn*4]];
-                }
+            pyrDownRowH<CastOp>(src, row, cn, dsize.width, width0, _tabs->tabL, _tabs->tabR, _tabs->tabM);
+        }
 
-                if( x == dsize.width )
-                    break;
+        // do vertical convolution and decimation and write the result to the destination image
+        for (int k = 0; k < PD_SZ; k++)
+            rows[k] = buf + ((y*2 - PD_SZ/2 + k - sy0) % PD_SZ)*bufstep;
 
-                if( cn == 1 )
-                {
-                    x += PyrDownVecH<T, WT, 1>(src + x * 2 - 2, row + x, width0 - x);
-                    for( ; x < width0; x++ )
-                        row[x] = src[x*2]*6 + (src[x*2 - 1] + src[x*2 + 1])*4 +
-                            src[x*2 - 2] + src[x*2 + 2];
-                }
-                else if( cn == 2 )
-                {
-                    x += PyrDownVecH<T, WT, 2>(src + x * 2 - 4, row + x, width0 - x);
-                    for( ; x < width0; x += 2 )
-                    {
-                        const T* s = src + x*2;
-                        WT t0 = s[0] * 6 + (s[-2] + s[2]) * 4 + s[-4] + s[4];
-                        WT t1 = s[1] * 6 + (s[-1] + s[3]) * 4 + s[-3] + s[5];
-                        row[x] = t0; row[x + 1] = t1;
-                    }
-                }
-                else if( cn == 3 )
-                {
-                    x += PyrDownVecH<T, WT, 3>(src + x * 2 - 6, row + x, width0 - x);
-                    for( ; x < width0; x += 3 )
-                    {
-                        const T* s = src + x*2;
-                        WT t0 = s[0]*6 + (s[-3] + s[3])*4 + s[-6] + s[6];
-                        WT t1 = s[1]*6 + (s[-2] + s[4])*4 + s[-5] + s[7];
-                        WT t2 = s[2]*6 + (s[-1] + s[5])*4 + s[-4] + s[8];
-                        row[x] = t0; row[x+1] = t1; row[x+2] = t2;
-                    }
-                }
-                else if( cn == 4 )
-                {
-                    x += PyrDownVecH<T, WT, 4>(src + x * 2 - 8, row + x, width0 - x);
-                    for( ; x < width0; x += 4 )
-                    {
-                        const T* s = src + x*2;
-                        WT t0 = s[0]*6 + (s[-4] + s[4])*4 + s[-8] + s[8];
-                        WT t1 = s[1]*6 + (s[-3] + s[5])*4 + s[-7] + s[9];
-                        row[x] = t0; row[x+1] = t1;
-                        t0 = s[2]*6 + (s[-2] + s[6])*4 + s[-6] + s[10];
-                        t1 = s[3]*6 + (s[-1] + s[7])*4 + s[-5] + s[11];
-                        row[x+2] = t0; row[x+3] = t1;
-                    }
-                }
+        pyrDownRowV<CastOp>(rows, dst, dsize.width);
+    }
+}
+
+/*
+Builds the levels 1..L of a Gaussian pyramid in one pass. The rows of the top level are split into
+bands processed in parallel; a band produces its rows of every level by pulling just the rows of the
+finer level it needs, so each source row is read once and the intermediate rows are still in cache
+when they are used. The rows a band needs that belong to a neighbouring band are computed again into
+a small private ring. Every row is computed by pyrDownRowH/pyrDownRowV exactly as pyrDown does.
+*/
+template<class CastOp>
+struct PyramidBandBuilder
+{
+    typedef typename CastOp::type1 WT;
+    typedef typename CastOp::rtype T;
+    enum { PD_SZ = 5, HALO_ROWS = 8 };
+
+    struct Level
+    {
+        const PyrDownTabs* tabs;
+        int y0, y1;      // the rows written to the level image
+        int next;        // the next row to produce
+        int sy;          // the next source row to filter horizontally
+        int bufstep;
+        std::vector<WT> hbuf;  // PD_SZ horizontally filtered source rows
+        std::vector<T> halo;   // HALO_ROWS rows outside of [y0, y1)
+    };
+
+    PyramidBandBuilder(const std::vector<Mat>& _levels, const std::vector<PyrDownTabs*>& _tabs,
+                       int _borderType, const std::vector<Range>& owned)
+        : levels(_levels), borderType(_borderType), lv(_levels.size())
+    {
+        int nlevels = (int)levels.size(), cn = levels[0].channels();
+        int lo = 0, hi = 0;
+        // the rows of each level the band needs, from the top down
+        for( int l = nlevels - 1; l >= 1; l-- )
+        {
+            Level& L = lv[l];
+            L.tabs = _tabs[l];
+            L.y0 = owned[l].start;
+            L.y1 = owned[l].end;
+            int need0 = L.y0, need1 = L.y1;
+            if( l < nlevels - 1 && hi > lo )
+            {
+                int h = levels[l].rows;
+                int n0 = std::max(lo*2 - PD_SZ/2, 0), n1 = std::min(hi*2 + PD_SZ/2 - 1, h);
+                if( need1 > need0 )
+                    need0 = std::min(need0, n0), need1 = std::max(need1, n1);
                 else
-                {
-                    for( ; x < width0; x++ )
-                    {
-                        int sx = (*_tabM)[x];
-                        row[x] = src[sx]*6 + (src[sx - cn] + src[sx + cn])*4 +
-                            src[sx - cn*2] + src[sx + cn*2];
-                    }
-                }
+                    need0 = n0, need1 = n1;
+            }
+            L.next = need0;
+            L.sy = need0*2 - PD_SZ/2;
+            L.bufstep = (int)alignSize(levels[l].cols*cn, 16);
+            L.hbuf.resize((size_t)L.bufstep*PD_SZ);
+            L.halo.resize((size_t)levels[l].cols*cn*HALO_ROWS);
+            lo = need0; hi = need1;
+            needEnd.push_back(need1);
+        }
+        std::reverse(needEnd.begin(), needEnd.end());
+    }
 
-                // tabR
-                const int* tabR = *_tabR;
-                for (int x_ = 0; x < dsize.width; x++, x_++)
-                {
-                    row[x] = src[tabR[x_+cn*2]]*6 + (src[tabR[x_+cn]] + src[tabR[x_+cn*3]])*4 +
-                        src[tabR[x_]] + src[tabR[x_+cn*4]];
-                }
-            } while (0);
+    const T* row( int l, int y ) const
+    {
+        if( l == 0 || (lv[l].y0 <= y && y < lv[l].y1) )
+            return levels[l].ptr<T>(y);
+        return &lv[l].halo[(size_t)(y % HALO_ROWS)*levels[l].cols*levels[l].channels()];
+    }
+
+    void produce( int l, int ymax )
+    {
+        Level& L = lv[l];
+        const Mat& src = levels[l - 1];
+        int cn = src.channels(), dwidth = levels[l].cols*cn, width0 = L.tabs->width0*cn;
+        WT* rows[PD_SZ];
+
+        for( ; L.next <= ymax; L.next++ )
+        {
+            int y = L.next;
+            for( ; L.sy <= y*2 + 2; L.sy++ )
+            {
+                int _sy = borderInterpolate(L.sy, src.rows, borderType);
+                if( l > 1 )
+                    produce(l - 1, _sy);
+                pyrDownRowH<CastOp>(row(l - 1, _sy), &L.hbuf[((L.sy + PD_SZ/2) % PD_SZ)*L.bufstep],
+                                    cn, dwidth, width0, L.tabs->tabL, L.tabs->tabR, L.tabs->tabM);
+            }
+            for( int k = 0; k < PD_SZ; k++ )
+                rows[k] = &L.hbuf[((y*2 + k) % PD_SZ)*L.bufstep];
+            pyrDownRowV<CastOp>(rows, (T*)row(l, y), dwidth);
         }
+    }
 
-        // do vertical convolution and decimation and write the result to the destination image
-        for (int k = 0; k < PD_SZ; k++)
-            rows[k] = buf + ((y*2 - PD_SZ/2 + k - sy0) % PD_SZ)*bufstep;
-        row0 = rows[0]; row1 = rows[1]; row2 = rows[2]; row3 = rows[3]; row4 = rows[4];
+    void run()
+    {
+        int nlevels = (int)levels.size();
+        // the top level pulls the rows below it, then the rest of the own rows of every level
+        for( int l = nlevels - 1; l >= 1; l-- )
+            produce(l, needEnd[l - 1] - 1);
+    }
 
-        int x = PyrDownVecV<WT, T>(rows, dst, dsize.width);
-        for (; x < dsize.width; x++ )
-            dst[x] = castOp(row2[x]*6 + (row1[x] + row3[x])*4 + row0[x] + row4[x]);
+    const std::vector<Mat>& levels;
+    int borderType;
+    std::vector<Level> lv;
+    std::vector<int> needEnd;
+};
+
+template<class CastOp> static void
+buildPyramid_( const std::vector<Mat>& levels, int borderType )
+{
+    int nlevels = (int)levels.size(), cn = levels[0].channels();
+    std::vector<PyrDownTabs*> tabs(nlevels, 0);
+    std::vector<Ptr<PyrDownTabs> > tabsHolder;
+    for( int l = 1; l < nlevels; l++ )
+    {
+        tabsHolder.push_back(makePtr<PyrDownTabs>(levels[l-1].size(), levels[l].size(), cn, borderType));
+        tabs[l] = tabsHolder.back().get();
     }
+
+    // bands of at least 16 rows of the first level, the same fraction of rows at every level
+    int nbands = std::max(1, std::min(getNumThreads()*2, levels[1].rows/16));
+    parallel_for_(Range(0, nbands), [&](const Range& range)
+    {
+        for( int b = range.start; b < range.end; b++ )
+        {
+            std::vector<Range> owned(nlevels);
+            for( int l = 1; l < nlevels; l++ )
+                owned[l] = Range((int)((int64)levels[l].rows*b/nbands), (int)((int64)levels[l].rows*(b + 1)/nbands));
+            PyramidBandBuilder<CastOp> builder(levels, tabs, borderType, owned);
+            builder.run();
+        }
+    });
 }
 
 
@@ -1672,6 +1823,74 @@ static bool ipp_buildpyramid( InputArray _src, OutputArrayOfArrays _dst, int max
 }
 #endif
 
+namespace cv
+{
+// levels 1..maxlevel are views into one buffer and are computed together, see PyramidBandBuilder
+static bool buildPyramidFused( const Mat& src, OutputArrayOfArrays _dst, int maxlevel, int borderType )
+{
+    if( borderType != BORDER_REFLECT_101 && borderType != BORDER_REFLECT && borderType != BORDER_REPLICATE )
+        return false;
+
+    typedef void (*BuildPyramidFunc)(const std::vector<Mat>&, int);
+    BuildPyramidFunc func = 0;
+    int type = src.type(), depth = src.depth();
+    if( depth == CV_8U )
+        func = buildPyramid_< FixPtCast<uchar, 8> >;
+    else if( depth == CV_16S )
+        func = buildPyramid_< FixPtCast<short, 8> >;
+    else if( depth == CV_16U )
+        func = buildPyramid_< FixPtCast<ushort, 8> >;
+    else if( depth == CV_32F )
+        func = buildPyramid_< FltCast<float, 8> >;
+    else if( depth == CV_64F )
+        func = buildPyramid_< FltCast<double, 8> >;
+    else
+        return false;
+
+    std::vector<Mat> levels(maxlevel + 1);
+    std::vector<Size> sizes(maxlevel + 1);
+    levels[0] = src;
+    sizes[0] = src.size();
+    size_t total = 0;
+    bool reuse = true;
+    for( int i = 1; i <= maxlevel; i++ )
+    {
+        sizes[i] = Size((sizes[i-1].width + 1)/2, (sizes[i-1].height + 1)/2);
+        total += sizes[i].area();
+        const Mat& m = _dst.getMatRef(i);
+        reuse = reuse && m.size() == sizes[i] && m.type() == type && m.data != src.data;
+    }
+    if( total > (size_t)INT_MAX )
+        return false;
+
+    if( reuse )
+    {
+        for( int i = 1; i <= maxlevel; i++ )
+            levels[i] = _dst.getMatRef(i);
+    }
+    else
+    {
+        Mat arena(1, (int)total, type);
+        int ofs = 0;
+        for( int i = 1; i <= maxlevel; i++ )
+        {
+            int n = (int)sizes[i].area();
+            levels[i] = arena.colRange(ofs, ofs + n).reshape(0, sizes[i].height);
+            ofs += n;
+        }
+    }
+
+    func(levels, borderType);
+
+    if( !reuse )
+    {
+        for( int i = 1; i <= maxlevel; i++ )
+            _dst.getMatRef(i) = levels[i];
+    }
+    return true;
+}
+}
+
 void cv::buildPyramid( InputArray _src, OutputArrayOfArrays _dst, int maxlevel, int borderType )
 {
     CV_INSTRUMENT_REGION();
@@ -1697,6 +1916,9 @@ void cv::buildPyramid( InputArray _src, OutputArrayOfArrays _dst, int maxlevel,
     CV_IPP_RUN(((IPP_VERSION_X100 >= 810) && ((borderType & ~BORDER_ISOLATED) == BORDER_DEFAULT && (!_src.isSubmatrix() || ((borderType & BORDER_ISOLATED) != 0)))),
         ipp_buildpyramid( _src,  _dst,  maxlevel,  borderType));
 
+    if( maxlevel >= 1 && src.dims <= 2 && buildPyramidFused(src, _dst, maxlevel, borderType) )
+        return;
+
     for( ; i <= maxlevel; i++ )
         pyrDown( _dst.getMatRef(i-1), _dst.getMatRef(i), Size(), borderType );
 }
@@ -0,0 +1,269 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+/*
+Recursive (IIR) approximation of the Gaussian filter.
+I.T. Young, L.J. van Vliet, "Recursive implementation of the Gaussian filter",
+Signal Processing 44 (1995), 139-151.
+
+Each axis is filtered by a causal and an anti-causal 3rd order recursion, so the cost per
+pixel does not depend on sigma. The recursions run on interleaved buffers where many
+independent signals (rows of a band, or columns of a strip) are stored side by side,
+which makes every step a vector operation.
+*/
+
+#include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
+
+namespace cv {
+
+namespace {
+
+struct RecursiveGaussianCoeffs
+{
+    explicit RecursiveGaussianCoeffs(double sigma)
+    {
+        double q = sigma >= 2.5 ? 0.98711*sigma - 0.96330 :
+                   3.97156 - 4.14554*std::sqrt(1 - 0.26891*sigma);
+        double q2 = q*q, q3 = q2*q;
+        double b0 = 1.57825 + 2.44413*q + 1.4281*q2 + 0.422205*q3;
+        double b1 = 2.44413*q + 2.85619*q2 + 1.26661*q3;
+        double b2 = -(1.4281*q2 + 1.26661*q3);
+        double b3 = 0.422205*q3;
+        a1 = (float)(b1/b0);
+        a2 = (float)(b2/b0);
+        a3 = (float)(b3/b0);
+        // keep the unit DC gain of the rounded coefficients, it matters for large sigma
+        B = (float)(1 - ((double)a1 + (double)a2 + (double)a3));
+        // the extrapolated border lets the transient of the initial conditions decay
+        border = cvCeil(sigma*3) + 3;
+    }
+
+    float B, a1, a2, a3;
+    int border;
+};
+
+/*
+ Filters `lanes` interleaved signals of n samples in place: buf[i*lanes + k] is the sample i of the
+ signal k. Three extra samples are reserved before and after the data for the initial conditions,
+ which are the steady state of a constant signal.
+*/
+static void recursiveGaussian(float* buf, int n, int lanes, const RecursiveGaussianCoeffs& c)
+{
+    float* data = buf + lanes*3;
+    int k;
+    for( int i = 1; i <= 3; i++ )
+        memcpy(data - i*lanes, data, lanes*sizeof(data[0]));
+
+    for( int i = 0; i < n; i++ )
+    {
+        float* w = data + i*lanes;
+        k = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int vlanes = VTraits<v_float32>::vlanes();
+        v_float32 vB = vx_setall_f32(c.B), va1 = vx_setall_f32(c.a1);
+        v_float32 va2 = vx_setall_f32(c.a2), va3 = vx_setall_f32(c.a3);
+        for( ; k <= lanes - vlanes; k += vlanes )
+        {
+            v_float32 s = v_mul(vB, vx_load(w + k));
+            s = v_fma(va1, vx_load(w + k - lanes), s);
+            s = v_fma(va2, vx_load(w + k - lanes*2), s);
+            s = v_fma(va3, vx_load(w + k - lanes*3), s);
+            v_store(w + k, s);
+        }
+#endif
+        for( ; k < lanes; k++ )
+            w[k] = c.B*w[k] + c.a1*w[k - lanes] + c.a2*w[k - lanes*2] + c.a3*w[k - lanes*3];
+    }
+
+    float* last = data + (n - 1)*lanes;
+    for( int i = 1; i <= 3; i++ )
+        memcpy(last + i*lanes, last, lanes*sizeof(data[0]));
+
+    for( int i = n - 1; i >= 0; i-- )
+    {
+        float* w = data + i*lanes;
+        k = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int vlanes = VTraits<v_float32>::vlanes();
+        v_float32 vB = vx_setall_f32(c.B), va1 = vx_setall_f32(c.a1);
+        v_float32 va2 = vx_setall_f32(c.a2), va3 = vx_setall_f32(c.a3);
+        for( ; k <= lanes - vlanes; k += vlanes )
+        {
+            v_float32 s = v_mul(vB, vx_load(w + k));
+            s = v_fma(va1, vx_load(w + k + lanes), s);
+            s = v_fma(va2, vx_load(w + k + lanes*2), s);
+            s = v_fma(va3, vx_load(w + k + lanes*3), s);
+            v_store(w + k, s);
+        }
+#endif
+        for( ; k < lanes; k++ )
+            w[k] = c.B*w[k] + c.a1*w[k + lanes] + c.a2*w[k + lanes*2] + c.a3*w[k + lanes*3];
+    }
+}
+
+// number of rows filtered together by the horizontal pass
+static const int RECURSIVE_BLUR_ROWS = 16;
+// number of interleaved columns filtered together by the vertical pass
+static const int RECURSIVE_BLUR_COLS = 64;
+
+template<typename T>
+static void recursiveBlurRows(const Mat& src, Mat& tmp, int y0, Point ofs, Size wholeSize,
+                              int borderType, const RecursiveGaussianCoeffs& c)
+{
+    int cn = src.channels(), width = src.cols, pad = c.border, n = width + pad*2;
+    std::vector<int> xtab(n);
+    for( int x = 0; x < n; x++ )
+        xtab[x] = borderInterpolate(ofs.x + x - pad, wholeSize.width, borderType);
+
+    parallel_for_(Range(0, (tmp.rows + RECURSIVE_BLUR_ROWS - 1)/RECURSIVE_BLUR_ROWS), [&](const Range& range)
+    {
+        const int R = RECURSIVE_BLUR_ROWS, lanes = R*cn;
+        AutoBuffer<float> _buf((n + 6)*lanes);
+        float* buf = _buf.data();
+        float* data = buf + lanes*3;
+
+        for( int band = range.start; band < range.end; band++ )
+        {
+            int r0 = band*R, nr = std::min(R, tmp.rows - r0);
+            for( int r = 0; r < R; r++ )
+            {
+                // the last band is padded by repeating its last row
+                const T* S = (const T*)(src.data + (ptrdiff_t)(y0 + r0 + std::min(r, nr - 1) - ofs.y)*(ptrdiff_t)src.step) - ofs.x*cn;
+                for( int x = 0; x < n; x++ )
+                {
+                    float* D = data + x*lanes + r;
+                    if( xtab[x] < 0 )
+                        for( int k = 0; k < cn; k++ )
+                            D[k*R] = 0.f;
+                    else
+                        for( int k = 0; k < cn; k++ )
+                            D[k*R] = (float)S[xtab[x]*cn + k];
+                }
+            }
+
+            recursiveGaussian(buf, n, lanes, c);
+
+            for( int r = 0; r < nr; r++ )
+            {
+                float* D = tmp.ptr<float>(r0 + r);
+                for( int x = 0; x < width; x++ )
+                    for( int k = 0; k < cn; k++ )
+                        D[x*cn + k] = data[(x + pad)*lanes + k*R + r];
+            }
+        }
+    });
+}
+
+template<typename T>
+static void recursiveBlurColumns(const Mat& tmp, Mat& dst, const std::vector<int>& ytab,
+                                 const RecursiveGaussianCoeffs& c)
+{
+    int widthn = dst.cols*dst.channels(), pad = c.border, n = dst.rows + pad*2;
+    CV_Assert( (int)ytab.size() == n );
+
+    parallel_for_(Range(0, (widthn + RECURSIVE_BLUR_COLS - 1)/RECURSIVE_BLUR_COLS), [&](const Range& range)
+    {
+        const int lanes = RECURSIVE_BLUR_COLS;
+        AutoBuffer<float> _buf((n + 6)*lanes);
+        float* buf = _buf.data();
+        float* data = buf + lanes*3;
+
+        for( int strip = range.start; strip < range.end; strip++ )
+        {
+            int x0 = strip*lanes, nx = std::min(lanes, widthn - x0);
+            for( int y = 0; y < n; y++ )
+            {
+                float* D = data + y*lanes;
+                if( ytab[y] < 0 )
+                    memset(D, 0, lanes*sizeof(D[0]));
+                else
+                {
+                    const float* S = tmp.ptr<float>(ytab[y]) + x0;
+                    memcpy(D, S, nx*sizeof(D[0]));
+                    for( int k = nx; k < lanes; k++ )
+                        D[k] = S[nx - 1];
+                }
+            }
+
+            recursiveGaussian(buf, n, lanes, c);
+
+            for( int y = 0; y < dst.rows; y++ )
+            {
+                const float* S = data + (y + pad)*lanes;
+                T* D = dst.ptr<T>(y) + x0;
+                for( int k = 0; k < nx; k++ )
+                    D[k] = saturate_cast<T>(S[k]);
+            }
+        }
+    }, std::max(1, widthn/(RECURSIVE_BLUR_COLS*4)));
+}
+
+template<typename T>
+static void recursiveGaussianBlur_(const Mat& src, Mat& dst, double sigmaX, double sigmaY, int borderType)
+{
+    RecursiveGaussianCoeffs cx(sigmaX), cy(sigmaY);
+    Size wholeSize;
+    Point ofs;
+    src.locateROI(wholeSize, ofs);
+
+    // rows of the whole image read by the vertical pass, they are filtered horizontally first
+    int n = src.rows + cy.border*2, ylo = INT_MAX, yhi = -1;
+    std::vector<int> ytab(n);
+    for( int y = 0; y < n; y++ )
+    {
+        ytab[y] = borderInterpolate(ofs.y + y - cy.border, wholeSize.height, borderType);
+        if( ytab[y] >= 0 )
+        {
+            ylo = std::min(ylo, ytab[y]);
+            yhi = std::max(yhi, ytab[y]);
+        }
+    }
+    for( int y = 0; y < n; y++ )
+        ytab[y] = ytab[y] < 0 ? -1 : ytab[y] - ylo;
+
+    Mat tmp(yhi - ylo + 1, src.cols*src.channels(), CV_32F);
+    recursiveBlurRows<T>(src, tmp, ylo, ofs, wholeSize, borderType, cx);
+    recursiveBlurColumns<T>(tmp, dst, ytab, cy);
+}
+
+} // namespace cv
+
+void recursiveGaussianBlur(InputArray _src, OutputArray _dst, double sigmaX, double sigmaY, int borderType)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( !_src.empty() );
+    if( sigmaY <= 0 )
+        sigmaY = sigmaX;
+    CV_CheckGE(sigmaX, 0.5, "recursiveGaussianBlur: sigma must be at least 0.5");
+    CV_CheckGE(sigmaY, 0.5, "recursiveGaussianBlur: sigma must be at least 0.5");
+
+    bool isolated = (borderType & BORDER_ISOLATED) != 0;
+    borderType &= ~BORDER_ISOLATED;
+    CV_Check(borderType, borderType == BORDER_CONSTANT || borderType == BORDER_REPLICATE ||
+             borderType == BORDER_REFLECT || borderType == BORDER_REFLECT_101,
+             "recursiveGaussianBlur: unsupported border type");
+
+    int type = _src.type(), depth = CV_MAT_DEPTH(type);
+    Mat src = _src.getMat();
+    if( isolated )
+        src = Mat(src.size(), type, src.data, src.step);
+    _dst.create(src.size(), type);
+    Mat dst = _dst.getMat();
+
+    if( depth == CV_8U )
+        recursiveGaussianBlur_<uchar>(src, dst, sigmaX, sigmaY, borderType);
+    else if( depth == CV_16U )
+        recursiveGaussianBlur_<ushort>(src, dst, sigmaX, sigmaY, borderType);
+    else if( depth == CV_16S )
+        recursiveGaussianBlur_<short>(src, dst, sigmaX, sigmaY, borderType);
+    else if( depth == CV_32F )
+        recursiveGaussianBlur_<float>(src, dst, sigmaX, sigmaY, borderType);
+    else
+        CV_Error(Error::StsNotImplemented,
+                 "Unsupported input format in recursiveGaussianBlur, the supported formats are: CV_8U, CV_16U, CV_16S and CV_32F.");
+}
+
+} // namespace cv
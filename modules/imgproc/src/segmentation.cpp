@@ -41,6 +41,7 @@
 //M*/
 
 #include "precomp.hpp"
+#include "opencv2/core/hal/intrin.hpp"
 
 /****************************************************************************************\
 *                                       Watershed                                        *
@@ -325,11 +326,425 @@ void cv::watershed( InputArray _src, InputOutputArray _markers )
 }
 
 
+/*
+Tiled watershed. Every tile keeps its own priority queues and floods its own pixels in the order of
+cv::watershed, and the tiles are processed in parallel in rounds. A round pops, in every tile, the
+pixels that were queued with the lowest priority present in the image when the round started (one
+wave of the flood), together with the pixels of a higher priority they uncover. The flood does not
+cross the tile borders during a round: the labels of the neighbouring tiles are read from a snapshot
+taken at the start of the round, and the pixels of a neighbouring tile to be queued are posted to
+it. Between the rounds the snapshot is updated and the posted pixels are queued in the tile order.
+So the result depends on the tile size but not on the number of threads, and a single tile gives
+exactly the result of cv::watershed.
+*/
+
+namespace cv
+{
+namespace
+{
+
+struct WSTile
+{
+    enum { NQ = 256 };
+
+    struct Node
+    {
+        int next;
+        int x, y;
+    };
+
+    struct Post
+    {
+        int tile, x, y, priority;
+    };
+
+    WSTile() : free_node(0), active_queue(NQ)
+    {
+        memset(count, 0, sizeof(count));
+    }
+
+    void push( int idx, int x, int y )
+    {
+        if( !free_node )
+            free_node = allocNodes();
+        int node = free_node;
+        free_node = storage[node].next;
+        storage[node].next = 0;
+        storage[node].x = x;
+        storage[node].y = y;
+        if( q[idx].last )
+            storage[q[idx].last].next = node;
+        else
+            q[idx].first = node;
+        q[idx].last = node;
+        count[idx]++;
+        active_queue = std::min(active_queue, idx);
+    }
+
+    void pop( int idx, int& x, int& y )
+    {
+        int node = q[idx].first;
+        q[idx].first = storage[node].next;
+        if( !storage[node].next )
+            q[idx].last = 0;
+        storage[node].next = free_node;
+        free_node = node;
+        count[idx]--;
+        x = storage[node].x;
+        y = storage[node].y;
+    }
+
+    // the highest priority (lowest index) non-empty queue or NQ
+    int lowest()
+    {
+        while( active_queue < NQ && !q[active_queue].first )
+            active_queue++;
+        return active_queue;
+    }
+
+    int allocNodes()
+    {
+        int sz = (int)storage.size();
+        int newsz = MAX(128, sz*3/2);
+
+        storage.resize(newsz);
+        if( sz == 0 )
+        {
+            storage[0].next = 0;
+            sz = 1;
+        }
+        for( int i = sz; i < newsz-1; i++ )
+            storage[i].next = i+1;
+        storage[newsz-1].next = 0;
+        return sz;
+    }
+
+    Rect r;
+    std::vector<Node> storage;
+    int free_node;
+    WSQueue q[NQ];
+    int count[NQ];
+    int active_queue;
+    std::vector<Post> outbox;
+    std::vector<Point> edge; // pixels on the tile edge labeled during the round
+};
+
+struct WatershedTiled
+{
+    enum { IN_QUEUE = -2, WSHED = -1, NQ = WSTile::NQ };
+
+    WatershedTiled( const Mat& _src, Mat& _mask, int _tileSize )
+        : src(_src), mask(_mask), tileSize(_tileSize)
+    {
+        ntx = (src.cols + tileSize - 1)/tileSize;
+        nty = (src.rows + tileSize - 1)/tileSize;
+        tiles.resize((size_t)ntx*nty);
+        for( int ty = 0; ty < nty; ty++ )
+            for( int tx = 0; tx < ntx; tx++ )
+                tiles[ty*ntx + tx].r = Rect(tx*tileSize, ty*tileSize, tileSize, tileSize) & Rect(0, 0, src.cols, src.rows);
+    }
+
+    static int diff( const uchar* a, const uchar* b )
+    {
+        return std::max(std::max(std::abs(a[0] - b[0]), std::abs(a[1] - b[1])), std::abs(a[2] - b[2]));
+    }
+
+    int tileOf( int x, int y ) const { return (y/tileSize)*ntx + x/tileSize; }
+
+    // put the unlabeled pixels next to the markers to the queues of their tiles
+    void init()
+    {
+        Size size = src.size();
+        parallel_for_(Range(0, size.height), [&](const Range& range)
+        {
+            for( int i = range.start; i < range.end; i++ )
+            {
+                int* m = mask.ptr<int>(i);
+                if( i == 0 || i == size.height - 1 )
+                {
+                    for( int j = 0; j < size.width; j++ )
+                        m[j] = WSHED;
+                    continue;
+                }
+                m[0] = m[size.width-1] = WSHED;
+                for( int j = 1; j < size.width-1; j++ )
+                    if( m[j] < 0 )
+                        m[j] = 0;
+            }
+        });
+
+        int mstep = (int)(mask.step/sizeof(int));
+        int istep = (int)src.step;
+        parallel_for_(Range(0, (int)tiles.size()), [&](const Range& range)
+        {
+            for( int t = range.start; t < range.end; t++ )
+            {
+                WSTile& tile = tiles[t];
+                int y0 = std::max(tile.r.y, 1), y1 = std::min(tile.r.y + tile.r.height, size.height - 1);
+                int x0 = std::max(tile.r.x, 1), x1 = std::min(tile.r.x + tile.r.width, size.width - 1);
+                for( int i = y0; i < y1; i++ )
+                {
+                    const int* m = mask.ptr<int>(i);
+                    const uchar* img = src.ptr(i);
+                    for( int j = x0; j < x1; j++ )
+                    {
+                        if( m[j] != 0 || (m[j-1] <= 0 && m[j+1] <= 0 && m[j-mstep] <= 0 && m[j+mstep] <= 0) )
+                            continue;
+                        const uchar* ptr = img + j*3;
+                        int idx = 256;
+                        if( m[j-1] > 0 )
+                            idx = diff(ptr, ptr - 3);
+                        if( m[j+1] > 0 )
+                            idx = std::min(idx, diff(ptr, ptr + 3));
+                        if( m[j-mstep] > 0 )
+                            idx = std::min(idx, diff(ptr, ptr - istep));
+                        if( m[j+mstep] > 0 )
+                            idx = std::min(idx, diff(ptr, ptr + istep));
+                        tile.push(idx, j, i);
+                    }
+                }
+            }
+        });
+
+        // mark the queued pixels once no tile reads the markers any more
+        parallel_for_(Range(0, (int)tiles.size()), [&](const Range& range)
+        {
+            for( int t = range.start; t < range.end; t++ )
+            {
+                const WSTile& tile = tiles[t];
+                for( int k = 0; k < NQ; k++ )
+                    for( int node = tile.q[k].first; node; node = tile.storage[node].next )
+                        mask.at<int>(tile.storage[node].y, tile.storage[node].x) = IN_QUEUE;
+            }
+        });
+
+        snapshot = mask.clone();
+    }
+
+    // pop the pixels queued with the given priority at the start of the round, and the pixels
+    // of a higher priority they uncover, in the order of cv::watershed
+    void flood( WSTile& tile, int priority )
+    {
+        int mstep = (int)(mask.step/sizeof(int));
+        int istep = (int)src.step;
+        const int x0 = tile.r.x, x1 = tile.r.x + tile.r.width - 1;
+        const int y0 = tile.r.y, y1 = tile.r.y + tile.r.height - 1;
+        const int dx[] = { -1, 1, 0, 0 }, dy[] = { 0, 0, -1, 1 };
+
+        int nwave = tile.count[priority];
+
+        for( ;; )
+        {
+            int idx = tile.lowest();
+            if( idx > priority || (idx == priority && nwave == 0) )
+                break;
+            if( idx == priority )
+                nwave--;
+
+            int x, y;
+            tile.pop(idx, x, y);
+            int* m = mask.ptr<int>(y) + x;
+            const int* s = snapshot.ptr<int>(y) + x;
+            const uchar* ptr = src.ptr(y) + x*3;
+            bool inside[4] = { x > x0, x < x1, y > y0, y < y1 };
+            int ofs[4] = { -1, 1, -mstep, mstep };
+            int iofs[4] = { -3, 3, -istep, istep };
+
+            // the labels of the neighbours in the other tiles are taken from the snapshot
+            int lab = 0;
+            for( int k = 0; k < 4; k++ )
+            {
+                int t = inside[k] ? m[ofs[k]] : s[ofs[k]];
+                if( t > 0 )
+                {
+                    if( lab == 0 ) lab = t;
+                    else if( t != lab ) lab = WSHED;
+                }
+            }
+
+            CV_Assert( lab != 0 );
+            m[0] = lab;
+            if( !(inside[0] && inside[1] && inside[2] && inside[3]) )
+                tile.edge.push_back(Point(x, y));
+
+            if( lab == WSHED )
+                continue;
+
+            for( int k = 0; k < 4; k++ )
+            {
+                if( inside[k] )
+                {
+                    if( m[ofs[k]] == 0 )
+                    {
+                        tile.push(diff(ptr, ptr + iofs[k]), x + dx[k], y + dy[k]);
+                        m[ofs[k]] = IN_QUEUE;
+                    }
+                }
+                else if( s[ofs[k]] == 0 )
+                {
+                    int nx = x + dx[k], ny = y + dy[k];
+                    WSTile::Post p = { tileOf(nx, ny), nx, ny, diff(ptr, ptr + iofs[k]) };
+                    tile.outbox.push_back(p);
+                }
+            }
+        }
+    }
+
+    void run()
+    {
+        init();
+
+        std::vector<int> active;
+        for( ;; )
+        {
+            // publish the labels on the tile edges and queue the posted pixels
+            for( size_t t = 0; t < tiles.size(); t++ )
+            {
+                WSTile& tile = tiles[t];
+                for( size_t k = 0; k < tile.edge.size(); k++ )
+                    snapshot.at<int>(tile.edge[k]) = mask.at<int>(tile.edge[k]);
+                tile.edge.clear();
+            }
+            for( size_t t = 0; t < tiles.size(); t++ )
+            {
+                WSTile& tile = tiles[t];
+                for( size_t k = 0; k < tile.outbox.size(); k++ )
+                {
+                    const WSTile::Post& p = tile.outbox[k];
+                    int& m = mask.at<int>(p.y, p.x);
+                    if( m == 0 )
+                    {
+                        tiles[p.tile].push(p.priority, p.x, p.y);
+                        m = IN_QUEUE;
+                    }
+                }
+                tile.outbox.clear();
+            }
+
+            int priority = NQ;
+            for( size_t t = 0; t < tiles.size(); t++ )
+                priority = std::min(priority, tiles[t].lowest());
+            if( priority == NQ )
+                break;
+
+            active.clear();
+            for( size_t t = 0; t < tiles.size(); t++ )
+                if( tiles[t].lowest() <= priority )
+                    active.push_back((int)t);
+
+            parallel_for_(Range(0, (int)active.size()), [&](const Range& range)
+            {
+                for( int k = range.start; k < range.end; k++ )
+                    flood(tiles[active[k]], priority);
+            });
+        }
+    }
+
+    const Mat& src;
+    Mat& mask;
+    Mat snapshot;
+    int tileSize, ntx, nty;
+    std::vector<WSTile> tiles;
+};
+
+}
+}
+
+void cv::watershedTiled( InputArray _src, InputOutputArray _markers, int tileSize )
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat(), dst = _markers.getMat();
+
+    CV_Assert( src.type() == CV_8UC3 && dst.type() == CV_32SC1 );
+    CV_Assert( src.size() == dst.size() );
+    CV_Assert( tileSize > 0 );
+
+    WatershedTiled ws(src, dst, tileSize);
+    ws.run();
+}
+
 /****************************************************************************************\
 *                                         Meanshift                                      *
 \****************************************************************************************/
 
 
+namespace cv
+{
+// Adds the pixels ptr[x..maxx] of one window row whose squared color distance to (c0, c1, c2)
+// does not exceed isr2 to the color and x sums; returns the number of such pixels.
+// The vector loop may read past maxx, but not past the image row of the given width.
+static int meanShiftWindowRow( const uchar* ptr, int x, int maxx, int width, int c0, int c1, int c2,
+                               int isr2, const int* tab, int& s0, int& s1, int& s2, int& sx )
+{
+    int row_count = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int VECSZ = VTraits<v_uint8>::vlanes();
+    const int VECSZ32 = VTraits<v_int32>::vlanes();
+    if( x + VECSZ <= width )
+    {
+        v_int16 vc0 = vx_setall_s16((short)c0), vc1 = vx_setall_s16((short)c1), vc2 = vx_setall_s16((short)c2);
+        v_int32 vr = vx_setall_s32(isr2), vmaxx = vx_setall_s32(maxx);
+        v_int32 vs0 = vx_setzero_s32(), vs1 = vx_setzero_s32(), vs2 = vx_setzero_s32();
+        v_int32 vsx = vx_setzero_s32(), vcount = vx_setzero_s32();
+        int CV_DECL_ALIGNED(CV_SIMD_WIDTH) idx[VTraits<v_int32>::max_nlanes];
+        for( int k = 0; k < VECSZ32; k++ )
+            idx[k] = k;
+        v_int32 vx = v_add(vx_load(idx), vx_setall_s32(x)), vstep = vx_setall_s32(VECSZ32);
+
+        for( ; x <= maxx && x + VECSZ <= width; x += VECSZ, ptr += VECSZ*3 )
+        {
+            v_uint8 b, g, r;
+            v_load_deinterleave(ptr, b, g, r);
+            v_uint16 b16[2], g16[2], r16[2];
+            v_expand(b, b16[0], b16[1]);
+            v_expand(g, g16[0], g16[1]);
+            v_expand(r, r16[0], r16[1]);
+
+            for( int h = 0; h < 2; h++ )
+            {
+                v_int16 d0 = v_sub(v_reinterpret_as_s16(b16[h]), vc0);
+                v_int16 d1 = v_sub(v_reinterpret_as_s16(g16[h]), vc1);
+                v_int16 d2 = v_sub(v_reinterpret_as_s16(r16[h]), vc2);
+                v_int32 e0[2], e1[2], e2[2];
+                v_mul_expand(d0, d0, e0[0], e0[1]);
+                v_mul_expand(d1, d1, e1[0], e1[1]);
+                v_mul_expand(d2, d2, e2[0], e2[1]);
+                v_uint32 t0[2], t1[2], t2[2];
+                v_expand(b16[h], t0[0], t0[1]);
+                v_expand(g16[h], t1[0], t1[1]);
+                v_expand(r16[h], t2[0], t2[1]);
+
+                for( int q = 0; q < 2; q++ )
+                {
+                    v_int32 m = v_and(v_le(v_add(v_add(e0[q], e1[q]), e2[q]), vr), v_le(vx, vmaxx));
+                    vs0 = v_add(vs0, v_and(v_reinterpret_as_s32(t0[q]), m));
+                    vs1 = v_add(vs1, v_and(v_reinterpret_as_s32(t1[q]), m));
+                    vs2 = v_add(vs2, v_and(v_reinterpret_as_s32(t2[q]), m));
+                    vsx = v_add(vsx, v_and(vx, m));
+                    vcount = v_sub(vcount, m);
+                    vx = v_add(vx, vstep);
+                }
+            }
+        }
+        s0 += v_reduce_sum(vs0); s1 += v_reduce_sum(vs1); s2 += v_reduce_sum(vs2);
+        sx += v_reduce_sum(vsx);
+        row_count = v_reduce_sum(vcount);
+    }
+#endif
+    for( ; x <= maxx; x++, ptr += 3 )
+    {
+        int t0 = ptr[0], t1 = ptr[1], t2 = ptr[2];
+        if( tab[t0-c0+255] + tab[t1-c1+255] + tab[t2-c2+255] <= isr2 )
+        {
+            s0 += t0; s1 += t1; s2 += t2;
+            sx += x; row_count++;
+        }
+    }
+    return row_count;
+}
+}
+
 void cv::pyrMeanShiftFiltering( InputArray _src, OutputArray _dst,
                                 double sp0, double sr, int max_level,
                                 TermCriteria termcrit )
@@ -353,7 +768,7 @@ void cv::pyrMeanShiftFiltering( InputArray _src, OutputArray _dst,
     std::vector<cv::Mat> src_pyramid(max_level+1);
     std::vector<cv::Mat> dst_pyramid(max_level+1);
     cv::Mat mask0;
-    int i, j, level;
+    int level;
     //uchar* submask = 0;
 
     #define cdiff(ofs0) (tab[c0-dptr[ofs0]+255] + \
@@ -381,7 +796,7 @@ void cv::pyrMeanShiftFiltering( InputArray _src, OutputArray _dst,
         termcrit.epsilon = 1.f;
     termcrit.epsilon = MAX(termcrit.epsilon, 0.f);
 
-    for( i = 0; i < 768; i++ )
+    for( int i = 0; i < 768; i++ )
         tab[i] = (i - 255)*(i - 255);
 
     // 1. construct pyramid
@@ -403,149 +818,110 @@ void cv::pyrMeanShiftFiltering( InputArray _src, OutputArray _dst,
     for( level = max_level; level >= 0; level-- )
     {
         cv::Mat src = src_pyramid[level];
+        cv::Mat dst = dst_pyramid[level];
         cv::Size size = src.size();
-        const uchar* sptr = src.ptr();
-        int sstep = (int)src.step;
-        uchar* dptr;
-        int dstep;
         float sp = (float)(sp0 / (1 << level));
         sp = MAX( sp, 1 );
 
         cv::Mat m;
         if( level < max_level )
         {
-            cv::Size size1 = dst_pyramid[level+1].size();
+            const cv::Mat& dst1 = dst_pyramid[level+1];
+            cv::Size size1 = dst1.size();
+            int dstep = (int)dst1.step;
             m = cv::Mat(size.height, size.width, CV_8UC1, mask0.ptr());
-            dstep = (int)dst_pyramid[level+1].step;
-            dptr = dst_pyramid[level+1].ptr() + dstep + cn;
-            cv::pyrUp( dst_pyramid[level+1], dst_pyramid[level], dst_pyramid[level].size() );
+            cv::pyrUp( dst1, dst, dst.size() );
             m.setTo(cv::Scalar::all(0));
 
-            for( i = 1; i < size1.height-1; i++, dptr += dstep - (size1.width-2)*3)
+            cv::parallel_for_(cv::Range(1, std::max(size1.height-1, 1)), [&](const cv::Range& range)
             {
-                uchar* mask = m.ptr(1 + i * 2);
-                for( j = 1; j < size1.width-1; j++, dptr += cn )
+                for( int i = range.start; i < range.end; i++ )
                 {
-                    int c0 = dptr[0], c1 = dptr[1], c2 = dptr[2];
-                    mask[j*2 - 1] = cdiff(-3) || cdiff(3) || cdiff(-dstep-3) || cdiff(-dstep) ||
-                        cdiff(-dstep+3) || cdiff(dstep-3) || cdiff(dstep) || cdiff(dstep+3);
+                    const uchar* dptr = dst1.ptr(i) + cn;
+                    uchar* mask = m.ptr(1 + i * 2);
+                    for( int j = 1; j < size1.width-1; j++, dptr += cn )
+                    {
+                        int c0 = dptr[0], c1 = dptr[1], c2 = dptr[2];
+                        mask[j*2 - 1] = cdiff(-3) || cdiff(3) || cdiff(-dstep-3) || cdiff(-dstep) ||
+                            cdiff(-dstep+3) || cdiff(dstep-3) || cdiff(dstep) || cdiff(dstep+3);
+                    }
                 }
-            }
+            });
 
             cv::dilate( m, m, cv::Mat() );
         }
 
-        dptr = dst_pyramid[level].ptr();
-        dstep = (int)dst_pyramid[level].step;
-
-        for( i = 0; i < size.height; i++, sptr += sstep - size.width*3,
-                                          dptr += dstep - size.width*3
-        )
+        // every pixel is filtered independently, so the rows are processed in parallel
+        cv::parallel_for_(cv::Range(0, size.height), [&](const cv::Range& range)
         {
-            uchar* mask = m.empty() ? NULL : m.ptr(i);
-            for( j = 0; j < size.width; j++, sptr += 3, dptr += 3 )
+            for( int i = range.start; i < range.end; i++ )
             {
-                int x0 = j, y0 = i, x1, y1, iter;
-                int c0, c1, c2;
+                const uchar* sptr = src.ptr(i);
+                uchar* dptr = dst.ptr(i);
+                const uchar* mask = m.empty() ? NULL : m.ptr(i);
+                for( int j = 0; j < size.width; j++, sptr += 3, dptr += 3 )
+                {
+                    int x0 = j, y0 = i, x1, y1, iter;
+                    int c0, c1, c2;
 
-                if( mask && !mask[j] )
-                    continue;
+                    if( mask && !mask[j] )
+                        continue;
 
-                c0 = sptr[0], c1 = sptr[1], c2 = sptr[2];
+                    c0 = sptr[0], c1 = sptr[1], c2 = sptr[2];
 
-                // iterate meanshift procedure
-                for( iter = 0; iter < termcrit.maxCount; iter++ )
-                {
-                    const uchar* ptr;
-                    int x, y, count = 0;
-                    int minx, miny, maxx, maxy;
-                    int s0 = 0, s1 = 0, s2 = 0, sx = 0, sy = 0;
-                    double icount;
-                    int stop_flag;
-
-                    //mean shift: process pixels in window (p-sigmaSp)x(p+sigmaSp)
-                    minx = cvRound(x0 - sp); minx = MAX(minx, 0);
-                    miny = cvRound(y0 - sp); miny = MAX(miny, 0);
-                    maxx = cvRound(x0 + sp); maxx = MIN(maxx, size.width-1);
-                    maxy = cvRound(y0 + sp); maxy = MIN(maxy, size.height-1);
-                    ptr = sptr + (miny - i)*sstep + (minx - j)*3;
-
-                    for( y = miny; y <= maxy; y++, ptr += sstep - (maxx-minx+1)*3 )
+                    // iterate meanshift procedure
+                    for( iter = 0; iter < termcrit.maxCount; iter++ )
                     {
-                        int row_count = 0;
-                        x = minx;
-                        #if CV_ENABLE_UNROLLED
-                        for( ; x + 3 <= maxx; x += 4, ptr += 12 )
-                        {
-                            int t0 = ptr[0], t1 = ptr[1], t2 = ptr[2];
-                            if( tab[t0-c0+255] + tab[t1-c1+255] + tab[t2-c2+255] <= isr2 )
-                            {
-                                s0 += t0; s1 += t1; s2 += t2;
-                                sx += x; row_count++;
-                            }
-                            t0 = ptr[3], t1 = ptr[4], t2 = ptr[5];
-                            if( tab[t0-c0+255] + tab[t1-c1+255] + tab[t2-c2+255] <= isr2 )
-                            {
-                                s0 += t0; s1 += t1; s2 += t2;
-                                sx += x+1; row_count++;
-                            }
-                            t0 = ptr[6], t1 = ptr[7], t2 = ptr[8];
-                            if( tab[t0-c0+255] + tab[t1-c1+255] + tab[t2-c2+255] <= isr2 )
-                            {
-                                s0 += t0; s1 += t1; s2 += t2;
-                                sx += x+2; row_count++;
-                            }
-                            t0 = ptr[9], t1 = ptr[10], t2 = ptr[11];
-                            if( tab[t0-c0+255] + tab[t1-c1+255] + tab[t2-c2+255] <= isr2 )
-                            {
-                                s0 += t0; s1 += t1; s2 += t2;
-                                sx += x+3; row_count++;
-                            }
-                        }
-                        #endif
-                        for( ; x <= maxx; x++, ptr += 3 )
+                        int y, count = 0;
+                        int minx, miny, maxx, maxy;
+                        int s0 = 0, s1 = 0, s2 = 0, sx = 0, sy = 0;
+                        double icount;
+                        int stop_flag;
+
+                        //mean shift: process pixels in window (p-sigmaSp)x(p+sigmaSp)
+                        minx = cvRound(x0 - sp); minx = MAX(minx, 0);
+                        miny = cvRound(y0 - sp); miny = MAX(miny, 0);
+                        maxx = cvRound(x0 + sp); maxx = MIN(maxx, size.width-1);
+                        maxy = cvRound(y0 + sp); maxy = MIN(maxy, size.height-1);
+
+                        for( y = miny; y <= maxy; y++ )
                         {
-                            int t0 = ptr[0], t1 = ptr[1], t2 = ptr[2];
-                            if( tab[t0-c0+255] + tab[t1-c1+255] + tab[t2-c2+255] <= isr2 )
-                            {
-                                s0 += t0; s1 += t1; s2 += t2;
-                                sx += x; row_count++;
-                            }
+                            int row_count = meanShiftWindowRow(src.ptr(y) + minx*3, minx, maxx, size.width, c0, c1, c2,
+                                                               isr2, tab, s0, s1, s2, sx);
+                            count += row_count;
+                            sy += y*row_count;
                         }
-                        count += row_count;
-                        sy += y*row_count;
-                    }
 
-                    if( count == 0 )
-                        break;
+                        if( count == 0 )
+                            break;
 
-                    icount = 1./count;
-                    x1 = cvRound(sx*icount);
-                    y1 = cvRound(sy*icount);
-                    s0 = cvRound(s0*icount);
-                    s1 = cvRound(s1*icount);
-                    s2 = cvRound(s2*icount);
+                        icount = 1./count;
+                        x1 = cvRound(sx*icount);
+                        y1 = cvRound(sy*icount);
+                        s0 = cvRound(s0*icount);
+                        s1 = cvRound(s1*icount);
+                        s2 = cvRound(s2*icount);
 
-                    stop_flag = (x0 == x1 && y0 == y1) || std::abs(x1-x0) + std::abs(y1-y0) +
-                        tab[s0 - c0 + 255] + tab[s1 - c1 + 255] +
-                        tab[s2 - c2 + 255] <= termcrit.epsilon;
+                        stop_flag = (x0 == x1 && y0 == y1) || std::abs(x1-x0) + std::abs(y1-y0) +
+                            tab[s0 - c0 + 255] + tab[s1 - c1 + 255] +
+                            tab[s2 - c2 + 255] <= termcrit.epsilon;
 
-                    x0 = x1; y0 = y1;
-                    c0 = s0; c1 = s1; c2 = s2;
+                        x0 = x1; y0 = y1;
+                        c0 = s0; c1 = s1; c2 = s2;
 
-                    if( stop_flag )
-                        break;
-                }
+                        if( stop_flag )
+                            break;
+                    }
 
-                dptr[0] = (uchar)c0;
-                dptr[1] = (uchar)c1;
-                dptr[2] = (uchar)c2;
+                    dptr[0] = (uchar)c0;
+                    dptr[1] = (uchar)c1;
+                    dptr[2] = (uchar)c2;
+                }
             }
-        }
+        });
     }
 }
 
-
 ///////////////////////////////////////////////////////////////////////////////////////////////
 
 CV_IMPL void cvWatershed( const CvArr* _src, CvArr* _markers )
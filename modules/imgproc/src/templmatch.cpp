@@ -611,9 +611,8 @@ void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
     blocksize.height = MIN( blocksize.height, corr.rows );
 
     Mat dftTempl( dftsize.height*tcn, dftsize.width, maxDepth );
-    Mat dftImg( dftsize, maxDepth );
 
-    int i, k, bufSize = 0;
+    int bufSize = 0;
     if( tcn > 1 && tdepth != maxDepth )
         bufSize = templ.cols*templ.rows*CV_ELEM_SIZE(tdepth);
 
@@ -629,7 +628,7 @@ void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
     Ptr<hal::DFT2D> c = hal::DFT2D::create(dftsize.width, dftsize.height, dftTempl.depth(), 1, 1, CV_HAL_DFT_IS_INPLACE, templ.rows);
 
     // compute DFT of each template plane
-    for( k = 0; k < tcn; k++ )
+    for( int k = 0; k < tcn; k++ )
     {
         int yofs = k*dftsize.height;
         Mat src = templ;
@@ -670,93 +669,98 @@ void crossCorr( const Mat& img, const Mat& _templ, Mat& corr,
     }
     borderType |= BORDER_ISOLATED;
 
-    Ptr<hal::DFT2D> cF, cR;
     int f = CV_HAL_DFT_IS_INPLACE;
     int f_inv = f | CV_HAL_DFT_INVERSE | CV_HAL_DFT_SCALE;
-    cF = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f, blocksize.height + templ.rows - 1);
-    cR = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f_inv, blocksize.height);
 
-    // calculate correlation by blocks
-    for( i = 0; i < tileCount; i++ )
+    // calculate correlation by blocks, the blocks are independent
+    parallel_for_(Range(0, tileCount), [&](const Range& range)
     {
-        int x = (i%tileCountX)*blocksize.width;
-        int y = (i/tileCountX)*blocksize.height;
-
-        Size bsz(std::min(blocksize.width, corr.cols - x),
-                 std::min(blocksize.height, corr.rows - y));
-        Size dsz(bsz.width + templ.cols - 1, bsz.height + templ.rows - 1);
-        int x0 = x - anchor.x + roiofs.x, y0 = y - anchor.y + roiofs.y;
-        int x1 = std::max(0, x0), y1 = std::max(0, y0);
-        int x2 = std::min(img0.cols, x0 + dsz.width);
-        int y2 = std::min(img0.rows, y0 + dsz.height);
-        Mat src0(img0, Range(y1, y2), Range(x1, x2));
-        Mat dst(dftImg, Rect(0, 0, dsz.width, dsz.height));
-        Mat dst1(dftImg, Rect(x1-x0, y1-y0, x2-x1, y2-y1));
-        Mat cdst(corr, Rect(x, y, bsz.width, bsz.height));
-
-        for( k = 0; k < cn; k++ )
-        {
-            Mat src = src0;
-            dftImg = Scalar::all(0);
+        std::vector<uchar> tbuf(bufSize);
+        Mat tdftImg( dftsize, maxDepth );
+        Ptr<hal::DFT2D> cF = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f, blocksize.height + templ.rows - 1);
+        Ptr<hal::DFT2D> cR = hal::DFT2D::create(dftsize.width, dftsize.height, maxDepth, 1, 1, f_inv, blocksize.height);
 
-            if( cn > 1 )
+        for( int i = range.start; i < range.end; i++ )
+        {
+            int x = (i%tileCountX)*blocksize.width;
+            int y = (i/tileCountX)*blocksize.height;
+
+            Size bsz(std::min(blocksize.width, corr.cols - x),
+                     std::min(blocksize.height, corr.rows - y));
+            Size dsz(bsz.width + templ.cols - 1, bsz.height + templ.rows - 1);
+            int x0 = x - anchor.x + roiofs.x, y0 = y - anchor.y + roiofs.y;
+            int x1 = std::max(0, x0), y1 = std::max(0, y0);
+            int x2 = std::min(img0.cols, x0 + dsz.width);
+            int y2 = std::min(img0.rows, y0 + dsz.height);
+            Mat src0(img0, Range(y1, y2), Range(x1, x2));
+            Mat dst(tdftImg, Rect(0, 0, dsz.width, dsz.height));
+            Mat dst1(tdftImg, Rect(x1-x0, y1-y0, x2-x1, y2-y1));
+            Mat cdst(corr, Rect(x, y, bsz.width, bsz.height));
+
+            for( int k = 0; k < cn; k++ )
             {
-                src = depth == maxDepth ? dst1 : Mat(y2-y1, x2-x1, depth, &buf[0]);
-                int pairs[] = {k, 0};
-                mixChannels(&src0, 1, &src, 1, pairs, 1);
-            }
+                Mat src = src0;
+                tdftImg = Scalar::all(0);
 
-            if( dst1.data != src.data )
-                src.convertTo(dst1, dst1.depth());
+                if( cn > 1 )
+                {
+                    src = depth == maxDepth ? dst1 : Mat(y2-y1, x2-x1, depth, &tbuf[0]);
+                    int pairs[] = {k, 0};
+                    mixChannels(&src0, 1, &src, 1, pairs, 1);
+                }
 
-            if( x2 - x1 < dsz.width || y2 - y1 < dsz.height )
-                copyMakeBorder(dst1, dst, y1-y0, dst.rows-dst1.rows-(y1-y0),
-                               x1-x0, dst.cols-dst1.cols-(x1-x0), borderType);
+                if( dst1.data != src.data )
+                    src.convertTo(dst1, dst1.depth());
 
-            if (bsz.height == blocksize.height)
-                cF->apply(dftImg.data, (int)dftImg.step, dftImg.data, (int)dftImg.step);
-            else
-                dft( dftImg, dftImg, 0, dsz.height );
+                if( x2 - x1 < dsz.width || y2 - y1 < dsz.height )
+                    copyMakeBorder(dst1, dst, y1-y0, dst.rows-dst1.rows-(y1-y0),
+                                   x1-x0, dst.cols-dst1.cols-(x1-x0), borderType);
 
-            Mat dftTempl1(dftTempl, Rect(0, tcn > 1 ? k*dftsize.height : 0,
-                                         dftsize.width, dftsize.height));
-            mulSpectrums(dftImg, dftTempl1, dftImg, 0, true);
+                if (bsz.height == blocksize.height)
+                    cF->apply(tdftImg.data, (int)tdftImg.step, tdftImg.data, (int)tdftImg.step);
+                else
+                    dft( tdftImg, tdftImg, 0, dsz.height );
 
-            if (bsz.height == blocksize.height)
-                cR->apply(dftImg.data, (int)dftImg.step, dftImg.data, (int)dftImg.step);
-            else
-                dft( dftImg, dftImg, DFT_INVERSE + DFT_SCALE, bsz.height );
+                Mat dftTempl1(dftTempl, Rect(0, tcn > 1 ? k*dftsize.height : 0,
+                                             dftsize.width, dftsize.height));
+                mulSpectrums(tdftImg, dftTempl1, tdftImg, 0, true);
 
-            src = dftImg(Rect(0, 0, bsz.width, bsz.height));
+                if (bsz.height == blocksize.height)
+                    cR->apply(tdftImg.data, (int)tdftImg.step, tdftImg.data, (int)tdftImg.step);
+                else
+                    dft( tdftImg, tdftImg, DFT_INVERSE + DFT_SCALE, bsz.height );
 
-            if( ccn > 1 )
-            {
-                if( cdepth != maxDepth )
+                src = tdftImg(Rect(0, 0, bsz.width, bsz.height));
+
+                if( ccn > 1 )
                 {
-                    Mat plane(bsz, cdepth, &buf[0]);
-                    src.convertTo(plane, cdepth, 1, delta);
-                    src = plane;
+                    if( cdepth != maxDepth )
+                    {
+                        Mat plane(bsz, cdepth, &tbuf[0]);
+                        src.convertTo(plane, cdepth, 1, delta);
+                        src = plane;
+                    }
+                    int pairs[] = {0, k};
+                    mixChannels(&src, 1, &cdst, 1, pairs, 1);
                 }
-                int pairs[] = {0, k};
-                mixChannels(&src, 1, &cdst, 1, pairs, 1);
-            }
-            else
-            {
-                if( k == 0 )
-                    src.convertTo(cdst, cdepth, 1, delta);
                 else
                 {
-                    if( maxDepth != cdepth )
+                    if( k == 0 )
+                        src.convertTo(cdst, cdepth, 1, delta);
+                    else
                     {
-                        Mat plane(bsz, cdepth, &buf[0]);
-                        src.convertTo(plane, cdepth);
-                        src = plane;
+                        if( maxDepth != cdepth )
+                        {
+                            Mat plane(bsz, cdepth, &tbuf[0]);
+                            src.convertTo(plane, cdepth);
+                            src = plane;
+                        }
+                        add(src, cdst, cdst);
                     }
-                    add(src, cdst, cdst);
                 }
             }
         }
-    }
+    });
 }
 
 static void matchTemplateMask( InputArray _img, InputArray _templ, OutputArray _result, int method, InputArray _mask )
@@ -903,7 +907,9 @@ static void matchTemplateMask( InputArray _img, InputArray _templ, OutputArray _
     }
 }
 
-static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method, int cn )
+// normalizes the cross-correlation in result using the integrals of the image,
+// sqsum is only needed by the methods other than TM_CCOEFF
+static void common_matchTemplate( const Mat& sum, const Mat& sqsum, const Mat& templ, Mat& result, int method, int cn )
 {
     if( method == cv::TM_CCORR )
         return;
@@ -916,19 +922,16 @@ static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method,
 
     double invArea = 1./((double)templ.rows * templ.cols);
 
-    Mat sum, sqsum;
     Scalar templMean, templSdv;
-    double *q0 = 0, *q1 = 0, *q2 = 0, *q3 = 0;
+    const double *q0 = 0, *q1 = 0, *q2 = 0, *q3 = 0;
     double templNorm = 0, templSum2 = 0;
 
     if( method == cv::TM_CCOEFF )
     {
-        integral(img, sum, CV_64F);
         templMean = mean(templ);
     }
     else
     {
-        integral(img, sum, sqsum, CV_64F);
         meanStdDev( templ, templMean, templSdv );
 
         templNorm = templSdv[0]*templSdv[0] + templSdv[1]*templSdv[1] + templSdv[2]*templSdv[2] + templSdv[3]*templSdv[3];
@@ -952,80 +955,96 @@ static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method,
         templNorm /= std::sqrt(invArea); // care of accuracy here
 
         CV_Assert(sqsum.data != NULL);
-        q0 = (double*)sqsum.data;
+        q0 = (const double*)sqsum.data;
         q1 = q0 + templ.cols*cn;
-        q2 = (double*)(sqsum.data + templ.rows*sqsum.step);
+        q2 = (const double*)(sqsum.data + templ.rows*sqsum.step);
         q3 = q2 + templ.cols*cn;
     }
 
     CV_Assert(sum.data != NULL);
-    double* p0 = (double*)sum.data;
-    double* p1 = p0 + templ.cols*cn;
-    double* p2 = (double*)(sum.data + templ.rows*sum.step);
-    double* p3 = p2 + templ.cols*cn;
+    const double* p0 = (const double*)sum.data;
+    const double* p1 = p0 + templ.cols*cn;
+    const double* p2 = (const double*)(sum.data + templ.rows*sum.step);
+    const double* p3 = p2 + templ.cols*cn;
 
     int sumstep = sum.data ? (int)(sum.step / sizeof(double)) : 0;
     int sqstep = sqsum.data ? (int)(sqsum.step / sizeof(double)) : 0;
 
-    int i, j, k;
-
-    for( i = 0; i < result.rows; i++ )
+    parallel_for_(Range(0, result.rows), [&](const Range& range)
     {
-        float* rrow = result.ptr<float>(i);
-        int idx = i * sumstep;
-        int idx2 = i * sqstep;
+        int i, j, k;
 
-        for( j = 0; j < result.cols; j++, idx += cn, idx2 += cn )
+        for( i = range.start; i < range.end; i++ )
         {
-            double num = rrow[j], t;
-            double wndMean2 = 0, wndSum2 = 0;
+            float* rrow = result.ptr<float>(i);
+            int idx = i * sumstep;
+            int idx2 = i * sqstep;
 
-            if( numType == 1 )
+            for( j = 0; j < result.cols; j++, idx += cn, idx2 += cn )
             {
-                for( k = 0; k < cn; k++ )
+                double num = rrow[j], t;
+                double wndMean2 = 0, wndSum2 = 0;
+
+                if( numType == 1 )
                 {
-                    t = p0[idx+k] - p1[idx+k] - p2[idx+k] + p3[idx+k];
-                    wndMean2 += t*t;
-                    num -= t*templMean[k];
-                }
+                    for( k = 0; k < cn; k++ )
+                    {
+                        t = p0[idx+k] - p1[idx+k] - p2[idx+k] + p3[idx+k];
+                        wndMean2 += t*t;
+                        num -= t*templMean[k];
+                    }
 
-                wndMean2 *= invArea;
-            }
+                    wndMean2 *= invArea;
+                }
 
-            if( isNormed || numType == 2 )
-            {
-                for( k = 0; k < cn; k++ )
+                if( isNormed || numType == 2 )
                 {
-                    t = q0[idx2+k] - q1[idx2+k] - q2[idx2+k] + q3[idx2+k];
-                    wndSum2 += t;
+                    for( k = 0; k < cn; k++ )
+                    {
+                        t = q0[idx2+k] - q1[idx2+k] - q2[idx2+k] + q3[idx2+k];
+                        wndSum2 += t;
+                    }
+
+                    if( numType == 2 )
+                    {
+                        num = wndSum2 - 2*num + templSum2;
+                        num = MAX(num, 0.);
+                    }
                 }
 
-                if( numType == 2 )
+                if( isNormed )
                 {
-                    num = wndSum2 - 2*num + templSum2;
-                    num = MAX(num, 0.);
+                    double diff2 = MAX(wndSum2 - wndMean2, 0);
+                    if (diff2 <= std::min(0.5, 10 * FLT_EPSILON * wndSum2))
+                        t = 0; // avoid rounding errors
+                    else
+                        t = std::sqrt(diff2)*templNorm;
+
+                    if( fabs(num) < t )
+                        num /= t;
+                    else if( fabs(num) < t*1.125 )
+                        num = num > 0 ? 1 : -1;
+                    else
+                        num = method != cv::TM_SQDIFF_NORMED ? 0 : 1;
                 }
-            }
 
-            if( isNormed )
-            {
-                double diff2 = MAX(wndSum2 - wndMean2, 0);
-                if (diff2 <= std::min(0.5, 10 * FLT_EPSILON * wndSum2))
-                    t = 0; // avoid rounding errors
-                else
-                    t = std::sqrt(diff2)*templNorm;
-
-                if( fabs(num) < t )
-                    num /= t;
-                else if( fabs(num) < t*1.125 )
-                    num = num > 0 ? 1 : -1;
-                else
-                    num = method != cv::TM_SQDIFF_NORMED ? 0 : 1;
+                rrow[j] = (float)num;
             }
-
-            rrow[j] = (float)num;
         }
-    }
+    }, std::max(1, result.rows/16));
+}
+
+static void common_matchTemplate( Mat& img, Mat& templ, Mat& result, int method, int cn )
+{
+    if( method == cv::TM_CCORR )
+        return;
+
+    Mat sum, sqsum;
+    if( method == cv::TM_CCOEFF )
+        integral(img, sum, CV_64F);
+    else
+        integral(img, sum, sqsum, CV_64F);
+    common_matchTemplate(sum, sqsum, templ, result, method, cn);
 }
 }
 
@@ -1193,6 +1212,218 @@ void cv::matchTemplate( InputArray _img, InputArray _templ, OutputArray _result,
     common_matchTemplate(img, templ, result, method, cn);
 }
 
+namespace cv
+{
+
+class TemplateMatcherImpl CV_FINAL : public TemplateMatcher
+{
+public:
+    TemplateMatcherImpl(InputArrayOfArrays _templs, int _method)
+    {
+        setMethod(_method);
+        setTemplates(_templs);
+    }
+
+    void setTemplates(InputArrayOfArrays templs) CV_OVERRIDE;
+    void match(InputArray image, OutputArrayOfArrays results) CV_OVERRIDE;
+
+    void setMethod(int _method) CV_OVERRIDE
+    {
+        CV_Assert( cv::TM_SQDIFF <= _method && _method <= cv::TM_CCOEFF_NORMED );
+        method = _method;
+    }
+    int getMethod() const CV_OVERRIDE { return method; }
+
+protected:
+    void prepare(Size imageSize);
+
+    int method;
+    std::vector<Mat> templs;
+    Size templMin, templMax;
+
+    // tiling and template spectra for the last image size
+    Size imageSize, blocksize, dftsize;
+    int dftDepth;
+    std::vector<Mat> spectra;
+};
+
+void TemplateMatcherImpl::setTemplates(InputArrayOfArrays _templs)
+{
+    std::vector<Mat> t;
+    _templs.getMatVector(t);
+    CV_Assert( !t.empty() );
+
+    int type = t[0].type(), depth = CV_MAT_DEPTH(type);
+    CV_Assert( depth == CV_8U || depth == CV_32F );
+    templMin = templMax = t[0].size();
+    for( size_t i = 0; i < t.size(); i++ )
+    {
+        CV_Assert( t[i].type() == type && t[i].dims <= 2 && !t[i].empty() );
+        templMin.width = std::min(templMin.width, t[i].cols);
+        templMin.height = std::min(templMin.height, t[i].rows);
+        templMax.width = std::max(templMax.width, t[i].cols);
+        templMax.height = std::max(templMax.height, t[i].rows);
+        // the templates are kept, the caller may reuse its buffers
+        t[i] = t[i].clone();
+    }
+    templs.swap(t);
+    imageSize = Size();
+    spectra.clear();
+}
+
+void TemplateMatcherImpl::prepare(Size _imageSize)
+{
+    if( _imageSize == imageSize && !spectra.empty() )
+        return;
+
+    const double blockScale = 4.5;
+    const int minBlockSize = 256;
+    int type = templs[0].type(), cn = CV_MAT_CN(type);
+    Size corrSize(_imageSize.width - templMin.width + 1, _imageSize.height - templMin.height + 1);
+
+    // the same tiling as crossCorr, but sized for the largest template, so one spectrum of
+    // each image block serves all the templates
+    blocksize.width = cvRound(templMax.width*blockScale);
+    blocksize.width = std::max( blocksize.width, minBlockSize - templMax.width + 1 );
+    blocksize.width = std::min( blocksize.width, corrSize.width );
+    blocksize.height = cvRound(templMax.height*blockScale);
+    blocksize.height = std::max( blocksize.height, minBlockSize - templMax.height + 1 );
+    blocksize.height = std::min( blocksize.height, corrSize.height );
+
+    dftsize.width = std::max(getOptimalDFTSize(blocksize.width + templMax.width - 1), 2);
+    dftsize.height = getOptimalDFTSize(blocksize.height + templMax.height - 1);
+    if( dftsize.width <= 0 || dftsize.height <= 0 )
+        CV_Error( cv::Error::StsOutOfRange, "the input arrays are too big" );
+
+    blocksize.width = std::min( dftsize.width - templMax.width + 1, corrSize.width );
+    blocksize.height = std::min( dftsize.height - templMax.height + 1, corrSize.height );
+
+    dftDepth = CV_MAT_DEPTH(type) == CV_8U ? CV_32F : CV_64F;
+    spectra.resize(templs.size());
+    for( size_t i = 0; i < templs.size(); i++ )
+    {
+        const Mat& templ = templs[i];
+        Mat& spectrum = spectra[i];
+        spectrum.create(dftsize.height*cn, dftsize.width, dftDepth);
+        spectrum = Scalar::all(0);
+        for( int k = 0; k < cn; k++ )
+        {
+            Mat plane(spectrum, Rect(0, k*dftsize.height, dftsize.width, dftsize.height));
+            Mat dst(plane, Rect(0, 0, templ.cols, templ.rows));
+            if( cn == 1 )
+                templ.convertTo(dst, dftDepth);
+            else
+            {
+                Mat src(templ.size(), CV_MAT_DEPTH(type));
+                int pairs[] = {k, 0};
+                mixChannels(&templ, 1, &src, 1, pairs, 1);
+                src.convertTo(dst, dftDepth);
+            }
+            dft(plane, plane, 0, templ.rows);
+        }
+    }
+    imageSize = _imageSize;
+}
+
+void TemplateMatcherImpl::match(InputArray _img, OutputArrayOfArrays _results)
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat img = _img.getMat();
+    int type = templs[0].type(), cn = CV_MAT_CN(type);
+    CV_Assert( img.type() == type && img.dims <= 2 );
+    CV_Assert( templMax.width <= img.cols && templMax.height <= img.rows );
+
+    prepare(img.size());
+
+    int ntempls = (int)templs.size();
+    std::vector<Mat> results(ntempls);
+    _results.create(ntempls, 1, CV_32F);
+    for( int i = 0; i < ntempls; i++ )
+    {
+        _results.create(img.rows - templs[i].rows + 1, img.cols - templs[i].cols + 1, CV_32F, i);
+        results[i] = _results.getMat(i);
+    }
+
+    Size corrSize(img.cols - templMin.width + 1, img.rows - templMin.height + 1);
+    int tileCountX = (corrSize.width + blocksize.width - 1)/blocksize.width;
+    int tileCountY = (corrSize.height + blocksize.height - 1)/blocksize.height;
+    int f = CV_HAL_DFT_IS_INPLACE;
+    int f_inv = f | CV_HAL_DFT_INVERSE | CV_HAL_DFT_SCALE;
+
+    // the spectrum of every image block is computed once and multiplied by all template spectra
+    parallel_for_(Range(0, tileCountX*tileCountY), [&](const Range& range)
+    {
+        Mat blockSpectrum(dftsize.height*cn, dftsize.width, dftDepth), corr(dftsize, dftDepth), prod;
+        Mat plane(dftsize, CV_MAT_DEPTH(type));
+        Ptr<hal::DFT2D> cF = hal::DFT2D::create(dftsize.width, dftsize.height, dftDepth, 1, 1, f,
+                                                blocksize.height + templMax.height - 1);
+        Ptr<hal::DFT2D> cR = hal::DFT2D::create(dftsize.width, dftsize.height, dftDepth, 1, 1, f_inv, blocksize.height);
+
+        for( int tile = range.start; tile < range.end; tile++ )
+        {
+            int x = (tile % tileCountX)*blocksize.width, y = (tile / tileCountX)*blocksize.height;
+            Rect r(x, y, std::min(blocksize.width + templMax.width - 1, img.cols - x),
+                   std::min(blocksize.height + templMax.height - 1, img.rows - y));
+            Mat src(img, r);
+
+            blockSpectrum = Scalar::all(0);
+            for( int k = 0; k < cn; k++ )
+            {
+                Mat bplane(blockSpectrum, Rect(0, k*dftsize.height, dftsize.width, dftsize.height));
+                Mat dst(bplane, Rect(0, 0, r.width, r.height));
+                if( cn == 1 )
+                    src.convertTo(dst, dftDepth);
+                else
+                {
+                    Mat splane(plane, Rect(0, 0, r.width, r.height));
+                    int pairs[] = {k, 0};
+                    mixChannels(&src, 1, &splane, 1, pairs, 1);
+                    splane.convertTo(dst, dftDepth);
+                }
+                cF->apply(bplane.data, (int)bplane.step, bplane.data, (int)bplane.step);
+            }
+
+            for( int i = 0; i < ntempls; i++ )
+            {
+                Mat& result = results[i];
+                Size bsz(std::min(blocksize.width, result.cols - x), std::min(blocksize.height, result.rows - y));
+                if( bsz.width <= 0 || bsz.height <= 0 )
+                    continue;
+
+                // the channels are summed in the frequency domain, one inverse transform per template
+                for( int k = 0; k < cn; k++ )
+                {
+                    Rect pr(0, k*dftsize.height, dftsize.width, dftsize.height);
+                    mulSpectrums(blockSpectrum(pr), spectra[i](pr), k == 0 ? corr : prod, 0, true);
+                    if( k > 0 )
+                        add(corr, prod, corr);
+                }
+                cR->apply(corr.data, (int)corr.step, corr.data, (int)corr.step);
+                corr(Rect(0, 0, bsz.width, bsz.height)).convertTo(result(Rect(x, y, bsz.width, bsz.height)), CV_32F);
+            }
+        }
+    });
+
+    if( method == cv::TM_CCORR )
+        return;
+
+    Mat sum, sqsum;
+    if( method == cv::TM_CCOEFF )
+        integral(img, sum, CV_64F);
+    else
+        integral(img, sum, sqsum, CV_64F);
+    for( int i = 0; i < ntempls; i++ )
+        common_matchTemplate(sum, sqsum, templs[i], results[i], method, cn);
+}
+
+Ptr<TemplateMatcher> createTemplateMatcher(InputArrayOfArrays templs, int method)
+{
+    return makePtr<TemplateMatcherImpl>(templs, method);
+}
+
+}
+
 CV_IMPL void
 cvMatchTemplate( const CvArr* _img, const CvArr* _templ, CvArr* _result, int method )
 {
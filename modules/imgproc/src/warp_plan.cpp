@@ -0,0 +1,339 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+#include "imgwarp.hpp"
+
+namespace cv {
+
+namespace {
+
+// destination tile of the plan, small enough to keep its packed offsets within 8 bits for moderate downscaling
+static const int WARP_PLAN_TILE_W = 64;
+static const int WARP_PLAN_TILE_H = 32;
+
+struct WarpPlanTile
+{
+    Rect dst;       // destination pixels
+    Rect src;       // source pixels read by the interpolation, may lie outside of the source image
+    Point base;     // packed tiles store the map relative to this point
+    bool packed;
+    size_t ofs;     // start of the tile in packedXY (packed tiles) or rawXY (the others)
+};
+
+class WarpPlanImpl CV_FINAL : public WarpPlan
+{
+public:
+    WarpPlanImpl(const Mat& XY, const Mat& A, int _interpolation, int _borderMode, const Scalar& _borderValue, bool packMaps);
+
+    void apply(InputArray src, OutputArray dst) const CV_OVERRIDE;
+    Size getDstSize() const CV_OVERRIDE { return dsize; }
+    size_t getMapMemory() const CV_OVERRIDE;
+
+private:
+    Size dsize;
+    int interpolation, borderMode;
+    Scalar borderValue;
+    std::vector<WarpPlanTile> tiles;
+    Mat XY, A;
+    std::vector<ushort> packedXY;
+    std::vector<short> rawXY;
+};
+
+// the map entry (x, y) with the interpolation table index refers to the source pixels [x - r0, x + r1]
+static void interpolationReach(int interpolation, int& r0, int& r1)
+{
+    r0 = interpolation == INTER_CUBIC ? 1 : interpolation == INTER_LANCZOS4 ? 3 : 0;
+    r1 = interpolation == INTER_CUBIC ? 2 : interpolation == INTER_LANCZOS4 ? 4 : 1;
+}
+
+WarpPlanImpl::WarpPlanImpl(const Mat& _XY, const Mat& _A, int _interpolation, int _borderMode,
+                           const Scalar& _borderValue, bool packMaps) :
+    dsize(_XY.size()), interpolation(_interpolation), borderMode(_borderMode), borderValue(_borderValue)
+{
+    CV_Assert( _XY.type() == CV_16SC2 && (_A.empty() || (_A.type() == CV_16UC1 && _A.size() == dsize)) );
+    int r0, r1;
+    interpolationReach(interpolation, r0, r1);
+
+    for( int y = 0; y < dsize.height; y += WARP_PLAN_TILE_H )
+        for( int x = 0; x < dsize.width; x += WARP_PLAN_TILE_W )
+        {
+            WarpPlanTile t;
+            t.dst = Rect(x, y, std::min(WARP_PLAN_TILE_W, dsize.width - x), std::min(WARP_PLAN_TILE_H, dsize.height - y));
+            int xmin = INT_MAX, ymin = INT_MAX, xmax = INT_MIN, ymax = INT_MIN;
+            for( int i = 0; i < t.dst.height; i++ )
+            {
+                const short* xy = _XY.ptr<short>(y + i) + x*2;
+                for( int j = 0; j < t.dst.width; j++ )
+                {
+                    xmin = std::min(xmin, (int)xy[j*2]);
+                    xmax = std::max(xmax, (int)xy[j*2]);
+                    ymin = std::min(ymin, (int)xy[j*2+1]);
+                    ymax = std::max(ymax, (int)xy[j*2+1]);
+                }
+            }
+            t.src = Rect(xmin - r0, ymin - r0, xmax - xmin + r0 + r1 + 1, ymax - ymin + r0 + r1 + 1);
+            t.base = Point(xmin, ymin);
+            t.packed = packMaps && xmax - xmin <= UCHAR_MAX && ymax - ymin <= UCHAR_MAX;
+            t.ofs = 0;
+            tiles.push_back(t);
+        }
+
+    if( !packMaps )
+    {
+        XY = _XY;
+        A = _A;
+        return;
+    }
+
+    for( size_t k = 0; k < tiles.size(); k++ )
+    {
+        WarpPlanTile& t = tiles[k];
+        t.ofs = t.packed ? packedXY.size() : rawXY.size();
+        for( int i = 0; i < t.dst.height; i++ )
+        {
+            const short* xy = _XY.ptr<short>(t.dst.y + i) + t.dst.x*2;
+            for( int j = 0; j < t.dst.width; j++ )
+            {
+                if( t.packed )
+                    packedXY.push_back((ushort)((xy[j*2] - t.base.x) | ((xy[j*2+1] - t.base.y) << 8)));
+                else
+                {
+                    rawXY.push_back(xy[j*2]);
+                    rawXY.push_back(xy[j*2+1]);
+                }
+            }
+        }
+    }
+    A = _A;
+}
+
+// expands the packed offsets of one tile to the CV_16SC2 map expected by remap
+static void unpackWarpPlanTile(const ushort* packed, short* xy, int n, Point base)
+{
+    int i = 0;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int VL = VTraits<v_uint16>::vlanes();
+    v_uint16 vmask = vx_setall_u16(UCHAR_MAX);
+    v_int16 vbx = vx_setall_s16((short)base.x), vby = vx_setall_s16((short)base.y);
+    for( ; i <= n - VL; i += VL )
+    {
+        v_uint16 w = vx_load(packed + i);
+        v_int16 dx = v_add(v_reinterpret_as_s16(v_and(w, vmask)), vbx);
+        v_int16 dy = v_add(v_reinterpret_as_s16(v_shr<8>(w)), vby);
+        v_store_interleave(xy + i*2, dx, dy);
+    }
+#endif
+    for( ; i < n; i++ )
+    {
+        xy[i*2] = (short)(base.x + (packed[i] & UCHAR_MAX));
+        xy[i*2+1] = (short)(base.y + (packed[i] >> 8));
+    }
+}
+
+void WarpPlanImpl::apply(InputArray _src, OutputArray _dst) const
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat();
+    CV_Assert( !src.empty() && src.dims <= 2 );
+    _dst.create(dsize, src.type());
+    Mat dst = _dst.getMat();
+    if( dst.data == src.data )
+        src = src.clone();
+
+    // with these borders the pixels that read nothing from the source do not depend on it
+    const bool skipOutside = borderMode == BORDER_CONSTANT || borderMode == BORDER_TRANSPARENT;
+    const Rect srcRect(0, 0, src.cols, src.rows);
+
+    parallel_for_(Range(0, (int)tiles.size()), [&](const Range& range)
+    {
+        AutoBuffer<short> _buf(WARP_PLAN_TILE_W*WARP_PLAN_TILE_H*2);
+        for( int k = range.start; k < range.end; k++ )
+        {
+            const WarpPlanTile& t = tiles[k];
+            Mat dpart = dst(t.dst);
+            if( skipOutside && (t.src & srcRect).empty() )
+            {
+                if( borderMode == BORDER_CONSTANT )
+                    dpart.setTo(borderValue);
+                continue;
+            }
+
+            Mat xy;
+            if( !XY.empty() )
+                xy = XY(t.dst);
+            else if( t.packed )
+            {
+                xy = Mat(t.dst.size(), CV_16SC2, _buf.data());
+                unpackWarpPlanTile(&packedXY[t.ofs], xy.ptr<short>(), (int)t.dst.area(), t.base);
+            }
+            else
+                xy = Mat(t.dst.size(), CV_16SC2, (void*)&rawXY[t.ofs]);
+
+            remap(src, dpart, xy, A.empty() ? Mat() : A(t.dst), interpolation, borderMode, borderValue);
+        }
+    });
+}
+
+size_t WarpPlanImpl::getMapMemory() const
+{
+    return XY.total()*XY.elemSize() + A.total()*A.elemSize() + packedXY.size()*sizeof(packedXY[0]) +
+           rawXY.size()*sizeof(rawXY[0]) + tiles.size()*sizeof(tiles[0]);
+}
+
+static int warpPlanInterpolation(int interpolation)
+{
+    if( interpolation == INTER_AREA )
+        interpolation = INTER_LINEAR;
+    CV_Check(interpolation, interpolation == INTER_NEAREST || interpolation == INTER_LINEAR ||
+             interpolation == INTER_CUBIC || interpolation == INTER_LANCZOS4,
+             "WarpPlan: unsupported interpolation method");
+    return interpolation;
+}
+
+static void checkWarpPlanSize(Size dsize)
+{
+    CV_Assert( dsize.width > 0 && dsize.height > 0 && dsize.width < SHRT_MAX && dsize.height < SHRT_MAX );
+}
+
+} // namespace
+
+Ptr<WarpPlan> createRemapPlan( InputArray _map1, InputArray _map2, int interpolation,
+                               int borderMode, const Scalar& borderValue, bool packMaps )
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( (interpolation & WARP_RELATIVE_MAP) == 0 );
+    interpolation = warpPlanInterpolation(interpolation);
+    Mat map1 = _map1.getMat(), map2 = _map2.getMat();
+    CV_Assert( !map1.empty() && (map2.empty() || map2.size() == map1.size()) );
+    checkWarpPlanSize(map1.size());
+
+    Mat XY, A;
+    if( map1.type() == CV_16SC2 )
+    {
+        // fixed-point maps are used as is; remap applies the table index for the nearest neighbor as well
+        XY = map1.clone();
+        if( !map2.empty() )
+        {
+            CV_Assert( map2.type() == CV_16UC1 || map2.type() == CV_16SC1 );
+            bitwise_and(Mat(map2.size(), CV_16UC1, map2.data, map2.step), Scalar::all(INTER_TAB_SIZE2 - 1), A);
+        }
+    }
+    else
+    {
+        bool nn = interpolation == INTER_NEAREST;
+        convertMaps(map1, map2, XY, A, CV_16SC2, nn);
+        if( nn )
+            A.release();
+    }
+    return makePtr<WarpPlanImpl>(XY, A, interpolation, borderMode, borderValue, packMaps);
+}
+
+Ptr<WarpPlan> createWarpAffinePlan( InputArray _M0, Size dsize, int flags,
+                                    int borderMode, const Scalar& borderValue, bool packMaps )
+{
+    CV_INSTRUMENT_REGION();
+
+    int interpolation = warpPlanInterpolation(flags & INTER_MAX);
+    checkWarpPlanSize(dsize);
+    Mat M0 = _M0.getMat();
+    CV_Assert( (M0.type() == CV_32F || M0.type() == CV_64F) && M0.rows == 2 && M0.cols == 3 );
+    double M[6] = {0};
+    Mat matM(2, 3, CV_64F, M);
+    M0.convertTo(matM, matM.type());
+
+    if( !(flags & WARP_INVERSE_MAP) )
+    {
+        double D = M[0]*M[4] - M[1]*M[3];
+        D = D != 0 ? 1./D : 0;
+        double A11 = M[4]*D, A22=M[0]*D;
+        M[0] = A11; M[1] *= -D;
+        M[3] *= -D; M[4] = A22;
+        double b1 = -M[0]*M[2] - M[1]*M[5];
+        double b2 = -M[3]*M[2] - M[4]*M[5];
+        M[2] = b1; M[5] = b2;
+    }
+
+    // the same fixed-point arithmetic as in warpAffine
+    const int AB_BITS = MAX(10, (int)INTER_BITS);
+    const int AB_SCALE = 1 << AB_BITS;
+    const bool nn = interpolation == INTER_NEAREST;
+    const int round_delta = nn ? AB_SCALE/2 : AB_SCALE/INTER_TAB_SIZE/2;
+    std::vector<int> adelta(dsize.width), bdelta(dsize.width);
+    for( int x = 0; x < dsize.width; x++ )
+    {
+        adelta[x] = saturate_cast<int>(M[0]*x*AB_SCALE);
+        bdelta[x] = saturate_cast<int>(M[3]*x*AB_SCALE);
+    }
+
+    Mat XY(dsize, CV_16SC2), A;
+    if( !nn )
+        A.create(dsize, CV_16UC1);
+    parallel_for_(Range(0, dsize.height), [&](const Range& range)
+    {
+        for( int y = range.start; y < range.end; y++ )
+        {
+            short* xy = XY.ptr<short>(y);
+            int X0 = saturate_cast<int>((M[1]*y + M[2])*AB_SCALE) + round_delta;
+            int Y0 = saturate_cast<int>((M[4]*y + M[5])*AB_SCALE) + round_delta;
+            if( nn )
+            {
+                for( int x = 0; x < dsize.width; x++ )
+                {
+                    xy[x*2] = saturate_cast<short>((X0 + adelta[x]) >> AB_BITS);
+                    xy[x*2+1] = saturate_cast<short>((Y0 + bdelta[x]) >> AB_BITS);
+                }
+                continue;
+            }
+            ushort* alpha = A.ptr<ushort>(y);
+            for( int x = 0; x < dsize.width; x++ )
+            {
+                int X = (X0 + adelta[x]) >> (AB_BITS - INTER_BITS);
+                int Y = (Y0 + bdelta[x]) >> (AB_BITS - INTER_BITS);
+                xy[x*2] = saturate_cast<short>(X >> INTER_BITS);
+                xy[x*2+1] = saturate_cast<short>(Y >> INTER_BITS);
+                alpha[x] = (ushort)((Y & (INTER_TAB_SIZE-1))*INTER_TAB_SIZE + (X & (INTER_TAB_SIZE-1)));
+            }
+        }
+    });
+    return makePtr<WarpPlanImpl>(XY, A, interpolation, borderMode, borderValue, packMaps);
+}
+
+Ptr<WarpPlan> createWarpPerspectivePlan( InputArray _M0, Size dsize, int flags,
+                                         int borderMode, const Scalar& borderValue, bool packMaps )
+{
+    CV_INSTRUMENT_REGION();
+
+    int interpolation = warpPlanInterpolation(flags & INTER_MAX);
+    checkWarpPlanSize(dsize);
+    Mat M0 = _M0.getMat();
+    CV_Assert( (M0.type() == CV_32F || M0.type() == CV_64F) && M0.rows == 3 && M0.cols == 3 );
+    double M[9];
+    Mat matM(3, 3, CV_64F, M);
+    M0.convertTo(matM, matM.type());
+    if( !(flags & WARP_INVERSE_MAP) )
+        invert(matM, matM);
+
+    // warpPerspective computes the map in blocks, the row segments have to start at the same columns
+    // to produce exactly the same rounding
+    int bh0 = std::min(16, dsize.height);
+    int bw0 = std::min(1024/bh0, dsize.width);
+
+    Mat XY(dsize, CV_16SC2), A;
+    if( interpolation != INTER_NEAREST )
+        A.create(dsize, CV_16UC1);
+    parallel_for_(Range(0, dsize.height), [&](const Range& range)
+    {
+        WarpPerspectiveLine warpLine(M, interpolation);
+        for( int y = range.start; y < range.end; y++ )
+            for( int x = 0; x < dsize.width; x += bw0 )
+                warpLine(XY.ptr<short>(y) + x*2, A.empty() ? 0 : A.ptr<short>(y) + x,
+                         x, y, std::min(bw0, dsize.width - x));
+    });
+    return makePtr<WarpPlanImpl>(XY, A, interpolation, borderMode, borderValue, packMaps);
+}
+
+} // namespace cv
@@ -289,4 +289,67 @@ namespace opencv_test { namespace {
         test.safe_run();
     }
 
+    static Mat makeBilateralTestImage(Size sz, int type)
+    {
+        Mat img(sz, CV_32FC3);
+        for (int y = 0; y < sz.height; y++)
+            for (int x = 0; x < sz.width; x++)
+            {
+                float v = 40.f + 60.f*x/sz.width + 40.f*y/sz.height;
+                img.at<Vec3f>(y, x) = Vec3f(v, v + 10.f, v + 20.f);
+            }
+        circle(img, Point(sz.width/3, sz.height/2), sz.height/4, Scalar(200, 190, 180), -1);
+        rectangle(img, Rect(sz.width*3/5, sz.height/5, sz.width/4, sz.height/2), Scalar(15, 20, 25), -1);
+        Mat noise(sz, CV_32FC3);
+        theRNG().fill(noise, RNG::NORMAL, 0, 8);
+        img += noise;
+        if (CV_MAT_CN(type) == 1)
+            cvtColor(img, img, COLOR_BGR2GRAY);
+        img.convertTo(img, CV_MAT_DEPTH(type));
+        return img;
+    }
+
+    typedef testing::TestWithParam<tuple<MatType, double> > Imgproc_BilateralGridFilter_Accuracy;
+
+    TEST_P(Imgproc_BilateralGridFilter_Accuracy, close_to_exact)
+    {
+        const int type = get<0>(GetParam());
+        const double sigmaSpace = get<1>(GetParam()), sigmaColor = 30;
+        const int prevThreads = getNumThreads();
+
+        Mat src = makeBilateralTestImage(Size(320, 241), type), ref, dst, dst1;
+        bilateralFilter(src, ref, 0, sigmaColor, sigmaSpace, BORDER_REPLICATE);
+        setNumThreads(4);
+        bilateralGridFilter(src, dst, sigmaColor, sigmaSpace);
+        setNumThreads(1);
+        bilateralGridFilter(src, dst1, sigmaColor, sigmaSpace);
+        setNumThreads(prevThreads);
+
+        ASSERT_EQ(src.type(), dst.type());
+        EXPECT_EQ(0, cvtest::norm(dst, dst1, NORM_INF));
+        // the approximation error stays a small fraction of the range kernel width
+        Mat ref32, dst32;
+        ref.convertTo(ref32, CV_32F);
+        dst.convertTo(dst32, CV_32F);
+        EXPECT_LE(cvtest::norm(ref32, dst32, NORM_L1)/ref32.total()/ref32.channels(), 1.5);
+        EXPECT_LE(cvtest::norm(ref32, dst32, NORM_INF), 0.75*sigmaColor);
+    }
+
+    INSTANTIATE_TEST_CASE_P(/**/, Imgproc_BilateralGridFilter_Accuracy, testing::Combine(
+        testing::Values(CV_8UC1, CV_8UC3, CV_32FC1, CV_32FC3),
+        testing::Values(3., 8.)));
+
+    TEST(Imgproc_BilateralGridFilter, inplace_and_flat)
+    {
+        Mat src(50, 70, CV_8UC3, Scalar(10, 100, 250)), dst;
+        bilateralGridFilter(src, dst, 20, 5);
+        EXPECT_EQ(0, cvtest::norm(src, dst, NORM_INF));
+
+        src = makeBilateralTestImage(Size(64, 48), CV_32FC1);
+        Mat ref;
+        bilateralGridFilter(src, ref, 25, 4);
+        bilateralGridFilter(src, src, 25, 4);
+        EXPECT_EQ(0, cvtest::norm(ref, src, NORM_INF));
+    }
+
 }} // namespace
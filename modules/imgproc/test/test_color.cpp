@@ -3217,4 +3217,67 @@ TEST(ImgProc_RGB2Lab, NaN_21111)
 #endif
 }
 
+typedef testing::TestWithParam< tuple<int, int, int> > ImgProc_DemosaicingPipeline;
+
+TEST_P(ImgProc_DemosaicingPipeline, accuracy)
+{
+    const int depth = get<0>(GetParam());
+    const int code = get<1>(GetParam());
+    const int binning = get<2>(GetParam());
+
+    Mat raw(243, 325, depth);
+    cvtest::randUni(theRNG(), raw, Scalar::all(0), Scalar::all(depth == CV_8U ? 256 : 4096));
+    const Scalar gains(1.5, 1.0, 2.0);
+    const Matx33f ccm(1.6f, -0.4f, -0.2f,
+                      -0.3f, 1.5f, -0.2f,
+                      -0.1f, -0.5f, 1.6f);
+
+    // the unfused pipeline in floating point
+    Mat rgb, ref;
+    cv::demosaicing(raw, rgb, code);
+    rgb.convertTo(rgb, CV_32F);
+    cv::multiply(rgb, gains, rgb);
+    cv::transform(rgb, rgb, ccm);
+    if (binning > 1)
+    {
+        Size dsize(raw.cols / binning, raw.rows / binning);
+        cv::resize(rgb(Rect(0, 0, dsize.width * binning, dsize.height * binning)), rgb, dsize, 0, 0, INTER_AREA);
+    }
+    rgb.convertTo(ref, depth);
+
+    Mat dst;
+    cv::demosaicingPipeline(raw, dst, code, gains, ccm, binning);
+    ASSERT_EQ(ref.size(), dst.size());
+    ASSERT_EQ(ref.type(), dst.type());
+    EXPECT_LE(cvtest::norm(dst, ref, NORM_INF), 1);
+
+    const int prevThreads = cv::getNumThreads();
+    cv::setNumThreads(1);
+    Mat dst1;
+    cv::demosaicingPipeline(raw, dst1, code, gains, ccm, binning);
+    cv::setNumThreads(prevThreads);
+    EXPECT_EQ(0, cvtest::norm(dst, dst1, NORM_INF));
+}
+
+TEST_P(ImgProc_DemosaicingPipeline, same_as_demosaicing)
+{
+    const int depth = get<0>(GetParam());
+    const int code = get<1>(GetParam());
+    if (get<2>(GetParam()) != 1)
+        throw SkipTestException("binning");
+
+    Mat raw(120, 161, depth);
+    cvtest::randUni(theRNG(), raw, Scalar::all(0), Scalar::all(depth == CV_8U ? 256 : 65536));
+
+    Mat ref, dst;
+    cv::demosaicing(raw, ref, code);
+    cv::demosaicingPipeline(raw, dst, code);
+    EXPECT_EQ(0, cvtest::norm(dst, ref, NORM_INF));
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, ImgProc_DemosaicingPipeline,
+    testing::Combine(testing::Values(CV_8U, CV_16U),
+                     testing::Values((int)COLOR_BayerBG2BGR, (int)COLOR_BayerGB2BGR, (int)COLOR_BayerRG2BGR, (int)COLOR_BayerGR2BGR),
+                     testing::Values(1, 2, 4)));
+
 }} // namespace
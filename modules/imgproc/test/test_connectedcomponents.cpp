@@ -800,5 +800,140 @@ TEST(Imgproc_ConnectedComponents, 4conn_regression_21366)
 
 
 
+static void checkIncrementalLabels(const Ptr<IncrementalConnectedComponents>& icc, const Mat& img)
+{
+    Mat ref, refStats, refCentroids;
+    int nref = connectedComponentsWithStats(img, ref, refStats, refCentroids, icc->getConnectivity(), CV_32S);
+    Mat labels, stats, centroids;
+    icc->getLabels(labels);
+    icc->getStats(stats, centroids);
+    ASSERT_EQ(img.size(), labels.size());
+    ASSERT_EQ(CV_32S, labels.type());
+
+    // the labels must be a renumbering of the reference ones
+    int n = stats.rows;
+    std::vector<int> fwd(n, -1), bwd(nref, -1);
+    for (int y = 0; y < img.rows; y++)
+        for (int x = 0; x < img.cols; x++)
+        {
+            int l = labels.at<int>(y, x), r = ref.at<int>(y, x);
+            ASSERT_TRUE(l >= 0 && l < n);
+            if (fwd[l] < 0 && bwd[r] < 0)
+            {
+                fwd[l] = r;
+                bwd[r] = l;
+            }
+            ASSERT_EQ(r, fwd[l]) << "at " << Point(x, y);
+            ASSERT_EQ(l, bwd[r]) << "at " << Point(x, y);
+        }
+
+    EXPECT_EQ(refStats.at<int>(0, CC_STAT_AREA), stats.at<int>(0, CC_STAT_AREA));
+    for (int l = 1; l < n; l++)
+    {
+        if (fwd[l] < 0)
+        {
+            EXPECT_EQ(0, stats.at<int>(l, CC_STAT_AREA));
+            continue;
+        }
+        for (int j = 0; j < CC_STAT_MAX; j++)
+            EXPECT_EQ(refStats.at<int>(fwd[l], j), stats.at<int>(l, j)) << "label " << l << ", stat " << j;
+        EXPECT_NEAR(refCentroids.at<double>(fwd[l], 0), centroids.at<double>(l, 0), 1e-9);
+        EXPECT_NEAR(refCentroids.at<double>(fwd[l], 1), centroids.at<double>(l, 1), 1e-9);
+    }
+}
+
+typedef testing::TestWithParam< tuple<int, int> > Imgproc_ConnectedComponents_Incremental;
+
+TEST_P(Imgproc_ConnectedComponents_Incremental, accuracy)
+{
+    const int connectivity = get<0>(GetParam());
+    const int mode = get<1>(GetParam()); // 0 - compare frames, 1 - change mask, 2 - dirty rectangles
+    RNG& rng = theRNG();
+
+    Mat img(301, 257, CV_8U);
+    randu(img, 0, 256);
+    GaussianBlur(img, img, Size(7, 7), 0);
+    img = img > 130;
+
+    Ptr<IncrementalConnectedComponents> icc = createIncrementalConnectedComponents(connectivity, 32);
+    icc->apply(img);
+    ASSERT_NO_FATAL_FAILURE(checkIncrementalLabels(icc, img));
+
+    for (int frame = 0; frame < 30; frame++)
+    {
+        Mat next = img.clone();
+        std::vector<Rect> rects;
+        for (int k = rng.uniform(1, 4); k > 0; k--)
+        {
+            Point p0(rng.uniform(0, img.cols), rng.uniform(0, img.rows));
+            Point p1(rng.uniform(0, img.cols), rng.uniform(0, img.rows));
+            switch (rng.uniform(0, 3))
+            {
+            case 0: // a line merges components
+                line(next, p0, p1, Scalar::all(255));
+                rects.push_back(Rect(p0, p1) | Rect(p1, Size(1, 1)));
+                break;
+            case 1: // a hole splits them
+            {
+                Rect r = Rect(p0, Size(rng.uniform(1, 40), rng.uniform(1, 40))) & Rect(Point(), img.size());
+                next(r).setTo(Scalar::all(0));
+                rects.push_back(r);
+                break;
+            }
+            default: // new random pixels
+            {
+                Rect r = Rect(p0, Size(rng.uniform(1, 20), rng.uniform(1, 20))) & Rect(Point(), img.size());
+                Mat noise(r.size(), CV_8U);
+                randu(noise, 0, 256);
+                next(r).setTo(Scalar::all(255), noise > 200);
+                rects.push_back(r);
+                break;
+            }
+            }
+        }
+
+        if (mode == 0)
+            icc->apply(next);
+        else if (mode == 1)
+            icc->apply(next, next != img);
+        else
+            icc->applyRegions(next, rects);
+        ASSERT_NO_FATAL_FAILURE(checkIncrementalLabels(icc, next)) << "frame " << frame;
+        img = next;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_ConnectedComponents_Incremental,
+                        testing::Combine(testing::Values(4, 8), testing::Values(0, 1, 2)));
+
+TEST(Imgproc_ConnectedComponents, incremental_persistent_labels)
+{
+    Mat img = Mat::zeros(100, 200, CV_8U);
+    rectangle(img, Rect(10, 10, 20, 20), Scalar::all(255), FILLED);
+    rectangle(img, Rect(150, 60, 20, 20), Scalar::all(255), FILLED);
+    Ptr<IncrementalConnectedComponents> icc = createIncrementalConnectedComponents(8, 16);
+    EXPECT_EQ(3, icc->apply(img));
+
+    Mat labels;
+    icc->getLabels(labels);
+    int la = labels.at<int>(15, 15), lb = labels.at<int>(65, 155);
+    EXPECT_NE(la, lb);
+
+    // the second square grows: both keep their labels
+    rectangle(img, Rect(150, 60, 30, 30), Scalar::all(255), FILLED);
+    icc->apply(img);
+    icc->getLabels(labels);
+    EXPECT_EQ(la, labels.at<int>(15, 15));
+    EXPECT_EQ(lb, labels.at<int>(85, 175));
+
+    // a bridge merges them: the smaller label survives
+    line(img, Point(25, 25), Point(155, 65), Scalar::all(255));
+    icc->apply(img);
+    icc->getLabels(labels);
+    EXPECT_EQ(std::min(la, lb), labels.at<int>(15, 15));
+    EXPECT_EQ(std::min(la, lb), labels.at<int>(65, 155));
+    ASSERT_NO_FATAL_FAILURE(checkIncrementalLabels(icc, img));
+}
+
 }
 } // namespace
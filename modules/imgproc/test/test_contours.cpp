@@ -534,6 +534,59 @@ TEST(Imgproc_FindContours, regression_4363_shared_nbd)
     }
 }
 
+typedef testing::TestWithParam<tuple<int, int> > Imgproc_FindContours_Parallel;
+
+TEST_P(Imgproc_FindContours_Parallel, same_as_serial)
+{
+    const int mode = get<0>(GetParam());
+    const int method = get<1>(GetParam());
+    const int nthreads = getNumThreads();
+
+    RNG& rng = TS::ptr()->get_rng();
+    Mat noise(1100, 1000, CV_8UC1), img;
+    rng.fill(noise, RNG::UNIFORM, 0, 256);
+    for (int iter = 0; iter < 3; iter++)
+    {
+        if (iter == 0)
+        {
+            // nested blobs crossing the band seams
+            img = Mat::zeros(noise.size(), CV_8UC1);
+            for (int i = 0; i < 40; i++)
+            {
+                Point center(rng.uniform(0, img.cols), rng.uniform(0, img.rows));
+                int r = rng.uniform(5, 300);
+                for (; r > 0; r -= rng.uniform(2, 20))
+                    circle(img, center, r, Scalar::all((r / 2) % 2 ? 0 : 255), FILLED);
+            }
+        }
+        else
+        {
+            // noise with a lot of tiny components and holes
+            cv::threshold(noise, img, iter == 1 ? 128 : 60, 255, THRESH_BINARY);
+        }
+        Mat src = img.clone();
+
+        vector<vector<Point> > contours0, contours1;
+        vector<Vec4i> hierarchy0, hierarchy1;
+        setNumThreads(1);
+        findContours(img, contours0, hierarchy0, mode, method, Point(3, -5));
+        setNumThreads(std::max(nthreads, 4));
+        findContours(img, contours1, hierarchy1, mode, method, Point(3, -5));
+        setNumThreads(nthreads);
+
+        EXPECT_EQ(0, cvtest::norm(src, img, NORM_INF));
+        ASSERT_EQ(contours0.size(), contours1.size()) << "iter = " << iter;
+        for (size_t i = 0; i < contours0.size(); i++)
+            ASSERT_EQ(contours0[i], contours1[i]) << "iter = " << iter << ", contour = " << i;
+        ASSERT_EQ(hierarchy0, hierarchy1) << "iter = " << iter;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_FindContours_Parallel,
+    testing::Combine(
+        testing::Values(RETR_EXTERNAL, RETR_LIST, RETR_CCOMP, RETR_TREE),
+        testing::Values(CHAIN_APPROX_NONE, CHAIN_APPROX_SIMPLE, CHAIN_APPROX_TC89_L1, CHAIN_APPROX_TC89_KCOS)));
+
 TEST(Imgproc_PointPolygonTest, regression_10222)
 {
     vector<Point> contour;
@@ -2490,5 +2490,109 @@ TEST(Imgproc_minEnclosingTriangle, regression_mat_with_diff_channels)
     EXPECT_NO_THROW(minEnclosingTriangle(pointsNx1, triangle));
 }
 
+static void checkContourDescriptors(const std::vector<Mat>& contours, bool closed)
+{
+    Mat areas, lengths, rects, moms, minRects;
+    cv::contourDescriptors(contours, areas, lengths, rects, moms, minRects, closed);
+    const int n = (int)contours.size();
+    ASSERT_EQ(Size(n, 1), areas.size());
+    ASSERT_EQ(Size(n, 1), lengths.size());
+    ASSERT_EQ(Size(n, 4), rects.size());
+    ASSERT_EQ(Size(n, 10), moms.size());
+    ASSERT_EQ(Size(n, 5), minRects.size());
+
+    for (int i = 0; i < n; i++)
+    {
+        const Mat& c = contours[i];
+        if (c.empty())
+        {
+            EXPECT_EQ(0., areas.at<double>(i));
+            EXPECT_EQ(0., lengths.at<double>(i));
+            EXPECT_EQ(0, rects.at<int>(2, i));
+            EXPECT_EQ(0., moms.at<double>(0, i));
+            continue;
+        }
+        EXPECT_NEAR(cv::contourArea(c), areas.at<double>(i), 1e-12 * std::max(1., areas.at<double>(i))) << i;
+        EXPECT_NEAR(cv::arcLength(c, closed), lengths.at<double>(i), 1e-12 * std::max(1., lengths.at<double>(i))) << i;
+
+        Rect r = cv::boundingRect(c);
+        EXPECT_EQ(r, Rect(rects.at<int>(0, i), rects.at<int>(1, i), rects.at<int>(2, i), rects.at<int>(3, i))) << i;
+
+        Moments m = cv::moments(c);
+        const double ref[] = { m.m00, m.m10, m.m01, m.m20, m.m11, m.m02, m.m30, m.m21, m.m12, m.m03 };
+        for (int j = 0; j < 10; j++)
+            EXPECT_NEAR(ref[j], moms.at<double>(j, i), 1e-10 * std::max(1., std::fabs(ref[j]))) << i << " " << j;
+
+        RotatedRect rr = cv::minAreaRect(c);
+        EXPECT_EQ(rr.center.x, minRects.at<float>(0, i)) << i;
+        EXPECT_EQ(rr.center.y, minRects.at<float>(1, i)) << i;
+        EXPECT_EQ(rr.size.width, minRects.at<float>(2, i)) << i;
+        EXPECT_EQ(rr.size.height, minRects.at<float>(3, i)) << i;
+        EXPECT_EQ(rr.angle, minRects.at<float>(4, i)) << i;
+    }
+
+    // only some of the descriptors, the same values
+    Mat areas2, moms2;
+    cv::contourDescriptors(contours, areas2, noArray(), noArray(), moms2);
+    EXPECT_LE(cvtest::norm(areas, areas2, NORM_INF), 1e-12 * std::max(1., cvtest::norm(areas, NORM_INF)));
+    EXPECT_EQ(0, cvtest::norm(moms, moms2, NORM_INF));
+}
+
+TEST(Imgproc_ContourDescriptors, same_as_single_contour_functions)
+{
+    const int prevThreads = getNumThreads();
+    setNumThreads(4);
+
+    Mat img(480, 640, CV_8UC1, Scalar(0));
+    RNG& rng = theRNG();
+    for (int i = 0; i < 150; i++)
+        ellipse(img, Point(rng.uniform(0, 640), rng.uniform(0, 480)), Size(rng.uniform(1, 40), rng.uniform(1, 40)),
+                rng.uniform(0, 180), 0, 360, Scalar(rng.uniform(0, 2) * 255), -1);
+
+    for (int approx = CHAIN_APPROX_NONE; approx <= CHAIN_APPROX_SIMPLE; approx++)
+    {
+        std::vector<std::vector<Point> > found;
+        findContours(img, found, RETR_LIST, approx);
+        ASSERT_GT(found.size(), 20u);
+        std::vector<Mat> contours(found.size());
+        for (size_t i = 0; i < found.size(); i++)
+            contours[i] = Mat(found[i], true);
+        checkContourDescriptors(contours, true);
+        checkContourDescriptors(contours, false);
+    }
+
+    // float points, single points, empty contours
+    std::vector<Mat> contours;
+    for (int i = 0; i < 40; i++)
+    {
+        Mat c(rng.uniform(1, 60), 1, CV_32FC2);
+        rng.fill(c, RNG::UNIFORM, -300, 300);
+        contours.push_back(c);
+    }
+    contours.push_back(Mat(1, 1, CV_32SC2, Scalar(5, -7)));
+    contours.push_back(Mat(0, 1, CV_32SC2));
+    checkContourDescriptors(contours, true);
+
+    setNumThreads(prevThreads);
+}
+
+TEST(Imgproc_ContourDescriptors, single_contour_and_empty_list)
+{
+    std::vector<Point> square;
+    square.push_back(Point(0, 0));
+    square.push_back(Point(10, 0));
+    square.push_back(Point(10, 10));
+    square.push_back(Point(0, 10));
+    Mat areas, rects;
+    cv::contourDescriptors(square, areas, noArray(), rects);
+    ASSERT_EQ(1, areas.cols);
+    EXPECT_EQ(100., areas.at<double>(0));
+    EXPECT_EQ(11, rects.at<int>(2, 0));
+
+    std::vector<std::vector<Point> > none;
+    cv::contourDescriptors(none, areas, noArray(), rects);
+    EXPECT_TRUE(areas.empty());
+    EXPECT_TRUE(rects.empty());
+}
+
 }} // namespace
-/* End of file. */
@@ -0,0 +1,123 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "test_precomp.hpp"
+
+namespace opencv_test { namespace {
+
+// reference: crop, resize, swap channels and normalize one region, in NCHW order
+static Mat cropResizeRef(const Mat& src, const Rect& r, Size size, const Scalar& mean, const Scalar& scale, bool swapRB)
+{
+    Mat patch, fpatch;
+    cv::resize(src(r), patch, size, 0, 0, INTER_LINEAR);
+    patch.convertTo(fpatch, CV_32F);
+    std::vector<Mat> planes;
+    cv::split(fpatch, planes);
+    if (swapRB && planes.size() >= 3)
+        std::swap(planes[0], planes[2]);
+    for (size_t c = 0; c < planes.size(); c++)
+        planes[c] = (planes[c] - mean[(int)c])*scale[(int)c];
+    Mat ref;
+    cv::vconcat(planes, ref);
+    return ref.reshape(1, 1);
+}
+
+typedef testing::TestWithParam<tuple<int, int> > Imgproc_CropResizeBatch_Resize;
+
+TEST_P(Imgproc_CropResizeBatch_Resize, axis_aligned)
+{
+    const int type = get<0>(GetParam());
+    const int layout = get<1>(GetParam());
+    const int cn = CV_MAT_CN(type);
+
+    Mat noise(480, 640, CV_32FC(cn)), src;
+    theRNG().fill(noise, RNG::UNIFORM, 0, 255);
+    cv::GaussianBlur(noise, noise, Size(0, 0), 3);
+    noise.convertTo(src, type);
+
+    std::vector<Rect> rois;
+    RNG& rng = theRNG();
+    for (int i = 0; i < 50; i++)
+    {
+        Rect r(rng.uniform(0, 600), rng.uniform(0, 440), rng.uniform(2, 300), rng.uniform(2, 300));
+        rois.push_back(r & Rect(0, 0, src.cols, src.rows));
+    }
+    const Size size(37, 24);
+    const Scalar mean(104, 117, 123, 10), scale(0.017, 0.018, 0.019, 0.02);
+
+    Mat blob;
+    cropResizeBatch(src, rois, blob, size, mean, scale, true, INTER_LINEAR, layout);
+    ASSERT_EQ(4, blob.dims);
+    ASSERT_EQ(CV_32F, blob.type());
+    ASSERT_EQ((int)rois.size(), blob.size[0]);
+
+    for (size_t i = 0; i < rois.size(); i++)
+    {
+        Mat ref = cropResizeRef(src, rois[i], size, mean, scale, true);
+        Mat item(1, (int)ref.total(), CV_32F, blob.ptr<float>((int)i));
+        if (layout == CROP_RESIZE_LAYOUT_NHWC)
+        {
+            // NHWC item is the transposed NCHW item
+            Mat t;
+            cv::transpose(Mat(size.area(), cn, CV_32F, item.data), t);
+            item = t.reshape(1, 1);
+        }
+        EXPECT_LE(cvtest::norm(ref, item, NORM_INF), 1e-5) << "roi " << rois[i];
+    }
+
+    // the same regions through the generic fixed-point sampler:
+    // positions are rounded to 1/32 of a pixel, resize weights to 1/2048
+    std::vector<RotatedRect> rrois;
+    for (const Rect& r : rois)
+        rrois.push_back(RotatedRect(Point2f(r.x + r.width*0.5f, r.y + r.height*0.5f), Size2f(r.size()), 360.f));
+    Mat blob2;
+    cropResizeBatch(src, rrois, blob2, size, mean, scale, true, INTER_LINEAR, layout);
+    EXPECT_LE(cvtest::norm(blob, blob2, NORM_INF), 0.02);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_CropResizeBatch_Resize,
+    testing::Combine(
+        testing::Values(CV_8UC1, CV_8UC3, CV_16UC4, CV_32FC3),
+        testing::Values((int)CROP_RESIZE_LAYOUT_NCHW, (int)CROP_RESIZE_LAYOUT_NHWC)
+    )
+);
+
+TEST(Imgproc_CropResizeBatch, rotated_90)
+{
+    Mat src(100, 120, CV_8UC1);
+    theRNG().fill(src, RNG::UNIFORM, 0, 256);
+    Rect r(17, 23, 40, 30);
+    Mat ref;
+    cv::rotate(src(r), ref, ROTATE_90_COUNTERCLOCKWISE);
+
+    std::vector<RotatedRect> rois(1, RotatedRect(Point2f(r.x + r.width*0.5f, r.y + r.height*0.5f),
+                                                 Size2f((float)r.height, (float)r.width), 90.f));
+    for (int interpolation : { INTER_LINEAR, INTER_NEAREST })
+    {
+        Mat blob, ref32f;
+        cropResizeBatch(src, rois, blob, ref.size(), Scalar(), Scalar::all(1), false, interpolation);
+        ref.convertTo(ref32f, CV_32F);
+        EXPECT_EQ(0, cvtest::norm(ref32f.reshape(1, 1), Mat(1, (int)ref.total(), CV_32F, blob.data), NORM_INF));
+    }
+}
+
+TEST(Imgproc_CropResizeBatch, border_and_empty)
+{
+    Mat src(50, 60, CV_8UC3, Scalar(10, 20, 30));
+    std::vector<Rect> rois(1, Rect(-20, -20, 200, 200));
+    Mat blob;
+    cropResizeBatch(src, rois, blob, Size(8, 8), Scalar(), Scalar::all(1), false, INTER_LINEAR, CROP_RESIZE_LAYOUT_NHWC);
+    for (int i = 0; i < 8*8; i++)
+    {
+        const float* p = blob.ptr<float>() + i*3;
+        ASSERT_EQ(10.f, p[0]);
+        ASSERT_EQ(20.f, p[1]);
+        ASSERT_EQ(30.f, p[2]);
+    }
+
+    cropResizeBatch(src, std::vector<Rect>(), blob, Size(8, 8));
+    EXPECT_EQ(0u, blob.total());
+}
+
+}} // namespace
@@ -416,4 +416,63 @@ TEST(Imgproc_DistanceTransform, precise_long_dist)
     EXPECT_EQ(cv::norm(expected, dist, NORM_INF), 0);
 }
 
+TEST(Imgproc_DistanceTransform, precise_labels)
+{
+    Mat src(311, 517, CV_8U), dist0, dist, labels, ccomp;
+    randu(src, 0, 256);
+    src = src > 3;
+    distanceTransform(src, dist0, DIST_L2, DIST_MASK_PRECISE, CV_32F);
+    distanceTransform(src, dist, labels, DIST_L2, DIST_MASK_PRECISE, DIST_LABEL_PIXEL);
+    EXPECT_EQ(cv::norm(dist0, dist, NORM_INF), 0);
+
+    std::vector<Point> zeros;
+    for (int y = 0; y < src.rows; y++)
+        for (int x = 0; x < src.cols; x++)
+            if (src.at<uchar>(y, x) == 0)
+                zeros.push_back(Point(x, y));
+
+    int nerrs = 0;
+    for (int y = 0; y < src.rows; y++)
+        for (int x = 0; x < src.cols; x++)
+        {
+            int l = labels.at<int>(y, x);
+            ASSERT_TRUE(l >= 1 && l <= (int)zeros.size());
+            Point p = zeros[l - 1];
+            double d0 = std::sqrt((double)(x - p.x)*(x - p.x) + (double)(y - p.y)*(y - p.y));
+            if (std::abs(d0 - dist.at<float>(y, x)) > 1e-3)
+                nerrs++;
+        }
+    EXPECT_EQ(0, nerrs);
+
+    // DIST_LABEL_CCOMP picks the same zero pixels
+    Mat comp;
+    connectedComponents(src == 0, comp, 8, CV_32S, CCL_WU);
+    distanceTransform(src, dist, ccomp, DIST_L2, DIST_MASK_PRECISE, DIST_LABEL_CCOMP);
+    EXPECT_EQ(cv::norm(dist0, dist, NORM_INF), 0);
+    nerrs = 0;
+    for (int y = 0; y < src.rows; y++)
+        for (int x = 0; x < src.cols; x++)
+            if (ccomp.at<int>(y, x) != comp.at<int>(zeros[labels.at<int>(y, x) - 1]))
+                nerrs++;
+    EXPECT_EQ(0, nerrs);
+}
+
+TEST(Imgproc_DistanceTransform, precise_thread_invariant)
+{
+    Mat src(1000, 1999, CV_8U);
+    randu(src, 0, 256);
+    src = src > 1;
+
+    int nthreads = getNumThreads();
+    Mat dist1, labels1, dist4, labels4;
+    setNumThreads(1);
+    distanceTransform(src, dist1, labels1, DIST_L2, DIST_MASK_PRECISE, DIST_LABEL_PIXEL);
+    setNumThreads(4);
+    distanceTransform(src, dist4, labels4, DIST_L2, DIST_MASK_PRECISE, DIST_LABEL_PIXEL);
+    setNumThreads(nthreads);
+
+    EXPECT_EQ(cv::norm(dist1, dist4, NORM_INF), 0);
+    EXPECT_EQ(cv::norm(labels1, labels4, NORM_INF), 0);
+}
+
 }} // namespace
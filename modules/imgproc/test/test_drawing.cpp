@@ -928,4 +928,104 @@ TEST(Drawing, circle_memory_access)
     cv::circle(matrix, cv::Point(-1, -1), 0, kBlue, 2, 8, 16);
 }
 
+typedef testing::TestWithParam<tuple<MatType, int> > Drawing_DrawList_Compare;
+
+TEST_P(Drawing_DrawList_Compare, same_as_drawing_functions)
+{
+    const int type = get<0>(GetParam()), lineType = get<1>(GetParam());
+    const int prevThreads = getNumThreads();
+    setNumThreads(4);
+
+    RNG& rng = theRNG();
+    Mat ref(373, 411, type, Scalar::all(0)), img = ref.clone();
+    Ptr<DrawList> list = createDrawList();
+
+    for (int i = 0; i < 60; i++)
+    {
+        // shapes cross the image borders and the row bands
+        Point p1(rng.uniform(-60, 470), rng.uniform(-60, 430)), p2(rng.uniform(-60, 470), rng.uniform(-60, 430));
+        Scalar color(rng.uniform(0, 256), rng.uniform(0, 256), rng.uniform(0, 256));
+        int thickness = rng.uniform(1, 12), shift = rng.uniform(0, 3);
+        Point ps(p1.x << shift, p1.y << shift), ps2(p2.x << shift, p2.y << shift);
+        std::vector<std::vector<Point> > poly(2);
+        for (int k = 0; k < 5; k++)
+        {
+            poly[0].push_back(Point(rng.uniform(-40, 450), rng.uniform(-40, 410)));
+            poly[1].push_back(Point(rng.uniform(-40, 450), rng.uniform(-40, 410)));
+        }
+
+        switch (i % 7)
+        {
+        case 0:
+            cv::line(ref, ps, ps2, color, thickness, lineType, shift);
+            list->addLine(ps, ps2, color, thickness, lineType, shift);
+            break;
+        case 1:
+            cv::rectangle(ref, Rect(p1, p2), color, i % 2 ? -1 : thickness, lineType);
+            list->addRectangle(Rect(p1, p2), color, i % 2 ? -1 : thickness, lineType);
+            break;
+        case 2:
+        {
+            int radius = rng.uniform(0, 120) << shift;
+            cv::circle(ref, ps, radius, color, i % 3 == 0 ? -1 : thickness, lineType, shift);
+            list->addCircle(ps, radius, color, i % 3 == 0 ? -1 : thickness, lineType, shift);
+            break;
+        }
+        case 3:
+            cv::polylines(ref, poly, i % 2 == 0, color, thickness, lineType);
+            list->addPolylines(poly, i % 2 == 0, color, thickness, lineType);
+            break;
+        case 4:
+            cv::fillPoly(ref, poly, color, lineType, 0, Point(3, -5));
+            list->addFillPoly(poly, color, lineType, 0, Point(3, -5));
+            break;
+        case 5:
+            cv::putText(ref, "DrawList 0123", p1, i % 8, 0.5 + (i % 4), color, thickness % 4 + 1, lineType, i % 2 == 0);
+            list->addText("DrawList 0123", p1, i % 8, 0.5 + (i % 4), color, thickness % 4 + 1, lineType, i % 2 == 0);
+            break;
+        case 6:
+            cv::line(ref, p1, p2, color, 1, lineType);
+            list->addLine(p1, p2, color, 1, lineType);
+            break;
+        }
+    }
+    list->render(img);
+    EXPECT_EQ(0, cvtest::norm(ref, img, NORM_INF));
+
+    setNumThreads(prevThreads);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Drawing_DrawList_Compare, testing::Combine(
+    testing::Values(CV_8UC1, CV_8UC3, CV_16UC1),
+    testing::Values((int)LINE_4, (int)LINE_8, (int)LINE_AA)));
+
+TEST(Drawing, DrawList_rerender_and_clear)
+{
+    Ptr<DrawList> list = createDrawList();
+    list->addRectangle(Rect(10, 10, 200, 100), Scalar(255, 0, 0), -1);
+    list->addCircle(Point(50, 50), 30, Scalar(0, 255, 0), 2, LINE_AA);
+    list->addText("", Point(0, 0), FONT_HERSHEY_SIMPLEX, 1, Scalar::all(255));
+    list->addPolylines(std::vector<std::vector<Point> >(1), true, Scalar::all(255));
+    EXPECT_EQ(3, list->getPrimitiveCount());
+
+    Mat ref8(120, 240, CV_8UC3, Scalar::all(7)), ref32(ref8.size(), CV_32FC1, Scalar::all(7));
+    cv::rectangle(ref8, Rect(10, 10, 200, 100), Scalar(255, 0, 0), -1);
+    cv::circle(ref8, Point(50, 50), 30, Scalar(0, 255, 0), 2, LINE_AA);
+    cv::rectangle(ref32, Rect(10, 10, 200, 100), Scalar(255, 0, 0), -1);
+    cv::circle(ref32, Point(50, 50), 30, Scalar(0, 255, 0), 2, LINE_AA);
+
+    // the same list on images of different types
+    Mat img8(ref8.size(), CV_8UC3, Scalar::all(7)), img32(ref8.size(), CV_32FC1, Scalar::all(7));
+    list->render(img8);
+    list->render(img32);
+    EXPECT_EQ(0, cvtest::norm(ref8, img8, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(ref32, img32, NORM_INF));
+
+    list->clear();
+    EXPECT_EQ(0, list->getPrimitiveCount());
+    Mat copy = img8.clone();
+    list->render(img8);
+    EXPECT_EQ(0, cvtest::norm(copy, img8, NORM_INF));
+}
+
 }} // namespace
@@ -2055,6 +2055,69 @@ TEST(Imgproc_Morphology, iterated)
     }
 }
 
+TEST(Imgproc_Morphology, large_rect_kernels)
+{
+    const int types[] = { CV_8U, CV_16U, CV_16S, CV_32F, CV_64F };
+    const int borders[] = { BORDER_CONSTANT, BORDER_REPLICATE, BORDER_REFLECT, BORDER_REFLECT_101 };
+    const Size ksizes[] = { Size(51, 51), Size(101, 1), Size(1, 40), Size(3, 17), Size(20, 5) };
+    RNG& rng = theRNG();
+    int nthreads = getNumThreads();
+    for( int iter = 0; iter < 40; iter++ )
+    {
+        int type = CV_MAKETYPE(types[iter % 5], rng.uniform(1, 5));
+        Size ksize = ksizes[rng.uniform(0, 5)];
+        Point anchor(rng.uniform(0, ksize.width), rng.uniform(0, ksize.height));
+        int borderType = borders[rng.uniform(0, 4)];
+        Scalar borderValue = rng.uniform(0, 2) ? morphologyDefaultBorderValue() : Scalar::all(rng.uniform(0, 100));
+        int op = rng.uniform(0, 2) ? MORPH_ERODE : MORPH_DILATE;
+        Mat big(rng.uniform(10, 90), rng.uniform(10, 90), type);
+        randu(big, 0, 255);
+        Mat src = big(Rect(2, 3, big.cols - 5, big.rows - 4));
+
+        // reference: min/max over all kernel shifts of the bordered image;
+        // like FilterEngine, the border is interpolated over the whole image
+        Mat dst0, dst1;
+        Scalar padValue = borderValue;
+        if( borderValue == morphologyDefaultBorderValue() )
+        {
+            const double maxVal[] = { UCHAR_MAX, 0, USHRT_MAX, SHRT_MAX, 0, FLT_MAX, DBL_MAX };
+            const double minVal[] = { 0, 0, 0, SHRT_MIN, 0, -FLT_MAX, -DBL_MAX };
+            padValue = Scalar::all(op == MORPH_ERODE ? maxVal[CV_MAT_DEPTH(type)] : minVal[CV_MAT_DEPTH(type)]);
+        }
+        Mat padded(src.rows + ksize.height - 1, src.cols + ksize.width - 1, type, padValue);
+        size_t esz = big.elemSize();
+        for( int y = 0; y < padded.rows; y++ )
+            for( int x = 0; x < padded.cols; x++ )
+            {
+                int sy = borderInterpolate(3 + y - anchor.y, big.rows, borderType);
+                int sx = borderInterpolate(2 + x - anchor.x, big.cols, borderType);
+                if( sy >= 0 && sx >= 0 )
+                    memcpy(padded.ptr(y) + x*esz, big.ptr(sy) + sx*esz, esz);
+            }
+        dst0 = padded(Rect(0, 0, src.cols, src.rows)).clone();
+        for( int dy = 0; dy < ksize.height; dy++ )
+            for( int dx = 0; dx < ksize.width; dx++ )
+            {
+                Mat shifted = padded(Rect(dx, dy, src.cols, src.rows));
+                if( op == MORPH_ERODE )
+                    cv::min(dst0, shifted, dst0);
+                else
+                    cv::max(dst0, shifted, dst0);
+            }
+
+        setNumThreads(iter % 2 ? std::max(nthreads, 4) : 1);
+        Mat kernel = getStructuringElement(MORPH_RECT, ksize);
+        morphologyEx(src, dst1, op, kernel, anchor, 1, borderType, borderValue);
+        // in-place processing of a submatrix
+        Mat big2 = big.clone(), dst2 = big2(Rect(2, 3, big.cols - 5, big.rows - 4));
+        morphologyEx(dst2, dst2, op, kernel, anchor, 1, borderType, borderValue);
+        setNumThreads(nthreads);
+        ASSERT_EQ(0.0, cvtest::norm(dst0, dst1, NORM_INF))
+            << "type=" << type << " ksize=" << ksize << " anchor=" << anchor << " border=" << borderType;
+        ASSERT_EQ(0.0, cvtest::norm(dst0, dst2, NORM_INF));
+    }
+}
+
 TEST(Imgproc_Sobel, borderTypes)
 {
     int kernelSize = 3;
@@ -2292,6 +2355,79 @@ TEST(Imgproc_MedianBlur, hires_regression_13409)
     ASSERT_EQ(0.0, cvtest::norm(dst_hires(Rect(516, 516, 1016, 1016)), dst_ref(Rect(4, 4, 1016, 1016)), NORM_INF));
 }
 
+static void medianBlurRef(const Mat& src, Mat& dst, int ksize)
+{
+    Mat src64, dst64(src.size(), CV_64FC(src.channels()));
+    src.convertTo(src64, CV_64F);
+    int r = ksize/2, cn = src.channels();
+    std::vector<double> buf(ksize*ksize);
+    for (int y = 0; y < src.rows; y++)
+        for (int x = 0; x < src.cols; x++)
+            for (int c = 0; c < cn; c++)
+            {
+                int n = 0;
+                for (int i = -r; i <= r; i++)
+                    for (int j = -r; j <= r; j++)
+                        buf[n++] = src64.ptr<double>(std::min(std::max(y + i, 0), src.rows - 1))
+                                   [std::min(std::max(x + j, 0), src.cols - 1)*cn + c];
+                std::nth_element(buf.begin(), buf.begin() + n/2, buf.end());
+                dst64.ptr<double>(y)[x*cn + c] = buf[n/2];
+            }
+    dst64.convertTo(dst, src.type());
+}
+
+typedef testing::TestWithParam<tuple<MatType, int> > Imgproc_MedianBlur_Large;
+
+TEST_P(Imgproc_MedianBlur_Large, accuracy)
+{
+    const int type = get<0>(GetParam()), ksize = get<1>(GetParam());
+    const int prevThreads = getNumThreads();
+    setNumThreads(4);
+
+    Mat src(123, 87, type), ref, dst;
+    if (CV_MAT_DEPTH(type) == CV_32F)
+        randu(src, -1000, 1000);
+    else if (CV_MAT_DEPTH(type) == CV_16S)
+        randu(src, -32768, 32768);
+    else
+        randu(src, 0, 65536);
+    // quantized values produce many ties between neighbours
+    src(Rect(0, 0, src.cols, 40)) /= 97;
+    if (CV_MAT_DEPTH(type) == CV_32F)
+        src.at<float>(5, 5) = -0.f;
+
+    medianBlurRef(src, ref, ksize);
+    medianBlur(src, dst, ksize);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+
+    // in-place
+    src.copyTo(dst);
+    medianBlur(dst, dst, ksize);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+
+    setNumThreads(prevThreads);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_MedianBlur_Large, testing::Combine(
+    testing::Values(CV_16UC1, CV_16SC1, CV_16UC3, CV_32FC1, CV_32FC4),
+    testing::Values(7, 11, 15)));
+
+TEST(Imgproc_MedianBlur, parallel_8u_bands)
+{
+    Mat src(301, 517, CV_8UC3), dst1, dst4;
+    randu(src, 0, 256);
+    const int prevThreads = getNumThreads();
+    for (int ksize = 7; ksize <= 31; ksize += 12)
+    {
+        setNumThreads(1);
+        medianBlur(src, dst1, ksize);
+        setNumThreads(4);
+        medianBlur(src, dst4, ksize);
+        EXPECT_EQ(0, cvtest::norm(dst1, dst4, NORM_INF)) << "ksize=" << ksize;
+    }
+    setNumThreads(prevThreads);
+}
+
 TEST(Imgproc_Sobel, s16_regression_13506)
 {
     Mat src = (Mat_<short>(8, 16) << 127, 138, 130, 102, 118,  97,  76,  84, 124,  90, 146,  63, 130,  87, 212,  85,
@@ -2323,6 +2459,49 @@ TEST(Imgproc_Pyrdown, issue_12961)
     ASSERT_EQ(0.0, cv::norm(dst));
 }
 
+TEST(Imgproc_BuildPyramid, same_as_pyrDown)
+{
+    const int depths[] = { CV_8U, CV_16U, CV_16S, CV_32F, CV_64F };
+    const int borders[] = { BORDER_REFLECT_101, BORDER_REFLECT, BORDER_REPLICATE };
+    const Size sizes[] = { Size(1, 1), Size(7, 3), Size(133, 97), Size(640, 481) };
+    const int prevThreads = getNumThreads();
+    RNG& rng = theRNG();
+    for (int depth : depths)
+    for (int cn = 1; cn <= 4; cn++)
+    for (const Size& sz : sizes)
+    for (int border : borders)
+    {
+        Mat src(sz, CV_MAKETYPE(depth, cn));
+        cvtest::randUni(rng, src, Scalar::all(0), Scalar::all(depth == CV_16S ? 100 : 255));
+        const int maxlevel = 5;
+        std::vector<Mat> ref(maxlevel + 1);
+        ref[0] = src;
+        for (int i = 1; i <= maxlevel; i++)
+            cv::pyrDown(ref[i-1], ref[i], Size(), border);
+
+        for (int nthreads = 1; nthreads <= 4; nthreads += 3)
+        {
+            setNumThreads(nthreads);
+            std::vector<Mat> pyr;
+            cv::buildPyramid(src, pyr, maxlevel, border);
+            ASSERT_EQ((size_t)maxlevel + 1, pyr.size());
+            for (int i = 0; i <= maxlevel; i++)
+            {
+                ASSERT_EQ(ref[i].size(), pyr[i].size());
+                EXPECT_EQ(0, cvtest::norm(ref[i], pyr[i], NORM_INF))
+                    << "depth=" << depth << " cn=" << cn << " size=" << sz << " border=" << border
+                    << " threads=" << nthreads << " level=" << i;
+            }
+            // the levels are reused by a second call
+            const uchar* data1 = pyr[1].data;
+            cv::buildPyramid(src, pyr, maxlevel, border);
+            EXPECT_EQ(data1, pyr[1].data);
+            EXPECT_EQ(0, cvtest::norm(ref[maxlevel], pyr[maxlevel], NORM_INF));
+        }
+    }
+    setNumThreads(prevThreads);
+}
+
 
 // https://github.com/opencv/opencv/issues/16857
 TEST(Imgproc, filter_empty_src_16857)
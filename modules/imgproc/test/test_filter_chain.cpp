@@ -0,0 +1,100 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "test_precomp.hpp"
+
+namespace opencv_test { namespace {
+
+static void gaussianRef(const Mat& src, Mat& dst, Size ksize, double sigma, int borderType)
+{
+    Mat kx = getGaussianKernel(ksize.width, sigma, std::max(src.depth(), CV_32F));
+    Mat ky = getGaussianKernel(ksize.height, sigma, std::max(src.depth(), CV_32F));
+    cv::sepFilter2D(src, dst, -1, kx, ky, Point(-1, -1), 0, borderType);
+}
+
+typedef testing::TestWithParam<tuple<MatType, int, int> > Imgproc_FilterChain_Compare;
+
+TEST_P(Imgproc_FilterChain_Compare, same_as_separate_calls)
+{
+    const int type = get<0>(GetParam()), borderType = get<1>(GetParam()), nthreads = get<2>(GetParam());
+    const int prevThreads = getNumThreads();
+    setNumThreads(nthreads);
+
+    Mat src(317, 245, type);
+    theRNG().fill(src, RNG::UNIFORM, 0, 255);
+
+    // blur, gradient magnitude
+    Mat blurred, gx, gy, mag;
+    gaussianRef(src, blurred, Size(5, 5), 1.2, borderType);
+    cv::Sobel(blurred, gx, CV_32F, 1, 0, 3, 1, 0, borderType);
+    cv::Sobel(blurred, gy, CV_32F, 0, 1, 3, 1, 0, borderType);
+    cv::magnitude(gx.reshape(1), gy.reshape(1), mag);
+    mag = mag.reshape(src.channels());
+
+    Ptr<FilterChain> chain = createFilterChain(borderType);
+    chain->addGaussianBlur(Size(5, 5), 1.2);
+    chain->addGradientMagnitude(3, true);
+    EXPECT_EQ(2, chain->getStageCount());
+    Mat dst;
+    chain->apply(src, dst);
+    ASSERT_EQ(mag.type(), dst.type());
+    EXPECT_LE(cvtest::norm(mag, dst, NORM_INF | NORM_RELATIVE), 1e-5);
+
+    // blur, derivative, scaling, threshold
+    Mat d16, d8, ref;
+    cv::Sobel(blurred, d16, CV_16S, 0, 1, 5, 0.5, 3, borderType);
+    d16.convertTo(d8, CV_8U, 0.25, 128);
+    cv::threshold(d8, ref, 140, 200, THRESH_TOZERO);
+
+    chain->clear();
+    EXPECT_EQ(0, chain->getStageCount());
+    chain->addGaussianBlur(Size(5, 5), 1.2);
+    chain->addSobel(CV_16S, 0, 1, 5, 0.5, 3);
+    chain->addConvertTo(CV_8U, 0.25, 128);
+    chain->addThreshold(140, 200, THRESH_TOZERO);
+    chain->apply(src, dst);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+
+    setNumThreads(prevThreads);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_FilterChain_Compare, testing::Combine(
+    testing::Values(CV_8UC1, CV_8UC3, CV_16SC1, CV_32FC1),
+    testing::Values((int)BORDER_CONSTANT, (int)BORDER_REPLICATE, (int)BORDER_REFLECT_101),
+    testing::Values(1, 4)));
+
+TEST(Imgproc_FilterChain, small_images_and_sep_filter)
+{
+    const int prevThreads = getNumThreads();
+    setNumThreads(4);
+
+    Mat kx = (Mat_<float>(1, 7) << 1, -2, 3, 0.5f, 3, -2, 1), ky = (Mat_<float>(5, 1) << 0.1f, 0.2f, 0.4f, 0.2f, 0.1f);
+    Ptr<FilterChain> chain = createFilterChain(BORDER_REFLECT);
+    chain->addSepFilter2D(CV_32F, kx, ky, 1.5);
+    chain->addGaussianBlur(Size(0, 0), 2.0);
+    chain->addGradientMagnitude(1, false);
+
+    for (int rows = 1; rows <= 40; rows += 13)
+    {
+        Mat src(rows, 50, CV_8UC1), f, g, gx, gy, ref, dst;
+        theRNG().fill(src, RNG::UNIFORM, 0, 255);
+        cv::sepFilter2D(src, f, CV_32F, kx, ky, Point(-1, -1), 1.5, BORDER_REFLECT);
+        gaussianRef(f, g, Size(17, 17), 2.0, BORDER_REFLECT);
+        cv::Sobel(g, gx, CV_32F, 1, 0, 1, 1, 0, BORDER_REFLECT);
+        cv::Sobel(g, gy, CV_32F, 0, 1, 1, 1, 0, BORDER_REFLECT);
+        ref = cv::abs(gx) + cv::abs(gy);
+
+        chain->apply(src, dst);
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF | NORM_RELATIVE), 1e-5) << "rows=" << rows;
+    }
+
+    // an empty chain copies the image
+    Mat src(10, 10, CV_8UC3, Scalar(1, 2, 3)), dst;
+    createFilterChain()->apply(src, dst);
+    EXPECT_EQ(0, cvtest::norm(src, dst, NORM_INF));
+
+    setNumThreads(prevThreads);
+}
+
+}} // namespace
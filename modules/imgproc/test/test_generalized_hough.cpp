@@ -0,0 +1,100 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "test_precomp.hpp"
+
+namespace opencv_test { namespace {
+
+static void drawArrow(Mat& img, Point2d center, double angle, double scale)
+{
+    static const Point2d pts[] = { Point2d(-20, -12), Point2d(10, -12), Point2d(10, -22), Point2d(28, 0),
+                                   Point2d(10, 22), Point2d(10, 12), Point2d(-20, 12), Point2d(-26, 0) };
+    const double a = angle * CV_PI / 180, ca = cos(a), sa = sin(a);
+    std::vector<Point> poly;
+    for (size_t i = 0; i < sizeof(pts) / sizeof(pts[0]); i++)
+        poly.push_back(Point(cvRound(center.x + scale * (ca * pts[i].x - sa * pts[i].y)),
+                             cvRound(center.y + scale * (sa * pts[i].x + ca * pts[i].y))));
+    cv::fillConvexPoly(img, poly, Scalar::all(255), LINE_AA);
+}
+
+class Imgproc_GeneralizedHough : public testing::TestWithParam<bool>
+{
+protected:
+    void SetUp() CV_OVERRIDE
+    {
+        templ = Mat::zeros(80, 80, CV_8UC1);
+        drawArrow(templ, Point2d(40, 40), 0, 1.0);
+        image = Mat::zeros(480, 640, CV_8UC1);
+        drawArrow(image, Point2d(200, 150), 0, 1.0);
+        drawArrow(image, Point2d(450, 300), 30, 1.0);
+        drawArrow(image, Point2d(150, 380), 0, 1.5);
+    }
+
+    Ptr<GeneralizedHough> create() const
+    {
+        if (!GetParam())
+        {
+            Ptr<GeneralizedHoughBallard> ballard = cv::createGeneralizedHoughBallard();
+            ballard->setVotesThreshold(20);
+            return ballard;
+        }
+        Ptr<GeneralizedHoughGuil> guil = cv::createGeneralizedHoughGuil();
+        guil->setLevels(360);
+        guil->setDp(2);
+        guil->setMaxBufferSize(1000);
+        guil->setAngleStep(1);
+        guil->setAngleThresh(1500);
+        guil->setMinScale(0.5);
+        guil->setMaxScale(2);
+        guil->setScaleStep(0.05);
+        guil->setScaleThresh(50);
+        guil->setPosThresh(10);
+        return guil;
+    }
+
+    void detect(int threads, Mat& positions, Mat& votes) const
+    {
+        const int prevThreads = cv::getNumThreads();
+        cv::setNumThreads(threads);
+        Ptr<GeneralizedHough> hough = create();
+        hough->setMinDist(10);
+        hough->setTemplate(templ);
+        hough->detect(image, positions, votes);
+        cv::setNumThreads(prevThreads);
+    }
+
+    Mat templ, image;
+};
+
+TEST_P(Imgproc_GeneralizedHough, finds_template)
+{
+    Mat positions, votes;
+    detect(cv::getNumThreads(), positions, votes);
+
+    ASSERT_FALSE(positions.empty());
+    bool found = false;
+    for (int i = 0; i < positions.cols; i++)
+    {
+        Vec4f p = positions.at<Vec4f>(i);
+        if (std::abs(p[0] - 200) <= 3 && std::abs(p[1] - 150) <= 3)
+            found = true;
+    }
+    EXPECT_TRUE(found);
+}
+
+TEST_P(Imgproc_GeneralizedHough, thread_invariant)
+{
+    Mat positions1, votes1, positions4, votes4;
+    detect(1, positions1, votes1);
+    detect(4, positions4, votes4);
+
+    ASSERT_EQ(positions1.size(), positions4.size());
+    ASSERT_FALSE(positions1.empty());
+    EXPECT_EQ(0, cvtest::norm(positions1, positions4, NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(votes1, votes4, NORM_INF));
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_GeneralizedHough, testing::Bool());
+
+}} // namespace
@@ -2026,5 +2026,70 @@ TEST(Imgproc_Hist_Calc, IPP_ranges_with_nonequal_exponent_21595)
     ASSERT_EQ(histogram_u.at<float>(2), 4.f) << "1 not counts correctly, res: " << histogram_u.at<float>(2);
 }
 
+typedef testing::TestWithParam< tuple<int, bool> > Imgproc_Hist_Calc_Bins;
+
+TEST_P(Imgproc_Hist_Calc_Bins, parallel_accuracy)
+{
+    const int depth = get<0>(GetParam());
+    const bool uniform = get<1>(GetParam());
+    const int histSize[] = { 4096 };
+    const int channels[] = { 0 };
+
+    RNG& rng = theRNG();
+    Mat big(520, 650, depth);
+    if (depth == CV_16U)
+        rng.fill(big, RNG::UNIFORM, 0, 5000);
+    else
+        rng.fill(big, RNG::NORMAL, 0, 1);
+    Mat src = big(Rect(3, 5, 640, 512));
+    Mat mask(src.size(), CV_8UC1);
+    rng.fill(mask, RNG::UNIFORM, 0, 2);
+
+    std::vector<float> bounds(histSize[0] + 1);
+    const float lo = depth == CV_16U ? 10.f : -3.f, hi = depth == CV_16U ? 4106.f : 3.f;
+    for (int i = 0; i <= histSize[0]; i++)
+    {
+        double t = (double)i / histSize[0];
+        bounds[i] = (float)(lo + (hi - lo) * (uniform ? t : t * t));
+    }
+    float range[] = { lo, hi };
+    const float* ranges[] = { uniform ? range : &bounds[0] };
+
+    for (int withMask = 0; withMask < 2; withMask++)
+    {
+        Mat_<float> ref = Mat_<float>::zeros(histSize[0], 1);
+        const double a = histSize[0] / ((double)hi - lo), b = -a * lo;
+        for (int y = 0; y < src.rows; y++)
+            for (int x = 0; x < src.cols; x++)
+            {
+                if (withMask && !mask.at<uchar>(y, x))
+                    continue;
+                double v = depth == CV_16U ? (double)src.at<ushort>(y, x) : (double)src.at<float>(y, x);
+                if (v < bounds[0] || v >= bounds[histSize[0]])
+                    continue;
+                int idx = 0;
+                if (uniform)
+                    idx = std::min(std::max(cvFloor(v * a + b), 0), histSize[0] - 1);
+                else
+                    while ((float)v >= bounds[idx + 1])
+                        idx++;
+                ref(idx)++;
+            }
+
+        const int prevThreads = cv::getNumThreads();
+        for (int threads = 1; threads <= 4; threads += 3)
+        {
+            cv::setNumThreads(threads);
+            Mat hist;
+            cv::calcHist(&src, 1, channels, withMask ? mask : Mat(), hist, 1, histSize, ranges, uniform);
+            EXPECT_EQ(0, cvtest::norm(hist, ref, NORM_INF)) << "threads=" << threads << " mask=" << withMask;
+        }
+        cv::setNumThreads(prevThreads);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_Hist_Calc_Bins,
+                        testing::Combine(testing::Values(CV_16U, CV_32F), testing::Bool()));
+
 }} // namespace
 /* End Of File */
@@ -340,6 +340,37 @@ TEST(HoughLines, regression_21983)
     EXPECT_NEAR(lines[0][1], 1.57179642, 1e-4);
 }
 
+TEST(HoughLines, parallel_voting_is_deterministic)
+{
+    const int prevThreads = getNumThreads();
+    Mat img(480, 640, CV_8UC1, Scalar(0));
+    RNG& rng = theRNG();
+    for (int i = 0; i < 20; i++)
+        line(img, Point(rng.uniform(0, 640), rng.uniform(0, 480)), Point(rng.uniform(0, 640), rng.uniform(0, 480)), Scalar(255));
+    for (int i = 0; i < 3000; i++)
+        img.at<uchar>(rng.uniform(0, 480), rng.uniform(0, 640)) = 255;
+    line(img, Point(0, 200), Point(639, 200), Scalar(255));
+
+    std::vector<Vec3f> lines[2];
+    std::vector<Vec4i> segments[2];
+    for (int k = 0; k < 2; k++)
+    {
+        setNumThreads(k == 0 ? 1 : 4);
+        HoughLines(img, lines[k], 1, CV_PI/360, 60);
+        HoughLinesP(img, segments[k], 1, CV_PI/180, 50, 30, 3);
+    }
+    setNumThreads(prevThreads);
+
+    ASSERT_FALSE(lines[0].empty());
+    EXPECT_EQ(0, cvtest::norm(Mat(lines[0]).reshape(1), Mat(lines[1]).reshape(1), NORM_INF));
+    ASSERT_EQ(segments[0].size(), segments[1].size());
+    EXPECT_EQ(0, cvtest::norm(Mat(segments[0]).reshape(1), Mat(segments[1]).reshape(1), NORM_INF));
+
+    // the horizontal line is the strongest one
+    EXPECT_EQ(200.f, lines[0][0][0]);
+    EXPECT_NEAR(CV_PI/2, lines[0][0][1], 1e-5);
+}
+
 INSTANTIATE_TEST_CASE_P( ImgProc, StandartHoughLinesTest, testing::Combine(testing::Values( "shared/pic5.png", "../stitching/a1.png" ),
                                                                            testing::Values( 1, 10 ),
                                                                            testing::Values( 0.05, 0.1 ),
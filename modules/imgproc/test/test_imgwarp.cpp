@@ -1763,5 +1763,100 @@ TEST(Imgproc_Remap, issue_23562)
     }
 }
 
+typedef testing::TestWithParam<tuple<int, int, bool> > Imgproc_WarpPlan_Compare;
+
+TEST_P(Imgproc_WarpPlan_Compare, bitexact)
+{
+    const int type = get<0>(GetParam()), interpolation = get<1>(GetParam());
+    const bool packMaps = get<2>(GetParam());
+    const Size ssize(320, 240), dsize(300, 250);
+    RNG& rng = theRNG();
+    Mat src(ssize, type);
+    rng.fill(src, RNG::UNIFORM, 0, 255);
+
+    // a lens-like distortion that reads partly outside of the source
+    Mat mapx(dsize, CV_32FC1), mapy(dsize, CV_32FC1);
+    for (int y = 0; y < dsize.height; y++)
+        for (int x = 0; x < dsize.width; x++)
+        {
+            float u = (x - dsize.width*0.5f)/dsize.width, v = (y - dsize.height*0.5f)/dsize.height;
+            float k = 1.3f + 0.6f*(u*u + v*v);
+            mapx.at<float>(y, x) = ssize.width*(0.5f + u*k);
+            mapy.at<float>(y, x) = ssize.height*(0.5f + v*k);
+        }
+    Mat M = getRotationMatrix2D(Point2f(150.f, 120.f), 25, 1.7);
+    Mat H = (Mat_<double>(3, 3) << 0.9, 0.15, -20, -0.1, 1.1, 15, 0.0004, -0.0006, 1);
+    const Scalar borderValue(7, 100, 200, 255);
+
+    for (int border = 0; border < 3; border++)
+    {
+        const int borderMode = border == 0 ? BORDER_CONSTANT : border == 1 ? BORDER_REFLECT_101 : BORDER_TRANSPARENT;
+        Mat ref, dst;
+
+        ref = Mat(dsize, type, Scalar::all(3));
+        dst = ref.clone();
+        cv::remap(src, ref, mapx, mapy, interpolation, borderMode, borderValue);
+        createRemapPlan(mapx, mapy, interpolation, borderMode, borderValue, packMaps)->apply(src, dst);
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << "remap, border=" << borderMode;
+
+        ref = Mat(dsize, type, Scalar::all(3));
+        dst = ref.clone();
+        cv::warpAffine(src, ref, M, dsize, interpolation, borderMode, borderValue);
+        createWarpAffinePlan(M, dsize, interpolation, borderMode, borderValue, packMaps)->apply(src, dst);
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << "warpAffine, border=" << borderMode;
+
+        ref = Mat(dsize, type, Scalar::all(3));
+        dst = ref.clone();
+        cv::warpPerspective(src, ref, H, dsize, interpolation | WARP_INVERSE_MAP, borderMode, borderValue);
+        createWarpPerspectivePlan(H, dsize, interpolation | WARP_INVERSE_MAP, borderMode, borderValue, packMaps)->apply(src, dst);
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF)) << "warpPerspective, border=" << borderMode;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_WarpPlan_Compare, testing::Combine(
+    testing::Values(CV_8UC1, CV_8UC3, CV_16UC1, CV_32FC1, CV_32FC4),
+    testing::Values((int)INTER_NEAREST, (int)INTER_LINEAR, (int)INTER_CUBIC, (int)INTER_LANCZOS4),
+    testing::Bool()));
+
+TEST(Imgproc_WarpPlan, fixed_point_maps_and_memory)
+{
+    const Size size(640, 480);
+    Mat src(size, CV_8UC3);
+    theRNG().fill(src, RNG::UNIFORM, 0, 255);
+
+    Mat mapx(size, CV_32FC1), mapy(size, CV_32FC1);
+    for (int y = 0; y < size.height; y++)
+        for (int x = 0; x < size.width; x++)
+        {
+            mapx.at<float>(y, x) = x*0.8f + y*0.05f + 10.3f;
+            mapy.at<float>(y, x) = y*0.9f - x*0.03f + 0.6f;
+        }
+    Mat map1, map2;
+    cv::convertMaps(mapx, mapy, map1, map2, CV_16SC2);
+
+    Mat ref, dst;
+    cv::remap(src, ref, map1, map2, INTER_LINEAR, BORDER_REPLICATE);
+    Ptr<WarpPlan> plan = createRemapPlan(map1, map2, INTER_LINEAR, BORDER_REPLICATE);
+    Ptr<WarpPlan> packed = createRemapPlan(map1, map2, INTER_LINEAR, BORDER_REPLICATE, Scalar(), true);
+    EXPECT_EQ(size, plan->getDstSize());
+    EXPECT_LT(packed->getMapMemory(), plan->getMapMemory()*3/4);
+
+    plan->apply(src, dst);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+    packed->apply(src, dst);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+
+    // nearest neighbor with the interpolation table index of the fixed-point maps
+    cv::remap(src, ref, map1, map2, INTER_NEAREST, BORDER_CONSTANT);
+    createRemapPlan(map1, map2, INTER_NEAREST, BORDER_CONSTANT, Scalar(), true)->apply(src, dst);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+
+    // a smaller source than the one the maps were made for
+    Mat small = src(Rect(0, 0, 200, 150));
+    cv::remap(small, ref, map1, map2, INTER_LINEAR, BORDER_CONSTANT, Scalar(1, 2, 3));
+    createRemapPlan(mapx, mapy, INTER_LINEAR, BORDER_CONSTANT, Scalar(1, 2, 3), true)->apply(small, dst);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+}
+
 }} // namespace
 /* End of file. */
@@ -402,4 +402,38 @@ TEST_F(Imgproc_LSD_Common, compareSegmentsVec4i)
     ASSERT_EQ(result2, 11);
 }
 
+TEST_F(Imgproc_LSD_Common, parallelSameAsSequential)
+{
+    test_image = Mat(img_size, CV_8UC1, Scalar::all(200));
+    for (int i = 0; i < 60; ++i)
+    {
+        Point p1(rng.uniform(0, img_size.width), rng.uniform(0, img_size.height));
+        Point p2(rng.uniform(0, img_size.width), rng.uniform(0, img_size.height));
+        line(test_image, p1, p2, Scalar::all(rng.uniform(0, 100)), rng.uniform(1, 4), LINE_AA);
+    }
+    Mat noise(img_size, CV_8SC1);
+    rng.fill(noise, RNG::NORMAL, 0, 8);
+    cv::add(test_image, noise, test_image, noArray(), CV_8U);
+
+    const int prevThreads = cv::getNumThreads();
+    for (int refine = LSD_REFINE_NONE; refine <= LSD_REFINE_ADV; ++refine)
+    {
+        Ptr<LineSegmentDetector> detector = createLineSegmentDetector(refine);
+        std::vector<Vec4f> lines1, lines4;
+        std::vector<double> width1, width4, nfa1, nfa4;
+
+        cv::setNumThreads(1);
+        detector->detect(test_image, lines1, width1, noArray(), nfa1);
+        cv::setNumThreads(4);
+        detector->detect(test_image, lines4, width4, noArray(), nfa4);
+
+        ASSERT_FALSE(lines1.empty()) << "refine=" << refine;
+        ASSERT_EQ(lines1.size(), lines4.size()) << "refine=" << refine;
+        EXPECT_EQ(0, cvtest::norm(lines1, lines4, NORM_INF)) << "refine=" << refine;
+        EXPECT_EQ(0, cvtest::norm(width1, width4, NORM_INF)) << "refine=" << refine;
+        EXPECT_EQ(0, cvtest::norm(nfa1, nfa4, NORM_INF)) << "refine=" << refine;
+    }
+    cv::setNumThreads(prevThreads);
+}
+
 }} // namespace
@@ -0,0 +1,82 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "test_precomp.hpp"
+
+namespace opencv_test { namespace {
+
+typedef testing::TestWithParam<tuple<int, double, int> > Imgproc_RecursiveGaussianBlur_Compare;
+
+// the recursive filter should stay within a few levels of the exact GaussianBlur
+TEST_P(Imgproc_RecursiveGaussianBlur_Compare, GaussianBlur)
+{
+    const int type = get<0>(GetParam());
+    const double sigma = get<1>(GetParam());
+    const int borderType = get<2>(GetParam());
+    const int ksize = 2*cvCeil(sigma*4) + 1;
+
+    RNG& rng = theRNG();
+    Mat noise(Size(320 + 2*ksize, 240 + 2*ksize), CV_MAKETYPE(CV_32F, CV_MAT_CN(type)));
+    rng.fill(noise, RNG::UNIFORM, 0, 255);
+    Mat whole;
+    cv::GaussianBlur(noise, noise, Size(0, 0), 2);
+    noise.convertTo(whole, type);
+    Mat src = whole(Rect(ksize, ksize/2, 320, 240));
+
+    Mat dst, ref;
+    cv::GaussianBlur(src, ref, Size(ksize, ksize), sigma, sigma, borderType);
+    recursiveGaussianBlur(src, dst, sigma, 0, borderType);
+    EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 3.) << "sigma=" << sigma;
+
+    if (CV_MAT_DEPTH(type) == CV_32F)
+    {
+        // the whole response to a step edge
+        Mat edge(src.size(), type, Scalar::all(0.));
+        edge.colRange(src.cols/2, src.cols).setTo(Scalar::all(1.));
+        cv::GaussianBlur(edge, ref, Size(ksize, ksize), sigma, sigma, borderType);
+        recursiveGaussianBlur(edge, dst, sigma, 0, borderType);
+        EXPECT_LE(cvtest::norm(ref, dst, NORM_INF), 0.025) << "sigma=" << sigma;
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Imgproc_RecursiveGaussianBlur_Compare,
+    testing::Combine(
+        testing::Values(CV_8UC1, CV_8UC3, CV_16UC1, CV_16SC1, CV_32FC1, CV_32FC4),
+        testing::Values(5., 12.5, 30.),
+        testing::Values(BORDER_REFLECT_101, BORDER_REPLICATE, BORDER_CONSTANT, BORDER_REFLECT | BORDER_ISOLATED)
+    )
+);
+
+TEST(Imgproc_RecursiveGaussianBlur, anisotropic_and_threads)
+{
+    Mat src(333, 517, CV_8UC3);
+    theRNG().fill(src, RNG::UNIFORM, 0, 256);
+
+    int nthreads = getNumThreads();
+    setNumThreads(1);
+    Mat dst1;
+    recursiveGaussianBlur(src, dst1, 7.5, 21.);
+    setNumThreads(4);
+    Mat dst4;
+    recursiveGaussianBlur(src, dst4, 7.5, 21.);
+    setNumThreads(nthreads);
+
+    EXPECT_EQ(0, cvtest::norm(dst1, dst4, NORM_INF));
+
+    Mat ref;
+    cv::GaussianBlur(src, ref, Size(61, 169), 7.5, 21.);
+    EXPECT_LE(cvtest::norm(ref, dst1, NORM_INF), 3.);
+}
+
+TEST(Imgproc_RecursiveGaussianBlur, inplace)
+{
+    Mat src(100, 120, CV_32FC1);
+    theRNG().fill(src, RNG::UNIFORM, 0, 1);
+    Mat ref;
+    recursiveGaussianBlur(src, ref, 10.);
+    recursiveGaussianBlur(src, src, 10.);
+    EXPECT_EQ(0, cvtest::norm(ref, src, NORM_INF));
+}
+
+}} // namespace
@@ -425,4 +425,60 @@ TEST(Imgproc_MatchTemplate, bug_9597) {
         cv::minMaxLoc(result, &minValue, NULL, NULL, NULL);
         ASSERT_GE(minValue, 0);
 }
+
+TEST(Imgproc_MatchTemplate, TemplateMatcher_same_as_matchTemplate)
+{
+    const int types[] = { CV_8UC1, CV_8UC3, CV_32FC1 };
+    const Size sizes[] = { Size(16, 16), Size(31, 9), Size(5, 40), Size(24, 24), Size(61, 43) };
+    int nthreads = getNumThreads();
+    setNumThreads(4);
+    for (int type : types)
+    {
+        Mat img(Size(403, 297), type);
+        RNG& rng = theRNG();
+        rng.fill(img, RNG::UNIFORM, 0, 256);
+        std::vector<Mat> templs;
+        for (Size sz : sizes)
+            templs.push_back(img(Rect(rng.uniform(0, img.cols - sz.width), rng.uniform(0, img.rows - sz.height),
+                                      sz.width, sz.height)).clone() + Scalar::all(rng.uniform(-5, 5)));
+        Ptr<TemplateMatcher> matcher = createTemplateMatcher(templs, TM_CCORR);
+        for (int method = TM_SQDIFF; method <= TM_CCOEFF_NORMED; method++)
+        {
+            matcher->setMethod(method);
+            std::vector<Mat> results;
+            // the second call reuses the cached template spectra
+            for (int iter = 0; iter < 2; iter++)
+                matcher->match(img, results);
+            ASSERT_EQ(templs.size(), results.size());
+            for (size_t i = 0; i < templs.size(); i++)
+            {
+                Mat ref;
+                cv::matchTemplate(img, templs[i], ref, method);
+                ASSERT_EQ(ref.size(), results[i].size());
+                double maxRef = cvtest::norm(ref, NORM_INF);
+                EXPECT_LE(cvtest::norm(ref, results[i], NORM_INF), std::max(maxRef, 1.)*1e-4)
+                    << "type=" << type << " method=" << method << " templ=" << templs[i].size();
+            }
+        }
+    }
+    setNumThreads(nthreads);
+}
+
+TEST(Imgproc_MatchTemplate, parallel_blocks)
+{
+    Mat img(Size(1024, 768), CV_8UC1), templ;
+    theRNG().fill(img, RNG::UNIFORM, 0, 256);
+    img(Rect(300, 200, 40, 30)).copyTo(templ);
+
+    int nthreads = getNumThreads();
+    setNumThreads(1);
+    Mat ref;
+    cv::matchTemplate(img, templ, ref, TM_CCOEFF_NORMED);
+    setNumThreads(4);
+    Mat result;
+    cv::matchTemplate(img, templ, result, TM_CCOEFF_NORMED);
+    setNumThreads(nthreads);
+
+    EXPECT_EQ(0, cvtest::norm(ref, result, NORM_INF));
+}
 } // namespace
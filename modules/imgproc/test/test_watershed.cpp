@@ -128,3 +128,70 @@ TEST(Imgproc_Watershed, regression) { CV_WatershedTest test; test.safe_run(); }
 }} // namespace
 
 #endif
+
+namespace opencv_test { namespace {
+
+static void makeWatershedInput(Size size, int nmarkers, Mat& img, Mat& markers)
+{
+    RNG& rng = theRNG();
+    img.create(size, CV_8UC3);
+    rng.fill(img, RNG::UNIFORM, 0, 256);
+    cv::GaussianBlur(img, img, Size(0, 0), 4);
+    markers = Mat::zeros(size, CV_32SC1);
+    for (int k = 1; k <= nmarkers; k++)
+        cv::circle(markers, Point(rng.uniform(0, size.width), rng.uniform(0, size.height)),
+                   rng.uniform(1, 6), Scalar::all(k), FILLED);
+}
+
+TEST(Imgproc_Watershed, tiled_single_tile)
+{
+    Mat img, markers;
+    makeWatershedInput(Size(317, 241), 30, img, markers);
+    Mat ref = markers.clone(), dst = markers.clone();
+    cv::watershed(img, ref);
+    cv::watershedTiled(img, dst, 317);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+}
+
+TEST(Imgproc_Watershed, tiled_deterministic)
+{
+    Mat img, markers;
+    makeWatershedInput(Size(517, 389), 60, img, markers);
+    const int prevThreads = getNumThreads();
+    for (int tileSize = 16; tileSize <= 128; tileSize *= 2)
+    {
+        Mat dst1 = markers.clone(), dst4 = markers.clone();
+        setNumThreads(1);
+        cv::watershedTiled(img, dst1, tileSize);
+        setNumThreads(4);
+        cv::watershedTiled(img, dst4, tileSize);
+        EXPECT_EQ(0, cvtest::norm(dst1, dst4, NORM_INF)) << "tileSize=" << tileSize;
+
+        // every pixel is labeled and the markers keep their labels
+        Mat unlabeled = (dst1 == 0) | (dst1 < -1);
+        EXPECT_EQ(0, countNonZero(unlabeled)) << "tileSize=" << tileSize;
+        Mat seeds = markers > 0;
+        cv::rectangle(seeds, Rect(0, 0, seeds.cols, seeds.rows), Scalar::all(0)); // the image border is -1
+        EXPECT_EQ(0, countNonZero((dst1 != markers) & seeds)) << "tileSize=" << tileSize;
+    }
+    setNumThreads(prevThreads);
+}
+
+TEST(Imgproc_PyrMeanShiftFiltering, parallel_rows)
+{
+    Mat img, dst1, dst4;
+    Mat markers;
+    makeWatershedInput(Size(203, 151), 1, img, markers);
+    const int prevThreads = getNumThreads();
+    for (int maxLevel = 0; maxLevel <= 2; maxLevel++)
+    {
+        setNumThreads(1);
+        cv::pyrMeanShiftFiltering(img, dst1, 10, 20, maxLevel);
+        setNumThreads(4);
+        cv::pyrMeanShiftFiltering(img, dst4, 10, 20, maxLevel);
+        EXPECT_EQ(0, cvtest::norm(dst1, dst4, NORM_INF)) << "maxLevel=" << maxLevel;
+    }
+    setNumThreads(prevThreads);
+}
+
+}} // namespace